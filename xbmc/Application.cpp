@@ -203,6 +203,9 @@
 #include "XHandle.h"
 #include "XTimeUtils.h"
 #endif
+#ifdef HAVE_INOTIFY
+#include "linux/LibraryWatcher.h"
+#endif
 
 #if defined(TARGET_ANDROID)
 #include "platform/android/activity/XBMCApp.h"
@@ -2928,6 +2931,10 @@ void CApplication::Stop(int exitCode)
     // cancel any jobs from the jobmanager
     CJobManager::GetInstance().CancelJobs();
 
+#ifdef HAVE_INOTIFY
+    CLibraryWatcher::GetInstance().Stop();
+#endif
+
     // stop scanning before we kill the network and so on
     if (m_musicInfoScanner->IsScanning())
       m_musicInfoScanner->Stop(true);
@@ -3629,6 +3636,29 @@ void CApplication::OnQueueNextItem()
   g_windowManager.SendThreadMessage(msg);
 }
 
+void CApplication::PrepareUpcomingItems()
+{
+  if (!m_pPlayer->IsPlayingAudio())
+    return;
+
+  CFileItemList items;
+  const CPlayList& playlist = g_playlistPlayer.GetPlaylist(g_playlistPlayer.GetCurrentPlaylist());
+  for (int i = 1; i <= g_advancedSettings.m_audioPreDecodeItems; i++)
+  {
+    int next = g_playlistPlayer.GetNextSong(i);
+    if (next < 0 || next >= playlist.size())
+      break;
+
+    // plugin and UPnP items are resolved only once they get queued
+    const CFileItemPtr item = playlist[next];
+    if (!item->IsAudio() || item->IsVideo() || item->IsPlugin() || URIUtils::IsUPnP(item->GetPath()))
+      break;
+    items.Add(CFileItemPtr(new CFileItem(*item)));
+  }
+
+  m_pPlayer->PrepareNextFiles(items);
+}
+
 void CApplication::OnPlayBackStopped()
 {
   CSingleLock lock(m_playStateMutex);
@@ -4222,6 +4252,7 @@ bool CApplication::OnMessage(CGUIMessage& message)
       }
       g_infoManager.SetCurrentItem(m_itemCurrentFile);
       g_partyModeManager.OnSongChange(true);
+      PrepareUpcomingItems();
 
       CVariant param;
       param["player"]["speed"] = 1;
@@ -5018,6 +5049,10 @@ void CApplication::UpdateLibraries()
     CLog::LogF(LOGNOTICE, "Starting music library startup scan");
     StartMusicScan("", !CSettings::GetInstance().GetBool(CSettings::SETTING_MUSICLIBRARY_BACKGROUNDUPDATE));
   }
+
+#ifdef HAVE_INOTIFY
+  CLibraryWatcher::GetInstance().Start();
+#endif
 }
 
 bool CApplication::IsVideoScanning() const
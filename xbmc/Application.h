@@ -497,6 +497,10 @@ protected:
   void VolumeChanged() const;
 
   PlayBackRet PlayStack(const CFileItem& item, bool bRestart);
+
+  /*! \brief Hand the playlist items after the current one to the player, so it can open them ahead of time
+  */
+  void PrepareUpcomingItems();
   int  GetActiveWindowID(void);
 
   float NavigationIdleTime();
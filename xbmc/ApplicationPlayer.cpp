@@ -504,6 +504,13 @@ void CApplicationPlayer::OnNothingToQueueNotify()
     player->OnNothingToQueueNotify();
 }
 
+void CApplicationPlayer::PrepareNextFiles(const CFileItemList &items)
+{
+  std::shared_ptr<IPlayer> player = GetInternal();
+  if (player)
+    player->PrepareNextFiles(items);
+}
+
 void CApplicationPlayer::GetVideoStreamInfo(int streamId, SPlayerVideoStreamInfo &info)
 {
   std::shared_ptr<IPlayer> player = GetInternal();
@@ -152,6 +152,7 @@ public:
   bool  OnAction(const CAction &action);
   void  OnNothingToQueueNotify();
   void  Pause();
+  void  PrepareNextFiles(const CFileItemList &items);
   bool  QueueNextFile(const CFileItem &file);
   bool  Record(bool bOnOff);
   void  Seek(bool bPlus = true, bool bLargeStep = false, bool bChapterOverride = false);
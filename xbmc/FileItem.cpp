@@ -125,7 +125,7 @@ CFileItem::CFileItem(const CEpgInfoTagPtr& tag)
   Initialize();
 
   m_bIsFolder = false;
-  m_epgInfoTag = tag;
+  GetPVRInfoTags().epg = tag;
   m_strPath = tag->Path();
   SetLabel(tag->Title());
   m_strLabel2 = tag->Plot();
@@ -149,7 +149,7 @@ CFileItem::CFileItem(const CPVRChannelPtr& channel)
 
   m_strPath = channel->Path();
   m_bIsFolder = false;
-  m_pvrChannelInfoTag = channel;
+  GetPVRInfoTags().channel = channel;
   SetLabel(channel->ChannelName());
   m_strLabel2 = epgNow ? epgNow->Title() :
       CSettings::GetInstance().GetBool(CSettings::SETTING_EPG_HIDENOINFOAVAILABLE) ?
@@ -190,7 +190,7 @@ CFileItem::CFileItem(const CPVRRecordingPtr& record)
   Initialize();
 
   m_bIsFolder = false;
-  m_pvrRecordingInfoTag = record;
+  GetPVRInfoTags().recording = record;
   m_strPath = record->m_strFileNameAndPath;
   SetLabel(record->m_strTitle);
   m_strLabel2 = record->m_strPlot;
@@ -204,7 +204,7 @@ CFileItem::CFileItem(const CPVRTimerInfoTagPtr& timer)
   Initialize();
 
   m_bIsFolder = timer->IsTimerRule();
-  m_pvrTimerInfoTag = timer;
+  GetPVRInfoTags().timer = timer;
   m_strPath = timer->Path();
   SetLabel(timer->Title());
   m_strLabel2 = timer->Summary();
@@ -241,6 +241,7 @@ CFileItem::CFileItem(const CGenre& genre)
 CFileItem::CFileItem(const CFileItem& item)
 : m_musicInfoTag(NULL),
   m_videoInfoTag(NULL),
+  m_pvrInfoTags(NULL),
   m_pictureInfoTag(NULL)
 {
   *this = item;
@@ -338,10 +339,12 @@ CFileItem::~CFileItem(void)
   delete m_musicInfoTag;
   delete m_videoInfoTag;
   delete m_pictureInfoTag;
+  delete m_pvrInfoTags;
 
   m_musicInfoTag = NULL;
   m_videoInfoTag = NULL;
   m_pictureInfoTag = NULL;
+  m_pvrInfoTags = NULL;
 }
 
 const CFileItem& CFileItem::operator=(const CFileItem& item)
@@ -398,11 +401,13 @@ const CFileItem& CFileItem::operator=(const CFileItem& item)
     m_pictureInfoTag = NULL;
   }
 
-  m_epgInfoTag = item.m_epgInfoTag;
-  m_pvrChannelInfoTag = item.m_pvrChannelInfoTag;
-  m_pvrRecordingInfoTag = item.m_pvrRecordingInfoTag;
-  m_pvrTimerInfoTag = item.m_pvrTimerInfoTag;
-  m_pvrRadioRDSInfoTag = item.m_pvrRadioRDSInfoTag;
+  if (item.m_pvrInfoTags)
+    GetPVRInfoTags() = *item.m_pvrInfoTags;
+  else
+  {
+    delete m_pvrInfoTags;
+    m_pvrInfoTags = NULL;
+  }
   m_addonInfo = item.m_addonInfo;
   m_eventLogEntry = item.m_eventLogEntry;
 
@@ -430,6 +435,7 @@ void CFileItem::Initialize()
 {
   m_musicInfoTag = NULL;
   m_videoInfoTag = NULL;
+  m_pvrInfoTags = NULL;
   m_pictureInfoTag = NULL;
   m_bLabelPreformated = false;
   m_bIsAlbum = false;
@@ -470,11 +476,8 @@ void CFileItem::Reset()
   m_musicInfoTag=NULL;
   delete m_videoInfoTag;
   m_videoInfoTag=NULL;
-  m_epgInfoTag.reset();
-  m_pvrChannelInfoTag.reset();
-  m_pvrRecordingInfoTag.reset();
-  m_pvrTimerInfoTag.reset();
-  m_pvrRadioRDSInfoTag.reset();
+  delete m_pvrInfoTags;
+  m_pvrInfoTags=NULL;
   delete m_pictureInfoTag;
   m_pictureInfoTag=NULL;
   m_extrainfo.clear();
@@ -529,10 +532,10 @@ void CFileItem::Archive(CArchive& ar)
     }
     else
       ar << 0;
-    if (m_pvrRadioRDSInfoTag)
+    if (HasPVRRadioRDSInfoTag())
     {
       ar << 1;
-      ar << *m_pvrRadioRDSInfoTag;
+      ar << *m_pvrInfoTags->radioRDS;
     }
     else
       ar << 0;
@@ -582,7 +585,7 @@ void CFileItem::Archive(CArchive& ar)
       ar >> *GetVideoInfoTag();
     ar >> iType;
     if (iType == 1)
-      ar >> *m_pvrRadioRDSInfoTag;
+      ar >> *GetPVRInfoTags().radioRDS;
     ar >> iType;
     if (iType == 1)
       ar >> *GetPictureInfoTag();
@@ -593,27 +596,48 @@ void CFileItem::Archive(CArchive& ar)
 
 void CFileItem::Serialize(CVariant& value) const
 {
-  //CGUIListItem::Serialize(value["CGUIListItem"]);
+  Serialize(value, NULL);
+}
+
+void CFileItem::SerializeFields(CVariant& value, const std::set<std::string>& fields) const
+{
+  Serialize(value, &fields);
+}
 
-  value["strPath"] = m_strPath;
-  value["dateTime"] = (m_dateTime.IsValid()) ? m_dateTime.GetAsRFC1123DateTime() : "";
-  value["lastmodified"] = m_dateTime.IsValid() ? m_dateTime.GetAsDBDateTime() : "";
-  value["size"] = m_dwSize;
-  value["DVDLabel"] = m_strDVDLabel;
-  value["title"] = m_strTitle;
-  value["mimetype"] = m_mimetype;
-  value["extrainfo"] = m_extrainfo;
+void CFileItem::Serialize(CVariant& value, const std::set<std::string>* fields) const
+{
+  //CGUIListItem::Serialize(value["CGUIListItem"]);
 
-  if (m_musicInfoTag)
+  auto wanted = [fields](const char* field) { return fields == NULL || fields->find(field) != fields->end(); };
+
+  if (wanted("strPath"))
+    value["strPath"] = m_strPath;
+  if (wanted("dateTime"))
+    value["dateTime"] = (m_dateTime.IsValid()) ? m_dateTime.GetAsRFC1123DateTime() : "";
+  if (wanted("lastmodified"))
+    value["lastmodified"] = m_dateTime.IsValid() ? m_dateTime.GetAsDBDateTime() : "";
+  if (wanted("size"))
+    value["size"] = m_dwSize;
+  if (wanted("DVDLabel"))
+    value["DVDLabel"] = m_strDVDLabel;
+  if (wanted("title"))
+    value["title"] = m_strTitle;
+  if (wanted("mimetype"))
+    value["mimetype"] = m_mimetype;
+  if (wanted("extrainfo"))
+    value["extrainfo"] = m_extrainfo;
+
+  // the tags are serialized on their own for JSON-RPC, only do it again when asked for
+  if (m_musicInfoTag && wanted("musicInfoTag"))
     (*m_musicInfoTag).Serialize(value["musicInfoTag"]);
 
-  if (m_videoInfoTag)
+  if (m_videoInfoTag && wanted("videoInfoTag"))
     (*m_videoInfoTag).Serialize(value["videoInfoTag"]);
 
-  if (m_pvrRadioRDSInfoTag)
-    m_pvrRadioRDSInfoTag->Serialize(value["rdsInfoTag"]);
+  if (HasPVRRadioRDSInfoTag() && wanted("rdsInfoTag"))
+    m_pvrInfoTags->radioRDS->Serialize(value["rdsInfoTag"]);
 
-  if (m_pictureInfoTag)
+  if (m_pictureInfoTag && wanted("pictureInfoTag"))
     (*m_pictureInfoTag).Serialize(value["pictureInfoTag"]);
 }
 
@@ -792,12 +816,12 @@ bool CFileItem::IsPVRRecording() const
 
 bool CFileItem::IsUsablePVRRecording() const
 {
-  return (m_pvrRecordingInfoTag && !m_pvrRecordingInfoTag->IsDeleted());
+  return (HasPVRRecordingInfoTag() && !m_pvrInfoTags->recording->IsDeleted());
 }
 
 bool CFileItem::IsDeletedPVRRecording() const
 {
-  return (m_pvrRecordingInfoTag && m_pvrRecordingInfoTag->IsDeleted());
+  return (HasPVRRecordingInfoTag() && m_pvrInfoTags->recording->IsDeleted());
 }
 
 bool CFileItem::IsPVRTimer() const
@@ -1338,8 +1362,8 @@ void CFileItem::FillInMimeType(bool lookup /*= true*/)
   {
     if( m_bIsFolder )
       m_mimetype = "x-directory/normal";
-    else if( m_pvrChannelInfoTag )
-      m_mimetype = m_pvrChannelInfoTag->InputFormat();
+    else if( HasPVRChannelInfoTag() )
+      m_mimetype = m_pvrInfoTags->channel->InputFormat();
     else if( StringUtils::StartsWithNoCase(m_strPath, "shout://")
           || StringUtils::StartsWithNoCase(m_strPath, "http://")
           || StringUtils::StartsWithNoCase(m_strPath, "https://"))
@@ -1447,8 +1471,8 @@ void CFileItem::UpdateInfo(const CFileItem &item, bool replaceLabels /*=true*/)
     //! @todo premiered info is normally stored in m_dateTime by the db
     *GetVideoInfoTag() = *item.GetVideoInfoTag();
     // preferably use some information from PVR info tag if available
-    if (m_pvrRecordingInfoTag)
-      m_pvrRecordingInfoTag->CopyClientInfo(GetVideoInfoTag());
+    if (HasPVRRecordingInfoTag())
+      m_pvrInfoTags->recording->CopyClientInfo(GetVideoInfoTag());
     SetOverlayImage(ICON_OVERLAY_UNWATCHED, GetVideoInfoTag()->m_playCount > 0);
     SetInvalid();
   }
@@ -1459,7 +1483,7 @@ void CFileItem::UpdateInfo(const CFileItem &item, bool replaceLabels /*=true*/)
   }
   if (item.HasPVRRadioRDSInfoTag())
   {
-    m_pvrRadioRDSInfoTag = item.m_pvrRadioRDSInfoTag;
+    GetPVRInfoTags().radioRDS = item.m_pvrInfoTags->radioRDS;
     SetInvalid();
   }
   if (item.HasPictureInfoTag())
@@ -2991,8 +3015,8 @@ std::string CFileItem::GetMovieName(bool bUseFolderNames /* = false */) const
   if (IsLabelPreformated())
     return GetLabel();
 
-  if (m_pvrRecordingInfoTag)
-    return m_pvrRecordingInfoTag->m_strTitle;
+  if (HasPVRRecordingInfoTag())
+    return m_pvrInfoTags->recording->m_strTitle;
   else if (CUtil::IsTVRecording(m_strPath))
   {
     std::string title = CPVRRecording::GetTitleFromURL(m_strPath);
@@ -3266,6 +3290,14 @@ CVideoInfoTag* CFileItem::GetVideoInfoTag()
   return m_videoInfoTag;
 }
 
+CFileItem::SPVRInfoTags& CFileItem::GetPVRInfoTags()
+{
+  if (!m_pvrInfoTags)
+    m_pvrInfoTags = new SPVRInfoTags;
+
+  return *m_pvrInfoTags;
+}
+
 CPictureInfoTag* CFileItem::GetPictureInfoTag()
 {
   if (!m_pictureInfoTag)
@@ -3391,15 +3423,15 @@ int CFileItem::GetVideoContentType() const
 bool CFileItem::IsResumePointSet() const
 {
   return (HasVideoInfoTag() && GetVideoInfoTag()->m_resumePoint.IsSet()) ||
-      (m_pvrRecordingInfoTag && m_pvrRecordingInfoTag->GetLastPlayedPosition() > 0);
+      (HasPVRRecordingInfoTag() && m_pvrInfoTags->recording->GetLastPlayedPosition() > 0);
 }
 
 double CFileItem::GetCurrentResumeTime() const
 {
-  if (m_pvrRecordingInfoTag)
+  if (HasPVRRecordingInfoTag())
   {
     // This will retrieve 'fresh' resume information from the PVR server
-    int rc = m_pvrRecordingInfoTag->GetLastPlayedPosition();
+    int rc = m_pvrInfoTags->recording->GetLastPlayedPosition();
     if (rc > 0)
       return rc;
     // Fall through to default value
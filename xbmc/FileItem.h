@@ -143,6 +143,7 @@ public:
   const CFileItem& operator=(const CFileItem& item);
   virtual void Archive(CArchive& ar);
   virtual void Serialize(CVariant& value) const;
+  virtual void SerializeFields(CVariant& value, const std::set<std::string>& fields) const;
   virtual void ToSortable(SortItem &sortable, Field field) const;
   void ToSortable(SortItem &sortable, const Fields &fields) const;
   virtual bool IsFileItem() const { return true; };
@@ -274,62 +275,64 @@ public:
 
   inline bool HasEPGInfoTag() const
   {
-    return m_epgInfoTag.get() != NULL;
+    return m_pvrInfoTags && m_pvrInfoTags->epg;
   }
 
   inline const EPG::CEpgInfoTagPtr GetEPGInfoTag() const
   {
-    return m_epgInfoTag;
+    return m_pvrInfoTags ? m_pvrInfoTags->epg : EPG::CEpgInfoTagPtr();
   }
 
   inline void SetEPGInfoTag(const EPG::CEpgInfoTagPtr& tag)
   {
-    m_epgInfoTag = tag;
+    if (tag || m_pvrInfoTags)
+      GetPVRInfoTags().epg = tag;
   }
 
   inline bool HasPVRChannelInfoTag() const
   {
-    return m_pvrChannelInfoTag.get() != NULL;
+    return m_pvrInfoTags && m_pvrInfoTags->channel;
   }
 
   inline const PVR::CPVRChannelPtr GetPVRChannelInfoTag() const
   {
-    return m_pvrChannelInfoTag;
+    return m_pvrInfoTags ? m_pvrInfoTags->channel : PVR::CPVRChannelPtr();
   }
 
   inline bool HasPVRRecordingInfoTag() const
   {
-    return m_pvrRecordingInfoTag.get() != NULL;
+    return m_pvrInfoTags && m_pvrInfoTags->recording;
   }
 
   inline const PVR::CPVRRecordingPtr GetPVRRecordingInfoTag() const
   {
-    return m_pvrRecordingInfoTag;
+    return m_pvrInfoTags ? m_pvrInfoTags->recording : PVR::CPVRRecordingPtr();
   }
 
   inline bool HasPVRTimerInfoTag() const
   {
-    return m_pvrTimerInfoTag != NULL;
+    return m_pvrInfoTags && m_pvrInfoTags->timer;
   }
 
   inline const PVR::CPVRTimerInfoTagPtr GetPVRTimerInfoTag() const
   {
-    return m_pvrTimerInfoTag;
+    return m_pvrInfoTags ? m_pvrInfoTags->timer : PVR::CPVRTimerInfoTagPtr();
   }
 
   inline bool HasPVRRadioRDSInfoTag() const
   {
-    return m_pvrRadioRDSInfoTag.get() != NULL;
+    return m_pvrInfoTags && m_pvrInfoTags->radioRDS;
   }
 
   inline const PVR::CPVRRadioRDSInfoTagPtr GetPVRRadioRDSInfoTag() const
   {
-    return m_pvrRadioRDSInfoTag;
+    return m_pvrInfoTags ? m_pvrInfoTags->radioRDS : PVR::CPVRRadioRDSInfoTagPtr();
   }
 
   inline void SetPVRRadioRDSInfoTag(const PVR::CPVRRadioRDSInfoTagPtr& tag)
   {
-    m_pvrRadioRDSInfoTag = tag;
+    if (tag || m_pvrInfoTags)
+      GetPVRInfoTags().radioRDS = tag;
   }
 
   /*!
@@ -529,6 +532,26 @@ private:
    */
   void Initialize();
 
+  /*! \brief the PVR and EPG tags, kept apart as library items never have any of them.
+   */
+  struct SPVRInfoTags
+  {
+    EPG::CEpgInfoTagPtr epg;
+    PVR::CPVRChannelPtr channel;
+    PVR::CPVRRecordingPtr recording;
+    PVR::CPVRTimerInfoTagPtr timer;
+    PVR::CPVRRadioRDSInfoTagPtr radioRDS;
+  };
+
+  /*! \brief get the PVR and EPG tags, allocating them if needed.
+   */
+  SPVRInfoTags& GetPVRInfoTags();
+
+  /*! \brief Serialize the members named in fields, or all of them if fields is NULL.
+   \sa SerializeFields
+   */
+  void Serialize(CVariant& value, const std::set<std::string>* fields) const;
+
   std::string m_strPath;            ///< complete path to item
 
   SortSpecial m_specialSort;
@@ -540,11 +563,7 @@ private:
   bool m_doContentLookup;
   MUSIC_INFO::CMusicInfoTag* m_musicInfoTag;
   CVideoInfoTag* m_videoInfoTag;
-  EPG::CEpgInfoTagPtr m_epgInfoTag;
-  PVR::CPVRChannelPtr m_pvrChannelInfoTag;
-  PVR::CPVRRecordingPtr m_pvrRecordingInfoTag;
-  PVR::CPVRTimerInfoTagPtr m_pvrTimerInfoTag;
-  PVR::CPVRRadioRDSInfoTagPtr m_pvrRadioRDSInfoTag;
+  SPVRInfoTags* m_pvrInfoTags;     ///< only allocated for PVR and EPG items
   CPictureInfoTag* m_pictureInfoTag;
   std::shared_ptr<const ADDON::IAddon> m_addonInfo;
   EventPtr m_eventLogEntry;
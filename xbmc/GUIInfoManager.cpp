@@ -6834,14 +6834,6 @@ bool CGUIInfoManager::GetInt(int &value, int info, int contextWindow, const CGUI
   return false;
 }
 
-// functor for comparison InfoPtr's
-struct InfoBoolFinder
-{
-  InfoBoolFinder(const std::string &expression, int context) : m_bool(expression, context) {};
-  bool operator() (const InfoPtr &right) const { return m_bool == *right; };
-  InfoBool m_bool;
-};
-
 INFO::InfoPtr CGUIInfoManager::Register(const std::string &expression, int context)
 {
   std::string condition(CGUIInfoLabel::ReplaceLocalize(expression));
@@ -6851,17 +6843,23 @@ INFO::InfoPtr CGUIInfoManager::Register(const std::string &expression, int conte
     return INFO::InfoPtr();
 
   CSingleLock lock(m_critInfo);
-  // do we have the boolean expression already registered?
-  std::vector<InfoPtr>::const_iterator i = std::find_if(m_bools.begin(), m_bools.end(), InfoBoolFinder(condition, context));
-  if (i != m_bools.end())
-    return *i;
-
+  // do we have the boolean expression already registered? (InfoBool matches case insensitively)
+  std::pair<int, std::string> key(context, condition);
+  StringUtils::ToLower(key.second);
+  InfoBoolIndex::const_iterator i = m_boolIndex.find(key);
+  if (i != m_boolIndex.end())
+    return m_bools[i->second];
+
+  // expressions register their operands while being constructed, so only index afterwards
+  InfoPtr info;
   if (condition.find_first_of("|+[]!") != condition.npos)
-    m_bools.push_back(std::make_shared<InfoExpression>(condition, context));
+    info = std::make_shared<InfoExpression>(condition, context);
   else
-    m_bools.push_back(std::make_shared<InfoSingle>(condition, context));
+    info = std::make_shared<InfoSingle>(condition, context);
 
-  return m_bools.back();
+  m_boolIndex.insert(std::make_pair(key, m_bools.size()));
+  m_bools.push_back(info);
+  return info;
 }
 
 bool CGUIInfoManager::EvaluateBool(const std::string &expression, int contextWindow /* = 0 */, const CGUIListItemPtr &item /* = NULL */)
@@ -9484,6 +9482,10 @@ void CGUIInfoManager::Clear()
     m_bools.erase(i, m_bools.end());
     i = std::remove_if(m_bools.begin(), m_bools.end(), std::mem_fun_ref(&InfoPtr::unique));
   }
+  // reindex what's left
+  m_boolIndex.clear();
+  for (size_t j = 0; j < m_bools.size(); ++j)
+    m_boolIndex.insert(std::make_pair(std::make_pair(m_bools[j]->GetContext(), m_bools[j]->GetExpression()), j));
   // log which ones are used - they should all be gone by now
   for (std::vector<InfoPtr>::const_iterator i = m_bools.begin(); i != m_bools.end(); ++i)
     CLog::Log(LOGDEBUG, "Infobool '%s' still used by %u instances", (*i)->GetExpression().c_str(), (unsigned int) i->use_count());
@@ -41,6 +41,8 @@
 #include <memory>
 #include <list>
 #include <map>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace MUSIC_INFO
@@ -337,6 +339,17 @@ protected:
   int m_prevWindowID;
 
   std::vector<INFO::InfoPtr> m_bools;
+
+  // hashed lookup of registered bools by context and expression
+  struct InfoBoolKeyHash
+  {
+    size_t operator()(const std::pair<int, std::string> &key) const
+    {
+      return std::hash<std::string>()(key.second) ^ std::hash<int>()(key.first);
+    }
+  };
+  typedef std::unordered_map<std::pair<int, std::string>, size_t, InfoBoolKeyHash> InfoBoolIndex;
+  InfoBoolIndex m_boolIndex;   ///< position of each bool in m_bools
   std::vector<INFO::CSkinVariableString> m_skinVariableStrings;
 
   int m_libraryHasMusic;
@@ -21,17 +21,78 @@
 #include "TextureCache.h"
 #include "TextureCacheJob.h"
 #include "filesystem/File.h"
+#include "pictures/Picture.h"
 #include "profiles/ProfilesManager.h"
 #include "threads/SingleLock.h"
+#include "utils/CPUInfo.h"
 #include "utils/Crc32.h"
 #include "settings/AdvancedSettings.h"
 #include "utils/log.h"
+#include "utils/Stopwatch.h"
 #include "utils/URIUtils.h"
 #include "utils/StringUtils.h"
 #include "URL.h"
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
 using namespace XFILE;
 
+// number of cached images recorded per database transaction when caching in bulk, and the
+// longest we hold them back so other callers waiting on one of them aren't blocked too long
+#define BULK_TRANSACTION_SIZE     500
+#define BULK_TRANSACTION_INTERVAL 2.0f
+// maximum number of threads decoding and scaling images when caching in bulk
+#define BULK_MAX_THREADS      4
+
+/*!
+ \brief Shared state of a CacheImages() call.
+ The calling thread and the helper jobs it submits all take images from the same list until
+ it's exhausted. Helpers may start after the call has returned, so they hold a reference.
+ */
+class CTextureCache::CBulkCache
+{
+public:
+  CBulkCache(CTextureCache &cache) : m_cache(cache), m_next(0), m_done(0), m_cancelled(false) {}
+
+  /*! \brief Take the next image and cache it
+   \return false if there were no images left to take.
+   */
+  bool ProcessOne()
+  {
+    size_t i = m_next++;
+    if (i >= m_jobs.size())
+      return false;
+
+    // skip images another job is already busy with
+    CTextureCacheJob *job = m_jobs[i].get();
+    bool process = false;
+    if (!m_cancelled)
+    {
+      CSingleLock lock(m_cache.m_processingSection);
+      process = m_cache.m_processinglist.insert(job->m_url).second;
+    }
+    bool success = process && job->CacheTexture();
+
+    CSingleLock lock(m_section);
+    if (process)
+      m_results.push_back(std::make_pair(job, success));
+    m_done++;
+    m_doneEvent.Set();
+    return true;
+  }
+
+  CTextureCache &m_cache;
+  std::vector<std::unique_ptr<CTextureCacheJob> > m_jobs;
+  std::atomic<size_t> m_next;
+  CCriticalSection m_section;
+  std::vector<std::pair<CTextureCacheJob*, bool> > m_results; ///< processed but not yet recorded
+  size_t m_done;
+  CEvent m_doneEvent;
+  std::atomic<bool> m_cancelled;
+};
+
 CTextureCache &CTextureCache::GetInstance()
 {
   static CTextureCache s_cache;
@@ -130,6 +191,90 @@ void CTextureCache::BackgroundCacheImage(const std::string &url)
   AddJob(new CTextureCacheJob(path, details.hash));
 }
 
+void CTextureCache::BackgroundCacheImages(const std::vector<std::string> &images)
+{
+  if (images.size() == 1)
+    BackgroundCacheImage(images[0]);
+  else if (!images.empty())
+    AddJob(new CTextureBulkCacheJob(images));
+}
+
+unsigned int CTextureCache::CacheImages(const std::vector<std::string> &images, CJob *job /* = NULL */)
+{
+  std::shared_ptr<CBulkCache> bulk = std::make_shared<CBulkCache>(*this);
+  std::set<std::string> urls;
+  for (std::vector<std::string>::const_iterator i = images.begin(); i != images.end(); ++i)
+  {
+    if (i->empty())
+      continue;
+
+    CTextureDetails details;
+    std::string path(GetCachedImage(*i, details));
+    if (!path.empty() && details.hash.empty())
+      continue; // image is already cached and doesn't need to be checked further
+
+    path = CTextureUtils::UnwrapImageURL(*i);
+    if (!path.empty() && urls.insert(path).second)
+      bulk->m_jobs.push_back(std::unique_ptr<CTextureCacheJob>(new CTextureCacheJob(path, details.hash)));
+  }
+  const size_t total = bulk->m_jobs.size();
+  if (!total)
+    return 0;
+
+  CStopWatch timer;
+  timer.StartZero();
+  CStopWatch flushTimer;
+  flushTimer.StartZero();
+  size_t helpers = std::min<size_t>(std::max(g_cpuInfo.getCPUCount(), 1), BULK_MAX_THREADS) - 1;
+  helpers = std::min(helpers, total - 1);
+  for (size_t i = 0; i < helpers; ++i)
+    CJobManager::GetInstance().Submit([bulk]()
+    {
+      CPicture::CScalerScope scaler;
+      while (bulk->ProcessOne()) {}
+    }, CJob::PRIORITY_LOW_PAUSABLE);
+
+  unsigned int cached = 0;
+  bool more = true;
+  CPicture::CScalerScope scaler;
+  while (true)
+  {
+    if (more)
+      more = bulk->ProcessOne();
+    else
+      bulk->m_doneEvent.WaitMSec(100);
+
+    std::vector<std::pair<CTextureCacheJob*, bool> > results;
+    size_t done;
+    {
+      CSingleLock lock(bulk->m_section);
+      done = bulk->m_done;
+      if (bulk->m_results.size() >= BULK_TRANSACTION_SIZE || done == total ||
+          flushTimer.GetElapsedSeconds() >= BULK_TRANSACTION_INTERVAL)
+        results.swap(bulk->m_results);
+    }
+    if (!results.empty())
+    {
+      OnBulkCachingComplete(results);
+      flushTimer.StartZero();
+      for (std::vector<std::pair<CTextureCacheJob*, bool> >::const_iterator i = results.begin(); i != results.end(); ++i)
+      {
+        if (i->second)
+          cached++;
+      }
+    }
+    if (done == total)
+      break;
+    if (job && job->ShouldCancel(done, total))
+      bulk->m_cancelled = true;
+  }
+
+  float elapsed = timer.GetElapsedSeconds();
+  CLog::Log(LOGNOTICE, "%s - cached %u of %u images in %.2fs (%.1f images/sec)", __FUNCTION__,
+            cached, (unsigned int)total, elapsed, elapsed > 0.0f ? cached / elapsed : 0.0f);
+  return cached;
+}
+
 std::string CTextureCache::CacheImage(const std::string &image, CBaseTexture **texture /* = NULL */, CTextureDetails *details /* = NULL */)
 {
   std::string url = CTextureUtils::UnwrapImageURL(image);
@@ -282,6 +427,33 @@ void CTextureCache::OnCachingComplete(bool success, CTextureCacheJob *job)
   m_completeEvent.Set();
 }
 
+void CTextureCache::OnBulkCachingComplete(const std::vector<std::pair<CTextureCacheJob*, bool> > &results)
+{
+  {
+    CSingleLock lock(m_databaseSection);
+    m_database.BeginTransaction();
+    for (std::vector<std::pair<CTextureCacheJob*, bool> >::const_iterator i = results.begin(); i != results.end(); ++i)
+    {
+      if (!i->second)
+        continue;
+      const CTextureCacheJob *job = i->first;
+      if (job->m_oldHash == job->m_details.hash)
+        m_database.SetCachedTextureValid(job->m_url, job->m_details.updateable);
+      else
+        m_database.AddCachedTexture(job->m_url, job->m_details);
+    }
+    m_database.CommitTransaction();
+  }
+
+  { // remove from our processing list
+    CSingleLock lock(m_processingSection);
+    for (std::vector<std::pair<CTextureCacheJob*, bool> >::const_iterator i = results.begin(); i != results.end(); ++i)
+      m_processinglist.erase(i->first->m_url);
+  }
+
+  m_completeEvent.Set();
+}
+
 void CTextureCache::OnJobComplete(unsigned int jobID, bool success, CJob *job)
 {
   if (strcmp(job->GetType(), kJobTypeCacheImage) == 0)
@@ -22,6 +22,7 @@
 
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 #include "utils/JobManager.h"
 #include "TextureDatabase.h"
@@ -80,6 +81,27 @@ public:
    */
   void BackgroundCacheImage(const std::string &image);
 
+  /*! \brief Cache a set of images (if required) using a single background job
+
+   Intended for caching lots of artwork at once, e.g. when scanning a new library.
+   \param images urls of the images to cache
+   \sa BackgroundCacheImage, CacheImages
+   */
+  void BackgroundCacheImages(const std::vector<std::string> &images);
+
+  /*! \brief Cache a set of images in bulk
+
+   Images not yet cached (or needing a recheck) are decoded and scaled on several
+   threads at once and recorded in the texture database in large transactions.
+   Blocks until all images are cached, logging the achieved throughput.
+
+   \param images urls of the images to cache
+   \param job [optional] job to report progress to and check for cancellation
+   \return the number of images that were cached
+   \sa BackgroundCacheImages
+   */
+  unsigned int CacheImages(const std::vector<std::string> &images, CJob *job = NULL);
+
   /*! \brief Cache an image to image cache, optionally return the texture
 
    Caches the given image, returning the texture if the caller wants it.
@@ -219,6 +241,13 @@ private:
    */
   void OnCachingComplete(bool success, CTextureCacheJob *job);
 
+  class CBulkCache;
+  /*! \brief Called with a batch of finished images when caching in bulk.
+   Records the successful ones in a single transaction and removes all of them from our processing list.
+   \param results the caching jobs with their success flags.
+   */
+  void OnBulkCachingComplete(const std::vector<std::pair<CTextureCacheJob*, bool> > &results);
+
   CCriticalSection m_databaseSection;
   CTextureDatabase m_database;
   std::set<std::string> m_processinglist; ///< currently processing list to avoid 2 jobs being processed at once
@@ -248,6 +248,26 @@ std::string CTextureCacheJob::GetImageHash(const std::string &url)
   return "";
 }
 
+CTextureBulkCacheJob::CTextureBulkCacheJob(const std::vector<std::string> &urls) : m_urls(urls)
+{
+}
+
+bool CTextureBulkCacheJob::operator==(const CJob* job) const
+{
+  if (strcmp(job->GetType(),GetType()) == 0)
+  {
+    const CTextureBulkCacheJob* bulkJob = dynamic_cast<const CTextureBulkCacheJob*>(job);
+    if (bulkJob && bulkJob->m_urls == m_urls)
+      return true;
+  }
+  return false;
+}
+
+bool CTextureBulkCacheJob::DoWork()
+{
+  return CTextureCache::GetInstance().CacheImages(m_urls, this) > 0;
+}
+
 CTextureUseCountJob::CTextureUseCountJob(const std::vector<CTextureDetails> &textures) : m_textures(textures)
 {
 }
@@ -127,6 +127,22 @@ private:
   std::string    m_cachePath;
 };
 
+/* \brief Job class for caching a set of textures at once
+ \sa CTextureCache::CacheImages
+ */
+class CTextureBulkCacheJob : public CJob
+{
+public:
+  CTextureBulkCacheJob(const std::vector<std::string> &urls);
+
+  virtual const char* GetType() const { return "cacheimages"; };
+  virtual bool operator==(const CJob *job) const;
+  virtual bool DoWork();
+
+private:
+  std::vector<std::string> m_urls;
+};
+
 /* \brief Job class for storing the use count of textures
  */
 class CTextureUseCountJob : public CJob
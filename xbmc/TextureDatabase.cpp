@@ -342,17 +342,17 @@ bool CTextureDatabase::AddCachedTexture(const std::string &url, const CTextureDe
     if (NULL == m_pDB.get()) return false;
     if (NULL == m_pDS.get()) return false;
 
-    std::string sql = PrepareSQL("DELETE FROM texture WHERE url='%s'", url.c_str());
-    m_pDS->exec(sql);
+    // bound queries, so bulk caching reuses the compiled statements
+    m_pDS->exec("DELETE FROM texture WHERE url=?", { url });
 
     std::string date = details.updateable ? CDateTime::GetCurrentDateTime().GetAsDBDateTime() : "";
-    sql = PrepareSQL("INSERT INTO texture (id, url, cachedurl, imagehash, lasthashcheck) VALUES(NULL, '%s', '%s', '%s', '%s')", url.c_str(), details.file.c_str(), details.hash.c_str(), date.c_str());
-    m_pDS->exec(sql);
+    m_pDS->exec("INSERT INTO texture (id, url, cachedurl, imagehash, lasthashcheck) VALUES(NULL, ?, ?, ?, ?)",
+                { url, details.file, details.hash, date });
     int textureID = (int)m_pDS->lastinsertid();
 
     // set the size information
-    sql = PrepareSQL("INSERT INTO sizes (idtexture, size, usecount, lastusetime, width, height) VALUES(%u, 1, 1, CURRENT_TIMESTAMP, %u, %u)", textureID, details.width, details.height);
-    m_pDS->exec(sql);
+    m_pDS->exec("INSERT INTO sizes (idtexture, size, usecount, lastusetime, width, height) VALUES(?, 1, 1, CURRENT_TIMESTAMP, ?, ?)",
+                { textureID, details.width, details.height });
   }
   catch (...)
   {
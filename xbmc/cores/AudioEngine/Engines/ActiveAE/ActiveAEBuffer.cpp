@@ -53,6 +53,7 @@ CSampleBuffer::CSampleBuffer() : pkt(NULL), pool(NULL)
   refCount = 0;
   timestamp = 0;
   pkt_start_offset = 0;
+  poolIndex = 0;
 }
 
 CSampleBuffer::~CSampleBuffer()
@@ -68,8 +69,7 @@ CSampleBuffer* CSampleBuffer::Acquire()
 
 void CSampleBuffer::Return()
 {
-  refCount--;
-  if (pool && refCount <= 0)
+  if (--refCount <= 0 && pool)
     pool->ReturnBuffer(this);
 }
 
@@ -98,14 +98,12 @@ CActiveAEBufferPool::~CActiveAEBufferPool()
 
 CSampleBuffer* CActiveAEBufferPool::GetFreeBuffer()
 {
-  CSampleBuffer* buf = NULL;
+  unsigned int index;
+  if (!m_freeSamples.Pop(index))
+    return NULL;
 
-  if (!m_freeSamples.empty())
-  {
-    buf = m_freeSamples.front();
-    m_freeSamples.pop_front();
-    buf->refCount = 1;
-  }
+  CSampleBuffer* buf = m_allSamples[index];
+  buf->refCount = 1;
   return buf;
 }
 
@@ -113,7 +111,7 @@ void CActiveAEBufferPool::ReturnBuffer(CSampleBuffer *buffer)
 {
   buffer->pkt->nb_samples = 0;
   buffer->pkt->pause_burst_ms = 0;
-  m_freeSamples.push_back(buffer);
+  m_freeSamples.Push(buffer->poolIndex);
 }
 
 bool CActiveAEBufferPool::Create(unsigned int totaltime)
@@ -139,13 +137,18 @@ bool CActiveAEBufferPool::Create(unsigned int totaltime)
     buffer = new CSampleBuffer();
     buffer->pool = this;
     buffer->pkt = new CSoundPacket(config, m_format.m_frames);
+    buffer->poolIndex = m_allSamples.size();
 
     m_allSamples.push_back(buffer);
-    m_freeSamples.push_back(buffer);
     time += buffertime;
     n++;
   }
 
+  // the free list is sized once, the first buffers are handed out first
+  m_freeSamples.Reset(m_allSamples.size());
+  for (unsigned int i = m_allSamples.size(); i > 0; i--)
+    m_freeSamples.Push(i - 1);
+
   return true;
 }
 
@@ -410,7 +413,7 @@ bool CActiveAEBufferPoolResample::ResampleBuffers(int64_t timestamp)
       busy = true;
     }
   }
-  else if (m_procSample || !m_freeSamples.empty())
+  else if (m_procSample || !m_freeSamples.Empty())
   {
     int free_samples;
     if (m_procSample)
@@ -741,7 +744,7 @@ bool CActiveAEBufferPoolAtempo::ProcessBuffers()
       busy = true;
     }
   }
-  else if (m_procSample || !m_freeSamples.empty())
+  else if (m_procSample || !m_freeSamples.Empty())
   {
     bool skipInput = false;
 
@@ -22,6 +22,8 @@
 #include "cores/AudioEngine/Utils/AEAudioFormat.h"
 #include "cores/AudioEngine/Interfaces/AE.h"
 #include "cores/AudioEngine/Engines/ActiveAE/AudioDSPAddons/ActiveAEDSP.h"
+#include "threads/LockFreeStack.h"
+#include <atomic>
 #include <deque>
 #include <memory>
 
@@ -74,7 +76,8 @@ public:
   CActiveAEBufferPool *pool;
   int64_t timestamp;
   int pkt_start_offset;
-  int refCount;
+  std::atomic<int> refCount;
+  unsigned int poolIndex;                // position in m_allSamples of the pool
 };
 
 class CActiveAEBufferPool
@@ -87,7 +90,7 @@ public:
   void ReturnBuffer(CSampleBuffer *buffer);
   AEAudioFormat m_format;
   std::deque<CSampleBuffer*> m_allSamples;
-  std::deque<CSampleBuffer*> m_freeSamples;
+  CLockFreeIndexStack m_freeSamples;     // indices into m_allSamples, buffers may be returned from any thread
 };
 
 class IAEResample;
@@ -18,11 +18,15 @@
  *
  */
 
+#include "cores/AudioEngine/Utils/AEMixKernels.h"
 #include "cores/AudioEngine/Utils/AEUtil.h"
 #include "ActiveAEResampleFFMPEG.h"
 #include "settings/Settings.h"
 #include "utils/log.h"
 
+#include <algorithm>
+#include <cstring>
+
 extern "C" {
 #include "libavutil/channel_layout.h"
 #include "libavutil/opt.h"
@@ -35,6 +39,7 @@ CActiveAEResampleFFMPEG::CActiveAEResampleFFMPEG()
 {
   m_pContext = NULL;
   m_doesResample = false;
+  m_directConvert = false;
 }
 
 CActiveAEResampleFFMPEG::~CActiveAEResampleFFMPEG()
@@ -65,6 +70,8 @@ bool CActiveAEResampleFFMPEG::Init(uint64_t dst_chan_layout, int dst_channels, i
   if (m_src_chan_layout == 0)
     m_src_chan_layout = av_get_default_channel_layout(m_src_channels);
 
+  m_directConvert = CanConvertDirect(remapLayout);
+
   m_pContext = swr_alloc_set_opts(NULL, m_dst_chan_layout, m_dst_fmt, m_dst_rate,
                                                         m_src_chan_layout, m_src_fmt, m_src_rate,
                                                         0, NULL);
@@ -182,9 +189,118 @@ bool CActiveAEResampleFFMPEG::Init(uint64_t dst_chan_layout, int dst_channels, i
     CLog::Log(LOGERROR, "CActiveAEResampleFFMPEG::Init - init resampler failed");
     return false;
   }
+
+  if (m_directConvert)
+    CLog::Log(LOGDEBUG, "CActiveAEResampleFFMPEG::Init - converting %s to %s with %s kernels",
+              av_get_sample_fmt_name(m_src_fmt), av_get_sample_fmt_name(m_dst_fmt), CAEMixKernels::GetName());
   return true;
 }
 
+bool CActiveAEResampleFFMPEG::CanConvertDirect(CAEChannelInfo *remapLayout)
+{
+  if (m_src_rate != m_dst_rate ||
+      m_src_channels != m_dst_channels ||
+      m_src_chan_layout != m_dst_chan_layout ||
+      m_src_channels > AE_CH_MAX)
+    return false;
+
+  // the sink stage maps the channels to the layout of the sink, it has to be the order we have
+  if (remapLayout)
+  {
+    if ((int)remapLayout->Count() != m_src_channels)
+      return false;
+    for (unsigned int out = 0; out < remapLayout->Count(); out++)
+    {
+      if (CAEUtil::GetAVChannelIndex((*remapLayout)[out], m_src_chan_layout) != (int)out)
+        return false;
+    }
+  }
+
+  // conversions from and to float, everything else is left to swresample
+  AVSampleFormat src = av_get_packed_sample_fmt(m_src_fmt);
+  AVSampleFormat dst = av_get_packed_sample_fmt(m_dst_fmt);
+  if (src != AV_SAMPLE_FMT_FLT && dst != AV_SAMPLE_FMT_FLT)
+    return false;
+
+  return (src == AV_SAMPLE_FMT_FLT || src == AV_SAMPLE_FMT_S16 || src == AV_SAMPLE_FMT_S32) &&
+         (dst == AV_SAMPLE_FMT_FLT || dst == AV_SAMPLE_FMT_S16 || dst == AV_SAMPLE_FMT_S32);
+}
+
+static void ConvertSamples(uint8_t *dst, AVSampleFormat dstFmt, const uint8_t *src, AVSampleFormat srcFmt, unsigned int count)
+{
+  if (srcFmt == AV_SAMPLE_FMT_S16)
+    CAEMixKernels::S16ToFloat((float*)dst, (const int16_t*)src, count);
+  else if (srcFmt == AV_SAMPLE_FMT_S32)
+    CAEMixKernels::S32ToFloat((float*)dst, (const int32_t*)src, count);
+  else if (dstFmt == AV_SAMPLE_FMT_S16)
+    CAEMixKernels::FloatToS16((int16_t*)dst, (const float*)src, count);
+  else if (dstFmt == AV_SAMPLE_FMT_S32)
+    CAEMixKernels::FloatToS32((int32_t*)dst, (const float*)src, count);
+  else if (dst != src)
+    memcpy(dst, src, count * sizeof(float));
+}
+
+int CActiveAEResampleFFMPEG::ConvertDirect(uint8_t **dst_buffer, uint8_t **src_buffer, int samples)
+{
+  const int channels = m_src_channels;
+  const bool srcPlanar = av_sample_fmt_is_planar(m_src_fmt) != 0;
+  const bool dstPlanar = av_sample_fmt_is_planar(m_dst_fmt) != 0;
+  const AVSampleFormat srcFmt = av_get_packed_sample_fmt(m_src_fmt);
+  const AVSampleFormat dstFmt = av_get_packed_sample_fmt(m_dst_fmt);
+
+  if (srcPlanar == dstPlanar)
+  {
+    int planes = srcPlanar ? channels : 1;
+    for (int i = 0; i < planes; i++)
+      ConvertSamples(dst_buffer[i], dstFmt, src_buffer[i], srcFmt, samples * channels / planes);
+    return samples;
+  }
+
+  // the layout changes in float, one side is float so a single buffer for the other side is enough
+  if (srcFmt != AV_SAMPLE_FMT_FLT || dstFmt != AV_SAMPLE_FMT_FLT)
+    m_convertBuffer.resize(samples * channels);
+  float *planes[AE_CH_MAX];
+
+  if (dstPlanar)
+  {
+    const float *in = (const float*)src_buffer[0];
+    if (srcFmt != AV_SAMPLE_FMT_FLT)
+    {
+      ConvertSamples((uint8_t*)m_convertBuffer.data(), AV_SAMPLE_FMT_FLT, src_buffer[0], srcFmt, samples * channels);
+      in = m_convertBuffer.data();
+    }
+
+    for (int i = 0; i < channels; i++)
+      planes[i] = dstFmt == AV_SAMPLE_FMT_FLT ? (float*)dst_buffer[i] : m_convertBuffer.data() + i * samples;
+    CAEMixKernels::Deinterleave(planes, in, channels, samples);
+
+    if (dstFmt != AV_SAMPLE_FMT_FLT)
+    {
+      for (int i = 0; i < channels; i++)
+        ConvertSamples(dst_buffer[i], dstFmt, (const uint8_t*)planes[i], AV_SAMPLE_FMT_FLT, samples);
+    }
+  }
+  else
+  {
+    for (int i = 0; i < channels; i++)
+    {
+      planes[i] = (float*)src_buffer[i];
+      if (srcFmt != AV_SAMPLE_FMT_FLT)
+      {
+        planes[i] = m_convertBuffer.data() + i * samples;
+        ConvertSamples((uint8_t*)planes[i], AV_SAMPLE_FMT_FLT, src_buffer[i], srcFmt, samples);
+      }
+    }
+
+    float *out = dstFmt == AV_SAMPLE_FMT_FLT ? (float*)dst_buffer[0] : m_convertBuffer.data();
+    CAEMixKernels::Interleave(out, planes, channels, samples);
+
+    if (dstFmt != AV_SAMPLE_FMT_FLT)
+      ConvertSamples(dst_buffer[0], dstFmt, (const uint8_t*)out, AV_SAMPLE_FMT_FLT, samples * channels);
+  }
+  return samples;
+}
+
 int CActiveAEResampleFFMPEG::Resample(uint8_t **dst_buffer, int dst_samples, uint8_t **src_buffer, int src_samples, double ratio)
 {
   int delta = 0;
@@ -205,11 +321,34 @@ int CActiveAEResampleFFMPEG::Resample(uint8_t **dst_buffer, int dst_samples, uin
     }
   }
 
-  int ret = swr_convert(m_pContext, dst_buffer, dst_samples, (const uint8_t**)src_buffer, src_samples);
-  if (ret < 0)
+  int ret;
+  if (m_directConvert && !m_doesResample && src_buffer && swr_get_delay(m_pContext, m_src_rate) == 0)
   {
-    CLog::Log(LOGERROR, "CActiveAEResampleFFMPEG::Resample - resample failed");
-    return -1;
+    ret = ConvertDirect(dst_buffer, src_buffer, std::min(src_samples, dst_samples));
+
+    // what does not fit is buffered by swresample, it is returned first by the next calls
+    if (src_samples > ret)
+    {
+      int planes = av_sample_fmt_is_planar(m_src_fmt) ? m_src_channels : 1;
+      int offset = ret * av_get_bytes_per_sample(m_src_fmt) * m_src_channels / planes;
+      uint8_t *rest[AE_CH_MAX];
+      for (int i = 0; i < planes; i++)
+        rest[i] = src_buffer[i] + offset;
+      if (swr_convert(m_pContext, NULL, 0, (const uint8_t**)rest, src_samples - ret) < 0)
+      {
+        CLog::Log(LOGERROR, "CActiveAEResampleFFMPEG::Resample - buffering input failed");
+        return -1;
+      }
+    }
+  }
+  else
+  {
+    ret = swr_convert(m_pContext, dst_buffer, dst_samples, (const uint8_t**)src_buffer, src_samples);
+    if (ret < 0)
+    {
+      CLog::Log(LOGERROR, "CActiveAEResampleFFMPEG::Resample - resample failed");
+      return -1;
+    }
   }
 
   // special handling for S24 formats which are carried in S32
@@ -24,6 +24,8 @@
 #include "cores/AudioEngine/Interfaces/AE.h"
 #include "cores/AudioEngine/Interfaces/AEResample.h"
 
+#include <vector>
+
 extern "C" {
 #include "libavutil/samplefmt.h"
 }
@@ -49,8 +51,12 @@ public:
   int GetDstBufferSize(int samples);
 
 protected:
+  bool CanConvertDirect(CAEChannelInfo *remapLayout);
+  int ConvertDirect(uint8_t **dst_buffer, uint8_t **src_buffer, int samples);
+
   bool m_loaded;
   bool m_doesResample;
+  bool m_directConvert; // only the sample format changes, converted without swresample
   uint64_t m_src_chan_layout, m_dst_chan_layout;
   int m_src_rate, m_dst_rate;
   int m_src_channels, m_dst_channels;
@@ -59,6 +65,7 @@ protected:
   int m_src_dither_bits, m_dst_dither_bits;
   SwrContext *m_pContext;
   double m_rematrix[AE_CH_MAX][AE_CH_MAX];
+  std::vector<float> m_convertBuffer;
 };
 
 }
@@ -0,0 +1,754 @@
+/*
+ *      Copyright (C) 2005-2013 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "AEMixKernels.h"
+#include "utils/CPUInfo.h"
+
+#include <atomic>
+#include <math.h>
+
+// the kernels are selected at runtime, so only the compiler has to support the instruction set
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MIX_KERNELS_SSE2
+#include <emmintrin.h>
+#if defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)))
+#define MIX_KERNELS_AVX2
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && _MSC_VER >= 1800
+#define MIX_KERNELS_AVX2
+#define TARGET_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define MIX_KERNELS_NEON
+#include <arm_neon.h>
+#endif
+
+// soft clip curve of CAEUtil::SoftClamp, the input is limited to +-3 where the curve reaches +-1
+#define CLAMP_LIMIT 3.0f
+#define CLAMP_C1    27.0f
+#define CLAMP_C2    9.0f
+
+#define S16_SCALE   32768.0f
+#define S32_SCALE   2147483648.0f
+
+namespace
+{
+
+struct SMixKernels
+{
+  const char* name;
+  bool (*MulAdd)(float *dst, const float *src, float gain, unsigned int count);
+  void (*Mul)(float *data, float gain, unsigned int count);
+  void (*Clamp)(float *data, unsigned int count);
+  void (*Interleave)(float *dst, const float * const *src, int channels, int samples);
+  void (*Deinterleave)(float * const *dst, const float *src, int channels, int samples);
+  void (*S16ToFloat)(float *dst, const int16_t *src, unsigned int count);
+  void (*S32ToFloat)(float *dst, const int32_t *src, unsigned int count);
+  void (*FloatToS16)(int16_t *dst, const float *src, unsigned int count);
+  void (*FloatToS32)(int32_t *dst, const float *src, unsigned int count);
+};
+
+/* scalar */
+
+bool MulAddC(float *dst, const float *src, float gain, unsigned int count)
+{
+  bool clip = false;
+  for (unsigned int i = 0; i < count; i++)
+  {
+    dst[i] += src[i] * gain;
+    if (fabsf(dst[i]) > 1.0f)
+      clip = true;
+  }
+  return clip;
+}
+
+void MulC(float *data, float gain, unsigned int count)
+{
+  for (unsigned int i = 0; i < count; i++)
+    data[i] *= gain;
+}
+
+void ClampC(float *data, unsigned int count)
+{
+  for (unsigned int i = 0; i < count; i++)
+  {
+    float x = data[i];
+    if (x < -CLAMP_LIMIT)
+      x = -CLAMP_LIMIT;
+    else if (x > CLAMP_LIMIT)
+      x = CLAMP_LIMIT;
+    float y = x * x;
+    data[i] = x * (CLAMP_C1 + y) / (CLAMP_C1 + CLAMP_C2 * y);
+  }
+}
+
+// channels first .. last of samples first .. samples
+void InterleaveRangeC(float *dst, const float * const *src, int channels, int first, int last, int start, int samples)
+{
+  for (int c = first; c < last; c++)
+  {
+    const float *in = src[c];
+    for (int s = start; s < samples; s++)
+      dst[s * channels + c] = in[s];
+  }
+}
+
+void DeinterleaveRangeC(float * const *dst, const float *src, int channels, int first, int last, int start, int samples)
+{
+  for (int c = first; c < last; c++)
+  {
+    float *out = dst[c];
+    for (int s = start; s < samples; s++)
+      out[s] = src[s * channels + c];
+  }
+}
+
+void InterleaveC(float *dst, const float * const *src, int channels, int samples)
+{
+  InterleaveRangeC(dst, src, channels, 0, channels, 0, samples);
+}
+
+void DeinterleaveC(float * const *dst, const float *src, int channels, int samples)
+{
+  DeinterleaveRangeC(dst, src, channels, 0, channels, 0, samples);
+}
+
+void S16ToFloatC(float *dst, const int16_t *src, unsigned int count)
+{
+  for (unsigned int i = 0; i < count; i++)
+    dst[i] = src[i] * (1.0f / S16_SCALE);
+}
+
+void S32ToFloatC(float *dst, const int32_t *src, unsigned int count)
+{
+  for (unsigned int i = 0; i < count; i++)
+    dst[i] = (float)src[i] * (1.0f / S32_SCALE);
+}
+
+void FloatToS16C(int16_t *dst, const float *src, unsigned int count)
+{
+  for (unsigned int i = 0; i < count; i++)
+  {
+    float v = src[i] * S16_SCALE;
+    if (v >= 32767.0f)
+      dst[i] = INT16_MAX;
+    else if (v <= -32768.0f)
+      dst[i] = INT16_MIN;
+    else
+      dst[i] = (int16_t)lrintf(v);
+  }
+}
+
+void FloatToS32C(int32_t *dst, const float *src, unsigned int count)
+{
+  for (unsigned int i = 0; i < count; i++)
+  {
+    float v = src[i] * S32_SCALE;
+    if (v >= S32_SCALE)
+      dst[i] = INT32_MAX;
+    else if (v <= -S32_SCALE)
+      dst[i] = INT32_MIN;
+    else
+      dst[i] = (int32_t)lrintf(v);
+  }
+}
+
+const SMixKernels kernelsC =
+{
+  "scalar", MulAddC, MulC, ClampC, InterleaveC, DeinterleaveC,
+  S16ToFloatC, S32ToFloatC, FloatToS16C, FloatToS32C
+};
+
+/* SSE2 */
+
+#if defined(MIX_KERNELS_SSE2)
+bool MulAddSSE2(float *dst, const float *src, float gain, unsigned int count)
+{
+  const __m128 g = _mm_set1_ps(gain);
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+  __m128 over = _mm_setzero_ps();
+
+  unsigned int i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    __m128 d = _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), g));
+    _mm_storeu_ps(dst + i, d);
+    over = _mm_or_ps(over, _mm_cmpgt_ps(_mm_and_ps(d, absMask), one));
+  }
+  bool clip = MulAddC(dst + i, src + i, gain, count - i);
+  return clip || _mm_movemask_ps(over) != 0;
+}
+
+void MulSSE2(float *data, float gain, unsigned int count)
+{
+  const __m128 g = _mm_set1_ps(gain);
+
+  unsigned int i = 0;
+  for (; i + 4 <= count; i += 4)
+    _mm_storeu_ps(data + i, _mm_mul_ps(_mm_loadu_ps(data + i), g));
+  MulC(data + i, gain, count - i);
+}
+
+void ClampSSE2(float *data, unsigned int count)
+{
+  const __m128 lo = _mm_set1_ps(-CLAMP_LIMIT);
+  const __m128 hi = _mm_set1_ps(CLAMP_LIMIT);
+  const __m128 c1 = _mm_set1_ps(CLAMP_C1);
+  const __m128 c2 = _mm_set1_ps(CLAMP_C2);
+
+  unsigned int i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    __m128 x = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(data + i), lo), hi);
+    __m128 y = _mm_mul_ps(x, x);
+    __m128 n = _mm_mul_ps(x, _mm_add_ps(c1, y));
+    _mm_storeu_ps(data + i, _mm_div_ps(n, _mm_add_ps(c1, _mm_mul_ps(c2, y))));
+  }
+  ClampC(data + i, count - i);
+}
+
+void InterleaveSSE2(float *dst, const float * const *src, int channels, int samples)
+{
+  if (channels == 2)
+  {
+    int s = 0;
+    for (; s + 4 <= samples; s += 4)
+    {
+      __m128 l = _mm_loadu_ps(src[0] + s);
+      __m128 r = _mm_loadu_ps(src[1] + s);
+      _mm_storeu_ps(dst + s * 2, _mm_unpacklo_ps(l, r));
+      _mm_storeu_ps(dst + s * 2 + 4, _mm_unpackhi_ps(l, r));
+    }
+    InterleaveRangeC(dst, src, channels, 0, channels, s, samples);
+    return;
+  }
+
+  // 4 samples of 4 channels are one transpose, the channels left over are copied one by one
+  int c = 0;
+  for (; c + 4 <= channels; c += 4)
+  {
+    int s = 0;
+    for (; s + 4 <= samples; s += 4)
+    {
+      __m128 r0 = _mm_loadu_ps(src[c] + s);
+      __m128 r1 = _mm_loadu_ps(src[c + 1] + s);
+      __m128 r2 = _mm_loadu_ps(src[c + 2] + s);
+      __m128 r3 = _mm_loadu_ps(src[c + 3] + s);
+      _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+      float *out = dst + s * channels + c;
+      _mm_storeu_ps(out, r0);
+      _mm_storeu_ps(out + channels, r1);
+      _mm_storeu_ps(out + channels * 2, r2);
+      _mm_storeu_ps(out + channels * 3, r3);
+    }
+    InterleaveRangeC(dst, src, channels, c, c + 4, s, samples);
+  }
+  InterleaveRangeC(dst, src, channels, c, channels, 0, samples);
+}
+
+void DeinterleaveSSE2(float * const *dst, const float *src, int channels, int samples)
+{
+  if (channels == 2)
+  {
+    int s = 0;
+    for (; s + 4 <= samples; s += 4)
+    {
+      __m128 a = _mm_loadu_ps(src + s * 2);
+      __m128 b = _mm_loadu_ps(src + s * 2 + 4);
+      _mm_storeu_ps(dst[0] + s, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+      _mm_storeu_ps(dst[1] + s, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+    }
+    DeinterleaveRangeC(dst, src, channels, 0, channels, s, samples);
+    return;
+  }
+
+  int c = 0;
+  for (; c + 4 <= channels; c += 4)
+  {
+    int s = 0;
+    for (; s + 4 <= samples; s += 4)
+    {
+      const float *in = src + s * channels + c;
+      __m128 r0 = _mm_loadu_ps(in);
+      __m128 r1 = _mm_loadu_ps(in + channels);
+      __m128 r2 = _mm_loadu_ps(in + channels * 2);
+      __m128 r3 = _mm_loadu_ps(in + channels * 3);
+      _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+      _mm_storeu_ps(dst[c] + s, r0);
+      _mm_storeu_ps(dst[c + 1] + s, r1);
+      _mm_storeu_ps(dst[c + 2] + s, r2);
+      _mm_storeu_ps(dst[c + 3] + s, r3);
+    }
+    DeinterleaveRangeC(dst, src, channels, c, c + 4, s, samples);
+  }
+  DeinterleaveRangeC(dst, src, channels, c, channels, 0, samples);
+}
+
+void S16ToFloatSSE2(float *dst, const int16_t *src, unsigned int count)
+{
+  const __m128 scale = _mm_set1_ps(1.0f / S16_SCALE);
+
+  unsigned int i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+    // sign extend by moving the sample into the upper half and shifting it back
+    __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+    __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+    _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+    _mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+  }
+  S16ToFloatC(dst + i, src + i, count - i);
+}
+
+void S32ToFloatSSE2(float *dst, const int32_t *src, unsigned int count)
+{
+  const __m128 scale = _mm_set1_ps(1.0f / S32_SCALE);
+
+  unsigned int i = 0;
+  for (; i + 4 <= count; i += 4)
+    _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)(src + i))), scale));
+  S32ToFloatC(dst + i, src + i, count - i);
+}
+
+void FloatToS16SSE2(int16_t *dst, const float *src, unsigned int count)
+{
+  const __m128 scale = _mm_set1_ps(S16_SCALE);
+  const __m128 lo = _mm_set1_ps(-32768.0f);
+  const __m128 hi = _mm_set1_ps(32767.0f);
+
+  unsigned int i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    __m128 a = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(src + i), scale), lo), hi);
+    __m128 b = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(src + i + 4), scale), lo), hi);
+    _mm_storeu_si128((__m128i*)(dst + i), _mm_packs_epi32(_mm_cvtps_epi32(a), _mm_cvtps_epi32(b)));
+  }
+  FloatToS16C(dst + i, src + i, count - i);
+}
+
+// cvtps2dq returns 0x80000000 for values that don't fit, the ones at or above +1.0 are flipped to INT32_MAX
+void FloatToS32SSE2(int32_t *dst, const float *src, unsigned int count)
+{
+  const __m128 scale = _mm_set1_ps(S32_SCALE);
+
+  unsigned int i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    __m128 v = _mm_mul_ps(_mm_loadu_ps(src + i), scale);
+    __m128i over = _mm_castps_si128(_mm_cmpge_ps(v, scale));
+    _mm_storeu_si128((__m128i*)(dst + i), _mm_xor_si128(_mm_cvtps_epi32(v), over));
+  }
+  FloatToS32C(dst + i, src + i, count - i);
+}
+
+const SMixKernels kernelsSSE2 =
+{
+  "sse2", MulAddSSE2, MulSSE2, ClampSSE2, InterleaveSSE2, DeinterleaveSSE2,
+  S16ToFloatSSE2, S32ToFloatSSE2, FloatToS16SSE2, FloatToS32SSE2
+};
+#endif
+
+/* AVX2 */
+
+#if defined(MIX_KERNELS_AVX2)
+TARGET_AVX2 bool MulAddAVX2(float *dst, const float *src, float gain, unsigned int count)
+{
+  const __m256 g = _mm256_set1_ps(gain);
+  const __m256 one = _mm256_set1_ps(1.0f);
+  const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+  __m256 over = _mm256_setzero_ps();
+
+  unsigned int i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    __m256 d = _mm256_add_ps(_mm256_loadu_ps(dst + i), _mm256_mul_ps(_mm256_loadu_ps(src + i), g));
+    _mm256_storeu_ps(dst + i, d);
+    over = _mm256_or_ps(over, _mm256_cmp_ps(_mm256_and_ps(d, absMask), one, _CMP_GT_OQ));
+  }
+  bool clip = _mm256_movemask_ps(over) != 0;
+  _mm256_zeroupper();
+  return MulAddSSE2(dst + i, src + i, gain, count - i) || clip;
+}
+
+TARGET_AVX2 void MulAVX2(float *data, float gain, unsigned int count)
+{
+  const __m256 g = _mm256_set1_ps(gain);
+
+  unsigned int i = 0;
+  for (; i + 8 <= count; i += 8)
+    _mm256_storeu_ps(data + i, _mm256_mul_ps(_mm256_loadu_ps(data + i), g));
+  _mm256_zeroupper();
+  MulSSE2(data + i, gain, count - i);
+}
+
+TARGET_AVX2 void ClampAVX2(float *data, unsigned int count)
+{
+  const __m256 lo = _mm256_set1_ps(-CLAMP_LIMIT);
+  const __m256 hi = _mm256_set1_ps(CLAMP_LIMIT);
+  const __m256 c1 = _mm256_set1_ps(CLAMP_C1);
+  const __m256 c2 = _mm256_set1_ps(CLAMP_C2);
+
+  unsigned int i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    __m256 x = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(data + i), lo), hi);
+    __m256 y = _mm256_mul_ps(x, x);
+    __m256 n = _mm256_mul_ps(x, _mm256_add_ps(c1, y));
+    _mm256_storeu_ps(data + i, _mm256_div_ps(n, _mm256_add_ps(c1, _mm256_mul_ps(c2, y))));
+  }
+  _mm256_zeroupper();
+  ClampSSE2(data + i, count - i);
+}
+
+TARGET_AVX2 void S16ToFloatAVX2(float *dst, const int16_t *src, unsigned int count)
+{
+  const __m256 scale = _mm256_set1_ps(1.0f / S16_SCALE);
+
+  unsigned int i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    __m256i v = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)(src + i)));
+    _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v), scale));
+  }
+  _mm256_zeroupper();
+  S16ToFloatC(dst + i, src + i, count - i);
+}
+
+TARGET_AVX2 void S32ToFloatAVX2(float *dst, const int32_t *src, unsigned int count)
+{
+  const __m256 scale = _mm256_set1_ps(1.0f / S32_SCALE);
+
+  unsigned int i = 0;
+  for (; i + 8 <= count; i += 8)
+    _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_loadu_si256((const __m256i*)(src + i))), scale));
+  _mm256_zeroupper();
+  S32ToFloatSSE2(dst + i, src + i, count - i);
+}
+
+// packs works within the 128 bit lanes, the permute puts the lanes back in sample order
+TARGET_AVX2 void FloatToS16AVX2(int16_t *dst, const float *src, unsigned int count)
+{
+  const __m256 scale = _mm256_set1_ps(S16_SCALE);
+  const __m256 lo = _mm256_set1_ps(-32768.0f);
+  const __m256 hi = _mm256_set1_ps(32767.0f);
+
+  unsigned int i = 0;
+  for (; i + 16 <= count; i += 16)
+  {
+    __m256 a = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(src + i), scale), lo), hi);
+    __m256 b = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(src + i + 8), scale), lo), hi);
+    __m256i packed = _mm256_packs_epi32(_mm256_cvtps_epi32(a), _mm256_cvtps_epi32(b));
+    _mm256_storeu_si256((__m256i*)(dst + i), _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0)));
+  }
+  _mm256_zeroupper();
+  FloatToS16SSE2(dst + i, src + i, count - i);
+}
+
+TARGET_AVX2 void FloatToS32AVX2(int32_t *dst, const float *src, unsigned int count)
+{
+  const __m256 scale = _mm256_set1_ps(S32_SCALE);
+
+  unsigned int i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    __m256 v = _mm256_mul_ps(_mm256_loadu_ps(src + i), scale);
+    __m256i over = _mm256_castps_si256(_mm256_cmp_ps(v, scale, _CMP_GE_OQ));
+    _mm256_storeu_si256((__m256i*)(dst + i), _mm256_xor_si256(_mm256_cvtps_epi32(v), over));
+  }
+  _mm256_zeroupper();
+  FloatToS32SSE2(dst + i, src + i, count - i);
+}
+
+// interleaving is bound by the scattered stores, the 128 bit transposes are kept
+const SMixKernels kernelsAVX2 =
+{
+  "avx2", MulAddAVX2, MulAVX2, ClampAVX2, InterleaveSSE2, DeinterleaveSSE2,
+  S16ToFloatAVX2, S32ToFloatAVX2, FloatToS16AVX2, FloatToS32AVX2
+};
+#endif
+
+/* NEON */
+
+#if defined(MIX_KERNELS_NEON)
+bool MulAddNEON(float *dst, const float *src, float gain, unsigned int count)
+{
+  const float32x4_t one = vdupq_n_f32(1.0f);
+  uint32x4_t over = vdupq_n_u32(0);
+
+  unsigned int i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    float32x4_t d = vaddq_f32(vld1q_f32(dst + i), vmulq_n_f32(vld1q_f32(src + i), gain));
+    vst1q_f32(dst + i, d);
+    over = vorrq_u32(over, vcagtq_f32(d, one));
+  }
+  uint32x2_t any = vorr_u32(vget_low_u32(over), vget_high_u32(over));
+  bool clip = (vget_lane_u32(any, 0) | vget_lane_u32(any, 1)) != 0;
+  return MulAddC(dst + i, src + i, gain, count - i) || clip;
+}
+
+void MulNEON(float *data, float gain, unsigned int count)
+{
+  unsigned int i = 0;
+  for (; i + 4 <= count; i += 4)
+    vst1q_f32(data + i, vmulq_n_f32(vld1q_f32(data + i), gain));
+  MulC(data + i, gain, count - i);
+}
+
+inline float32x4_t DivNEON(float32x4_t n, float32x4_t d)
+{
+#if defined(__aarch64__)
+  return vdivq_f32(n, d);
+#else
+  // two newton-raphson steps on the reciprocal estimate
+  float32x4_t r = vrecpeq_f32(d);
+  r = vmulq_f32(vrecpsq_f32(d, r), r);
+  r = vmulq_f32(vrecpsq_f32(d, r), r);
+  return vmulq_f32(n, r);
+#endif
+}
+
+void ClampNEON(float *data, unsigned int count)
+{
+  const float32x4_t lo = vdupq_n_f32(-CLAMP_LIMIT);
+  const float32x4_t hi = vdupq_n_f32(CLAMP_LIMIT);
+  const float32x4_t c1 = vdupq_n_f32(CLAMP_C1);
+
+  unsigned int i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    float32x4_t x = vminq_f32(vmaxq_f32(vld1q_f32(data + i), lo), hi);
+    float32x4_t y = vmulq_f32(x, x);
+    float32x4_t n = vmulq_f32(x, vaddq_f32(c1, y));
+    vst1q_f32(data + i, DivNEON(n, vaddq_f32(c1, vmulq_n_f32(y, CLAMP_C2))));
+  }
+  ClampC(data + i, count - i);
+}
+
+void InterleaveNEON(float *dst, const float * const *src, int channels, int samples)
+{
+  int s = 0;
+  if (channels == 2)
+  {
+    for (; s + 4 <= samples; s += 4)
+    {
+      float32x4x2_t v;
+      v.val[0] = vld1q_f32(src[0] + s);
+      v.val[1] = vld1q_f32(src[1] + s);
+      vst2q_f32(dst + s * 2, v);
+    }
+  }
+  else if (channels == 4)
+  {
+    for (; s + 4 <= samples; s += 4)
+    {
+      float32x4x4_t v;
+      for (int c = 0; c < 4; c++)
+        v.val[c] = vld1q_f32(src[c] + s);
+      vst4q_f32(dst + s * 4, v);
+    }
+  }
+  InterleaveRangeC(dst, src, channels, 0, channels, s, samples);
+}
+
+void DeinterleaveNEON(float * const *dst, const float *src, int channels, int samples)
+{
+  int s = 0;
+  if (channels == 2)
+  {
+    for (; s + 4 <= samples; s += 4)
+    {
+      float32x4x2_t v = vld2q_f32(src + s * 2);
+      vst1q_f32(dst[0] + s, v.val[0]);
+      vst1q_f32(dst[1] + s, v.val[1]);
+    }
+  }
+  else if (channels == 4)
+  {
+    for (; s + 4 <= samples; s += 4)
+    {
+      float32x4x4_t v = vld4q_f32(src + s * 4);
+      for (int c = 0; c < 4; c++)
+        vst1q_f32(dst[c] + s, v.val[c]);
+    }
+  }
+  DeinterleaveRangeC(dst, src, channels, 0, channels, s, samples);
+}
+
+void S16ToFloatNEON(float *dst, const int16_t *src, unsigned int count)
+{
+  const float scale = 1.0f / S16_SCALE;
+
+  unsigned int i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    int16x8_t v = vld1q_s16(src + i);
+    vst1q_f32(dst + i, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v))), scale));
+    vst1q_f32(dst + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v))), scale));
+  }
+  S16ToFloatC(dst + i, src + i, count - i);
+}
+
+void S32ToFloatNEON(float *dst, const int32_t *src, unsigned int count)
+{
+  const float scale = 1.0f / S32_SCALE;
+
+  unsigned int i = 0;
+  for (; i + 4 <= count; i += 4)
+    vst1q_f32(dst + i, vmulq_n_f32(vcvtq_f32_s32(vld1q_s32(src + i)), scale));
+  S32ToFloatC(dst + i, src + i, count - i);
+}
+
+// saturating conversion, rounded to nearest
+inline int32x4_t RoundNEON(float32x4_t v)
+{
+#if defined(__aarch64__)
+  return vcvtnq_s32_f32(v);
+#else
+  // armv7 only truncates, ties are rounded away from zero instead of to even
+  const uint32x4_t sign = vdupq_n_u32(0x80000000);
+  float32x4_t half = vreinterpretq_f32_u32(vorrq_u32(vandq_u32(vreinterpretq_u32_f32(v), sign),
+                                                     vreinterpretq_u32_f32(vdupq_n_f32(0.5f))));
+  return vcvtq_s32_f32(vaddq_f32(v, half));
+#endif
+}
+
+void FloatToS16NEON(int16_t *dst, const float *src, unsigned int count)
+{
+  const float32x4_t lo = vdupq_n_f32(-32768.0f);
+  const float32x4_t hi = vdupq_n_f32(32767.0f);
+
+  unsigned int i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    float32x4_t a = vminq_f32(vmaxq_f32(vmulq_n_f32(vld1q_f32(src + i), S16_SCALE), lo), hi);
+    float32x4_t b = vminq_f32(vmaxq_f32(vmulq_n_f32(vld1q_f32(src + i + 4), S16_SCALE), lo), hi);
+    vst1q_s16(dst + i, vcombine_s16(vqmovn_s32(RoundNEON(a)), vqmovn_s32(RoundNEON(b))));
+  }
+  FloatToS16C(dst + i, src + i, count - i);
+}
+
+void FloatToS32NEON(int32_t *dst, const float *src, unsigned int count)
+{
+  unsigned int i = 0;
+  for (; i + 4 <= count; i += 4)
+    vst1q_s32(dst + i, RoundNEON(vmulq_n_f32(vld1q_f32(src + i), S32_SCALE)));
+  FloatToS32C(dst + i, src + i, count - i);
+}
+
+const SMixKernels kernelsNEON =
+{
+  "neon", MulAddNEON, MulNEON, ClampNEON, InterleaveNEON, DeinterleaveNEON,
+  S16ToFloatNEON, S32ToFloatNEON, FloatToS16NEON, FloatToS32NEON
+};
+#endif
+
+const SMixKernels* SelectKernels(unsigned int features)
+{
+#if defined(MIX_KERNELS_AVX2)
+  if (features & CPU_FEATURE_AVX2)
+    return &kernelsAVX2;
+#endif
+#if defined(MIX_KERNELS_SSE2)
+  if (features & CPU_FEATURE_SSE2)
+    return &kernelsSSE2;
+#endif
+#if defined(MIX_KERNELS_NEON)
+  if (features & CPU_FEATURE_NEON)
+    return &kernelsNEON;
+#endif
+  return &kernelsC;
+}
+
+std::atomic<const SMixKernels*> selectedKernels(nullptr);
+
+const SMixKernels* GetKernels()
+{
+  const SMixKernels* kernels = selectedKernels.load(std::memory_order_acquire);
+  if (!kernels)
+  {
+    kernels = SelectKernels(g_cpuInfo.GetCPUFeatures());
+    selectedKernels.store(kernels, std::memory_order_release);
+  }
+  return kernels;
+}
+
+}
+
+bool CAEMixKernels::MulAdd(float *dst, const float *src, float gain, unsigned int count)
+{
+  return GetKernels()->MulAdd(dst, src, gain, count);
+}
+
+void CAEMixKernels::Mul(float *data, float gain, unsigned int count)
+{
+  GetKernels()->Mul(data, gain, count);
+}
+
+void CAEMixKernels::Clamp(float *data, unsigned int count)
+{
+  GetKernels()->Clamp(data, count);
+}
+
+void CAEMixKernels::Interleave(float *dst, const float * const *src, int channels, int samples)
+{
+  GetKernels()->Interleave(dst, src, channels, samples);
+}
+
+void CAEMixKernels::Deinterleave(float * const *dst, const float *src, int channels, int samples)
+{
+  GetKernels()->Deinterleave(dst, src, channels, samples);
+}
+
+void CAEMixKernels::S16ToFloat(float *dst, const int16_t *src, unsigned int count)
+{
+  GetKernels()->S16ToFloat(dst, src, count);
+}
+
+void CAEMixKernels::S32ToFloat(float *dst, const int32_t *src, unsigned int count)
+{
+  GetKernels()->S32ToFloat(dst, src, count);
+}
+
+void CAEMixKernels::FloatToS16(int16_t *dst, const float *src, unsigned int count)
+{
+  GetKernels()->FloatToS16(dst, src, count);
+}
+
+void CAEMixKernels::FloatToS32(int32_t *dst, const float *src, unsigned int count)
+{
+  GetKernels()->FloatToS32(dst, src, count);
+}
+
+void CAEMixKernels::SetCPUFeatures(unsigned int features)
+{
+  selectedKernels.store(SelectKernels(features), std::memory_order_release);
+}
+
+const char* CAEMixKernels::GetName()
+{
+  return GetKernels()->name;
+}
@@ -0,0 +1,76 @@
+#pragma once
+/*
+ *      Copyright (C) 2005-2013 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdint.h>
+
+/*!
+ \brief Mixing, gain and sample format conversion kernels used by ActiveAE.
+
+ The kernels are selected at runtime from the CPU features reported by CCPUInfo
+ (SSE2, AVX2 or NEON, with a scalar fallback). None of them require aligned buffers.
+ Float samples are in the range -1.0 .. 1.0, integer conversions round to nearest and
+ saturate the same way as swresample does.
+ */
+class CAEMixKernels
+{
+public:
+  /*!
+   \brief dst += src * gain
+   \return true if a mixed sample is outside -1.0 .. 1.0 and the buffer needs clamping
+   */
+  static bool MulAdd(float *dst, const float *src, float gain, unsigned int count);
+
+  /*!
+   \brief data *= gain
+   */
+  static void Mul(float *data, float gain, unsigned int count);
+
+  /*!
+   \brief Soft clip the samples into -1.0 .. 1.0, see CAEUtil::SoftClamp.
+   */
+  static void Clamp(float *data, unsigned int count);
+
+  /*!
+   \brief Interleave channels planes of samples floats into dst.
+   */
+  static void Interleave(float *dst, const float * const *src, int channels, int samples);
+
+  /*!
+   \brief Split interleaved samples into channels planes.
+   */
+  static void Deinterleave(float * const *dst, const float *src, int channels, int samples);
+
+  static void S16ToFloat(float *dst, const int16_t *src, unsigned int count);
+  static void S32ToFloat(float *dst, const int32_t *src, unsigned int count);
+  static void FloatToS16(int16_t *dst, const float *src, unsigned int count);
+  static void FloatToS32(int32_t *dst, const float *src, unsigned int count);
+
+  /*!
+   \brief Select the kernels for the given CPU_FEATURE_* flags instead of the detected ones.
+   Passing 0 selects the scalar kernels.
+   */
+  static void SetCPUFeatures(unsigned int features);
+
+  /*!
+   \brief Name of the selected kernel set, for logging.
+   */
+  static const char* GetName();
+};
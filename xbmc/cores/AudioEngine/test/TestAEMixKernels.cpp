@@ -0,0 +1,244 @@
+/*
+ *      Copyright (C) 2005-2013 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cores/AudioEngine/Utils/AEMixKernels.h"
+#include "utils/CPUInfo.h"
+#include "utils/Stopwatch.h"
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#define BENCHMARK_RATE     192000
+#define BENCHMARK_CHANNELS 8
+#define BENCHMARK_STREAMS  4
+#define BENCHMARK_PERIOD   1024
+#define BENCHMARK_SECONDS  2
+
+/* samples mostly within -1.0 .. 1.0 with a few beyond, so that clamping and saturation are hit */
+static std::vector<float> CreateSamples(size_t count, unsigned int seed)
+{
+  std::vector<float> samples(count);
+  for (size_t i = 0; i < count; i++)
+  {
+    seed = seed * 1103515245 + 12345;
+    samples[i] = ((int)(seed >> 8) % 20000 - 10000) / 8000.0f;
+  }
+  return samples;
+}
+
+struct SKernelResults
+{
+  std::vector<float> mixed;
+  bool clip;
+  std::vector<float> scaled;
+  std::vector<float> clamped;
+  std::vector<float> interleaved;
+  std::vector<float> deinterleaved;
+  std::vector<float> fromS16;
+  std::vector<float> fromS32;
+  std::vector<int16_t> toS16;
+  std::vector<int32_t> toS32;
+};
+
+static SKernelResults RunKernels(int channels, int samples)
+{
+  SKernelResults results;
+  unsigned int count = channels * samples;
+  std::vector<float> a = CreateSamples(count, 1);
+  std::vector<float> b = CreateSamples(count, 2);
+
+  results.mixed = a;
+  results.clip = CAEMixKernels::MulAdd(&results.mixed[0], &b[0], 0.7f, count);
+
+  results.scaled = a;
+  CAEMixKernels::Mul(&results.scaled[0], 0.3f, count);
+
+  results.clamped = results.mixed;
+  CAEMixKernels::Clamp(&results.clamped[0], count);
+
+  const float *planes[BENCHMARK_CHANNELS];
+  float *outPlanes[BENCHMARK_CHANNELS];
+  results.deinterleaved.assign(count, 0.0f);
+  for (int c = 0; c < channels; c++)
+  {
+    planes[c] = &a[c * samples];
+    outPlanes[c] = &results.deinterleaved[c * samples];
+  }
+  results.interleaved.assign(count, 0.0f);
+  CAEMixKernels::Interleave(&results.interleaved[0], planes, channels, samples);
+  CAEMixKernels::Deinterleave(outPlanes, &results.interleaved[0], channels, samples);
+
+  std::vector<int16_t> s16(count);
+  std::vector<int32_t> s32(count);
+  for (unsigned int i = 0; i < count; i++)
+  {
+    s16[i] = (int16_t)(i * 2654435761u >> 16);
+    s32[i] = (int32_t)(i * 2654435761u);
+  }
+  results.fromS16.resize(count);
+  CAEMixKernels::S16ToFloat(&results.fromS16[0], &s16[0], count);
+  results.fromS32.resize(count);
+  CAEMixKernels::S32ToFloat(&results.fromS32[0], &s32[0], count);
+
+  results.toS16.resize(count);
+  CAEMixKernels::FloatToS16(&results.toS16[0], &a[0], count);
+  results.toS32.resize(count);
+  CAEMixKernels::FloatToS32(&results.toS32[0], &a[0], count);
+
+  return results;
+}
+
+template<typename T>
+static void ExpectNear(const std::vector<T> &expected, const std::vector<T> &actual, double error)
+{
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); i++)
+    ASSERT_NEAR((double)expected[i], (double)actual[i], error) << "at " << i;
+}
+
+class TestAEMixKernels : public testing::Test
+{
+protected:
+  ~TestAEMixKernels()
+  {
+    CAEMixKernels::SetCPUFeatures(g_cpuInfo.GetCPUFeatures());
+  }
+
+  /* every kernel set the cpu supports, scalar first */
+  static std::vector<unsigned int> GetFeatureSets()
+  {
+    std::vector<unsigned int> sets;
+    unsigned int features = g_cpuInfo.GetCPUFeatures();
+    sets.push_back(0);
+    if (features & CPU_FEATURE_SSE2)
+      sets.push_back(CPU_FEATURE_SSE2);
+    if (features & CPU_FEATURE_AVX2)
+      sets.push_back(CPU_FEATURE_SSE2 | CPU_FEATURE_AVX2);
+    if (features & CPU_FEATURE_NEON)
+      sets.push_back(CPU_FEATURE_NEON);
+    return sets;
+  }
+};
+
+TEST_F(TestAEMixKernels, Scalar)
+{
+  CAEMixKernels::SetCPUFeatures(0);
+
+  float clamp[] = { -10.0f, -3.0f, 0.0f, 0.5f, 3.0f, 4.0f };
+  CAEMixKernels::Clamp(clamp, 6);
+  EXPECT_EQ(-1.0f, clamp[0]);
+  EXPECT_EQ(-1.0f, clamp[1]);
+  EXPECT_EQ(0.0f, clamp[2]);
+  EXPECT_FLOAT_EQ(0.5f * 27.25f / 29.25f, clamp[3]);
+  EXPECT_EQ(1.0f, clamp[4]);
+  EXPECT_EQ(1.0f, clamp[5]);
+
+  const float samples[] = { 1.0f, -1.0f, 0.5f, 2.0f, -2.0f, 0.0f };
+  int16_t s16[6];
+  int32_t s32[6];
+  CAEMixKernels::FloatToS16(s16, samples, 6);
+  CAEMixKernels::FloatToS32(s32, samples, 6);
+  const int16_t expectedS16[] = { 32767, -32768, 16384, 32767, -32768, 0 };
+  const int32_t expectedS32[] = { INT32_MAX, INT32_MIN, 1 << 30, INT32_MAX, INT32_MIN, 0 };
+  for (int i = 0; i < 6; i++)
+  {
+    EXPECT_EQ(expectedS16[i], s16[i]);
+    EXPECT_EQ(expectedS32[i], s32[i]);
+  }
+
+  float mix[] = { 0.5f, 0.5f };
+  const float add[] = { 0.5f, 1.0f };
+  EXPECT_FALSE(CAEMixKernels::MulAdd(mix, add, 1.0f, 1));
+  EXPECT_TRUE(CAEMixKernels::MulAdd(mix, add, 1.0f, 2));
+}
+
+TEST_F(TestAEMixKernels, MatchScalar)
+{
+  // odd sample counts leave tails for every vector width
+  static const int sizes[][2] = { { 1, 1 }, { 1, 37 }, { 2, 1 }, { 2, 301 }, { 3, 17 }, { 6, 1023 }, { 8, 1024 }, { 8, 4099 } };
+  std::vector<unsigned int> sets = GetFeatureSets();
+
+  for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+  {
+    CAEMixKernels::SetCPUFeatures(0);
+    SKernelResults expected = RunKernels(sizes[i][0], sizes[i][1]);
+
+    for (size_t j = 1; j < sets.size(); j++)
+    {
+      CAEMixKernels::SetCPUFeatures(sets[j]);
+      SKernelResults results = RunKernels(sizes[i][0], sizes[i][1]);
+      SCOPED_TRACE(testing::Message() << CAEMixKernels::GetName() << " " << sizes[i][0] << "ch " << sizes[i][1] << " samples");
+      // float results may differ in the last bit where the compiler contracts the scalar code
+      ExpectNear(expected.mixed, results.mixed, 1e-6);
+      EXPECT_EQ(expected.clip, results.clip);
+      ExpectNear(expected.scaled, results.scaled, 1e-6);
+      ExpectNear(expected.clamped, results.clamped, 1e-5);
+      EXPECT_TRUE(expected.interleaved == results.interleaved);
+      EXPECT_TRUE(expected.deinterleaved == results.deinterleaved);
+      EXPECT_TRUE(expected.fromS16 == results.fromS16);
+      EXPECT_TRUE(expected.fromS32 == results.fromS32);
+      ExpectNear(expected.toS16, results.toS16, 1);
+      ExpectNear(expected.toS32, results.toS32, 1);
+    }
+  }
+}
+
+/* the ActiveAE mix stage for one period: streams added with volume, clamped, gui sound added,
+   master volume applied and converted for an S32 sink */
+TEST_F(TestAEMixKernels, Benchmark)
+{
+  const unsigned int count = BENCHMARK_PERIOD * BENCHMARK_CHANNELS;
+  const int periods = BENCHMARK_SECONDS * BENCHMARK_RATE / BENCHMARK_PERIOD;
+  std::vector<float> streams[BENCHMARK_STREAMS];
+  for (int i = 0; i < BENCHMARK_STREAMS; i++)
+    streams[i] = CreateSamples(count, i + 1);
+  std::vector<float> gui = CreateSamples(count, 99);
+  std::vector<float> mix(count);
+  std::vector<int32_t> sink(count);
+  std::vector<unsigned int> sets = GetFeatureSets();
+
+  for (size_t i = 0; i < sets.size(); i++)
+  {
+    CAEMixKernels::SetCPUFeatures(sets[i]);
+    CStopWatch timer;
+
+    timer.StartZero();
+    for (int period = 0; period < periods; period++)
+    {
+      std::fill(mix.begin(), mix.end(), 0.0f);
+      bool clip = false;
+      for (int j = 0; j < BENCHMARK_STREAMS; j++)
+        clip |= CAEMixKernels::MulAdd(&mix[0], &streams[j][0], 0.25f, count);
+      if (clip)
+        CAEMixKernels::Clamp(&mix[0], count);
+      CAEMixKernels::MulAdd(&mix[0], &gui[0], 0.1f, count);
+      CAEMixKernels::Mul(&mix[0], 0.8f, count);
+      CAEMixKernels::FloatToS32(&sink[0], &mix[0], count);
+    }
+    float elapsed = timer.GetElapsedMilliseconds();
+
+    std::cout << CAEMixKernels::GetName() << " mixing " << BENCHMARK_STREAMS << " streams, "
+              << BENCHMARK_RATE << " Hz " << BENCHMARK_CHANNELS << "ch: "
+              << testing::PrintToString(elapsed / BENCHMARK_SECONDS) << " ms per second of audio" << std::endl;
+  }
+}
@@ -0,0 +1,235 @@
+/*
+ *      Copyright (C) 2005-2013 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cores/AudioEngine/Engines/ActiveAE/ActiveAEResampleFFMPEG.h"
+#include "utils/Stopwatch.h"
+
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "libavutil/samplefmt.h"
+}
+
+#define TEST_RATE          48000
+#define BENCHMARK_RATE     192000
+#define BENCHMARK_CHANNELS 8
+#define BENCHMARK_PERIOD   1024
+#define BENCHMARK_SECONDS  2
+
+using namespace ActiveAE;
+
+/* exposes whether the sample format conversion bypasses swresample, and allows to turn it off */
+class CTestResample : public CActiveAEResampleFFMPEG
+{
+public:
+  using CActiveAEResampleFFMPEG::Init;
+
+  bool Init(AVSampleFormat dstFmt, AVSampleFormat srcFmt, int channels, int rate)
+  {
+    return CActiveAEResampleFFMPEG::Init(0, channels, rate, dstFmt, av_get_bytes_per_sample(dstFmt) * 8, 0,
+                                         0, channels, rate, srcFmt, av_get_bytes_per_sample(srcFmt) * 8, 0,
+                                         false, true, NULL, AE_QUALITY_MID, false);
+  }
+  bool IsDirect() const { return m_directConvert; }
+  void DisableDirect() { m_directConvert = false; }
+};
+
+/* a buffer in the layout of an AVSampleFormat, planar formats have one plane per channel */
+class CTestBuffer
+{
+public:
+  CTestBuffer(AVSampleFormat fmt, int channels, int samples)
+  {
+    int planes = av_sample_fmt_is_planar(fmt) ? channels : 1;
+    m_planeSize = samples * av_get_bytes_per_sample(fmt) * channels / planes;
+    m_data.assign(m_planeSize * planes, 0);
+    for (int i = 0; i < planes; i++)
+      m_planes[i] = &m_data[i * m_planeSize];
+  }
+
+  /* pseudo random samples, floats go a bit beyond -1.0 .. 1.0 */
+  void Fill(AVSampleFormat fmt)
+  {
+    AVSampleFormat packed = av_get_packed_sample_fmt(fmt);
+    unsigned int seed = 7;
+    int bytes = av_get_bytes_per_sample(fmt);
+    for (size_t i = 0; i < m_data.size() / bytes; i++)
+    {
+      seed = seed * 1103515245 + 12345;
+      if (packed == AV_SAMPLE_FMT_FLT)
+        ((float*)&m_data[0])[i] = ((int)(seed >> 8) % 20000 - 10000) / 9000.0f;
+      else if (packed == AV_SAMPLE_FMT_S16)
+        ((int16_t*)&m_data[0])[i] = (int16_t)(seed >> 16);
+      else
+        ((int32_t*)&m_data[0])[i] = (int32_t)seed;
+    }
+  }
+
+  uint8_t** Offset(AVSampleFormat fmt, int channels, int samples)
+  {
+    int planes = av_sample_fmt_is_planar(fmt) ? channels : 1;
+    int offset = samples * av_get_bytes_per_sample(fmt) * channels / planes;
+    for (int i = 0; i < planes; i++)
+      m_offset[i] = m_planes[i] + offset;
+    return m_offset;
+  }
+
+  std::vector<uint8_t> m_data;
+  int m_planeSize;
+  uint8_t* m_planes[AE_CH_MAX];
+  uint8_t* m_offset[AE_CH_MAX];
+};
+
+/* integer samples may differ by one where float rounding differs between swresample and the kernels */
+static void ExpectSameSamples(AVSampleFormat fmt, const std::vector<uint8_t> &expected, const std::vector<uint8_t> &actual)
+{
+  ASSERT_EQ(expected.size(), actual.size());
+  AVSampleFormat packed = av_get_packed_sample_fmt(fmt);
+  size_t count = expected.size() / av_get_bytes_per_sample(fmt);
+  for (size_t i = 0; i < count; i++)
+  {
+    if (packed == AV_SAMPLE_FMT_FLT)
+      ASSERT_FLOAT_EQ(((const float*)&expected[0])[i], ((const float*)&actual[0])[i]) << "at " << i;
+    else if (packed == AV_SAMPLE_FMT_S16)
+      ASSERT_NEAR(((const int16_t*)&expected[0])[i], ((const int16_t*)&actual[0])[i], 1) << "at " << i;
+    else
+      ASSERT_NEAR((double)((const int32_t*)&expected[0])[i], (double)((const int32_t*)&actual[0])[i], 1) << "at " << i;
+  }
+}
+
+/* converts the input in two calls, the first one with less room than input to make the resampler buffer */
+static std::vector<uint8_t> Convert(CTestResample &resample, AVSampleFormat dstFmt, AVSampleFormat srcFmt, int channels, bool direct)
+{
+  const int samples = 1001;
+  const int room = 600;
+
+  CTestBuffer in(srcFmt, channels, samples * 2);
+  in.Fill(srcFmt);
+  CTestBuffer out(dstFmt, channels, samples * 2);
+
+  EXPECT_TRUE(resample.Init(dstFmt, srcFmt, channels, TEST_RATE));
+  if (!direct)
+    resample.DisableDirect();
+
+  int done = resample.Resample(out.m_planes, room, in.m_planes, samples, 1.0);
+  EXPECT_EQ(room, done);
+  done += resample.Resample(out.Offset(dstFmt, channels, done), samples * 2 - done,
+                            in.Offset(srcFmt, channels, samples), samples, 1.0);
+  EXPECT_EQ(samples * 2, done);
+  EXPECT_EQ(0, resample.GetBufferedSamples());
+
+  return out.m_data;
+}
+
+TEST(TestActiveAEResampleFFMPEG, DirectConversion)
+{
+  static const AVSampleFormat formats[][2] =
+  {
+    { AV_SAMPLE_FMT_FLT,  AV_SAMPLE_FMT_FLTP },
+    { AV_SAMPLE_FMT_FLTP, AV_SAMPLE_FMT_FLT  },
+    { AV_SAMPLE_FMT_FLTP, AV_SAMPLE_FMT_S16  },
+    { AV_SAMPLE_FMT_FLTP, AV_SAMPLE_FMT_S32P },
+    { AV_SAMPLE_FMT_FLT,  AV_SAMPLE_FMT_S16P },
+    { AV_SAMPLE_FMT_S16,  AV_SAMPLE_FMT_FLT  },
+    { AV_SAMPLE_FMT_S32,  AV_SAMPLE_FMT_FLT  },
+    { AV_SAMPLE_FMT_S32,  AV_SAMPLE_FMT_FLTP },
+    { AV_SAMPLE_FMT_S16P, AV_SAMPLE_FMT_FLT  },
+  };
+  static const int channels[] = { 1, 2, 6, 8 };
+
+  for (size_t i = 0; i < sizeof(formats) / sizeof(formats[0]); i++)
+  {
+    for (size_t j = 0; j < sizeof(channels) / sizeof(channels[0]); j++)
+    {
+      AVSampleFormat dstFmt = formats[i][0];
+      AVSampleFormat srcFmt = formats[i][1];
+      SCOPED_TRACE(testing::Message() << av_get_sample_fmt_name(srcFmt) << " to " << av_get_sample_fmt_name(dstFmt)
+                                      << " " << channels[j] << "ch");
+
+      CTestResample swr;
+      std::vector<uint8_t> expected = Convert(swr, dstFmt, srcFmt, channels[j], false);
+      CTestResample direct;
+      std::vector<uint8_t> actual = Convert(direct, dstFmt, srcFmt, channels[j], true);
+      EXPECT_TRUE(direct.IsDirect());
+      ExpectSameSamples(dstFmt, expected, actual);
+    }
+  }
+}
+
+TEST(TestActiveAEResampleFFMPEG, NotDirect)
+{
+  // integer to integer, a rate change and a different channel count go through swresample
+  CTestResample resample;
+  EXPECT_TRUE(resample.Init(AV_SAMPLE_FMT_S32, AV_SAMPLE_FMT_S16, 2, TEST_RATE));
+  EXPECT_FALSE(resample.IsDirect());
+
+  CTestResample rate;
+  EXPECT_TRUE(rate.Init(0, 2, 44100, AV_SAMPLE_FMT_FLT, 32, 0, 0, 2, 48000, AV_SAMPLE_FMT_FLTP, 32, 0,
+                        false, true, NULL, AE_QUALITY_MID, false));
+  EXPECT_FALSE(rate.IsDirect());
+
+  CTestResample downmix;
+  EXPECT_TRUE(downmix.Init(0, 2, TEST_RATE, AV_SAMPLE_FMT_FLT, 32, 0, 0, 6, TEST_RATE, AV_SAMPLE_FMT_FLTP, 32, 0,
+                           false, true, NULL, AE_QUALITY_MID, false));
+  EXPECT_FALSE(downmix.IsDirect());
+}
+
+/* the stream stage (decoder FLTP to the internal FLT) and the sink stage (FLT to S32) */
+TEST(TestActiveAEResampleFFMPEG, Benchmark)
+{
+  static const AVSampleFormat formats[][2] =
+  {
+    { AV_SAMPLE_FMT_FLT, AV_SAMPLE_FMT_FLTP },
+    { AV_SAMPLE_FMT_S32, AV_SAMPLE_FMT_FLT  },
+  };
+  const int periods = BENCHMARK_SECONDS * BENCHMARK_RATE / BENCHMARK_PERIOD;
+
+  for (size_t i = 0; i < sizeof(formats) / sizeof(formats[0]); i++)
+  {
+    AVSampleFormat dstFmt = formats[i][0];
+    AVSampleFormat srcFmt = formats[i][1];
+    CTestBuffer in(srcFmt, BENCHMARK_CHANNELS, BENCHMARK_PERIOD);
+    in.Fill(srcFmt);
+    CTestBuffer out(dstFmt, BENCHMARK_CHANNELS, BENCHMARK_PERIOD);
+
+    float elapsed[2];
+    for (int direct = 0; direct < 2; direct++)
+    {
+      CTestResample resample;
+      ASSERT_TRUE(resample.Init(dstFmt, srcFmt, BENCHMARK_CHANNELS, BENCHMARK_RATE));
+      if (!direct)
+        resample.DisableDirect();
+
+      CStopWatch timer;
+      timer.StartZero();
+      for (int period = 0; period < periods; period++)
+        ASSERT_EQ(BENCHMARK_PERIOD, resample.Resample(out.m_planes, BENCHMARK_PERIOD, in.m_planes, BENCHMARK_PERIOD, 1.0));
+      elapsed[direct] = timer.GetElapsedMilliseconds() / BENCHMARK_SECONDS;
+    }
+
+    std::cout << av_get_sample_fmt_name(srcFmt) << " to " << av_get_sample_fmt_name(dstFmt) << ", "
+              << BENCHMARK_RATE << " Hz " << BENCHMARK_CHANNELS << "ch (ms per second of audio): swresample "
+              << testing::PrintToString(elapsed[0]) << ", direct " << testing::PrintToString(elapsed[1]) << std::endl;
+  }
+}
@@ -64,6 +64,7 @@ public:
 };
 
 class CFileItem;
+class CFileItemList;
 
 enum IPlayerAudioCapabilities
 {
@@ -237,6 +238,11 @@ public:
   virtual bool OpenFile(const CFileItem& file, const CPlayerOptions& options){ return false;}
   virtual bool QueueNextFile(const CFileItem &file) { return false; }
   virtual void OnNothingToQueueNotify() {}
+  /*!
+   \brief The playlist items that follow the playing or queued file, nearest first.
+   A player may open and buffer them ahead of QueueNextFile, an empty list drops what it prepared.
+   */
+  virtual void PrepareNextFiles(const CFileItemList &items) {}
   virtual bool CloseFile(bool reopen = false) = 0;
   virtual bool IsPlaying() const { return false;}
   virtual bool CanPause() { return true; };
@@ -19,6 +19,7 @@
  */
 
 #include "DVDCodecUtils.h"
+#include "DVDPictureKernels.h"
 #include "DVDClock.h"
 #include "cores/VideoPlayer/VideoRenderers/RenderManager.h"
 #include "utils/log.h"
@@ -35,10 +36,6 @@
 #pragma comment(lib, "swscale.lib")
 #endif
 
-extern "C" {
-#include "libswscale/swscale.h"
-}
-
 // allocate a new picture (AV_PIX_FMT_YUV420P)
 DVDVideoPicture* CDVDCodecUtils::AllocatePicture(int iWidth, int iHeight)
 {
@@ -47,6 +44,7 @@ DVDVideoPicture* CDVDCodecUtils::AllocatePicture(int iWidth, int iHeight)
   {
     pPicture->iWidth = iWidth;
     pPicture->iHeight = iHeight;
+    pPicture->poolBuffer = NULL;
 
     int w = iWidth / 2;
     int h = iHeight / 2;
@@ -82,94 +80,29 @@ void CDVDCodecUtils::FreePicture(DVDVideoPicture* pPicture)
 
 bool CDVDCodecUtils::CopyPicture(DVDVideoPicture* pDst, DVDVideoPicture* pSrc)
 {
-  uint8_t *s, *d;
   int w = pSrc->iWidth;
   int h = pSrc->iHeight;
 
-  s = pSrc->data[0];
-  d = pDst->data[0];
-
-  for (int y = 0; y < h; y++)
-  {
-    memcpy(d, s, w);
-    s += pSrc->iLineSize[0];
-    d += pDst->iLineSize[0];
-  }
+  CDVDPictureKernels::CopyPlane(pDst->data[0], pDst->iLineSize[0], pSrc->data[0], pSrc->iLineSize[0], w, h);
 
   w >>= 1;
   h >>= 1;
 
-  s = pSrc->data[1];
-  d = pDst->data[1];
-  for (int y = 0; y < h; y++)
-  {
-    memcpy(d, s, w);
-    s += pSrc->iLineSize[1];
-    d += pDst->iLineSize[1];
-  }
-
-  s = pSrc->data[2];
-  d = pDst->data[2];
-  for (int y = 0; y < h; y++)
-  {
-    memcpy(d, s, w);
-    s += pSrc->iLineSize[2];
-    d += pDst->iLineSize[2];
-  }
+  CDVDPictureKernels::CopyPlane(pDst->data[1], pDst->iLineSize[1], pSrc->data[1], pSrc->iLineSize[1], w, h);
+  CDVDPictureKernels::CopyPlane(pDst->data[2], pDst->iLineSize[2], pSrc->data[2], pSrc->iLineSize[2], w, h);
   return true;
 }
 
 bool CDVDCodecUtils::CopyPicture(YV12Image* pImage, DVDVideoPicture *pSrc)
 {
-  uint8_t *s = pSrc->data[0];
-  uint8_t *d = pImage->plane[0];
   int w = pImage->width * pImage->bpp;
   int h = pImage->height;
-  if ((w == pSrc->iLineSize[0]) && ((unsigned int) pSrc->iLineSize[0] == pImage->stride[0]))
-  {
-    memcpy(d, s, w*h);
-  }
-  else
-  {
-    for (int y = 0; y < h; y++)
-    {
-      memcpy(d, s, w);
-      s += pSrc->iLineSize[0];
-      d += pImage->stride[0];
-    }
-  }
-  s = pSrc->data[1];
-  d = pImage->plane[1];
+  CDVDPictureKernels::CopyPlane(pImage->plane[0], pImage->stride[0], pSrc->data[0], pSrc->iLineSize[0], w, h);
+
   w =(pImage->width  >> pImage->cshift_x) * pImage->bpp;
   h =(pImage->height >> pImage->cshift_y);
-  if ((w==pSrc->iLineSize[1]) && ((unsigned int) pSrc->iLineSize[1]==pImage->stride[1]))
-  {
-    memcpy(d, s, w*h);
-  }
-  else
-  {
-    for (int y = 0; y < h; y++)
-    {
-      memcpy(d, s, w);
-      s += pSrc->iLineSize[1];
-      d += pImage->stride[1];
-    }
-  }
-  s = pSrc->data[2];
-  d = pImage->plane[2];
-  if ((w==pSrc->iLineSize[2]) && ((unsigned int) pSrc->iLineSize[2]==pImage->stride[2]))
-  {
-    memcpy(d, s, w*h);
-  }
-  else
-  {
-    for (int y = 0; y < h; y++)
-    {
-      memcpy(d, s, w);
-      s += pSrc->iLineSize[2];
-      d += pImage->stride[2];
-    }
-  }
+  CDVDPictureKernels::CopyPlane(pImage->plane[1], pImage->stride[1], pSrc->data[1], pSrc->iLineSize[1], w, h);
+  CDVDPictureKernels::CopyPlane(pImage->plane[2], pImage->stride[2], pSrc->data[2], pSrc->iLineSize[2], w, h);
   return true;
 }
 
@@ -180,6 +113,7 @@ DVDVideoPicture* CDVDCodecUtils::ConvertToNV12Picture(DVDVideoPicture *pSrc)
   if (pPicture)
   {
     *pPicture = *pSrc;
+    pPicture->poolBuffer = NULL;
 
     int w = pPicture->iWidth / 2;
     int h = pPicture->iHeight / 2;
@@ -199,26 +133,14 @@ DVDVideoPicture* CDVDCodecUtils::ConvertToNV12Picture(DVDVideoPicture *pSrc)
       pPicture->format = RENDER_FMT_NV12;
       
       // copy luma
-      uint8_t *s = pSrc->data[0];
-      uint8_t *d = pPicture->data[0];
-      for (int y = 0; y < (int)pSrc->iHeight; y++)
-      {
-        memcpy(d, s, pSrc->iWidth);
-        s += pSrc->iLineSize[0];
-        d += pPicture->iLineSize[0];
-      }
+      CDVDPictureKernels::CopyPlane(pPicture->data[0], pPicture->iLineSize[0], pSrc->data[0], pSrc->iLineSize[0],
+                                    pSrc->iWidth, pSrc->iHeight);
 
       //copy chroma
-      for (int y = 0; y < (int)pSrc->iHeight/2; y++) {
-        uint8_t *s_u = pSrc->data[1] + (y * pSrc->iLineSize[1]);
-        uint8_t *s_v = pSrc->data[2] + (y * pSrc->iLineSize[2]);
-        uint8_t *d_uv = pPicture->data[1] + (y * pPicture->iLineSize[1]);
-        for (int x = 0; x < (int)pSrc->iWidth/2; x++) {
-          *d_uv++ = *s_u++;
-          *d_uv++ = *s_v++;
-        }
-      }
-      
+      CDVDPictureKernels::InterleaveUV(pPicture->data[1], pPicture->iLineSize[1],
+                                       pSrc->data[1], pSrc->iLineSize[1],
+                                       pSrc->data[2], pSrc->iLineSize[2],
+                                       pSrc->iWidth / 2, pSrc->iHeight / 2);
     }
     else
     {
@@ -237,6 +159,7 @@ DVDVideoPicture* CDVDCodecUtils::ConvertToYUV422PackedPicture(DVDVideoPicture *p
   if (pPicture)
   {
     *pPicture = *pSrc;
+    pPicture->poolBuffer = NULL;
 
     int totalsize = pPicture->iWidth * pPicture->iHeight * 2;
     uint8_t* data = (uint8_t*) av_malloc(totalsize);
@@ -253,27 +176,11 @@ DVDVideoPicture* CDVDCodecUtils::ConvertToYUV422PackedPicture(DVDVideoPicture *p
       pPicture->iLineSize[3] = 0;
       pPicture->format = format;
 
-      //if this is going to be used for anything else than testing the renderer
-      //the library should not be loaded on every function call
-      {
-        // Perform the scaling.
-        uint8_t* src[] =       { pSrc->data[0],          pSrc->data[1],      pSrc->data[2],      NULL };
-        int      srcStride[] = { pSrc->iLineSize[0],     pSrc->iLineSize[1], pSrc->iLineSize[2], 0    };
-        uint8_t* dst[] =       { pPicture->data[0],      NULL,               NULL,               NULL };
-        int      dstStride[] = { pPicture->iLineSize[0], 0,                  0,                  0    };
-
-        int dstformat;
-        if (format == RENDER_FMT_UYVY422)
-          dstformat = AV_PIX_FMT_UYVY422;
-        else
-          dstformat = AV_PIX_FMT_YUYV422;
-
-        struct SwsContext *ctx = sws_getContext(pSrc->iWidth, pSrc->iHeight, AV_PIX_FMT_YUV420P,
-                                                           pPicture->iWidth, pPicture->iHeight, (AVPixelFormat)dstformat,
-                                                           SWS_BILINEAR, NULL, NULL, NULL);
-        sws_scale(ctx, src, srcStride, 0, pSrc->iHeight, dst, dstStride);
-        sws_freeContext(ctx);
-      }
+      // same result as the unscaled swscale path, chroma rows are repeated
+      const uint8_t* src[] = { pSrc->data[0],      pSrc->data[1],      pSrc->data[2]      };
+      const int srcStride[] = { pSrc->iLineSize[0], pSrc->iLineSize[1], pSrc->iLineSize[2] };
+      CDVDPictureKernels::PackYUV422(pPicture->data[0], pPicture->iLineSize[0], src, srcStride,
+                                     pSrc->iWidth, pSrc->iHeight, format == RENDER_FMT_UYVY422);
     }
     else
     {
@@ -287,69 +194,23 @@ DVDVideoPicture* CDVDCodecUtils::ConvertToYUV422PackedPicture(DVDVideoPicture *p
 
 bool CDVDCodecUtils::CopyNV12Picture(YV12Image* pImage, DVDVideoPicture *pSrc)
 {
-  uint8_t *s = pSrc->data[0];
-  uint8_t *d = pImage->plane[0];
-  int w = pSrc->iWidth;
-  int h = pSrc->iHeight;
   // Copy Y
-  if ((w == pSrc->iLineSize[0]) && ((unsigned int) pSrc->iLineSize[0] == pImage->stride[0]))
-  {
-    memcpy(d, s, w*h);
-  }
-  else
-  {
-    for (int y = 0; y < h; y++)
-    {
-      memcpy(d, s, w);
-      s += pSrc->iLineSize[0];
-      d += pImage->stride[0];
-    }
-  }
-  
-  s = pSrc->data[1];
-  d = pImage->plane[1];
-  w = pSrc->iWidth;
-  h = pSrc->iHeight >> 1;
+  CDVDPictureKernels::CopyPlane(pImage->plane[0], pImage->stride[0], pSrc->data[0], pSrc->iLineSize[0],
+                                pSrc->iWidth, pSrc->iHeight);
+
   // Copy packed UV (width is same as for Y as it's both U and V components)
-  if ((w==pSrc->iLineSize[1]) && ((unsigned int) pSrc->iLineSize[1]==pImage->stride[1]))
-  {
-    memcpy(d, s, w*h);
-  }
-  else
-  {
-    for (int y = 0; y < h; y++)
-    {
-      memcpy(d, s, w);
-      s += pSrc->iLineSize[1];
-      d += pImage->stride[1];
-    }
-  }
+  CDVDPictureKernels::CopyPlane(pImage->plane[1], pImage->stride[1], pSrc->data[1], pSrc->iLineSize[1],
+                                pSrc->iWidth, pSrc->iHeight >> 1);
 
   return true;
 }
 
 bool CDVDCodecUtils::CopyYUV422PackedPicture(YV12Image* pImage, DVDVideoPicture *pSrc)
 {
-  uint8_t *s = pSrc->data[0];
-  uint8_t *d = pImage->plane[0];
-  int w = pSrc->iWidth;
-  int h = pSrc->iHeight;
-
   // Copy YUYV
-  if ((w * 2 == pSrc->iLineSize[0]) && ((unsigned int) pSrc->iLineSize[0] == pImage->stride[0]))
-  {
-    memcpy(d, s, w*h*2);
-  }
-  else
-  {
-    for (int y = 0; y < h; y++)
-    {
-      memcpy(d, s, w*2);
-      s += pSrc->iLineSize[0];
-      d += pImage->stride[0];
-    }
-  }
-  
+  CDVDPictureKernels::CopyPlane(pImage->plane[0], pImage->stride[0], pSrc->data[0], pSrc->iLineSize[0],
+                                pSrc->iWidth * 2, pSrc->iHeight);
+
   return true;
 }
 
@@ -0,0 +1,442 @@
+/*
+ *      Copyright (C) 2005-2013 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "DVDPictureKernels.h"
+#include "utils/CPUInfo.h"
+
+#include <atomic>
+#include <cstring>
+
+// the kernels are selected at runtime, so only the compiler has to support the instruction set
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PICTURE_KERNELS_SSE2
+#include <emmintrin.h>
+#if defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)))
+#define PICTURE_KERNELS_AVX2
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && _MSC_VER >= 1800
+#define PICTURE_KERNELS_AVX2
+#define TARGET_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define PICTURE_KERNELS_NEON
+#include <arm_neon.h>
+#endif
+
+namespace
+{
+
+struct SPictureKernels
+{
+  const char* name;
+  // copy of a row whose destination is written with non-temporal stores
+  void (*StreamRow)(uint8_t *dst, const uint8_t *src, int size);
+  void (*InterleaveRow)(uint8_t *dst, const uint8_t *u, const uint8_t *v, int width, bool stream);
+  void (*PackYUYVRow)(uint8_t *dst, const uint8_t *y, const uint8_t *u, const uint8_t *v, int width, bool stream);
+  void (*PackUYVYRow)(uint8_t *dst, const uint8_t *y, const uint8_t *u, const uint8_t *v, int width, bool stream);
+  // orders the non-temporal stores before the picture is handed on
+  void (*Fence)();
+};
+
+/* scalar */
+
+void StreamRowC(uint8_t *dst, const uint8_t *src, int size)
+{
+  memcpy(dst, src, size);
+}
+
+void InterleaveRowC(uint8_t *dst, const uint8_t *u, const uint8_t *v, int width, bool stream)
+{
+  for (int x = 0; x < width; x++)
+  {
+    *dst++ = u[x];
+    *dst++ = v[x];
+  }
+}
+
+template<bool uyvy>
+void PackRowC(uint8_t *dst, const uint8_t *y, const uint8_t *u, const uint8_t *v, int width, bool stream)
+{
+  for (int x = 0; x < width / 2; x++)
+  {
+    if (uyvy)
+    {
+      dst[0] = u[x];
+      dst[1] = y[0];
+      dst[2] = v[x];
+      dst[3] = y[1];
+    }
+    else
+    {
+      dst[0] = y[0];
+      dst[1] = u[x];
+      dst[2] = y[1];
+      dst[3] = v[x];
+    }
+    dst += 4;
+    y += 2;
+  }
+}
+
+void FenceC()
+{
+}
+
+const SPictureKernels kernelsC =
+{
+  "scalar", StreamRowC, InterleaveRowC, PackRowC<false>, PackRowC<true>, FenceC
+};
+
+/* SSE2 */
+
+#if defined(PICTURE_KERNELS_SSE2)
+inline void Store128(uint8_t *dst, __m128i value, bool stream)
+{
+  if (stream)
+    _mm_stream_si128((__m128i*)dst, value);
+  else
+    _mm_storeu_si128((__m128i*)dst, value);
+}
+
+void StreamRowSSE2(uint8_t *dst, const uint8_t *src, int size)
+{
+  int head = (16 - ((uintptr_t)dst & 15)) & 15;
+  if (head > size)
+    head = size;
+  memcpy(dst, src, head);
+  dst += head;
+  src += head;
+  size -= head;
+
+  for (; size >= 64; size -= 64, src += 64, dst += 64)
+  {
+    __m128i a = _mm_loadu_si128((const __m128i*)src);
+    __m128i b = _mm_loadu_si128((const __m128i*)(src + 16));
+    __m128i c = _mm_loadu_si128((const __m128i*)(src + 32));
+    __m128i d = _mm_loadu_si128((const __m128i*)(src + 48));
+    _mm_stream_si128((__m128i*)dst, a);
+    _mm_stream_si128((__m128i*)(dst + 16), b);
+    _mm_stream_si128((__m128i*)(dst + 32), c);
+    _mm_stream_si128((__m128i*)(dst + 48), d);
+  }
+  for (; size >= 16; size -= 16, src += 16, dst += 16)
+    _mm_stream_si128((__m128i*)dst, _mm_loadu_si128((const __m128i*)src));
+  memcpy(dst, src, size);
+}
+
+void InterleaveRowSSE2(uint8_t *dst, const uint8_t *u, const uint8_t *v, int width, bool stream)
+{
+  stream = stream && ((uintptr_t)dst & 15) == 0;
+
+  int x = 0;
+  for (; x + 16 <= width; x += 16, dst += 32)
+  {
+    __m128i mu = _mm_loadu_si128((const __m128i*)(u + x));
+    __m128i mv = _mm_loadu_si128((const __m128i*)(v + x));
+    Store128(dst, _mm_unpacklo_epi8(mu, mv), stream);
+    Store128(dst + 16, _mm_unpackhi_epi8(mu, mv), stream);
+  }
+  InterleaveRowC(dst, u + x, v + x, width - x, false);
+}
+
+template<bool uyvy>
+void PackRowSSE2(uint8_t *dst, const uint8_t *y, const uint8_t *u, const uint8_t *v, int width, bool stream)
+{
+  stream = stream && ((uintptr_t)dst & 15) == 0;
+
+  int x = 0;
+  for (; x + 16 <= width; x += 16, dst += 32)
+  {
+    __m128i my = _mm_loadu_si128((const __m128i*)(y + x));
+    __m128i muv = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(u + x / 2)),
+                                    _mm_loadl_epi64((const __m128i*)(v + x / 2)));
+    if (uyvy)
+    {
+      Store128(dst, _mm_unpacklo_epi8(muv, my), stream);
+      Store128(dst + 16, _mm_unpackhi_epi8(muv, my), stream);
+    }
+    else
+    {
+      Store128(dst, _mm_unpacklo_epi8(my, muv), stream);
+      Store128(dst + 16, _mm_unpackhi_epi8(my, muv), stream);
+    }
+  }
+  PackRowC<uyvy>(dst, y + x, u + x / 2, v + x / 2, width - x, false);
+}
+
+void FenceSSE2()
+{
+  _mm_sfence();
+}
+
+const SPictureKernels kernelsSSE2 =
+{
+  "sse2", StreamRowSSE2, InterleaveRowSSE2, PackRowSSE2<false>, PackRowSSE2<true>, FenceSSE2
+};
+#endif
+
+/* AVX2 */
+
+#if defined(PICTURE_KERNELS_AVX2)
+TARGET_AVX2 inline void Store256(uint8_t *dst, __m256i value, bool stream)
+{
+  if (stream)
+    _mm256_stream_si256((__m256i*)dst, value);
+  else
+    _mm256_storeu_si256((__m256i*)dst, value);
+}
+
+TARGET_AVX2 void StreamRowAVX2(uint8_t *dst, const uint8_t *src, int size)
+{
+  int head = (32 - ((uintptr_t)dst & 31)) & 31;
+  if (head > size)
+    head = size;
+  memcpy(dst, src, head);
+  dst += head;
+  src += head;
+  size -= head;
+
+  for (; size >= 128; size -= 128, src += 128, dst += 128)
+  {
+    __m256i a = _mm256_loadu_si256((const __m256i*)src);
+    __m256i b = _mm256_loadu_si256((const __m256i*)(src + 32));
+    __m256i c = _mm256_loadu_si256((const __m256i*)(src + 64));
+    __m256i d = _mm256_loadu_si256((const __m256i*)(src + 96));
+    _mm256_stream_si256((__m256i*)dst, a);
+    _mm256_stream_si256((__m256i*)(dst + 32), b);
+    _mm256_stream_si256((__m256i*)(dst + 64), c);
+    _mm256_stream_si256((__m256i*)(dst + 96), d);
+  }
+  for (; size >= 32; size -= 32, src += 32, dst += 32)
+    _mm256_stream_si256((__m256i*)dst, _mm256_loadu_si256((const __m256i*)src));
+  memcpy(dst, src, size);
+}
+
+// unpack works within the 128 bit lanes, the permutes put the lanes back in pixel order
+TARGET_AVX2 void InterleaveRowAVX2(uint8_t *dst, const uint8_t *u, const uint8_t *v, int width, bool stream)
+{
+  stream = stream && ((uintptr_t)dst & 31) == 0;
+
+  int x = 0;
+  for (; x + 32 <= width; x += 32, dst += 64)
+  {
+    __m256i mu = _mm256_loadu_si256((const __m256i*)(u + x));
+    __m256i mv = _mm256_loadu_si256((const __m256i*)(v + x));
+    __m256i lo = _mm256_unpacklo_epi8(mu, mv);
+    __m256i hi = _mm256_unpackhi_epi8(mu, mv);
+    Store256(dst, _mm256_permute2x128_si256(lo, hi, 0x20), stream);
+    Store256(dst + 32, _mm256_permute2x128_si256(lo, hi, 0x31), stream);
+  }
+  _mm256_zeroupper();
+  InterleaveRowSSE2(dst, u + x, v + x, width - x, false);
+}
+
+template<bool uyvy>
+TARGET_AVX2 void PackRowAVX2(uint8_t *dst, const uint8_t *y, const uint8_t *u, const uint8_t *v, int width, bool stream)
+{
+  stream = stream && ((uintptr_t)dst & 31) == 0;
+
+  int x = 0;
+  for (; x + 32 <= width; x += 32, dst += 64)
+  {
+    __m256i my = _mm256_loadu_si256((const __m256i*)(y + x));
+    __m128i mu = _mm_loadu_si128((const __m128i*)(u + x / 2));
+    __m128i mv = _mm_loadu_si128((const __m128i*)(v + x / 2));
+    // chroma of luma 0-15 in the low lane and of luma 16-31 in the high lane
+    __m256i muv = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_unpacklo_epi8(mu, mv)),
+                                          _mm_unpackhi_epi8(mu, mv), 1);
+    __m256i lo, hi;
+    if (uyvy)
+    {
+      lo = _mm256_unpacklo_epi8(muv, my);
+      hi = _mm256_unpackhi_epi8(muv, my);
+    }
+    else
+    {
+      lo = _mm256_unpacklo_epi8(my, muv);
+      hi = _mm256_unpackhi_epi8(my, muv);
+    }
+    Store256(dst, _mm256_permute2x128_si256(lo, hi, 0x20), stream);
+    Store256(dst + 32, _mm256_permute2x128_si256(lo, hi, 0x31), stream);
+  }
+  _mm256_zeroupper();
+  PackRowSSE2<uyvy>(dst, y + x, u + x / 2, v + x / 2, width - x, false);
+}
+
+const SPictureKernels kernelsAVX2 =
+{
+  "avx2", StreamRowAVX2, InterleaveRowAVX2, PackRowAVX2<false>, PackRowAVX2<true>, FenceSSE2
+};
+#endif
+
+/* NEON */
+
+#if defined(PICTURE_KERNELS_NEON)
+void InterleaveRowNEON(uint8_t *dst, const uint8_t *u, const uint8_t *v, int width, bool stream)
+{
+  int x = 0;
+  for (; x + 16 <= width; x += 16, dst += 32)
+  {
+    uint8x16x2_t uv;
+    uv.val[0] = vld1q_u8(u + x);
+    uv.val[1] = vld1q_u8(v + x);
+    vst2q_u8(dst, uv);
+  }
+  InterleaveRowC(dst, u + x, v + x, width - x, false);
+}
+
+template<bool uyvy>
+void PackRowNEON(uint8_t *dst, const uint8_t *y, const uint8_t *u, const uint8_t *v, int width, bool stream)
+{
+  int x = 0;
+  for (; x + 16 <= width; x += 16, dst += 32)
+  {
+    uint8x8x2_t my = vld2_u8(y + x);
+    uint8x8x4_t out;
+    if (uyvy)
+    {
+      out.val[0] = vld1_u8(u + x / 2);
+      out.val[1] = my.val[0];
+      out.val[2] = vld1_u8(v + x / 2);
+      out.val[3] = my.val[1];
+    }
+    else
+    {
+      out.val[0] = my.val[0];
+      out.val[1] = vld1_u8(u + x / 2);
+      out.val[2] = my.val[1];
+      out.val[3] = vld1_u8(v + x / 2);
+    }
+    vst4_u8(dst, out);
+  }
+  PackRowC<uyvy>(dst, y + x, u + x / 2, v + x / 2, width - x, false);
+}
+
+// there are no non-temporal stores to use from C, the copy stays memcpy
+const SPictureKernels kernelsNEON =
+{
+  "neon", StreamRowC, InterleaveRowNEON, PackRowNEON<false>, PackRowNEON<true>, FenceC
+};
+#endif
+
+const SPictureKernels* SelectKernels(unsigned int features)
+{
+#if defined(PICTURE_KERNELS_AVX2)
+  if (features & CPU_FEATURE_AVX2)
+    return &kernelsAVX2;
+#endif
+#if defined(PICTURE_KERNELS_SSE2)
+  if (features & CPU_FEATURE_SSE2)
+    return &kernelsSSE2;
+#endif
+#if defined(PICTURE_KERNELS_NEON)
+  if (features & CPU_FEATURE_NEON)
+    return &kernelsNEON;
+#endif
+  return &kernelsC;
+}
+
+std::atomic<const SPictureKernels*> selectedKernels(nullptr);
+
+const SPictureKernels* GetKernels()
+{
+  const SPictureKernels* kernels = selectedKernels.load(std::memory_order_acquire);
+  if (!kernels)
+  {
+    kernels = SelectKernels(g_cpuInfo.GetCPUFeatures());
+    selectedKernels.store(kernels, std::memory_order_release);
+  }
+  return kernels;
+}
+
+}
+
+void CDVDPictureKernels::CopyPlane(uint8_t *dst, int dstStride, const uint8_t *src, int srcStride, int width, int height)
+{
+  // a contiguous plane is copied as a single row
+  if (width == srcStride && width == dstStride)
+  {
+    width *= height;
+    height = 1;
+  }
+
+  if (width * height < STREAM_THRESHOLD)
+  {
+    for (int y = 0; y < height; y++, src += srcStride, dst += dstStride)
+      memcpy(dst, src, width);
+    return;
+  }
+
+  const SPictureKernels* kernels = GetKernels();
+  for (int y = 0; y < height; y++, src += srcStride, dst += dstStride)
+    kernels->StreamRow(dst, src, width);
+  kernels->Fence();
+}
+
+void CDVDPictureKernels::InterleaveUV(uint8_t *dst, int dstStride,
+                                      const uint8_t *srcU, int srcUStride,
+                                      const uint8_t *srcV, int srcVStride,
+                                      int width, int height)
+{
+  const SPictureKernels* kernels = GetKernels();
+  bool stream = width * 2 * height >= STREAM_THRESHOLD;
+
+  for (int y = 0; y < height; y++)
+  {
+    kernels->InterleaveRow(dst, srcU, srcV, width, stream);
+    dst += dstStride;
+    srcU += srcUStride;
+    srcV += srcVStride;
+  }
+  if (stream)
+    kernels->Fence();
+}
+
+void CDVDPictureKernels::PackYUV422(uint8_t *dst, int dstStride, const uint8_t * const src[3], const int srcStride[3],
+                                    int width, int height, bool uyvy)
+{
+  const SPictureKernels* kernels = GetKernels();
+  bool stream = width * 2 * height >= STREAM_THRESHOLD;
+  void (*PackRow)(uint8_t*, const uint8_t*, const uint8_t*, const uint8_t*, int, bool) =
+    uyvy ? kernels->PackUYVYRow : kernels->PackYUYVRow;
+
+  for (int y = 0; y < height; y++)
+  {
+    PackRow(dst, src[0] + y * srcStride[0], src[1] + (y >> 1) * srcStride[1], src[2] + (y >> 1) * srcStride[2],
+            width, stream);
+    dst += dstStride;
+  }
+  if (stream)
+    kernels->Fence();
+}
+
+void CDVDPictureKernels::SetCPUFeatures(unsigned int features)
+{
+  selectedKernels.store(SelectKernels(features), std::memory_order_release);
+}
+
+const char* CDVDPictureKernels::GetName()
+{
+  return GetKernels()->name;
+}
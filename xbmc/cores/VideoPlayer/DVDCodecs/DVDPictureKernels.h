@@ -0,0 +1,72 @@
+#pragma once
+
+/*
+ *      Copyright (C) 2005-2013 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdint.h>
+
+/*!
+ \brief Plane copy and pixel format conversion kernels used by CDVDCodecUtils.
+
+ The kernels are selected at runtime from the CPU features reported by CCPUInfo
+ (SSE2, AVX2 or NEON, with a scalar fallback). Planes that are larger than
+ STREAM_THRESHOLD are written with non-temporal stores, the destination of these
+ copies is read by the renderer upload and not by the cpu.
+ */
+class CDVDPictureKernels
+{
+public:
+  /*!
+   \brief Plane size in bytes above which the destination is written bypassing the cache.
+   */
+  static const int STREAM_THRESHOLD = 1024 * 1024;
+
+  /*!
+   \brief Copy a plane of height rows of width bytes.
+   */
+  static void CopyPlane(uint8_t *dst, int dstStride, const uint8_t *src, int srcStride, int width, int height);
+
+  /*!
+   \brief Interleave separate U and V planes into a packed UV plane (NV12 chroma).
+   \param width number of chroma samples per row
+   */
+  static void InterleaveUV(uint8_t *dst, int dstStride,
+                           const uint8_t *srcU, int srcUStride,
+                           const uint8_t *srcV, int srcVStride,
+                           int width, int height);
+
+  /*!
+   \brief Pack a YUV 4:2:0 planar picture into YUY2 or UYVY, chroma rows are repeated.
+   \param width number of luma samples per row
+   */
+  static void PackYUV422(uint8_t *dst, int dstStride, const uint8_t * const src[3], const int srcStride[3],
+                         int width, int height, bool uyvy);
+
+  /*!
+   \brief Select the kernels for the given CPU_FEATURE_* flags instead of the detected ones.
+   Passing 0 selects the scalar kernels.
+   */
+  static void SetCPUFeatures(unsigned int features);
+
+  /*!
+   \brief Name of the selected kernel set, for logging.
+   */
+  static const char* GetName();
+};
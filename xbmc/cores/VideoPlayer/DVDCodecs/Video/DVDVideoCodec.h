@@ -51,6 +51,7 @@ class CDVDMediaCodecInfo;
 class CDVDVideoCodecIMXBuffer;
 class CMMALBuffer;
 class CDVDAmlogicInfo;
+class CDVDVideoPoolBuffer;
 
 
 // should be entirely filled by all codecs
@@ -102,6 +103,9 @@ struct DVDVideoPicture
 
   };
 
+  CDVDVideoPoolBuffer *poolBuffer;      //< planes of a software picture that can be referenced instead of copied, may be NULL.
+                                        //< owned by the codec, Acquire() it to keep the planes beyond the next Decode call
+
   unsigned int iFlags;
 
   double       iRepeatPicture;
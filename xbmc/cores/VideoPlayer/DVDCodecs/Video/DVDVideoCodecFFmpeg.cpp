@@ -28,6 +28,7 @@
 #include "DVDClock.h"
 #include "DVDCodecs/DVDCodecs.h"
 #include "DVDCodecs/DVDCodecUtils.h"
+#include "DVDVideoFramePool.h"
 #include "utils/CPUInfo.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
@@ -169,7 +170,7 @@ enum AVPixelFormat CDVDVideoCodecFFmpeg::GetFormat(struct AVCodecContext * avctx
   if (ctx->GetHardware())
   {
     ctx->SetHardware(NULL);
-    avctx->get_buffer2 = avcodec_default_get_buffer2;
+    avctx->get_buffer2 = ctx->m_framePool ? GetBuffer : avcodec_default_get_buffer2;
     avctx->slice_flags = 0;
     avctx->hwaccel_context = 0;
   }
@@ -263,6 +264,12 @@ enum AVPixelFormat CDVDVideoCodecFFmpeg::GetFormat(struct AVCodecContext * avctx
   return avcodec_default_get_format(avctx, fmt);
 }
 
+int CDVDVideoCodecFFmpeg::GetBuffer(struct AVCodecContext *avctx, AVFrame *frame, int flags)
+{
+  CDVDVideoCodecFFmpeg* ctx = (CDVDVideoCodecFFmpeg*)avctx->opaque;
+  return ctx->m_framePool->GetBuffer(avctx, frame, flags);
+}
+
 CDVDVideoCodecFFmpeg::CDVDVideoCodecFFmpeg(CProcessInfo &processInfo) : CDVDVideoCodec(processInfo)
 {
   m_pCodecContext = nullptr;
@@ -272,6 +279,7 @@ CDVDVideoCodecFFmpeg::CDVDVideoCodecFFmpeg(CProcessInfo &processInfo) : CDVDVide
   m_pFilterIn = nullptr;
   m_pFilterOut = nullptr;
   m_pFilterFrame = nullptr;
+  m_pPoolBuffer = nullptr;
 
   m_iPictureWidth = 0;
   m_iPictureHeight = 0;
@@ -342,6 +350,13 @@ bool CDVDVideoCodecFFmpeg::Open(CDVDStreamInfo &hints, CDVDCodecOptions &options
   m_pCodecContext->get_format = GetFormat;
   m_pCodecContext->codec_tag = hints.codec_tag;
 
+  // software decoded frames are allocated from a pool, the renderer can reference them instead of copying
+  if (pCodec->capabilities & CODEC_CAP_DR1)
+  {
+    m_framePool = CDVDVideoFramePool::Create();
+    m_pCodecContext->get_buffer2 = GetBuffer;
+  }
+
   // setup threading model
   if (!hints.software)
   {
@@ -463,6 +478,7 @@ bool CDVDVideoCodecFFmpeg::Open(CDVDStreamInfo &hints, CDVDCodecOptions &options
 
 void CDVDVideoCodecFFmpeg::Dispose()
 {
+  ReleasePoolBuffer();
   av_frame_free(&m_pFrame);
   av_frame_free(&m_pDecodedFrame);
   av_frame_free(&m_pFilterFrame);
@@ -470,6 +486,20 @@ void CDVDVideoCodecFFmpeg::Dispose()
   SAFE_RELEASE(m_pHardware);
 
   FilterClose();
+
+  if (m_framePool)
+  {
+    CDVDVideoFramePool::SStats stats;
+    m_framePool->GetStats(stats);
+    CLog::Log(LOGDEBUG, "CDVDVideoCodecFFmpeg::Dispose - frame pool allocated %u buffers for %u frames, peak %u kB",
+              stats.allocations, stats.requests, (unsigned int)(stats.peakBytes / 1024));
+    m_framePool.reset();
+  }
+}
+
+void CDVDVideoCodecFFmpeg::ReleasePoolBuffer()
+{
+  SAFE_RELEASE(m_pPoolBuffer);
 }
 
 void CDVDVideoCodecFFmpeg::SetDropState(bool bDrop)
@@ -790,6 +820,7 @@ void CDVDVideoCodecFFmpeg::Reset()
   m_skippedDeint = 0;
   m_droppedFrames = 0;
   m_iLastKeyframe = m_pCodecContext->has_b_frames;
+  ReleasePoolBuffer();
   avcodec_flush_buffers(m_pCodecContext);
 
   if (m_pHardware)
@@ -814,6 +845,7 @@ bool CDVDVideoCodecFFmpeg::GetPictureCommon(DVDVideoPicture* pDvdVideoPicture)
   if (!m_pFrame)
     return false;
 
+  pDvdVideoPicture->poolBuffer = nullptr;
   pDvdVideoPicture->iWidth = m_pFrame->width;
   pDvdVideoPicture->iHeight = m_pFrame->height;
 
@@ -964,6 +996,18 @@ bool CDVDVideoCodecFFmpeg::GetPicture(DVDVideoPicture* pDvdVideoPicture)
       m_postProc.GetPicture(pDvdVideoPicture);
   }
 
+  // hand out the pool buffer only if the planes are still the decoded ones
+  ReleasePoolBuffer();
+  if (m_framePool && pDvdVideoPicture->data[0] == m_pFrame->data[0])
+  {
+    m_pPoolBuffer = m_framePool->Reference(m_pFrame);
+    pDvdVideoPicture->poolBuffer = m_pPoolBuffer;
+
+    CDVDVideoFramePool::SStats stats;
+    m_framePool->GetStats(stats);
+    m_processInfo.UpdateVideoBufferStats(stats.allocations, stats.peakBytes);
+  }
+
   return true;
 }
 
@@ -25,6 +25,7 @@
 #include "DVDVideoCodec.h"
 #include "DVDResource.h"
 #include "DVDVideoPPFFmpeg.h"
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -38,6 +39,8 @@ extern "C" {
 }
 
 class CCriticalSection;
+class CDVDVideoFramePool;
+class CDVDVideoPoolBuffer;
 
 class CDVDVideoCodecFFmpeg : public CDVDVideoCodec
 {
@@ -79,6 +82,8 @@ public:
 protected:
   void Dispose();
   static enum AVPixelFormat GetFormat(struct AVCodecContext * avctx, const AVPixelFormat * fmt);
+  static int GetBuffer(struct AVCodecContext *avctx, AVFrame *frame, int flags);
+  void ReleasePoolBuffer();
 
   int  FilterOpen(const std::string& filters, bool scale);
   void FilterClose();
@@ -100,6 +105,9 @@ protected:
 
   CDVDVideoPPFFmpeg m_postProc;
 
+  std::shared_ptr<CDVDVideoFramePool> m_framePool;
+  CDVDVideoPoolBuffer *m_pPoolBuffer;
+
   int m_iPictureWidth;
   int m_iPictureHeight;
 
@@ -0,0 +1,203 @@
+/*
+ *      Copyright (C) 2005-2013 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "DVDVideoFramePool.h"
+#include "threads/SingleLock.h"
+
+#include <algorithm>
+#include <cstring>
+
+extern "C" {
+#include "libavutil/imgutils.h"
+#include "libavutil/pixdesc.h"
+}
+
+// decoders read past the end of the last plane, same padding as FFmpeg's default allocator
+#define FRAME_PADDING (16 + 64 - 1)
+
+std::shared_ptr<CDVDVideoFramePool> CDVDVideoFramePool::Create()
+{
+  return std::shared_ptr<CDVDVideoFramePool>(new CDVDVideoFramePool());
+}
+
+CDVDVideoFramePool::~CDVDVideoFramePool()
+{
+  // buffers in use hold a reference to the pool, so only free ones are left
+  for (auto buffer : m_free)
+    Free(buffer);
+}
+
+bool CDVDVideoFramePool::IsSupported(AVPixelFormat format)
+{
+  const AVPixFmtDescriptor *desc = av_pix_fmt_desc_get(format);
+  if (!desc)
+    return false;
+
+  return !(desc->flags & (AV_PIX_FMT_FLAG_HWACCEL | AV_PIX_FMT_FLAG_PAL |
+                          AV_PIX_FMT_FLAG_PSEUDOPAL | AV_PIX_FMT_FLAG_BITSTREAM));
+}
+
+int CDVDVideoFramePool::GetBuffer(AVCodecContext *avctx, AVFrame *frame, int flags)
+{
+  AVPixelFormat format = (AVPixelFormat)frame->format;
+  if (!IsSupported(format) || !(avctx->codec->capabilities & CODEC_CAP_DR1))
+    return avcodec_default_get_buffer2(avctx, frame, flags);
+
+  int width = frame->width;
+  int height = frame->height;
+  int linesizeAlign[AV_NUM_DATA_POINTERS];
+  avcodec_align_dimensions2(avctx, &width, &height, linesizeAlign);
+
+  // widen the picture until every line is aligned, like FFmpeg's own pool does
+  int linesize[4];
+  int unaligned;
+  do
+  {
+    int ret = av_image_fill_linesizes(linesize, format, width);
+    if (ret < 0)
+      return ret;
+    width += width & ~(width - 1);
+
+    unaligned = 0;
+    for (int i = 0; i < 4; i++)
+      unaligned |= linesize[i] % linesizeAlign[i];
+  } while (unaligned);
+
+  uint8_t *data[4];
+  int size = av_image_fill_pointers(data, format, height, NULL, linesize);
+  if (size < 0)
+    return size;
+  size += FRAME_PADDING;
+
+  SBuffer *buffer = Get(size);
+  if (!buffer)
+    return AVERROR(ENOMEM);
+
+  memset(frame->data, 0, sizeof(frame->data));
+  memset(frame->linesize, 0, sizeof(frame->linesize));
+  memset(frame->buf, 0, sizeof(frame->buf));
+
+  frame->buf[0] = av_buffer_create(buffer->data, size, FreeBuffer, buffer, 0);
+  if (!frame->buf[0])
+  {
+    FreeBuffer(buffer, buffer->data);
+    return AVERROR(ENOMEM);
+  }
+
+  av_image_fill_pointers(frame->data, format, height, buffer->data, linesize);
+  for (int i = 0; i < 4; i++)
+    frame->linesize[i] = linesize[i];
+  frame->extended_data = frame->data;
+
+  return 0;
+}
+
+CDVDVideoPoolBuffer* CDVDVideoFramePool::Reference(const AVFrame *frame)
+{
+  if (!frame->buf[0] || frame->buf[1])
+    return NULL;
+
+  // only compared, buffers of other allocators carry their own opaque
+  SBuffer *buffer = (SBuffer*)av_buffer_get_opaque(frame->buf[0]);
+  {
+    CSingleLock lock(m_section);
+    if (m_used.find(buffer) == m_used.end())
+      return NULL;
+  }
+
+  AVBufferRef *ref = av_buffer_ref(frame->buf[0]);
+  if (!ref)
+    return NULL;
+
+  return new CDVDVideoPoolBuffer(ref);
+}
+
+void CDVDVideoFramePool::GetStats(SStats &stats)
+{
+  CSingleLock lock(m_section);
+  stats = m_stats;
+}
+
+CDVDVideoFramePool::SBuffer* CDVDVideoFramePool::Get(size_t size)
+{
+  CSingleLock lock(m_section);
+
+  // the frame layout changed, buffers still in use are freed when they come back
+  if (size != m_size)
+  {
+    for (auto buffer : m_free)
+      Free(buffer);
+    m_free.clear();
+    m_size = size;
+  }
+
+  SBuffer *buffer;
+  if (!m_free.empty())
+  {
+    buffer = m_free.back();
+    m_free.pop_back();
+  }
+  else
+  {
+    uint8_t *data = (uint8_t*)av_malloc(size);
+    if (!data)
+      return NULL;
+
+    buffer = new SBuffer;
+    buffer->data = data;
+    buffer->size = size;
+
+    m_stats.allocations++;
+    m_stats.bytes += size;
+    m_stats.peakBytes = std::max(m_stats.peakBytes, m_stats.bytes);
+  }
+
+  m_stats.requests++;
+  m_used.insert(buffer);
+  buffer->pool = shared_from_this();
+  return buffer;
+}
+
+void CDVDVideoFramePool::Return(SBuffer *buffer)
+{
+  CSingleLock lock(m_section);
+
+  m_used.erase(buffer);
+  if (buffer->size == m_size)
+    m_free.push_back(buffer);
+  else
+    Free(buffer);
+}
+
+void CDVDVideoFramePool::Free(SBuffer *buffer)
+{
+  m_stats.bytes -= buffer->size;
+  av_free(buffer->data);
+  delete buffer;
+}
+
+void CDVDVideoFramePool::FreeBuffer(void *opaque, uint8_t *data)
+{
+  SBuffer *buffer = (SBuffer*)opaque;
+
+  // the last buffer may hold the last reference to the pool, release it once the buffer is back
+  std::shared_ptr<CDVDVideoFramePool> pool = std::move(buffer->pool);
+  pool->Return(buffer);
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+/*
+ *      Copyright (C) 2005-2013 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cores/VideoPlayer/DVDResource.h"
+#include "threads/CriticalSection.h"
+
+#include <memory>
+#include <set>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+extern "C" {
+#include "libavcodec/avcodec.h"
+}
+
+/*!
+ \brief A reference to a decoded picture held in a CDVDVideoFramePool buffer.
+
+ The planes of the picture stay valid as long as the reference is held, so a renderer
+ can upload them directly instead of copying them into its own buffers first.
+ */
+class CDVDVideoPoolBuffer : public IDVDResourceCounted<CDVDVideoPoolBuffer>
+{
+public:
+  //! takes over the given buffer reference
+  explicit CDVDVideoPoolBuffer(AVBufferRef *buffer) : m_buffer(buffer) {}
+  virtual ~CDVDVideoPoolBuffer() { av_buffer_unref(&m_buffer); }
+
+private:
+  AVBufferRef *m_buffer;
+};
+
+/*!
+ \brief Reference counted pool of frame buffers for FFmpeg's get_buffer2 callback.
+
+ Buffers are recycled once the decoder and every CDVDVideoPoolBuffer referencing them
+ let go of them, so steady state playback does not allocate frame memory. Buffers that
+ are still referenced keep the pool alive after the decoder is closed.
+ */
+class CDVDVideoFramePool : public std::enable_shared_from_this<CDVDVideoFramePool>
+{
+public:
+  struct SStats
+  {
+    unsigned int requests = 0;    // buffers handed to the decoder
+    unsigned int allocations = 0; // buffers that had to be allocated
+    size_t bytes = 0;             // memory held by the pool, in use or free
+    size_t peakBytes = 0;
+  };
+
+  static std::shared_ptr<CDVDVideoFramePool> Create();
+  ~CDVDVideoFramePool();
+
+  /*!
+   \brief Whether frames of the given format can be allocated from the pool.
+   Hardware and palette formats are left to FFmpeg.
+   */
+  static bool IsSupported(AVPixelFormat format);
+
+  /*!
+   \brief get_buffer2 implementation, falls back to avcodec_default_get_buffer2 for unsupported formats.
+   */
+  int GetBuffer(AVCodecContext *avctx, AVFrame *frame, int flags);
+
+  /*!
+   \brief Returns a new reference to the planes of frame, or NULL if they were not allocated by this pool.
+   */
+  CDVDVideoPoolBuffer* Reference(const AVFrame *frame);
+
+  void GetStats(SStats &stats);
+
+private:
+  struct SBuffer
+  {
+    uint8_t *data;
+    size_t size;
+    std::shared_ptr<CDVDVideoFramePool> pool; // set while the buffer is handed out
+  };
+
+  CDVDVideoFramePool() = default;
+  CDVDVideoFramePool(const CDVDVideoFramePool&) = delete;
+  CDVDVideoFramePool& operator=(const CDVDVideoFramePool&) = delete;
+
+  SBuffer* Get(size_t size);
+  void Return(SBuffer *buffer);
+  void Free(SBuffer *buffer);
+  static void FreeBuffer(void *opaque, uint8_t *data);
+
+  CCriticalSection m_section;
+  std::vector<SBuffer*> m_free;
+  std::set<SBuffer*> m_used;
+  size_t m_size = 0; // size of the buffers of the current frame layout
+  SStats m_stats;
+};
@@ -19,6 +19,18 @@
  */
 
 #include "DVDDemux.h"
+#include "DVDDemuxUtils.h"
+
+CDVDDemux::CDVDDemux()
+  : m_demuxerId(NewGuid())
+{
+  CDVDDemuxUtils::AddPoolUser();
+}
+
+CDVDDemux::~CDVDDemux()
+{
+  CDVDDemuxUtils::RemovePoolUser();
+}
 
 std::string CDemuxStreamAudio::GetStreamType()
 {
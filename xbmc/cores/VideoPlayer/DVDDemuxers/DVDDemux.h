@@ -230,8 +230,8 @@ class CDVDDemux
 {
 public:
 
-  CDVDDemux() : m_demuxerId(NewGuid()) {}
-  virtual ~CDVDDemux() {}
+  CDVDDemux();
+  virtual ~CDVDDemux();
 
 
   /*
@@ -20,6 +20,7 @@
 
 #include "DVDDemuxFFmpeg.h"
 
+#include <inttypes.h>
 #include <sstream>
 #include <utility>
 
@@ -271,6 +272,11 @@ bool CDVDDemuxFFmpeg::Open(CDVDInputStream* pInput, bool streaminfo, bool filein
     if(m_pInput->Seek(0, SEEK_POSSIBLE) == 0)
       m_ioContext->seekable = 0;
 
+    // reads from a mapped file are a copy without a syscall, let packets be read
+    // straight from the mapping instead of copying them through the avio buffer
+    if (m_pInput->IsMemoryMapped())
+      m_ioContext->direct = 1;
+
     std::string content = m_pInput->GetContent();
     StringUtils::ToLower(content);
     if (StringUtils::StartsWith(content, "audio/l16"))
@@ -554,6 +560,11 @@ void CDVDDemuxFFmpeg::Dispose()
 
   if (m_pFormatContext)
   {
+    DemuxPacketPoolStats stats;
+    CDVDDemuxUtils::GetPoolStats(stats);
+    CLog::Log(LOGDEBUG, "CDVDDemuxFFmpeg::Dispose - packet pool: %" PRIu64" packets, %" PRIu64" reused buffers, %" PRIu64" adopted, %" PRIu64" bytes copied",
+              stats.allocated, stats.poolHits, stats.adopted, stats.copiedBytes);
+
     for (unsigned int i = 0; i < m_pFormatContext->nb_streams; i++)
     {
       avcodec_close(m_pFormatContext->streams[i]->codec);
@@ -565,6 +576,9 @@ void CDVDDemuxFFmpeg::Dispose()
       m_ioContext = m_pFormatContext->pb;
     }
     avformat_close_input(&m_pFormatContext);
+
+    // don't keep the buffers of a high bitrate stream around for whatever comes next
+    CDVDDemuxUtils::TrimPool();
   }
 
   if(m_ioContext)
@@ -957,17 +971,9 @@ DemuxPacket* CDVDDemuxFFmpeg::Read()
           m_pkt.pkt.pts = AV_NOPTS_VALUE;
         }
 
-        // copy contents into our own packet
+        // the payload is handed over below, once the timestamps were read
         pPacket->iSize = m_pkt.pkt.size;
 
-        if (m_pkt.pkt.data)
-        {
-          pPacket->pData = m_pkt.pkt.data;
-          // so we can free AVPacket when DemuxPacket is freed
-          pPacket->pkt = new AVPacket(m_pkt.pkt);
-        }
-
-
         pPacket->pts = ConvertTimestamp(m_pkt.pkt.pts, stream->time_base.den, stream->time_base.num);
         pPacket->dts = ConvertTimestamp(m_pkt.pkt.dts, stream->time_base.den, stream->time_base.num);
         pPacket->duration =  DVD_SEC_TO_TIME((double)m_pkt.pkt.duration * stream->time_base.num / stream->time_base.den);
@@ -1020,8 +1026,9 @@ DemuxPacket* CDVDDemuxFFmpeg::Read()
         pPacket->iStreamId = m_pkt.pkt.stream_index;
       }
       m_pkt.result = -1;
-      if (pPacket && pPacket->pkt)
-        memset(&m_pkt.pkt, 0, sizeof(AVPacket));
+      // the packet takes over the AVPacket reference instead of copying the payload
+      if (pPacket && m_pkt.pkt.data)
+        CDVDDemuxUtils::AdoptAVPacket(pPacket, &m_pkt.pkt);
       else
         av_packet_unref(&m_pkt.pkt);
     }
@@ -23,9 +23,13 @@
 #endif
 #include "DVDDemuxUtils.h"
 #include "DVDClock.h"
+#include "threads/CriticalSection.h"
+#include "threads/SingleLock.h"
 #include "utils/log.h"
 #include "system.h"
 
+#include <vector>
+
 #ifdef TARGET_POSIX
 #include "linux/XMemUtils.h"
 #endif
@@ -34,18 +38,206 @@ extern "C" {
 #include "libavcodec/avcodec.h"
 }
 
+// data buffers are pooled in power of two size classes from 1KB to 4MB, larger ones are allocated directly
+#define PACKET_POOL_MIN_SHIFT     10
+#define PACKET_POOL_MAX_SHIFT     22
+#define PACKET_POOL_CLASSES       (PACKET_POOL_MAX_SHIFT - PACKET_POOL_MIN_SHIFT + 1)
+// free buffers kept per size class, and in bytes over all size classes
+#define PACKET_POOL_MAX_BUFFERS   64
+#define PACKET_POOL_MAX_BYTES     (8 * 1024 * 1024)
+#define PACKET_POOL_MAX_ENTRIES   256
+
+namespace
+{
+
+// what AllocateDemuxPacket really hands out, the DemuxPacket must stay the first member
+struct DemuxPacketEntry
+{
+  DemuxPacket packet;
+  AVPacket avpkt;    // adopted AVPacket, packet.pkt points here
+  uint8_t* buffer;   // data buffer, owned by the entry until the packet is freed
+  int sizeClass;     // size class of buffer or -1 if it isn't pooled
+};
+
+class CDemuxPacketPool
+{
+public:
+  CDemuxPacketPool()
+    : m_users(0),
+      m_pooledBytes(0)
+  {
+    memset(&m_stats, 0, sizeof(m_stats));
+  }
+
+  void AddUser()
+  {
+    CSingleLock lock(m_section);
+    m_users++;
+  }
+
+  void RemoveUser()
+  {
+    {
+      CSingleLock lock(m_section);
+      m_users--;
+    }
+    Trim();
+  }
+
+  // frees all pooled buffers and entries, packets still in use are pooled again once freed
+  void Trim()
+  {
+    std::vector<DemuxPacketEntry*> entries;
+    std::vector<uint8_t*> buffers;
+    {
+      CSingleLock lock(m_section);
+      entries.swap(m_entries);
+      for (int i = 0; i < PACKET_POOL_CLASSES; i++)
+      {
+        buffers.insert(buffers.end(), m_buffers[i].begin(), m_buffers[i].end());
+        std::vector<uint8_t*>().swap(m_buffers[i]);
+      }
+      m_pooledBytes = 0;
+    }
+
+    for (std::vector<DemuxPacketEntry*>::iterator it = entries.begin(); it != entries.end(); ++it)
+      delete *it;
+    for (std::vector<uint8_t*>::iterator it = buffers.begin(); it != buffers.end(); ++it)
+      _aligned_free(*it);
+  }
+
+  DemuxPacketEntry* GetEntry()
+  {
+    DemuxPacketEntry* entry = NULL;
+    {
+      CSingleLock lock(m_section);
+      m_stats.allocated++;
+      if (!m_entries.empty())
+      {
+        entry = m_entries.back();
+        m_entries.pop_back();
+      }
+    }
+    if (!entry)
+      entry = new DemuxPacketEntry;
+
+    memset(entry, 0, sizeof(DemuxPacketEntry));
+    entry->sizeClass = -1;
+    return entry;
+  }
+
+  void ReleaseEntry(DemuxPacketEntry* entry)
+  {
+    {
+      CSingleLock lock(m_section);
+      if (m_users > 0 && m_entries.size() < PACKET_POOL_MAX_ENTRIES)
+      {
+        m_entries.push_back(entry);
+        return;
+      }
+    }
+    delete entry;
+  }
+
+  static int GetSizeClass(int iDataSize)
+  {
+    int sizeClass = 0;
+    while ((1 << (sizeClass + PACKET_POOL_MIN_SHIFT)) < iDataSize)
+      sizeClass++;
+    return sizeClass < PACKET_POOL_CLASSES ? sizeClass : -1;
+  }
+
+  uint8_t* GetBuffer(int sizeClass)
+  {
+    {
+      CSingleLock lock(m_section);
+      std::vector<uint8_t*> &buffers = m_buffers[sizeClass];
+      if (!buffers.empty())
+      {
+        uint8_t* buffer = buffers.back();
+        buffers.pop_back();
+        m_pooledBytes -= GetBufferSize(sizeClass);
+        m_stats.poolHits++;
+        return buffer;
+      }
+    }
+    return (uint8_t*)_aligned_malloc(GetBufferSize(sizeClass) + FF_INPUT_BUFFER_PADDING_SIZE, 16);
+  }
+
+  void ReleaseBuffer(uint8_t* buffer, int sizeClass)
+  {
+    {
+      CSingleLock lock(m_section);
+      std::vector<uint8_t*> &buffers = m_buffers[sizeClass];
+      size_t size = GetBufferSize(sizeClass);
+      if (m_users > 0 && buffers.size() < PACKET_POOL_MAX_BUFFERS && m_pooledBytes + size <= PACKET_POOL_MAX_BYTES)
+      {
+        buffers.push_back(buffer);
+        m_pooledBytes += size;
+        return;
+      }
+    }
+    _aligned_free(buffer);
+  }
+
+  void CountAdopted(uint64_t copiedBytes)
+  {
+    CSingleLock lock(m_section);
+    m_stats.adopted++;
+    m_stats.copiedBytes += copiedBytes;
+  }
+
+  void GetStats(DemuxPacketPoolStats &stats)
+  {
+    CSingleLock lock(m_section);
+    stats = m_stats;
+  }
+
+private:
+  static size_t GetBufferSize(int sizeClass)
+  {
+    return (size_t)1 << (sizeClass + PACKET_POOL_MIN_SHIFT);
+  }
+
+  CCriticalSection m_section;
+  int m_users;            // demuxers alive, nothing is pooled without one
+  size_t m_pooledBytes;   // size of the buffers in m_buffers
+  std::vector<DemuxPacketEntry*> m_entries;
+  std::vector<uint8_t*> m_buffers[PACKET_POOL_CLASSES];
+  DemuxPacketPoolStats m_stats;
+};
+
+// never destroyed, packets may still be freed during shutdown
+CDemuxPacketPool& GetPool()
+{
+  static CDemuxPacketPool* pool = new CDemuxPacketPool;
+  return *pool;
+}
+
+}
+
 void CDVDDemuxUtils::FreeDemuxPacket(DemuxPacket* pPacket)
 {
   if (pPacket)
   {
     try {
-      if (pPacket->pkt)
+      DemuxPacketEntry* entry = reinterpret_cast<DemuxPacketEntry*>(pPacket);
+      if (pPacket->pkt == &entry->avpkt)
+        av_packet_unref(&entry->avpkt);
+      else if (pPacket->pkt)
       {
-        av_free_packet(pPacket->pkt);
+        av_packet_unref(pPacket->pkt);
         delete pPacket->pkt;
       }
-      else if (pPacket->pData) _aligned_free(pPacket->pData);
-      delete pPacket;
+
+      if (entry->buffer)
+      {
+        if (entry->sizeClass >= 0)
+          GetPool().ReleaseBuffer(entry->buffer, entry->sizeClass);
+        else
+          _aligned_free(entry->buffer);
+      }
+      GetPool().ReleaseEntry(entry);
     }
     catch(...) {
       CLog::Log(LOGERROR, "%s - Exception thrown while freeing packet", __FUNCTION__);
@@ -55,13 +247,11 @@ void CDVDDemuxUtils::FreeDemuxPacket(DemuxPacket* pPacket)
 
 DemuxPacket* CDVDDemuxUtils::AllocateDemuxPacket(int iDataSize)
 {
-  DemuxPacket* pPacket = new DemuxPacket;
-  if (!pPacket) return NULL;
+  DemuxPacketEntry* entry = GetPool().GetEntry();
+  DemuxPacket* pPacket = &entry->packet;
 
   try
   {
-    memset(pPacket, 0, sizeof(DemuxPacket));
-
     if (iDataSize > 0)
     {
       // need to allocate a few bytes more.
@@ -73,7 +263,13 @@ DemuxPacket* CDVDDemuxUtils::AllocateDemuxPacket(int iDataSize)
         * Note, if the first 23 bits of the additional bytes are not 0 then damaged
         * MPEG bitstreams could cause overread and segfault
         */
-      pPacket->pData =(uint8_t*)_aligned_malloc(iDataSize + FF_INPUT_BUFFER_PADDING_SIZE, 16);
+      entry->sizeClass = CDemuxPacketPool::GetSizeClass(iDataSize);
+      if (entry->sizeClass >= 0)
+        entry->buffer = GetPool().GetBuffer(entry->sizeClass);
+      else
+        entry->buffer = (uint8_t*)_aligned_malloc(iDataSize + FF_INPUT_BUFFER_PADDING_SIZE, 16);
+
+      pPacket->pData = entry->buffer;
       if (!pPacket->pData)
       {
         FreeDemuxPacket(pPacket);
@@ -98,3 +294,53 @@ DemuxPacket* CDVDDemuxUtils::AllocateDemuxPacket(int iDataSize)
   }
   return pPacket;
 }
+
+void CDVDDemuxUtils::AdoptAVPacket(DemuxPacket* pPacket, AVPacket* avpkt)
+{
+  DemuxPacketEntry* entry = reinterpret_cast<DemuxPacketEntry*>(pPacket);
+  uint64_t copiedBytes = 0;
+
+  if (avpkt->buf)
+  {
+    // reference counted, take over the reference
+    av_packet_move_ref(&entry->avpkt, avpkt);
+  }
+  else
+  {
+    // the payload is owned by the demuxer, av_packet_ref copies it into a padded buffer
+    if (av_packet_ref(&entry->avpkt, avpkt) < 0)
+    {
+      CLog::Log(LOGERROR, "%s - failed to reference packet", __FUNCTION__);
+      av_packet_unref(avpkt);
+      pPacket->iSize = 0;
+      return;
+    }
+    copiedBytes = avpkt->size;
+    av_packet_unref(avpkt);
+  }
+
+  pPacket->pData = entry->avpkt.data;
+  pPacket->iSize = entry->avpkt.size;
+  pPacket->pkt = &entry->avpkt;
+  GetPool().CountAdopted(copiedBytes);
+}
+
+void CDVDDemuxUtils::GetPoolStats(DemuxPacketPoolStats &stats)
+{
+  GetPool().GetStats(stats);
+}
+
+void CDVDDemuxUtils::AddPoolUser()
+{
+  GetPool().AddUser();
+}
+
+void CDVDDemuxUtils::RemovePoolUser()
+{
+  GetPool().RemoveUser();
+}
+
+void CDVDDemuxUtils::TrimPool()
+{
+  GetPool().Trim();
+}
@@ -22,10 +22,37 @@
 
 #include "DVDDemuxPacket.h"
 
+#include <stdint.h>
+
+struct AVPacket;
+
+/*! \brief Counters of the demux packet pool, see CDVDDemuxUtils::GetPoolStats() */
+struct DemuxPacketPoolStats
+{
+  uint64_t allocated;   //!< packets handed out
+  uint64_t poolHits;    //!< packets that reused a pooled data buffer
+  uint64_t adopted;     //!< AVPackets taken over by reference
+  uint64_t copiedBytes; //!< payload bytes copied because an AVPacket was not reference counted
+};
+
 class CDVDDemuxUtils
 {
 public:
   static void FreeDemuxPacket(DemuxPacket* pPacket);
   static DemuxPacket* AllocateDemuxPacket(int iDataSize = 0);
+  /*! \brief Hand the payload of an AVPacket over to a packet from AllocateDemuxPacket(0)
+   The reference of a reference counted AVPacket is moved, so the payload is not copied.
+   \param pPacket packet without data
+   \param avpkt the AVPacket, blank afterwards
+   */
+  static void AdoptAVPacket(DemuxPacket* pPacket, AVPacket* avpkt);
+  static void GetPoolStats(DemuxPacketPoolStats &stats);
+  /*! \brief Packet buffers are only pooled while there is a user, the last one leaving trims the pool
+   Every demuxer is a user for its lifetime.
+   */
+  static void AddPoolUser();
+  static void RemovePoolUser();
+  /*! \brief Free the pooled buffers, e.g. once a demuxer is done with a stream */
+  static void TrimPool();
 };
 
@@ -167,6 +167,11 @@ public:
    */
   virtual bool GetCacheStatus(XFILE::SCacheStatus *status) { return false; }
 
+  /*! \brief Whether the stream reads from a memory mapped file
+   Reads don't need a syscall then, so they don't need to be buffered
+   */
+  virtual bool IsMemoryMapped() { return false; }
+
   bool IsStreamType(DVDStreamType type) const { return m_streamType == type; }
   virtual bool IsEOF() = 0;
   virtual BitstreamStats GetBitstreamStats() const { return m_stats; }
@@ -78,8 +78,13 @@ bool CDVDInputStreamFile::Open()
   }
 
   if (!(flags & READ_CACHED))
+  {
     flags |= READ_NO_CACHE; // Make sure CFile honors our no-cache hint
 
+    if (g_advancedSettings.m_cacheMemoryMapping)
+      flags |= READ_MAPPED;
+  }
+
   std::string content = m_item.GetMimeType();
 
   if (content == "video/mp4" ||
@@ -175,6 +180,11 @@ BitstreamStats CDVDInputStreamFile::GetBitstreamStats() const
     return m_stats;
 }
 
+bool CDVDInputStreamFile::IsMemoryMapped()
+{
+  return m_pFile && m_pFile->IoControl(IOCTRL_MAPPED_DATA, NULL) == 0;
+}
+
 int CDVDInputStreamFile::GetBlockSize()
 {
   if(m_pFile)
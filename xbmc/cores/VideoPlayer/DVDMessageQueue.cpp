@@ -35,6 +35,11 @@ CDVDMessageQueue::CDVDMessageQueue(const std::string &owner) : m_hEvent(true), m
   m_TimeFront = DVD_NOPTS_VALUE;
   m_TimeSize = 1.0 / 4.0; /* 4 seconds */
   m_iMaxDataSize = 0;
+  m_drain = false;
+
+  m_ringProducer.clear();
+  m_sequence = 0;
+  m_bWaiting = false;
 }
 
 CDVDMessageQueue::~CDVDMessageQueue()
@@ -57,8 +62,12 @@ void CDVDMessageQueue::Flush(CDVDMsg::Message type)
 {
   CSingleLock lock(m_section);
 
-  m_messages.remove_if([type](const DVDMessageListItem &item){
-    return type == CDVDMsg::NONE || item.message->IsType(type);
+  m_messages.remove_if([this, type](const DVDMessageListItem &item){
+    if (type != CDVDMsg::NONE && !item.message->IsType(type))
+      return false;
+    if (item.message->IsType(CDVDMsg::DEMUXER_PACKET))
+      RemovePacketInfo(item.message);
+    return true;
   });
 
   m_prioMessages.remove_if([type](const DVDMessageListItem &item){
@@ -67,7 +76,10 @@ void CDVDMessageQueue::Flush(CDVDMsg::Message type)
 
   if (type == CDVDMsg::DEMUXER_PACKET ||  type == CDVDMsg::NONE)
   {
-    m_iDataSize = 0;
+    // the ring only holds demuxer packets
+    ClearRing();
+
+    // packets that are put concurrently were already accounted, so m_iDataSize isn't simply reset
     m_TimeBack = DVD_NOPTS_VALUE;
     m_TimeFront = DVD_NOPTS_VALUE;
   }
@@ -94,8 +106,71 @@ void CDVDMessageQueue::End()
   m_bAbortRequest = false;
 }
 
+void CDVDMessageQueue::AddPacketInfo(CDVDMsg* pMsg)
+{
+  DemuxPacket* packet = ((CDVDMsgDemuxerPacket*)pMsg)->GetPacket();
+  if (packet)
+  {
+    m_iDataSize += packet->iSize;
+    if (packet->dts != DVD_NOPTS_VALUE)
+      m_TimeFront = packet->dts;
+    else if (packet->pts != DVD_NOPTS_VALUE)
+      m_TimeFront = packet->pts;
+
+    double back = DVD_NOPTS_VALUE;
+    m_TimeBack.compare_exchange_strong(back, m_TimeFront.load());
+  }
+}
+
+void CDVDMessageQueue::RemovePacketInfo(CDVDMsg* pMsg)
+{
+  DemuxPacket* packet = ((CDVDMsgDemuxerPacket*)pMsg)->GetPacket();
+  if (packet)
+  {
+    m_iDataSize -= packet->iSize;
+    if (packet->dts != DVD_NOPTS_VALUE)
+      m_TimeBack = packet->dts;
+    else if (packet->pts != DVD_NOPTS_VALUE)
+      m_TimeBack = packet->pts;
+  }
+}
+
+void CDVDMessageQueue::ClearRing()
+{
+  const CDVDMessageRing::Entry* entry;
+  while ((entry = m_ring.Front()))
+  {
+    RemovePacketInfo(entry->message);
+    entry->message->Release();
+    m_ring.Pop();
+  }
+}
+
 MsgQueueReturnCode CDVDMessageQueue::Put(CDVDMsg* pMsg, int priority, bool front)
 {
+  bool bAccounted = false;
+
+  // demuxer packets in normal order go through the ring, unless another thread is putting packets right now
+  if (pMsg && priority == 0 && front && m_bInitialized && pMsg->IsType(CDVDMsg::DEMUXER_PACKET) &&
+      !m_ringProducer.test_and_set(std::memory_order_acquire))
+  {
+    // account before the packet becomes visible, so that the consumer never subtracts first
+    AddPacketInfo(pMsg);
+    bAccounted = true;
+    bool bPushed = m_ring.Push(pMsg, ++m_sequence);
+    m_ringProducer.clear(std::memory_order_release);
+
+    if (bPushed)
+    {
+      // inform waiter for new packet
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (m_bWaiting)
+        m_hEvent.Set();
+      return MSGQ_OK;
+    }
+    // ring is full, continue with the list
+  }
+
   CSingleLock lock(m_section);
 
   if (!m_bInitialized)
@@ -124,27 +199,15 @@ MsgQueueReturnCode CDVDMessageQueue::Put(CDVDMsg* pMsg, int priority, bool front
   }
   else
   {
+    // messages put to the back jump the queue, sequence 0 sorts them before anything in the ring
     if (front)
-      m_messages.emplace_front(pMsg, priority);
+      m_messages.emplace_front(pMsg, priority, ++m_sequence);
     else
       m_messages.emplace_back(pMsg, priority);
   }
 
-  if (pMsg->IsType(CDVDMsg::DEMUXER_PACKET) && priority == 0)
-  {
-    DemuxPacket* packet = ((CDVDMsgDemuxerPacket*)pMsg)->GetPacket();
-    if (packet)
-    {
-      m_iDataSize += packet->iSize;
-      if (packet->dts != DVD_NOPTS_VALUE)
-        m_TimeFront = packet->dts;
-      else if (packet->pts != DVD_NOPTS_VALUE)
-        m_TimeFront = packet->pts;
-
-      if (m_TimeBack == DVD_NOPTS_VALUE)
-        m_TimeBack = m_TimeFront;
-    }
-  }
+  if (pMsg->IsType(CDVDMsg::DEMUXER_PACKET) && priority == 0 && !bAccounted)
+    AddPacketInfo(pMsg);
 
   pMsg->Release();
 
@@ -170,25 +233,28 @@ MsgQueueReturnCode CDVDMessageQueue::Get(CDVDMsg** pMsg, unsigned int iTimeoutIn
 
   while (!m_bAbortRequest)
   {
-    std::list<DVDMessageListItem> &msgs = (priority > 0 || !m_prioMessages.empty()) ? m_prioMessages : m_messages;
+    bool bPrio = (priority > 0 || !m_prioMessages.empty());
+    std::list<DVDMessageListItem> &msgs = bPrio ? m_prioMessages : m_messages;
 
-    if (!msgs.empty() && (msgs.back().priority >= priority || m_drain))
+    // the ring holds normal demuxer packets, take it if it is older than the oldest normal message
+    const CDVDMessageRing::Entry* entry = bPrio ? NULL : m_ring.Front();
+    if (entry && (msgs.empty() || entry->sequence < msgs.back().sequence))
+    {
+      priority = 0;
+      RemovePacketInfo(entry->message);
+      *pMsg = entry->message;
+      m_ring.Pop();
+
+      ret = MSGQ_OK;
+      break;
+    }
+    else if (!msgs.empty() && (msgs.back().priority >= priority || m_drain))
     {
       DVDMessageListItem& item(msgs.back());
       priority = item.priority;
 
       if (item.message->IsType(CDVDMsg::DEMUXER_PACKET) && item.priority == 0)
-      {
-        DemuxPacket* packet = ((CDVDMsgDemuxerPacket*)item.message)->GetPacket();
-        if (packet)
-        {
-          m_iDataSize -= packet->iSize;
-          if (packet->dts != DVD_NOPTS_VALUE)
-            m_TimeBack = packet->dts;
-          else if (packet->pts != DVD_NOPTS_VALUE)
-            m_TimeBack = packet->pts;
-        }
-      }
+        RemovePacketInfo(item.message);
 
       *pMsg = item.message->Acquire();
       msgs.pop_back();
@@ -204,10 +270,20 @@ MsgQueueReturnCode CDVDMessageQueue::Get(CDVDMsg** pMsg, unsigned int iTimeoutIn
     else
     {
       m_hEvent.Reset();
+
+      // packets are put into the ring without the lock, only then the event is set if we are waiting
+      m_bWaiting = true;
+      if (!bPrio && !m_ring.Empty())
+      {
+        m_bWaiting = false;
+        continue;
+      }
       lock.Leave();
 
       // wait for a new message
-      if (!m_hEvent.WaitMSec(iTimeoutInMilliSeconds))
+      bool bSignaled = m_hEvent.WaitMSec(iTimeoutInMilliSeconds);
+      m_bWaiting = false;
+      if (!bSignaled)
         return MSGQ_TIMEOUT;
 
       lock.Enter();
@@ -238,6 +314,8 @@ unsigned CDVDMessageQueue::GetPacketCount(CDVDMsg::Message type)
     if(item.message->IsType(type))
       count++;
   }
+  if (type == CDVDMsg::DEMUXER_PACKET)
+    count += m_ring.Size();
 
   return count;
 }
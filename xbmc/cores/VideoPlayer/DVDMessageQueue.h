@@ -22,6 +22,7 @@
 
 #include "DVDMessage.h"
 #include <atomic>
+#include <stdint.h>
 #include <string>
 #include <list>
 #include <algorithm>
@@ -30,15 +31,17 @@
 
 struct DVDMessageListItem
 {
-  DVDMessageListItem(CDVDMsg* msg, int prio)
+  DVDMessageListItem(CDVDMsg* msg, int prio, uint64_t seq = 0)
   {
     message = msg->Acquire();
     priority = prio;
+    sequence = seq;
   }
   DVDMessageListItem()
   {
     message = NULL;
     priority = 0;
+    sequence = 0;
   }
   DVDMessageListItem(const DVDMessageListItem&) = delete;
  ~DVDMessageListItem()
@@ -51,6 +54,63 @@ struct DVDMessageListItem
 
   CDVDMsg* message;
   int priority;
+  uint64_t sequence; // order of normal messages, see CDVDMessageQueue::Put
+};
+
+/*!
+ * \brief Bounded single producer / single consumer ring for demuxer packets.
+ * Push() must only be called by one thread at a time, Front(), Pop() and Size() by one other thread at a time.
+ */
+class CDVDMessageRing
+{
+public:
+  struct Entry
+  {
+    CDVDMsg* message;
+    uint64_t sequence;
+  };
+
+  CDVDMessageRing() : m_head(0), m_tail(0) {}
+
+  bool Push(CDVDMsg* msg, uint64_t sequence)
+  {
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail - m_head.load(std::memory_order_acquire) == Capacity)
+      return false;
+
+    m_entries[tail % Capacity].message = msg;
+    m_entries[tail % Capacity].sequence = sequence;
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  //! returns NULL if the ring is empty
+  const Entry* Front() const
+  {
+    size_t head = m_head.load(std::memory_order_relaxed);
+    if (head == m_tail.load(std::memory_order_acquire))
+      return NULL;
+    return &m_entries[head % Capacity];
+  }
+
+  void Pop()
+  {
+    m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  size_t Size() const
+  {
+    return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_relaxed);
+  }
+
+  bool Empty() const { return Size() == 0; }
+
+private:
+  static const size_t Capacity = 2048;
+
+  Entry m_entries[Capacity];
+  std::atomic<size_t> m_head;
+  std::atomic<size_t> m_tail;
 };
 
 enum MsgQueueReturnCode
@@ -108,17 +168,20 @@ public:
   bool IsDataBased() const;
 
 private:
+  void AddPacketInfo(CDVDMsg* pMsg);
+  void RemovePacketInfo(CDVDMsg* pMsg);
+  void ClearRing();
 
   CEvent m_hEvent;
   mutable CCriticalSection m_section;
 
   std::atomic<bool> m_bAbortRequest;
-  bool m_bInitialized;
+  std::atomic<bool> m_bInitialized;
   bool m_drain;
 
-  int m_iDataSize;
-  double m_TimeFront;
-  double m_TimeBack;
+  std::atomic<int> m_iDataSize;
+  std::atomic<double> m_TimeFront;
+  std::atomic<double> m_TimeBack;
   double m_TimeSize;
 
   int m_iMaxDataSize;
@@ -126,5 +189,12 @@ private:
 
   std::list<DVDMessageListItem> m_messages;
   std::list<DVDMessageListItem> m_prioMessages;
+
+  // demuxer packets are put into the ring without taking m_section, the consumer side is serialized by m_section.
+  // normal messages are numbered so that the consumer can merge the ring with m_messages in the order they were put.
+  CDVDMessageRing m_ring;
+  std::atomic_flag m_ringProducer;
+  std::atomic<uint64_t> m_sequence;
+  std::atomic<bool> m_bWaiting;
 };
 
@@ -381,3 +381,36 @@ bool CProcessInfo::IsSeeking()
 
   return m_stateSeeking;
 }
+
+// player statistics
+void CProcessInfo::UpdateVideoFrameStats(int output, int dropped)
+{
+  CSingleLock lock(m_statsSection);
+
+  m_videoFramesOutput = output;
+  m_videoFramesDropped = dropped;
+}
+
+void CProcessInfo::GetVideoFrameStats(int &output, int &dropped)
+{
+  CSingleLock lock(m_statsSection);
+
+  output = m_videoFramesOutput;
+  dropped = m_videoFramesDropped;
+}
+
+void CProcessInfo::UpdateVideoBufferStats(int allocations, int64_t peakBytes)
+{
+  CSingleLock lock(m_statsSection);
+
+  m_videoBufferAllocations = allocations;
+  m_videoBufferPeakBytes = peakBytes;
+}
+
+void CProcessInfo::GetVideoBufferStats(int &allocations, int64_t &peakBytes)
+{
+  CSingleLock lock(m_statsSection);
+
+  allocations = m_videoBufferAllocations;
+  peakBytes = m_videoBufferPeakBytes;
+}
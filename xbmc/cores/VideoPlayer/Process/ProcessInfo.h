@@ -23,6 +23,7 @@
 #include "cores/VideoPlayer/VideoRenderers/RenderFormats.h"
 #include "threads/CriticalSection.h"
 #include <list>
+#include <stdint.h>
 #include <string>
 
 class CProcessInfo
@@ -76,6 +77,12 @@ public:
   void SetStateSeeking(bool active);
   bool IsSeeking();
 
+  // player statistics
+  void UpdateVideoFrameStats(int output, int dropped);
+  void GetVideoFrameStats(int &output, int &dropped);
+  void UpdateVideoBufferStats(int allocations, int64_t peakBytes);
+  void GetVideoBufferStats(int &allocations, int64_t &peakBytes);
+
 protected:
   CProcessInfo();
 
@@ -110,4 +117,11 @@ protected:
   // player states
   CCriticalSection m_stateSection;
   bool m_stateSeeking;
+
+  // player statistics
+  CCriticalSection m_statsSection;
+  int m_videoFramesOutput = 0;
+  int m_videoFramesDropped = 0;
+  int m_videoBufferAllocations = 0;
+  int64_t m_videoBufferPeakBytes = 0;
 };
@@ -4702,6 +4702,17 @@ int CVideoPlayer::GetCacheLevel() const
   return (int)(m_State.cache_level * 100);
 }
 
+void CVideoPlayer::GetPipelineStats(SPlayerPipelineStats &stats) const
+{
+  int discard;
+  stats.cache_level = GetCacheLevel();
+  stats.video_level = m_VideoPlayerVideo->GetLevel();
+  stats.audio_level = m_VideoPlayerAudio->GetLevel();
+  m_processInfo->GetRenderBuffers(stats.render_queued, discard, stats.render_free);
+  m_processInfo->GetVideoFrameStats(stats.frames_output, stats.frames_dropped);
+  m_processInfo->GetVideoBufferStats(stats.buffer_allocations, stats.buffer_peak_bytes);
+}
+
 double CVideoPlayer::GetQueueTime()
 {
   int a = m_VideoPlayerAudio->GetLevel();
@@ -286,6 +286,19 @@ public:
   void             Update  (CDVDInputStream* input, CDVDDemux* demuxer, std::string filename2 = "");
 };
 
+struct SPlayerPipelineStats
+{
+  int cache_level = 0;      // level of the input stream cache, in percent
+  int video_level = 0;      // level of the video decoder queue, in percent
+  int audio_level = 0;      // level of the audio decoder queue, in percent
+  int render_queued = 0;    // pictures waiting in the render queue
+  int render_free = 0;      // free render buffers
+  int frames_output = 0;    // pictures handed to the renderer
+  int frames_dropped = 0;   // pictures dropped by decoder or output
+  int buffer_allocations = 0;      // frame buffers allocated by the software decoder
+  int64_t buffer_peak_bytes = 0;   // peak memory of the software decoder frame pool
+};
+
 class CProcessInfo;
 
 class CVideoPlayer : public IPlayer, public CThread, public IVideoPlayer, public IDispResource, public IRenderMsg
@@ -396,6 +409,11 @@ public:
   virtual bool IsCaching() const override;
   virtual int GetCacheLevel() const override;
 
+  /*!
+   \brief Snapshot of the demux -> decode -> render queues, e.g. for benchmarks
+   */
+  void GetPipelineStats(SPlayerPipelineStats &stats) const;
+
   virtual int OnDVDNavResult(void* pData, int iMessage) override;
   void GetVideoResolution(unsigned int &width, unsigned int &height) override;
 
@@ -86,6 +86,7 @@ CVideoPlayerVideo::CVideoPlayerVideo(CDVDClock* pClock
   m_messageQueue.SetMaxTimeSize(8.0);
 
   m_iDroppedFrames = 0;
+  m_iOutputFrames = 0;
   m_fFrameRate = 25;
   m_bCalcFrameRate = false;
   m_fStableFrameRate = 0.0;
@@ -255,6 +256,7 @@ void CVideoPlayerVideo::Process()
   m_videoStats.Start();
   m_droppingStats.Reset();
   m_iDroppedFrames = 0;
+  m_iOutputFrames = 0;
   m_rewindStalled = false;
 
   while (!m_bStop)
@@ -630,6 +632,10 @@ bool CVideoPlayerVideo::ProcessDecoderOutput(int &decoderState, double &frametim
         m_iDroppedFrames++;
         m_pullupCorrection.Flush();
       }
+      else if (!(iResult & EOS_DROPPED))
+        m_iOutputFrames++;
+
+      m_processInfo.UpdateVideoFrameStats(m_iOutputFrames, m_iDroppedFrames);
     }
     else
     {
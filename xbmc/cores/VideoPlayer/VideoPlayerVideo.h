@@ -115,6 +115,7 @@ protected:
   int m_iLateFrames;
   int m_iDroppedFrames;
   int m_iDroppedRequest;
+  int m_iOutputFrames;
 
   double m_fFrameRate;       //framerate of the video currently playing
   bool m_bCalcFrameRate;     //if we should calculate the framerate from the timestamps
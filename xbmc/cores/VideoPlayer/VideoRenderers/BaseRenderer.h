@@ -83,6 +83,11 @@ public:
   virtual void ReleaseImage(int source, bool preserve = false) = 0;
   virtual void AddVideoPictureHW(DVDVideoPicture &picture, int index) {};
   virtual bool IsPictureHW(DVDVideoPicture &picture) { return false; };
+  /*!
+   \brief Keep a reference to the planes of a pooled software picture instead of copying them into the image
+   \return false if the picture has to be copied
+   */
+  virtual bool AddVideoPicturePooled(DVDVideoPicture &picture, int index) { return false; };
   virtual void FlipPage(int source) = 0;
   virtual void PreInit() = 0;
   virtual void UnInit() = 0;
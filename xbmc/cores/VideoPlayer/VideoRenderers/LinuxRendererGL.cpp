@@ -48,6 +48,7 @@
 #include "RenderFormats.h"
 #include "cores/IPlayer.h"
 #include "cores/VideoPlayer/DVDCodecs/DVDCodecUtils.h"
+#include "cores/VideoPlayer/DVDCodecs/Video/DVDVideoFramePool.h"
 #include "cores/FFmpeg.h"
 
 extern "C" {
@@ -112,6 +113,9 @@ CLinuxRendererGL::YUVBUFFER::YUVBUFFER()
   memset(&pbo   , 0, sizeof(pbo));
   flipindex = 0;
   hwDec = NULL;
+  poolBuffer = NULL;
+  memset(&poolPlane, 0, sizeof(poolPlane));
+  memset(&poolStride, 0, sizeof(poolStride));
 }
 
 CLinuxRendererGL::YUVBUFFER::~YUVBUFFER()
@@ -386,6 +390,47 @@ void CLinuxRendererGL::ReleaseImage(int source, bool preserve)
   m_bImageReady = true;
 }
 
+bool CLinuxRendererGL::AddVideoPicturePooled(DVDVideoPicture &picture, int index)
+{
+  // with pixel buffer objects the copy into the mapped buffer replaces the copy in the driver
+  if (m_pboUsed)
+    return false;
+
+  if (m_format != RENDER_FMT_YUV420P &&
+      m_format != RENDER_FMT_YUV420P10 &&
+      m_format != RENDER_FMT_YUV420P16)
+    return false;
+
+  YUVBUFFER &buf = m_buffers[index];
+  if (picture.iWidth != buf.image.width || picture.iHeight != buf.image.height)
+    return false;
+
+  CDVDVideoPoolBuffer *pic = picture.poolBuffer->Acquire();
+  if (buf.poolBuffer)
+    buf.poolBuffer->Release();
+  buf.poolBuffer = pic;
+
+  for (int p = 0; p < MAX_PLANES; p++)
+  {
+    buf.poolPlane[p] = picture.data[p];
+    buf.poolStride[p] = picture.iLineSize[p];
+  }
+  return true;
+}
+
+void CLinuxRendererGL::ReleaseBuffer(int idx)
+{
+  ReleasePoolBuffer(idx);
+}
+
+void CLinuxRendererGL::ReleasePoolBuffer(int index)
+{
+  YUVBUFFER &buf = m_buffers[index];
+  if (buf.poolBuffer)
+    buf.poolBuffer->Release();
+  buf.poolBuffer = NULL;
+}
+
 void CLinuxRendererGL::GetPlaneTextureSize(YUVPLANE& plane)
 {
   /* texture is assumed to be bound */
@@ -1818,6 +1863,14 @@ bool CLinuxRendererGL::UploadYV12Texture(int source)
 
   if (!(im->flags&IMAGE_FLAG_READY))
     return false;
+
+  BYTE*    plane[MAX_PLANES];
+  unsigned stride[MAX_PLANES];
+  for (int p = 0; p < MAX_PLANES; p++)
+  {
+    plane[p]  = buf.poolBuffer ? buf.poolPlane[p]  : im->plane[p];
+    stride[p] = buf.poolBuffer ? buf.poolStride[p] : im->stride[p];
+  }
   bool deinterlacing;
   if (m_currentField == FIELD_FULL)
     deinterlacing = false;
@@ -1834,47 +1887,47 @@ bool CLinuxRendererGL::UploadYV12Texture(int source)
     // Load Even Y Field
     LoadPlane( fields[FIELD_TOP][0] , GL_LUMINANCE, buf.flipindex
              , im->width, im->height >> 1
-             , im->stride[0]*2, im->bpp, im->plane[0] );
+             , stride[0]*2, im->bpp, plane[0] );
 
     //load Odd Y Field
     LoadPlane( fields[FIELD_BOT][0], GL_LUMINANCE, buf.flipindex
              , im->width, im->height >> 1
-             , im->stride[0]*2, im->bpp, im->plane[0] + im->stride[0]) ;
+             , stride[0]*2, im->bpp, plane[0] + stride[0]) ;
 
     // Load Even U & V Fields
     LoadPlane( fields[FIELD_TOP][1], GL_LUMINANCE, buf.flipindex
              , im->width >> im->cshift_x, im->height >> (im->cshift_y + 1)
-             , im->stride[1]*2, im->bpp, im->plane[1] );
+             , stride[1]*2, im->bpp, plane[1] );
 
     LoadPlane( fields[FIELD_TOP][2], GL_ALPHA, buf.flipindex
              , im->width >> im->cshift_x, im->height >> (im->cshift_y + 1)
-             , im->stride[2]*2, im->bpp, im->plane[2] );
+             , stride[2]*2, im->bpp, plane[2] );
 
     // Load Odd U & V Fields
     LoadPlane( fields[FIELD_BOT][1], GL_LUMINANCE, buf.flipindex
              , im->width >> im->cshift_x, im->height >> (im->cshift_y + 1)
-             , im->stride[1]*2, im->bpp, im->plane[1] + im->stride[1] );
+             , stride[1]*2, im->bpp, plane[1] + stride[1] );
 
     LoadPlane( fields[FIELD_BOT][2], GL_ALPHA, buf.flipindex
              , im->width >> im->cshift_x, im->height >> (im->cshift_y + 1)
-             , im->stride[2]*2, im->bpp, im->plane[2] + im->stride[2] );
+             , stride[2]*2, im->bpp, plane[2] + stride[2] );
   }
   else
   {
     //Load Y plane
     LoadPlane( fields[FIELD_FULL][0], GL_LUMINANCE, buf.flipindex
              , im->width, im->height
-             , im->stride[0], im->bpp, im->plane[0] );
+             , stride[0], im->bpp, plane[0] );
 
     //load U plane
     LoadPlane( fields[FIELD_FULL][1], GL_LUMINANCE, buf.flipindex
              , im->width >> im->cshift_x, im->height >> im->cshift_y
-             , im->stride[1], im->bpp, im->plane[1] );
+             , stride[1], im->bpp, plane[1] );
 
     //load V plane
     LoadPlane( fields[FIELD_FULL][2], GL_ALPHA, buf.flipindex
              , im->width >> im->cshift_x, im->height >> im->cshift_y
-             , im->stride[2], im->bpp, im->plane[2] );
+             , stride[2], im->bpp, plane[2] );
   }
 
   VerifyGLState();
@@ -1891,6 +1944,8 @@ void CLinuxRendererGL::DeleteYV12Texture(int index)
   YUVFIELDS &fields = m_buffers[index].fields;
   GLuint    *pbo    = m_buffers[index].pbo;
 
+  ReleasePoolBuffer(index);
+
   if( fields[FIELD_FULL][0].id == 0 ) return;
 
   /* finish up all textures, and delete them */
@@ -39,6 +39,7 @@
 #include "threads/Event.h"
 
 class CRenderCapture;
+class CDVDVideoPoolBuffer;
 
 class CBaseTexture;
 namespace Shaders { class BaseYUV2RGBShader; }
@@ -122,6 +123,8 @@ public:
   virtual bool IsConfigured() { return m_bConfigured; }
   virtual int GetImage(YV12Image *image, int source = AUTOSOURCE, bool readonly = false);
   virtual void ReleaseImage(int source, bool preserve = false);
+  virtual bool AddVideoPicturePooled(DVDVideoPicture &picture, int index);
+  virtual void ReleaseBuffer(int idx);
   virtual void FlipPage(int source);
   virtual void PreInit();
   virtual void UnInit();
@@ -157,6 +160,7 @@ protected:
 
   bool UploadYV12Texture(int index);
   void DeleteYV12Texture(int index);
+  void ReleasePoolBuffer(int index);
   bool CreateYV12Texture(int index);
 
   bool UploadNV12Texture(int index);
@@ -239,6 +243,11 @@ protected:
     GLuint    pbo[MAX_PLANES];
 
     void *hwDec;
+
+    // planes of a decoded picture that are uploaded instead of image
+    CDVDVideoPoolBuffer *poolBuffer;
+    BYTE     *poolPlane[MAX_PLANES];
+    unsigned  poolStride[MAX_PLANES];
   };
 
   typedef YUVBUFFER          YUVBUFFERS[NUM_BUFFERS];
@@ -74,6 +74,7 @@
 #endif
 
 #include "RenderCapture.h"
+#include "RendererNull.h"
 
 /* to use the same as player */
 #include "../VideoPlayer/DVDClock.h"
@@ -125,6 +126,7 @@ void CRenderManager::CClockSync::Reset()
 }
 
 unsigned int CRenderManager::m_nextCaptureId = 0;
+bool CRenderManager::m_bHeadless = false;
 
 CRenderManager::CRenderManager(CDVDClock &clock, IRenderMsg *player) :
   m_pRenderer(nullptr),
@@ -522,7 +524,11 @@ void CRenderManager::CreateRenderer()
 {
   if (!m_pRenderer)
   {
-    if (m_format == RENDER_FMT_VAAPI || m_format == RENDER_FMT_VAAPINV12)
+    if (m_bHeadless)
+    {
+      m_pRenderer = new CRendererNull;
+    }
+    else if (m_format == RENDER_FMT_VAAPI || m_format == RENDER_FMT_VAAPINV12)
     {
 #if defined(HAVE_LIBVA)
       m_pRenderer = new CRendererVAAPI;
@@ -1156,7 +1162,8 @@ int CRenderManager::AddVideoPicture(DVDVideoPicture& pic)
        || pic.format == RENDER_FMT_YUV420P10
        || pic.format == RENDER_FMT_YUV420P16)
   {
-    CDVDCodecUtils::CopyPicture(&image, &pic);
+    if (!pic.poolBuffer || !m_pRenderer->AddVideoPicturePooled(pic, index))
+      CDVDCodecUtils::CopyPicture(&image, &pic);
   }
   else if(pic.format == RENDER_FMT_NV12)
   {
@@ -86,6 +86,13 @@ public:
   bool IsConfigured() const;
   void ToggleDebug();
 
+  /**
+   * Headless render managers use CRendererNull, pictures are queued and presented
+   * but never drawn. Used to run a player without a display, has to be set before PreInit.
+   */
+  static void SetHeadless(bool headless) { m_bHeadless = headless; }
+  static bool IsHeadless() { return m_bHeadless; }
+
   unsigned int AllocRenderCapture();
   void ReleaseRenderCapture(unsigned int captureId);
   void StartRenderCapture(unsigned int captureId, unsigned int width, unsigned int height, int flags);
@@ -265,6 +272,7 @@ protected:
   CCriticalSection m_captCritSect;
   std::map<unsigned int, CRenderCapture*> m_captures;
   static unsigned int m_nextCaptureId;
+  static bool m_bHeadless;
   unsigned int m_captureWaitCounter;
   //set to true when adding something to m_captures, set to false when m_captures is made empty
   //std::list::empty() isn't thread safe, using an extra bool will save a lock per render when no captures are requested
@@ -0,0 +1,156 @@
+/*
+ *      Copyright (C) 2005-2013 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RendererNull.h"
+#include "RenderCapture.h"
+#include "cores/VideoPlayer/DVDCodecs/Video/DVDVideoCodec.h"
+#include "cores/VideoPlayer/DVDCodecs/Video/DVDVideoFramePool.h"
+#include "utils/log.h"
+
+#include <cstring>
+
+CRendererNull::CRendererNull()
+ : m_bConfigured(false)
+ , m_iNumBuffers(NUM_BUFFERS)
+{
+  memset(m_buffers, 0, sizeof(m_buffers));
+  memset(m_poolBuffers, 0, sizeof(m_poolBuffers));
+}
+
+CRendererNull::~CRendererNull()
+{
+  FreeBuffers();
+}
+
+bool CRendererNull::Configure(unsigned int width, unsigned int height, unsigned int d_width, unsigned int d_height, float fps, unsigned flags, ERenderFormat format, unsigned extended_formatl, unsigned int orientation)
+{
+  if (!HandlesRenderFormat(format))
+  {
+    CLog::Log(LOGERROR, "CRendererNull::Configure - unsupported format %d", format);
+    return false;
+  }
+
+  FreeBuffers();
+
+  m_sourceWidth = width;
+  m_sourceHeight = height;
+  m_renderOrientation = orientation;
+  m_fps = fps;
+  m_iFlags = flags;
+  m_format = format;
+  CalculateFrameAspectRatio(d_width, d_height);
+
+  // same layout as the software path of CLinuxRendererGL, so that CDVDCodecUtils::CopyPicture can fill it
+  for (int i = 0; i < NUM_BUFFERS; i++)
+  {
+    YV12Image &im = m_buffers[i];
+    im.width = width;
+    im.height = height;
+    im.cshift_x = 1;
+    im.cshift_y = 1;
+    im.bpp = (format == RENDER_FMT_YUV420P) ? 1 : 2;
+
+    im.stride[0] = im.bpp * im.width;
+    im.stride[1] = im.bpp * (im.width >> im.cshift_x);
+    im.stride[2] = im.bpp * (im.width >> im.cshift_x);
+
+    im.planesize[0] = im.stride[0] * im.height;
+    im.planesize[1] = im.stride[1] * (im.height >> im.cshift_y);
+    im.planesize[2] = im.stride[2] * (im.height >> im.cshift_y);
+
+    for (int p = 0; p < MAX_PLANES; p++)
+      im.plane[p] = new uint8_t[im.planesize[p]];
+  }
+
+  m_bConfigured = true;
+  return true;
+}
+
+void CRendererNull::UnInit()
+{
+  FreeBuffers();
+  m_bConfigured = false;
+}
+
+void CRendererNull::FreeBuffers()
+{
+  for (int i = 0; i < NUM_BUFFERS; i++)
+  {
+    ReleaseBuffer(i);
+    for (int p = 0; p < MAX_PLANES; p++)
+    {
+      delete[] m_buffers[i].plane[p];
+      m_buffers[i].plane[p] = NULL;
+    }
+  }
+}
+
+int CRendererNull::GetImage(YV12Image *image, int source, bool readonly)
+{
+  if (!image || !m_bConfigured)
+    return -1;
+
+  if (source < 0 || source >= m_iNumBuffers)
+    return -1;
+
+  *image = m_buffers[source];
+  return source;
+}
+
+bool CRendererNull::AddVideoPicturePooled(DVDVideoPicture &picture, int index)
+{
+  if (!m_bConfigured || index < 0 || index >= m_iNumBuffers)
+    return false;
+
+  picture.poolBuffer->Acquire();
+  ReleaseBuffer(index);
+  m_poolBuffers[index] = picture.poolBuffer;
+  return true;
+}
+
+void CRendererNull::ReleaseBuffer(int idx)
+{
+  SAFE_RELEASE(m_poolBuffers[idx]);
+}
+
+CRenderInfo CRendererNull::GetRenderInfo()
+{
+  CRenderInfo info;
+  info.formats.push_back(RENDER_FMT_YUV420P);
+  info.formats.push_back(RENDER_FMT_YUV420P10);
+  info.formats.push_back(RENDER_FMT_YUV420P16);
+  info.max_buffer_size = NUM_BUFFERS;
+  info.optimal_buffer_size = 4;
+  return info;
+}
+
+bool CRendererNull::RenderCapture(CRenderCapture* capture)
+{
+  capture->BeginRender();
+  capture->EndRender();
+  return true;
+}
+
+bool CRendererNull::HandlesRenderFormat(ERenderFormat format)
+{
+  return format == RENDER_FMT_YUV420P ||
+         format == RENDER_FMT_YUV420P10 ||
+         format == RENDER_FMT_YUV420P16;
+}
@@ -0,0 +1,66 @@
+/*
+ *      Copyright (C) 2005-2013 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include "BaseRenderer.h"
+
+class CDVDVideoPoolBuffer;
+
+/*!
+ * \brief Renderer for software decoded pictures that keeps them in system memory and never draws them.
+ * Used by CRenderManager in headless mode, e.g. to benchmark the player pipeline without a display.
+ */
+class CRendererNull : public CBaseRenderer
+{
+public:
+  CRendererNull();
+  virtual ~CRendererNull();
+
+  // Player functions
+  virtual bool Configure(unsigned int width, unsigned int height, unsigned int d_width, unsigned int d_height, float fps, unsigned flags, ERenderFormat format, unsigned extended_formatl, unsigned int orientation);
+  virtual bool IsConfigured() { return m_bConfigured; }
+  virtual int GetImage(YV12Image *image, int source = -1, bool readonly = false);
+  virtual void ReleaseImage(int source, bool preserve = false) {}
+  virtual void FlipPage(int source) {}
+  virtual void PreInit() {}
+  virtual void UnInit();
+  virtual void Reset() {}
+  virtual void SetBufferSize(int numBuffers) { m_iNumBuffers = numBuffers; }
+  virtual CRenderInfo GetRenderInfo();
+  virtual void Update() {}
+  virtual void RenderUpdate(bool clear, unsigned int flags = 0, unsigned int alpha = 255) {}
+  virtual bool RenderCapture(CRenderCapture* capture);
+  virtual bool HandlesRenderFormat(ERenderFormat format);
+  virtual bool AddVideoPicturePooled(DVDVideoPicture &picture, int index);
+  virtual void ReleaseBuffer(int idx);
+
+  // Feature support
+  virtual bool SupportsMultiPassRendering() { return false; }
+  virtual bool Supports(ESCALINGMETHOD method) { return method == VS_SCALINGMETHOD_LINEAR; }
+
+private:
+  void FreeBuffers();
+
+  bool m_bConfigured;
+  int m_iNumBuffers;
+  YV12Image m_buffers[NUM_BUFFERS];
+  CDVDVideoPoolBuffer *m_poolBuffers[NUM_BUFFERS]; // decoder pictures kept instead of a copy
+};
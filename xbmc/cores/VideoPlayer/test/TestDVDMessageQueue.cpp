@@ -0,0 +1,175 @@
+/*
+ *      Copyright (C) 2005-2013 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cores/VideoPlayer/DVDMessageQueue.h"
+#include "cores/VideoPlayer/DVDClock.h"
+#include "cores/VideoPlayer/DVDDemuxers/DVDDemuxPacket.h"
+#include "cores/VideoPlayer/DVDDemuxers/DVDDemuxUtils.h"
+#include "utils/Stopwatch.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#define PACKET_SIZE 1024
+
+static double Now()
+{
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/* the packet index travels in the stream id, the time it was put in the duration. without timestamps the level is data based */
+static CDVDMsg* CreatePacket(int index)
+{
+  DemuxPacket* packet = CDVDDemuxUtils::AllocateDemuxPacket(PACKET_SIZE);
+  packet->iSize = PACKET_SIZE;
+  packet->iStreamId = index;
+  packet->dts = DVD_NOPTS_VALUE;
+  packet->pts = DVD_NOPTS_VALUE;
+  packet->duration = Now();
+  return new CDVDMsgDemuxerPacket(packet);
+}
+
+static int GetIndex(CDVDMsg* pMsg)
+{
+  if (pMsg->IsType(CDVDMsg::DEMUXER_PACKET))
+    return ((CDVDMsgDemuxerPacket*)pMsg)->GetPacket()->iStreamId;
+  return *(CDVDMsgInt*)pMsg;
+}
+
+TEST(TestDVDMessageQueue, Order)
+{
+  CDVDMessageQueue queue("test");
+  queue.SetMaxDataSize(100 * PACKET_SIZE);
+  queue.Init();
+
+  /* packets and control messages come out in the order they were put */
+  for (int i = 0; i < 10; i++)
+  {
+    if (i % 3 == 0)
+      queue.Put(new CDVDMsgInt(CDVDMsg::PLAYER_SETSPEED, i));
+    else
+      queue.Put(CreatePacket(i));
+  }
+  EXPECT_EQ(6U, queue.GetPacketCount(CDVDMsg::DEMUXER_PACKET));
+  EXPECT_EQ(6 * PACKET_SIZE, queue.GetDataSize());
+
+  /* urgent messages skip the queue, prioritized messages come first */
+  queue.Put(new CDVDMsgInt(CDVDMsg::PLAYER_SETSPEED, 100), 0, false);
+  queue.Put(new CDVDMsgInt(CDVDMsg::PLAYER_SETSPEED, 200), 1);
+
+  CDVDMsg* pMsg;
+  ASSERT_EQ(MSGQ_OK, queue.Get(&pMsg, 0));
+  EXPECT_EQ(200, GetIndex(pMsg));
+  pMsg->Release();
+  ASSERT_EQ(MSGQ_OK, queue.Get(&pMsg, 0));
+  EXPECT_EQ(100, GetIndex(pMsg));
+  pMsg->Release();
+
+  for (int i = 0; i < 10; i++)
+  {
+    ASSERT_EQ(MSGQ_OK, queue.Get(&pMsg, 0));
+    EXPECT_EQ(i, GetIndex(pMsg));
+    pMsg->Release();
+  }
+  EXPECT_EQ(MSGQ_TIMEOUT, queue.Get(&pMsg, 0));
+  EXPECT_EQ(0, queue.GetDataSize());
+  EXPECT_EQ(0, queue.GetLevel());
+}
+
+TEST(TestDVDMessageQueue, Flush)
+{
+  CDVDMessageQueue queue("test");
+  queue.SetMaxDataSize(100 * PACKET_SIZE);
+  queue.Init();
+
+  for (int i = 0; i < 50; i++)
+    queue.Put(CreatePacket(i));
+  queue.Put(new CDVDMsgInt(CDVDMsg::PLAYER_SETSPEED, 50));
+  EXPECT_EQ(50, queue.GetLevel());
+
+  queue.Flush();
+  EXPECT_EQ(0U, queue.GetPacketCount(CDVDMsg::DEMUXER_PACKET));
+  EXPECT_EQ(0, queue.GetDataSize());
+
+  /* flushing packets keeps control messages */
+  CDVDMsg* pMsg;
+  ASSERT_EQ(MSGQ_OK, queue.Get(&pMsg, 0));
+  EXPECT_EQ(50, GetIndex(pMsg));
+  pMsg->Release();
+  queue.End();
+}
+
+TEST(TestDVDMessageQueue, ProducerConsumerStress)
+{
+  static const int messages = 500000;
+  static const int controlInterval = 100;
+
+  CDVDMessageQueue queue("test");
+  queue.SetMaxDataSize(1000 * PACKET_SIZE);
+  queue.Init();
+
+  /* the demuxer puts packets and the occasional control message, it backs off while the queue is full */
+  std::thread producer([&queue]()
+  {
+    for (int i = 0; i < messages; i++)
+    {
+      while (queue.IsFull())
+        std::this_thread::yield();
+      if (i % controlInterval == 0)
+        queue.Put(new CDVDMsgInt(CDVDMsg::PLAYER_SETSPEED, i));
+      else
+        queue.Put(CreatePacket(i));
+    }
+  });
+
+  std::vector<float> latencies;
+  latencies.reserve(messages);
+  int expected = 0;
+  CStopWatch timer;
+  timer.StartZero();
+  while (expected < messages)
+  {
+    CDVDMsg* pMsg;
+    if (queue.Get(&pMsg, 1000) != MSGQ_OK)
+      break;
+    EXPECT_EQ(expected, GetIndex(pMsg));
+    if (pMsg->IsType(CDVDMsg::DEMUXER_PACKET))
+      latencies.push_back((float)(Now() - ((CDVDMsgDemuxerPacket*)pMsg)->GetPacket()->duration));
+    pMsg->Release();
+    expected++;
+  }
+  float elapsed = timer.GetElapsedSeconds();
+  producer.join();
+
+  EXPECT_EQ(messages, expected);
+  EXPECT_EQ(0, queue.GetDataSize());
+  ASSERT_FALSE(latencies.empty());
+
+  std::sort(latencies.begin(), latencies.end());
+  std::cout << "Messages/s: " << testing::PrintToString(expected / std::max(elapsed, 0.001f)) << std::endl;
+  std::cout << "Latency p50 (us): " << testing::PrintToString(latencies[latencies.size() / 2]) << std::endl;
+  std::cout << "Latency p99 (us): " << testing::PrintToString(latencies[latencies.size() * 99 / 100]) << std::endl;
+  queue.End();
+}
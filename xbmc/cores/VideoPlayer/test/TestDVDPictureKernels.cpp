@@ -0,0 +1,204 @@
+/*
+ *      Copyright (C) 2005-2013 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cores/VideoPlayer/DVDCodecs/DVDPictureKernels.h"
+#include "utils/CPUInfo.h"
+#include "utils/Stopwatch.h"
+
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#define BENCHMARK_WIDTH  3840
+#define BENCHMARK_HEIGHT 2160
+#define BENCHMARK_LOOPS  50
+
+/* a YUV 4:2:0 picture with padded strides, filled with a pattern that differs per plane */
+class CTestPicture
+{
+public:
+  CTestPicture(int width, int height, int padding)
+  {
+    this->width = width;
+    this->height = height;
+    for (int i = 0; i < 3; i++)
+    {
+      int w = i ? width / 2 : width;
+      int h = i ? height / 2 : height;
+      stride[i] = w + padding;
+      planes[i].resize(stride[i] * h + padding);
+      for (size_t j = 0; j < planes[i].size(); j++)
+        planes[i][j] = (uint8_t)(j * 7 + i * 85 + (j >> 8));
+      data[i] = &planes[i][0];
+    }
+  }
+
+  int width;
+  int height;
+  int stride[3];
+  const uint8_t* data[3];
+  std::vector<uint8_t> planes[3];
+};
+
+struct SKernelResults
+{
+  std::vector<uint8_t> copy;
+  std::vector<uint8_t> nv12;
+  std::vector<uint8_t> yuyv;
+  std::vector<uint8_t> uyvy;
+};
+
+/* output strides are odd so that the kernels also hit unaligned rows */
+static SKernelResults RunKernels(const CTestPicture &picture)
+{
+  SKernelResults results;
+  int w = picture.width;
+  int h = picture.height;
+  int stride = w + 3;
+
+  results.copy.assign(stride * h, 0);
+  CDVDPictureKernels::CopyPlane(&results.copy[0], stride, picture.data[0], picture.stride[0], w, h);
+
+  results.nv12.assign(stride * (h / 2), 0);
+  CDVDPictureKernels::InterleaveUV(&results.nv12[0], stride,
+                                   picture.data[1], picture.stride[1],
+                                   picture.data[2], picture.stride[2],
+                                   w / 2, h / 2);
+
+  results.yuyv.assign((w * 2 + 1) * h, 0);
+  CDVDPictureKernels::PackYUV422(&results.yuyv[0], w * 2 + 1, picture.data, picture.stride, w, h, false);
+  results.uyvy.assign((w * 2 + 1) * h, 0);
+  CDVDPictureKernels::PackYUV422(&results.uyvy[0], w * 2 + 1, picture.data, picture.stride, w, h, true);
+
+  return results;
+}
+
+class TestDVDPictureKernels : public testing::Test
+{
+protected:
+  ~TestDVDPictureKernels()
+  {
+    CDVDPictureKernels::SetCPUFeatures(g_cpuInfo.GetCPUFeatures());
+  }
+
+  /* every kernel set the cpu supports, scalar first */
+  static std::vector<unsigned int> GetFeatureSets()
+  {
+    std::vector<unsigned int> sets;
+    unsigned int features = g_cpuInfo.GetCPUFeatures();
+    sets.push_back(0);
+    if (features & CPU_FEATURE_SSE2)
+      sets.push_back(CPU_FEATURE_SSE2);
+    if (features & CPU_FEATURE_AVX2)
+      sets.push_back(CPU_FEATURE_SSE2 | CPU_FEATURE_AVX2);
+    if (features & CPU_FEATURE_NEON)
+      sets.push_back(CPU_FEATURE_NEON);
+    return sets;
+  }
+};
+
+TEST_F(TestDVDPictureKernels, PackYUV422Scalar)
+{
+  CTestPicture picture(4, 2, 0);
+  uint8_t yuyv[16];
+  uint8_t uyvy[16];
+
+  CDVDPictureKernels::SetCPUFeatures(0);
+  CDVDPictureKernels::PackYUV422(yuyv, 8, picture.data, picture.stride, 4, 2, false);
+  CDVDPictureKernels::PackYUV422(uyvy, 8, picture.data, picture.stride, 4, 2, true);
+
+  // both rows share the chroma row
+  for (int y = 0; y < 2; y++)
+  {
+    const uint8_t* luma = picture.data[0] + y * 4;
+    const uint8_t expectedYUYV[] = { luma[0], picture.data[1][0], luma[1], picture.data[2][0],
+                                     luma[2], picture.data[1][1], luma[3], picture.data[2][1] };
+    const uint8_t expectedUYVY[] = { picture.data[1][0], luma[0], picture.data[2][0], luma[1],
+                                     picture.data[1][1], luma[2], picture.data[2][1], luma[3] };
+    EXPECT_EQ(0, memcmp(expectedYUYV, yuyv + y * 8, 8));
+    EXPECT_EQ(0, memcmp(expectedUYVY, uyvy + y * 8, 8));
+  }
+}
+
+TEST_F(TestDVDPictureKernels, MatchScalar)
+{
+  // odd sizes leave tails for every vector width, 4K exceeds the streaming threshold
+  static const int sizes[][3] = { { 2, 2, 0 }, { 66, 34, 5 }, { 718, 478, 17 }, { 1920, 1080, 0 }, { 3840, 2160, 64 } };
+  std::vector<unsigned int> sets = GetFeatureSets();
+
+  for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+  {
+    CTestPicture picture(sizes[i][0], sizes[i][1], sizes[i][2]);
+
+    CDVDPictureKernels::SetCPUFeatures(0);
+    SKernelResults expected = RunKernels(picture);
+
+    for (size_t j = 1; j < sets.size(); j++)
+    {
+      CDVDPictureKernels::SetCPUFeatures(sets[j]);
+      SKernelResults results = RunKernels(picture);
+      SCOPED_TRACE(testing::Message() << CDVDPictureKernels::GetName() << " " << picture.width << "x" << picture.height);
+      EXPECT_TRUE(expected.copy == results.copy);
+      EXPECT_TRUE(expected.nv12 == results.nv12);
+      EXPECT_TRUE(expected.yuyv == results.yuyv);
+      EXPECT_TRUE(expected.uyvy == results.uyvy);
+    }
+  }
+}
+
+TEST_F(TestDVDPictureKernels, Benchmark)
+{
+  CTestPicture picture(BENCHMARK_WIDTH, BENCHMARK_HEIGHT, 0);
+  int w = picture.width;
+  int h = picture.height;
+  std::vector<uint8_t> luma(w * h);
+  std::vector<uint8_t> chroma(w * h / 2);
+  std::vector<uint8_t> packed(w * h * 2);
+  std::vector<unsigned int> sets = GetFeatureSets();
+
+  for (size_t i = 0; i < sets.size(); i++)
+  {
+    CDVDPictureKernels::SetCPUFeatures(sets[i]);
+    CStopWatch timer;
+
+    timer.StartZero();
+    for (int loop = 0; loop < BENCHMARK_LOOPS; loop++)
+      CDVDPictureKernels::CopyPlane(&luma[0], w, picture.data[0], picture.stride[0], w, h);
+    float copy = timer.GetElapsedMilliseconds() / BENCHMARK_LOOPS;
+
+    timer.StartZero();
+    for (int loop = 0; loop < BENCHMARK_LOOPS; loop++)
+      CDVDPictureKernels::InterleaveUV(&chroma[0], w, picture.data[1], picture.stride[1],
+                                       picture.data[2], picture.stride[2], w / 2, h / 2);
+    float nv12 = timer.GetElapsedMilliseconds() / BENCHMARK_LOOPS;
+
+    timer.StartZero();
+    for (int loop = 0; loop < BENCHMARK_LOOPS; loop++)
+      CDVDPictureKernels::PackYUV422(&packed[0], w * 2, picture.data, picture.stride, w, h, false);
+    float yuyv = timer.GetElapsedMilliseconds() / BENCHMARK_LOOPS;
+
+    std::cout << CDVDPictureKernels::GetName() << " " << w << "x" << h << " (ms per frame):"
+              << " copy luma " << testing::PrintToString(copy)
+              << ", interleave nv12 " << testing::PrintToString(nv12)
+              << ", pack yuyv " << testing::PrintToString(yuyv) << std::endl;
+  }
+}
@@ -0,0 +1,200 @@
+/*
+ *      Copyright (C) 2005-2013 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cores/AudioEngine/AEFactory.h"
+#include "cores/IPlayerCallback.h"
+#include "cores/VideoPlayer/VideoPlayer.h"
+#include "cores/VideoPlayer/VideoRenderers/RenderManager.h"
+#include "settings/Settings.h"
+#include "test/TestUtils.h"
+#include "threads/Event.h"
+#include "utils/Stopwatch.h"
+#include "utils/StringUtils.h"
+#include "FileItem.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#if defined(TARGET_LINUX)
+#include <dirent.h>
+#include <unistd.h>
+#endif
+
+#include "gtest/gtest.h"
+
+#define BENCHMARK_MAX_SECONDS  60
+#define BENCHMARK_FRAME_MS     16 /* the benchmark renders like a 60Hz display */
+#define BENCHMARK_SAMPLE_MS    100
+
+/* cpu time in seconds used by the threads of this process so far, summed by thread name */
+static std::map<std::string, double> GetThreadCpuTimes()
+{
+  std::map<std::string, double> times;
+#if defined(TARGET_LINUX)
+  DIR *dir = opendir("/proc/self/task");
+  if (!dir)
+    return times;
+
+  double ticks = (double)sysconf(_SC_CLK_TCK);
+  struct dirent *entry;
+  while ((entry = readdir(dir)) != NULL)
+  {
+    if (entry->d_name[0] == '.')
+      continue;
+
+    std::ifstream file(StringUtils::Format("/proc/self/task/%s/stat", entry->d_name).c_str());
+    std::string line;
+    if (!std::getline(file, line))
+      continue;
+
+    // "tid (name) state ppid ...", utime and stime are the 14th and 15th field
+    size_t open = line.find('(');
+    size_t close = line.rfind(')');
+    if (open == std::string::npos || close == std::string::npos || close < open)
+      continue;
+
+    std::vector<std::string> fields = StringUtils::Split(line.substr(close + 2), " ");
+    if (fields.size() < 13)
+      continue;
+
+    std::string name = line.substr(open + 1, close - open - 1);
+    times[name] += (atof(fields[11].c_str()) + atof(fields[12].c_str())) / ticks;
+  }
+  closedir(dir);
+#endif
+  return times;
+}
+
+class TestVideoPlayerBenchmark : public testing::Test, public IPlayerCallback
+{
+protected:
+  static bool audio;
+
+  static void SetUpTestCase()
+  {
+    CRenderManager::SetHeadless(true);
+
+    /* software decoding only, hardware decoders need a display */
+#ifdef HAVE_LIBVA
+    CSettings::GetInstance().SetBool(CSettings::SETTING_VIDEOPLAYER_USEVAAPI, false);
+#endif
+#ifdef HAVE_LIBVDPAU
+    CSettings::GetInstance().SetBool(CSettings::SETTING_VIDEOPLAYER_USEVDPAU, false);
+#endif
+
+    /* audio goes to the NULL sink, playback is video only if the engine doesn't start */
+    CSettings::GetInstance().SetString(CSettings::SETTING_AUDIOOUTPUT_AUDIODEVICE, "NULL:NULL");
+    audio = CAEFactory::LoadEngine() && CAEFactory::StartEngine();
+  }
+
+  static void TearDownTestCase()
+  {
+    CAEFactory::UnLoadEngine();
+    CRenderManager::SetHeadless(false);
+  }
+
+  virtual void OnPlayBackEnded() { m_ended.Set(); }
+  virtual void OnPlayBackStarted() {}
+  virtual void OnPlayBackStopped() { m_ended.Set(); }
+  virtual void OnQueueNextItem() {}
+
+  CEvent m_ended;
+};
+
+bool TestVideoPlayerBenchmark::audio = false;
+
+TEST_F(TestVideoPlayerBenchmark, Playback)
+{
+  std::vector<std::string> files = CXBMCTestUtils::Instance().getBenchmarkMediaFiles();
+  files.erase(std::remove(files.begin(), files.end(), ""), files.end());
+  if (files.empty())
+  {
+    std::cout << "No media files given, add them with --add-benchmark-mediafile" << std::endl;
+    return;
+  }
+
+  for (std::vector<std::string>::const_iterator it = files.begin(); it != files.end(); ++it)
+  {
+    CVideoPlayer player(*this);
+    CPlayerOptions options;
+    options.video_only = !audio;
+
+    m_ended.Reset();
+    std::map<std::string, double> cpuStart = GetThreadCpuTimes();
+    CStopWatch timer;
+    timer.StartZero();
+    ASSERT_TRUE(player.OpenFile(CFileItem(*it, false), options)) << *it;
+
+    SPlayerPipelineStats stats;
+    SPlayerPipelineStats maxLevels;
+    double videoLevel = 0.0, audioLevel = 0.0, renderQueued = 0.0;
+    int samples = 0;
+    CStopWatch sampleTimer;
+    sampleTimer.StartZero();
+
+    /* this thread takes the part of the render thread */
+    while (!m_ended.WaitMSec(BENCHMARK_FRAME_MS) && timer.GetElapsedSeconds() < BENCHMARK_MAX_SECONDS)
+    {
+      player.FrameMove();
+      player.Render(true, 255, true);
+
+      if (sampleTimer.GetElapsedMilliseconds() >= BENCHMARK_SAMPLE_MS)
+      {
+        player.GetPipelineStats(stats);
+        videoLevel += stats.video_level;
+        audioLevel += stats.audio_level;
+        renderQueued += stats.render_queued;
+        maxLevels.video_level = std::max(maxLevels.video_level, stats.video_level);
+        maxLevels.audio_level = std::max(maxLevels.audio_level, stats.audio_level);
+        maxLevels.render_queued = std::max(maxLevels.render_queued, stats.render_queued);
+        samples++;
+        sampleTimer.StartZero();
+      }
+    }
+    float elapsed = timer.GetElapsedSeconds();
+    player.GetPipelineStats(stats);
+    std::map<std::string, double> cpuEnd = GetThreadCpuTimes();
+    player.CloseFile();
+
+    EXPECT_GT(stats.frames_output, 0) << *it;
+    samples = std::max(samples, 1);
+
+    std::cout << *it << std::endl;
+    std::cout << "  Frames/s: " << testing::PrintToString(stats.frames_output / std::max(elapsed, 0.001f))
+              << " (" << stats.frames_output << " frames in " << elapsed << "s)" << std::endl;
+    std::cout << "  Dropped frames: " << stats.frames_dropped << std::endl;
+    std::cout << "  Frame buffer allocations/s: " << testing::PrintToString(stats.buffer_allocations / std::max(elapsed, 0.001f))
+              << " (" << stats.buffer_allocations << " total)" << std::endl;
+    std::cout << "  Peak frame memory (MiB): " << stats.buffer_peak_bytes / (1024.0 * 1024.0) << std::endl;
+    std::cout << "  Video queue level avg/max (%): " << videoLevel / samples << " / " << maxLevels.video_level << std::endl;
+    std::cout << "  Audio queue level avg/max (%): " << audioLevel / samples << " / " << maxLevels.audio_level << std::endl;
+    std::cout << "  Render queue avg/max (pictures): " << renderQueued / samples << " / " << maxLevels.render_queued << std::endl;
+    for (std::map<std::string, double>::const_iterator cpu = cpuEnd.begin(); cpu != cpuEnd.end(); ++cpu)
+    {
+      double used = cpu->second - cpuStart[cpu->first];
+      if (used > 0.0)
+        std::cout << "  CPU time " << cpu->first << " (s): " << used << std::endl;
+    }
+  }
+}
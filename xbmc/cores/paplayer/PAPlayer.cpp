@@ -25,8 +25,10 @@
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "music/tags/MusicInfoTag.h"
+#include "URL.h"
 #include "utils/log.h"
 #include "utils/JobManager.h"
+#include "utils/Stopwatch.h"
 
 #include "cores/AudioEngine/AEFactory.h"
 #include "cores/AudioEngine/Utils/AEUtil.h"
@@ -34,6 +36,8 @@
 #include "cores/DataCacheCore.h"
 #include "cores/VideoPlayer/Process/ProcessInfo.h"
 
+#include <algorithm>
+
 #define TIME_TO_CACHE_NEXT_FILE 5000 /* 5 seconds before end of song, start caching the next song */
 #define FAST_XFADE_TIME           80 /* 80 milliseconds */
 #define MAX_SKIP_XFADE_TIME     2000 /* max 2 seconds crossfade on track skip */
@@ -53,6 +57,48 @@ public:
   }
 };
 
+class CPreDecodeJob : public CJob
+{
+  CFileItem m_item;
+  PAPlayer::PreDecodePtr m_preDecode;
+
+public:
+                CPreDecodeJob(const CFileItem& item, const PAPlayer::PreDecodePtr &preDecode)
+                  : m_item(item), m_preDecode(preDecode) {}
+  virtual       ~CPreDecodeJob() {}
+  virtual bool  DoWork()
+  {
+    CSingleLock lock(m_preDecode->m_lock);
+    if (m_preDecode->m_abort)
+      return false;
+    m_preDecode->m_started = true;
+
+    CStopWatch timer;
+    timer.StartZero();
+    PAPlayer::StreamInfo *si = new PAPlayer::StreamInfo();
+    if (!PAPlayer::OpenDecoder(si, m_item, &m_preDecode->m_abort))
+    {
+      si->m_decoder.Destroy();
+      delete si;
+      return false;
+    }
+    m_preDecode->m_stream = si;
+
+    CLog::Log(LOGDEBUG, "CPreDecodeJob - pre-decoded %s in %.0f ms",
+              CURL::GetRedacted(m_item.GetPath()).c_str(), timer.GetElapsedMilliseconds());
+    return true;
+  }
+};
+
+PAPlayer::PreDecode::~PreDecode()
+{
+  if (m_stream)
+  {
+    m_stream->m_decoder.Destroy();
+    delete m_stream;
+  }
+}
+
 // PAP: Psycho-acoustic Audio Player
 // Supporting all open  audio codec standards.
 // First one being nullsoft's nsv audio decoder format
@@ -76,12 +122,14 @@ PAPlayer::PAPlayer(IPlayerCallback& callback) :
   m_newForcedTotalTime (-1)
 {
   memset(&m_playerGUIData, 0, sizeof(m_playerGUIData));
+  memset(&m_queueStats, 0, sizeof(m_queueStats));
   m_processInfo.reset(CProcessInfo::CreateInstance());
 }
 
 PAPlayer::~PAPlayer()
 {
   CloseFile();
+  ClearPreDecoded();
   delete m_FileItem;
 }
 
@@ -344,30 +392,17 @@ bool PAPlayer::QueueNextFileEx(const CFileItem &file, bool fadeIn/* = true */, b
     m_continueStream = false;
   }
 
-  StreamInfo *si = new StreamInfo();
-  if (!si->m_decoder.Create(file, (file.m_lStartOffset * 1000) / 75))
-  {
-    CLog::Log(LOGWARNING, "PAPlayer::QueueNextFileEx - Failed to create the decoder");
+  CStopWatch queueTimer;
+  queueTimer.StartZero();
 
-    delete si;
-    // advance playlist
-    if (job)
-      m_callback.OnPlayBackStarted();
-    m_callback.OnQueueNextItem();
-    return false;
-  }
-
-  /* decode until there is data-available */
-  si->m_decoder.Start();
-  while(si->m_decoder.GetDataSize(true) == 0)
+  /* use the decoder opened ahead of time if there is one */
+  StreamInfo *si = TakePreDecoded(file);
+  const bool preDecoded = si != NULL;
+  if (!si)
   {
-    int status = si->m_decoder.GetStatus();
-    if (status == STATUS_ENDED   ||
-        status == STATUS_NO_FILE ||
-        si->m_decoder.ReadSamples(PACKET_SIZE) == RET_ERROR)
+    si = new StreamInfo();
+    if (!OpenDecoder(si, file, NULL))
     {
-      CLog::Log(LOGINFO, "PAPlayer::QueueNextFileEx - Error reading samples");
-
       si->m_decoder.Destroy();
       delete si;
       // advance playlist
@@ -376,10 +411,8 @@ bool PAPlayer::QueueNextFileEx(const CFileItem &file, bool fadeIn/* = true */, b
       m_callback.OnQueueNextItem();
       return false;
     }
-
-    /* yield our time so that the main PAP thread doesnt stall */
-    CThread::Sleep(1);
   }
+  si->m_decoder.Start();
 
   // set m_upcomingCrossfadeMS depending on type of file and user settings
   UpdateCrossfadeTime(file);
@@ -448,9 +481,143 @@ bool PAPlayer::QueueNextFileEx(const CFileItem &file, bool fadeIn/* = true */, b
 
   *m_FileItem = file;
 
+  float queueMs = queueTimer.GetElapsedMilliseconds();
+  m_queueStats.m_queued++;
+  if (preDecoded)
+    m_queueStats.m_preDecoded++;
+  m_queueStats.m_totalMs += queueMs;
+  m_queueStats.m_maxMs = std::max(m_queueStats.m_maxMs, queueMs);
+  CLog::Log(LOGDEBUG, "PAPlayer::QueueNextFileEx - %s stream ready after %.0f ms",
+            preDecoded ? "pre-decoded" : "opened", queueMs);
+
   return true;
 }
 
+bool PAPlayer::OpenDecoder(StreamInfo *si, const CFileItem &file, const std::atomic_bool *abort)
+{
+  if (!si->m_decoder.Create(file, (file.m_lStartOffset * 1000) / 75))
+  {
+    CLog::Log(LOGWARNING, "PAPlayer::OpenDecoder - Failed to create the decoder");
+    return false;
+  }
+
+  /* decode until there is data-available, the decoder isn't started yet so it stops at queued */
+  while(si->m_decoder.GetDataSize(true) == 0)
+  {
+    int status = si->m_decoder.GetStatus();
+    if (status == STATUS_ENDED   ||
+        status == STATUS_NO_FILE ||
+        si->m_decoder.ReadSamples(PACKET_SIZE) == RET_ERROR)
+    {
+      CLog::Log(LOGINFO, "PAPlayer::OpenDecoder - Error reading samples");
+      return false;
+    }
+
+    if (abort && *abort)
+      return false;
+
+    /* yield our time so that the main PAP thread doesnt stall */
+    XbmcThreads::ThreadSleep(1);
+  }
+
+  return true;
+}
+
+void PAPlayer::PrepareNextFiles(const CFileItemList &items)
+{
+  std::vector<PreDecodePtr> preDecoded;
+
+  CSingleLock lock(m_preDecodeLock);
+  for (int i = 0; i < items.Size(); i++)
+  {
+    const CFileItemPtr item = items.Get(i);
+    // cd drives don't really like to be read at two places at once
+    if (item->IsCDDA())
+      continue;
+
+    bool queued = false;
+    for (std::vector<PreDecodePtr>::iterator it = preDecoded.begin(); it != preDecoded.end() && !queued; ++it)
+      queued = (*it)->m_path == item->GetPath() && (*it)->m_startOffset == item->m_lStartOffset;
+    if (queued)
+      continue;
+
+    PreDecodePtr preDecode;
+    for (std::vector<PreDecodePtr>::iterator it = m_preDecoded.begin(); it != m_preDecoded.end(); ++it)
+    {
+      if ((*it)->m_path == item->GetPath() && (*it)->m_startOffset == item->m_lStartOffset)
+      {
+        preDecode = *it;
+        break;
+      }
+    }
+
+    if (!preDecode)
+    {
+      preDecode.reset(new PreDecode());
+      preDecode->m_path = item->GetPath();
+      preDecode->m_startOffset = item->m_lStartOffset;
+      CJobManager::GetInstance().AddJob(new CPreDecodeJob(*item, preDecode), NULL, CJob::PRIORITY_NORMAL);
+    }
+    preDecoded.push_back(preDecode);
+  }
+
+  /* stop the jobs of items that are not upcoming anymore, the decoders go with the last reference */
+  for (std::vector<PreDecodePtr>::iterator it = m_preDecoded.begin(); it != m_preDecoded.end(); ++it)
+  {
+    if (std::find(preDecoded.begin(), preDecoded.end(), *it) == preDecoded.end())
+      (*it)->m_abort = true;
+  }
+  m_preDecoded.swap(preDecoded);
+}
+
+PAPlayer::StreamInfo* PAPlayer::TakePreDecoded(const CFileItem &file)
+{
+  PreDecodePtr preDecode;
+  {
+    CSingleLock lock(m_preDecodeLock);
+    for (std::vector<PreDecodePtr>::iterator it = m_preDecoded.begin(); it != m_preDecoded.end(); ++it)
+    {
+      if ((*it)->m_path == file.GetPath() && (*it)->m_startOffset == file.m_lStartOffset)
+      {
+        preDecode = *it;
+        m_preDecoded.erase(it);
+        break;
+      }
+    }
+  }
+  if (!preDecode)
+    return NULL;
+
+  /* wait for a job that is still decoding, one that did not get to run yet is not waited for */
+  CSingleLock lock(preDecode->m_lock);
+  preDecode->m_abort = true;
+  StreamInfo *si = preDecode->m_stream;
+  preDecode->m_stream = NULL;
+  if (!si)
+    CLog::Log(LOGDEBUG, "PAPlayer::TakePreDecoded - %s was not pre-decoded (%s)", CURL::GetRedacted(file.GetPath()).c_str(),
+              preDecode->m_started ? "failed to open" : "job did not run in time");
+  return si;
+}
+
+void PAPlayer::ClearPreDecoded()
+{
+  CSingleLock lock(m_preDecodeLock);
+  for (std::vector<PreDecodePtr>::iterator it = m_preDecoded.begin(); it != m_preDecoded.end(); ++it)
+    (*it)->m_abort = true;
+  m_preDecoded.clear();
+}
+
+void PAPlayer::LogQueueStats()
+{
+  if (!m_queueStats.m_queued)
+    return;
+
+  CLog::Log(LOGDEBUG, "PAPlayer - %u tracks queued, %u pre-decoded, time to ready %.1f ms average, %.0f ms max",
+            m_queueStats.m_queued, m_queueStats.m_preDecoded,
+            m_queueStats.m_totalMs / m_queueStats.m_queued, m_queueStats.m_maxMs);
+  memset(&m_queueStats, 0, sizeof(m_queueStats));
+}
+
 void PAPlayer::UpdateStreamInfoPlayNextAtFrame(StreamInfo *si, unsigned int crossFadingTime)
 {
   // if no crossfading or cue sheet, wait for eof
@@ -539,6 +706,10 @@ bool PAPlayer::CloseFile(bool reopen)
   /* wait for the thread to terminate */
   StopThread(true);//true - wait for end of thread
 
+  /* reopen means the next file follows right away and may be one of the pre-decoded ones */
+  if (!reopen)
+    ClearPreDecoded();
+
   // wait for any pending jobs to complete
   {
     CSingleLock lock(m_streamsLock);
@@ -550,6 +721,8 @@ bool PAPlayer::CloseFile(bool reopen)
     }
   }
 
+  LogQueueStats();
+
   return true;
 }
 
@@ -22,6 +22,8 @@
 
 #include <atomic>
 #include <list>
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "cores/IPlayer.h"
@@ -35,11 +37,13 @@
 
 class IAEStream;
 class CFileItem;
+class CFileItemList;
 class CProcessInfo;
 
 class PAPlayer : public IPlayer, public CThread, public IJobCallback
 {
 friend class CQueueNextFileJob;
+friend class CPreDecodeJob;
 public:
   PAPlayer(IPlayerCallback& callback);
   virtual ~PAPlayer();
@@ -49,6 +53,7 @@ public:
   virtual bool OpenFile(const CFileItem& file, const CPlayerOptions &options);
   virtual bool QueueNextFile(const CFileItem &file);
   virtual void OnNothingToQueueNotify();
+  virtual void PrepareNextFiles(const CFileItemList &items);
   virtual bool CloseFile(bool reopen = false);
   virtual bool IsPlaying() const;
   virtual void Pause() override;
@@ -126,6 +131,21 @@ private:
 
   typedef std::list<StreamInfo*> StreamList;
 
+  /* an upcoming playlist item that a CPreDecodeJob opens and decodes ahead of time */
+  struct PreDecode
+  {
+    PreDecode() : m_startOffset(0), m_stream(NULL), m_started(false), m_abort(false) {}
+    ~PreDecode();
+
+    std::string m_path;                  /* the item's path and start offset to match it when queued */
+    int64_t m_startOffset;
+    StreamInfo* m_stream;                /* decoded until data is available, NULL if not done or failed */
+    CCriticalSection m_lock;             /* held by the job while it decodes */
+    bool m_started;                      /* if the job got to run before the item was needed */
+    std::atomic_bool m_abort;            /* the item is not upcoming anymore or has been queued */
+  };
+  typedef std::shared_ptr<PreDecode> PreDecodePtr;
+
   bool                m_signalSpeedChange;   /* true if OnPlaybackSpeedChange needs to be called */
   std::atomic_int m_playbackSpeed;           /* the playback speed (1 = normal) */
   bool                m_isPlaying;
@@ -149,7 +169,22 @@ private:
   int64_t             m_newForcedTotalTime;
   std::unique_ptr<CProcessInfo> m_processInfo;
 
+  CCriticalSection    m_preDecodeLock;       /* lock for the pre-decoded items */
+  std::vector<PreDecodePtr> m_preDecoded;    /* upcoming items, nearest first */
+
+  struct
+  {
+    unsigned int m_queued;               /* number of tracks queued */
+    unsigned int m_preDecoded;           /* of them, how many had been pre-decoded */
+    float m_totalMs;                     /* time from QueueNextFileEx until the stream was ready */
+    float m_maxMs;
+  } m_queueStats;
+
   bool QueueNextFileEx(const CFileItem &file, bool fadeIn = true, bool job = false);
+  static bool OpenDecoder(StreamInfo *si, const CFileItem &file, const std::atomic_bool *abort);
+  StreamInfo* TakePreDecoded(const CFileItem &file);
+  void ClearPreDecoded();
+  void LogQueueStats();
   void SoftStart(bool wait = false);
   void SoftStop(bool wait = false, bool close = true);
   void CloseAllStreams(bool fade = true);
@@ -284,6 +284,33 @@ bool CDatabase::ExecuteQuery(const std::string &strQuery)
   return bReturn;
 }
 
+bool CDatabase::ExecuteQuery(const std::string &strQuery, const std::vector<field_value> &params)
+{
+  bool bReturn = false;
+
+  try
+  {
+    if (NULL == m_pDB.get()) return bReturn;
+    if (NULL == m_pDS.get()) return bReturn;
+
+    if (m_multipleExecute)
+    {
+      m_multipleQueries.push_back(m_pDS->bind_params(strQuery, params));
+      return true;
+    }
+
+    m_pDS->exec(strQuery, params);
+    bReturn = true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s - failed to execute query '%s'",
+        __FUNCTION__, strQuery.c_str());
+  }
+
+  return bReturn;
+}
+
 bool CDatabase::ResultQuery(const std::string &strQuery)
 {
   bool bReturn = false;
@@ -306,6 +333,26 @@ bool CDatabase::ResultQuery(const std::string &strQuery)
   return bReturn;
 }
 
+bool CDatabase::ResultQuery(const std::string &strQuery, const std::vector<field_value> &params)
+{
+  bool bReturn = false;
+
+  try
+  {
+    if (NULL == m_pDB.get()) return bReturn;
+    if (NULL == m_pDS.get()) return bReturn;
+
+    bReturn = m_pDS->query(strQuery, params);
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s - failed to execute query '%s'",
+        __FUNCTION__, strQuery.c_str());
+  }
+
+  return bReturn;
+}
+
 bool CDatabase::QueueInsertQuery(const std::string &strQuery)
 {
   if (strQuery.empty())
@@ -532,6 +579,13 @@ void CDatabase::Close()
 
   if (NULL == m_pDB.get() ) return ;
   if (NULL != m_pDS.get()) m_pDS->close();
+
+  StatementCacheStats stats;
+  if (m_pDB->getStatementCacheStats(stats) && stats.hits + stats.misses > 0)
+    CLog::Log(LOGDEBUG, "%s - %s statement cache: %" PRIu64 " hits, %" PRIu64 " misses (%.1f%% hit rate), %" PRIu64 " evictions",
+              __FUNCTION__, m_pDB->getDatabase(), stats.hits, stats.misses,
+              100.0 * stats.hits / (stats.hits + stats.misses), stats.evictions);
+
   m_pDB->disconnect();
   m_pDB.reset();
   m_pDS.reset();
@@ -23,6 +23,7 @@
 namespace dbiplus {
   class Database;
   class Dataset;
+  class field_value;
 }
 
 #include <memory>
@@ -128,6 +129,17 @@ public:
    */
   bool ExecuteQuery(const std::string &strQuery);
 
+  /*!
+   * @brief Execute a query with bound parameters that does not return any result.
+   *        The compiled statement is cached per connection, so repeated calls
+   *        with the same strQuery skip parsing and planning.
+   * @param strQuery The query to execute, using '?' as parameter placeholders.
+   * @param params The values to bind to the placeholders, in order.
+   * @return True if the query was executed successfully, false otherwise.
+   * @sa ExecuteQuery
+   */
+  bool ExecuteQuery(const std::string &strQuery, const std::vector<dbiplus::field_value> &params);
+
   /*!
    * @brief Execute a query that returns a result.
    * @remarks Call m_pDS->close(); to clean up the dataset when done.
@@ -136,6 +148,16 @@ public:
    */
   bool ResultQuery(const std::string &strQuery);
 
+  /*!
+   * @brief Execute a query with bound parameters that returns a result.
+   * @remarks Call m_pDS->close(); to clean up the dataset when done.
+   * @param strQuery The query to execute, using '?' as parameter placeholders.
+   * @param params The values to bind to the placeholders, in order.
+   * @return True if the query was executed successfully, false otherwise.
+   * @sa ResultQuery
+   */
+  bool ResultQuery(const std::string &strQuery, const std::vector<dbiplus::field_value> &params);
+
   /*!
    * @brief Start a multiple execution queue. Any ExecuteQuery() function
    *        following this call will be queued rather than executed until
@@ -93,6 +93,8 @@ Dataset::Dataset():
   frecno = 0;
   fbof = feof = true;
   autocommit = true;
+  fstreaming = false;
+  fetched_rows = 0;
   fieldIndexMapID = ~0;
 
   fields_object = new Fields();
@@ -111,6 +113,8 @@ Dataset::Dataset(Database *newDb):
   frecno = 0;
   fbof = feof = true;
   autocommit = true;
+  fstreaming = false;
+  fetched_rows = 0;
   fieldIndexMapID = ~0;
 
   fields_object = new Fields();
@@ -202,11 +206,70 @@ void Dataset::parse_sql(std::string &sql) {
 }
 
 
+std::string Dataset::bind_params(const std::string &sql, const BindList &params) {
+  if (db == NULL) throw DbErrors("No Database Connection");
+  std::string result;
+  result.reserve(sql.size() + params.size() * 16);
+  BindList::const_iterator param = params.begin();
+  bool quoted = false;
+  for (std::string::const_iterator c = sql.begin(); c != sql.end(); ++c) {
+    if (*c == '\'')
+      quoted = !quoted;
+    if (*c != '?' || quoted) {
+      result += *c;
+      continue;
+    }
+    if (param == params.end())
+      throw DbErrors("Too few bind parameters for query: %s", sql.c_str());
+
+    if (param->get_isNull())
+      result += "NULL";
+    else {
+      switch (param->get_fType()) {
+      case ft_String:
+      case ft_Char:
+      case ft_WChar:
+      case ft_WideString:
+        result += db->prepare("'%s'", param->get_asString().c_str());
+        break;
+      case ft_Boolean:
+        result += param->get_asBool() ? "1" : "0";
+        break;
+      case ft_Float:
+      case ft_Double:
+      case ft_LongDouble:
+        result += db->prepare("%.17g", param->get_asDouble());
+        break;
+      default:
+        result += param->get_asString();
+        break;
+      }
+    }
+    ++param;
+  }
+  if (param != params.end())
+    throw DbErrors("Too many bind parameters for query: %s", sql.c_str());
+  return result;
+}
+
+
+bool Dataset::query(const std::string &sql, const BindList &params) {
+  return query(bind_params(sql, params));
+}
+
+
+int Dataset::exec(const std::string &sql, const BindList &params) {
+  return exec(bind_params(sql, params));
+}
+
+
 void Dataset::close(void) {
   haveError  = false;
   frecno = 0;
   fbof = feof = true;
   active = false;
+  fstreaming = false;
+  fetched_rows = 0;
 
   fieldIndexMap_Entries.clear();
   fieldIndexMap_Sorter.clear();
@@ -56,6 +56,19 @@ class Dataset;		// forward declaration of class Dataset
 #define DB_UNEXPECTED		7	// This shouldn't ever happen
 #define DB_UNEXPECTED_RESULT   -1       //For integer functions
 
+/* values bound in order to the '?' placeholders of a parameterised query */
+typedef std::vector<field_value> BindList;
+
+/* counters of a per connection cache of compiled statements */
+struct StatementCacheStats
+{
+  StatementCacheStats() : hits(0), misses(0), evictions(0), size(0) {}
+  uint64_t hits;       // statement was reused from the cache
+  uint64_t misses;     // statement had to be compiled
+  uint64_t evictions;  // least recently used statement was finalized to make room
+  unsigned int size;   // statements currently held by the cache
+};
+
 /******************* Class Database definition ********************
 
    represents  connection with database server;
@@ -165,6 +178,9 @@ public:
 
   virtual bool in_transaction() {return false;};
 
+/* fills stats with the compiled statement cache counters, returns false if the backend has no such cache */
+  virtual bool getStatementCacheStats(StatementCacheStats &stats) const { return false; }
+
 };
 
 
@@ -211,6 +227,8 @@ protected:
   ParamList plist;              // Paramlist for locate
   bool fbof, feof;
   bool autocommit;		// for transactions
+  bool fstreaming;		// forward-only cursor, rows are fetched as next() is called
+  int fetched_rows;		// rows fetched so far by a forward-only cursor
 
 
 /* Variables to store SQL statements */
@@ -308,6 +326,20 @@ public:
   virtual const void* getExecRes()=0;
 /* as open, but with our query exept Sql */
   virtual bool query(const std::string &sql) = 0;
+/* as query, but binds params in order to the '?' placeholders of sql */
+  virtual bool query(const std::string &sql, const BindList &params);
+/* as query, but opens a forward-only cursor which fetches one row at a time as next()
+   is called instead of materializing the whole result set up front. While streaming,
+   num_rows() is the number of rows fetched so far, get_result_set() holds the current
+   row only and seek(), prev() and last() are not supported. Backends without cursor
+   support fall back to query() */
+  virtual bool query_streaming(const std::string &sql) { return query(sql); }
+/* true if the current result is read through a forward-only cursor */
+  bool is_streaming() const { return fstreaming; }
+/* as exec, but binds params in order to the '?' placeholders of sql */
+  virtual int  exec(const std::string &sql, const BindList &params);
+/* substitutes params as escaped literals for the '?' placeholders of sql */
+  std::string bind_params(const std::string &sql, const BindList &params);
 /* Close SQL Query*/
   virtual void close();
 /* This function looks for field Field_name with value equal Field_value
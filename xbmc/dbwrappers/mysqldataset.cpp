@@ -1352,6 +1352,7 @@ char *MysqlDatabase::mysql_vmprintf(const char *zFormat, va_list ap) {
 MysqlDataset::MysqlDataset():Dataset() {
   haveError = false;
   db = NULL;
+  cursor = NULL;
   errmsg = NULL;
   autorefresh = false;
 }
@@ -1359,11 +1360,13 @@ MysqlDataset::MysqlDataset():Dataset() {
 MysqlDataset::MysqlDataset(MysqlDatabase *newDb):Dataset(newDb) {
   haveError = false;
   db = newDb;
+  cursor = NULL;
   errmsg = NULL;
   autorefresh = false;
 }
 
 MysqlDataset::~MysqlDataset() {
+   if (cursor) mysql_free_result(cursor);
    if (errmsg) free(errmsg);
  }
 
@@ -1584,58 +1587,7 @@ bool MysqlDataset::query(const std::string &query) {
   while ((row = mysql_fetch_row(stmt)))
   { // have a row of data
     sql_record *res = new sql_record;
-    res->resize(numColumns);
-    for (unsigned int i = 0; i < numColumns; i++)
-    {
-      field_value &v = res->at(i);
-      switch (fields[i].type)
-      {
-        case MYSQL_TYPE_LONGLONG:
-        case MYSQL_TYPE_DECIMAL:
-        case MYSQL_TYPE_NEWDECIMAL:
-        case MYSQL_TYPE_TINY:
-        case MYSQL_TYPE_SHORT:
-        case MYSQL_TYPE_INT24:
-        case MYSQL_TYPE_LONG:
-          if (row[i] != NULL)
-          {
-            v.set_asInt(atoi(row[i]));
-          }
-          else
-          {
-            v.set_asInt(0);
-          }
-          break;
-        case MYSQL_TYPE_FLOAT:
-        case MYSQL_TYPE_DOUBLE:
-          if (row[i] != NULL)
-          {
-            v.set_asDouble(atof(row[i]));
-          }
-          else
-          {
-            v.set_asDouble(0);
-          }
-          break;
-        case MYSQL_TYPE_STRING:
-        case MYSQL_TYPE_VAR_STRING:
-        case MYSQL_TYPE_VARCHAR:
-          if (row[i] != NULL) v.set_asString((const char *)row[i] );
-          break;
-        case MYSQL_TYPE_TINY_BLOB:
-        case MYSQL_TYPE_MEDIUM_BLOB:
-        case MYSQL_TYPE_LONG_BLOB:
-        case MYSQL_TYPE_BLOB:
-          if (row[i] != NULL) v.set_asString((const char *)row[i]);
-          break;
-        case MYSQL_TYPE_NULL:
-        default:
-          CLog::Log(LOGDEBUG,"MYSQL: Unknown field type: %u", fields[i].type);
-          v.set_asString("");
-          v.set_isNull();
-          break;
-      }
-    }
+    fetch_row(fields, row, *res);
     result.records.push_back(res);
   }
   mysql_free_result(stmt);
@@ -1645,6 +1597,133 @@ bool MysqlDataset::query(const std::string &query) {
   return true;
 }
 
+void MysqlDataset::fetch_row(MYSQL_FIELD *fields, MYSQL_ROW row, sql_record &rec) {
+  const unsigned int numColumns = result.record_header.size();
+  rec.resize(numColumns);
+  for (unsigned int i = 0; i < numColumns; i++)
+  {
+    field_value &v = rec.at(i);
+    switch (fields[i].type)
+    {
+      case MYSQL_TYPE_LONGLONG:
+      case MYSQL_TYPE_DECIMAL:
+      case MYSQL_TYPE_NEWDECIMAL:
+      case MYSQL_TYPE_TINY:
+      case MYSQL_TYPE_SHORT:
+      case MYSQL_TYPE_INT24:
+      case MYSQL_TYPE_LONG:
+        if (row[i] != NULL)
+        {
+          v.set_asInt(atoi(row[i]));
+        }
+        else
+        {
+          v.set_asInt(0);
+        }
+        break;
+      case MYSQL_TYPE_FLOAT:
+      case MYSQL_TYPE_DOUBLE:
+        if (row[i] != NULL)
+        {
+          v.set_asDouble(atof(row[i]));
+        }
+        else
+        {
+          v.set_asDouble(0);
+        }
+        break;
+      case MYSQL_TYPE_STRING:
+      case MYSQL_TYPE_VAR_STRING:
+      case MYSQL_TYPE_VARCHAR:
+        if (row[i] != NULL) v.set_asString((const char *)row[i] );
+        break;
+      case MYSQL_TYPE_TINY_BLOB:
+      case MYSQL_TYPE_MEDIUM_BLOB:
+      case MYSQL_TYPE_LONG_BLOB:
+      case MYSQL_TYPE_BLOB:
+        if (row[i] != NULL) v.set_asString((const char *)row[i]);
+        break;
+      case MYSQL_TYPE_NULL:
+      default:
+        CLog::Log(LOGDEBUG,"MYSQL: Unknown field type: %u", fields[i].type);
+        v.set_asString("");
+        v.set_isNull();
+        break;
+    }
+  }
+}
+
+bool MysqlDataset::step_cursor() {
+  if (cursor == NULL)
+    return false;
+
+  MYSQL_ROW row = mysql_fetch_row(cursor);
+  if (row)
+  {
+    // reuse the single row buffer of the result set
+    if (result.records.empty())
+      result.records.push_back(new sql_record);
+    *result.records[0] = sql_record();
+    fetch_row(mysql_fetch_fields(cursor), row, *result.records[0]);
+    frecno = 0;
+    fetched_rows++;
+    return true;
+  }
+
+  // done or failed, an error is flagged on the connection
+  unsigned int err = mysql_errno(handle());
+  mysql_free_result(cursor);
+  cursor = NULL;
+  for (unsigned int i = 0; i < result.records.size(); i++)
+    delete result.records[i];
+  result.records.clear();
+  feof = true;
+
+  if (err != 0)
+  {
+    static_cast<MysqlDatabase*>(db)->setErr(err, "streaming query");
+    throw DbErrors(db->getErrorMsg());
+  }
+  return false;
+}
+
+bool MysqlDataset::query_streaming(const std::string &query) {
+  if(!handle()) throw DbErrors("No Database Connection");
+  std::string qry = query;
+  if (qry.find("select") == std::string::npos && qry.find("SELECT") == std::string::npos)
+    throw DbErrors("MUST be select SQL!");
+
+  close();
+
+  size_t loc;
+
+  // mysql doesn't understand CAST(foo as integer) => change to CAST(foo as signed integer)
+  while ((loc = ci_find(qry, "as integer)")) != std::string::npos)
+    qry = qry.insert(loc + 3, "signed ");
+
+  if ( static_cast<MysqlDatabase*>(db)->setErr(static_cast<MysqlDatabase*>(db)->query_with_reconnect(qry.c_str()), qry.c_str()) != MYSQL_OK )
+    throw DbErrors(db->getErrorMsg());
+
+  cursor = mysql_use_result(handle());
+  if (cursor == NULL)
+    throw DbErrors("Missing result set!");
+
+  // column headers
+  const unsigned int numColumns = mysql_num_fields(cursor);
+  MYSQL_FIELD *fields = mysql_fetch_fields(cursor);
+  result.record_header.resize(numColumns);
+  for (unsigned int i = 0; i < numColumns; i++)
+    result.record_header[i].name = fields[i].name;
+
+  fstreaming = true;
+  active = true;
+  ds_state = dsSelect;
+
+  fbof = feof = !step_cursor();
+  fill_fields();
+  return true;
+}
+
 void MysqlDataset::open(const std::string &sql) {
    set_select_sql(sql);
    open();
@@ -1662,6 +1741,11 @@ void MysqlDataset::open() {
 }
 
 void MysqlDataset::close() {
+  if (cursor)
+  {
+    mysql_free_result(cursor);
+    cursor = NULL;
+  }
   Dataset::close();
   result.clear();
   edit_object->clear();
@@ -1681,6 +1765,8 @@ void MysqlDataset::cancel() {
 }
 
 int MysqlDataset::num_rows() {
+  if (fstreaming)
+    return fetched_rows;
   return result.records.size();
 }
 
@@ -1693,21 +1779,36 @@ bool MysqlDataset::bof() {
 }
 
 void MysqlDataset::first() {
+  if (fstreaming)
+  {
+    if (fetched_rows > 1)
+      throw DbErrors("Can't rewind a streaming query");
+    return;
+  }
   Dataset::first();
   this->fill_fields();
 }
 
 void MysqlDataset::last() {
+  if (fstreaming) throw DbErrors("Can't seek in a streaming query");
   Dataset::last();
   fill_fields();
 }
 
 void MysqlDataset::prev(void) {
+  if (fstreaming) throw DbErrors("Can't seek in a streaming query");
   Dataset::prev();
   fill_fields();
 }
 
 void MysqlDataset::next(void) {
+  if (fstreaming)
+  {
+    fbof = false;
+    if (!feof && step_cursor())
+      fill_fields();
+    return;
+  }
   Dataset::next();
   if (!eof())
       fill_fields();
@@ -1727,6 +1828,7 @@ void MysqlDataset::free_row(void)
 }
 
 bool MysqlDataset::seek(int pos) {
+  if (fstreaming) throw DbErrors("Can't seek in a streaming query");
   if (ds_state == dsSelect)
   {
     Dataset::seek(pos);
@@ -128,6 +128,14 @@ protected:
 /* Changing field values during dataset navigation */
   virtual void free_row();  // free the memory allocated for the current row
 
+/* copies row of a result with the given fields into rec */
+  void fetch_row(MYSQL_FIELD *fields, MYSQL_ROW row, sql_record &rec);
+/* fetches the next row of the forward-only cursor, returns false once it is exhausted */
+  bool step_cursor();
+
+/* unbuffered result of an open forward-only cursor */
+  MYSQL_RES *cursor;
+
 public:
 /* constructor */
   MysqlDataset();
@@ -149,6 +157,9 @@ or insert() operations default = false) */
   virtual const void* getExecRes();
 /* as open, but with our query exept Sql */
   virtual bool query(const std::string &query);
+/* forward-only cursor through mysql_use_result(). No other query may be run on the
+   connection until the cursor is exhausted or closed */
+  virtual bool query_streaming(const std::string &query);
 /* func. closes a query */
   virtual void close(void);
 /* Cancel changes, made in insert or edit states of dataset */
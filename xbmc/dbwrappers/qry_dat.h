@@ -77,6 +77,7 @@ private:
 public:
   field_value();
   field_value(const char *s);
+  field_value(const std::string &s);
   field_value(const bool b);
   field_value(const char c);
   field_value(const short s);
@@ -46,6 +46,10 @@
 using namespace XFILE;
 
 namespace dbiplus {
+
+// number of compiled statements kept per connection
+static const size_t STATEMENT_CACHE_SIZE = 64;
+
 //************* Callback function ***************************
 
 int callback(void* res_ptr,int ncol, char** reslt,char** cols)
@@ -197,6 +201,8 @@ int SqliteDatabase::setErr(int err_code, const char * qry){
     break;
   case SQLITE_MISMATCH:  error = "Data type mismatch";
     break;
+  case SQLITE_RANGE: error = "Bind parameter index out of range";
+    break;
   default : error = "Undefined SQLite error";
   }
   error = "[" + db + "] " + error;
@@ -281,6 +287,7 @@ bool SqliteDatabase::exists(void)
 
 void SqliteDatabase::disconnect(void) {
   if (active == false) return;
+  clear_statement_cache();
   sqlite3_close(conn);
   active = false;
 }
@@ -436,6 +443,60 @@ void SqliteDatabase::rollback_transaction() {
 }
 
 
+// methods for the statement cache
+// ---------------------------------------------
+int SqliteDatabase::acquire_statement(const std::string &sql, sqlite3_stmt **stmt) {
+  std::unordered_map<std::string, StatementList::iterator>::iterator it = stmt_index.find(sql);
+  if (it != stmt_index.end()) {
+    *stmt = it->second->second;
+    stmt_cache.erase(it->second);
+    stmt_index.erase(it);
+    stmt_stats.hits++;
+    return SQLITE_OK;
+  }
+
+  stmt_stats.misses++;
+  *stmt = NULL;
+  return sqlite3_prepare_v2(conn, sql.c_str(), -1, stmt, NULL);
+}
+
+void SqliteDatabase::release_statement(const std::string &sql, sqlite3_stmt *stmt) {
+  if (stmt == NULL) return;
+
+  sqlite3_reset(stmt);
+  sqlite3_clear_bindings(stmt);
+
+  // the same sql may have been compiled twice by nested queries, keep only one
+  if (!active || stmt_index.find(sql) != stmt_index.end()) {
+    sqlite3_finalize(stmt);
+    return;
+  }
+
+  stmt_cache.push_front(std::make_pair(sql, stmt));
+  stmt_index[sql] = stmt_cache.begin();
+
+  if (stmt_cache.size() > STATEMENT_CACHE_SIZE) {
+    stmt_index.erase(stmt_cache.back().first);
+    sqlite3_finalize(stmt_cache.back().second);
+    stmt_cache.pop_back();
+    stmt_stats.evictions++;
+  }
+}
+
+void SqliteDatabase::clear_statement_cache() {
+  for (StatementList::iterator i = stmt_cache.begin(); i != stmt_cache.end(); ++i)
+    sqlite3_finalize(i->second);
+  stmt_cache.clear();
+  stmt_index.clear();
+}
+
+bool SqliteDatabase::getStatementCacheStats(StatementCacheStats &stats) const {
+  stats = stmt_stats;
+  stats.size = stmt_cache.size();
+  return true;
+}
+
+
 // methods for formatting
 // ---------------------------------------------
 std::string SqliteDatabase::vprepare(const char *format, va_list args)
@@ -473,6 +534,7 @@ std::string SqliteDatabase::vprepare(const char *format, va_list args)
 SqliteDataset::SqliteDataset():Dataset() {
   haveError = false;
   db = NULL;
+  cursor = NULL;
   errmsg = NULL;
   autorefresh = false;
 }
@@ -481,11 +543,13 @@ SqliteDataset::SqliteDataset():Dataset() {
 SqliteDataset::SqliteDataset(SqliteDatabase *newDb):Dataset(newDb) {
   haveError = false;
   db = newDb;
+  cursor = NULL;
   errmsg = NULL;
   autorefresh = false;
 }
 
  SqliteDataset::~SqliteDataset(){
+   if (cursor) sqlite3_finalize(cursor);
    if (errmsg) sqlite3_free(errmsg);
  }
 
@@ -588,6 +652,124 @@ void SqliteDataset::fill_fields() {
 }
 
 
+int SqliteDataset::bind_statement(sqlite3_stmt *stmt, const BindList &params) {
+  if ((size_t)sqlite3_bind_parameter_count(stmt) != params.size())
+    return SQLITE_RANGE;
+
+  int rc = SQLITE_OK;
+  for (unsigned int i = 0; i < params.size() && rc == SQLITE_OK; i++)
+  {
+    const field_value &v = params[i];
+    const int col = i + 1;
+    if (v.get_isNull())
+    {
+      rc = sqlite3_bind_null(stmt, col);
+      continue;
+    }
+    switch (v.get_fType())
+    {
+    case ft_Boolean:
+    case ft_Short:
+    case ft_UShort:
+    case ft_Int:
+    case ft_UInt:
+    case ft_Int64:
+      rc = sqlite3_bind_int64(stmt, col, v.get_asInt64());
+      break;
+    case ft_Float:
+    case ft_Double:
+    case ft_LongDouble:
+      rc = sqlite3_bind_double(stmt, col, v.get_asDouble());
+      break;
+    default:
+    {
+      const std::string str = v.get_asString();
+      rc = sqlite3_bind_text(stmt, col, str.c_str(), (int)str.size(), SQLITE_TRANSIENT);
+      break;
+    }
+    }
+  }
+  return rc;
+}
+
+void SqliteDataset::fetch_header(sqlite3_stmt *stmt) {
+  const unsigned int numColumns = sqlite3_column_count(stmt);
+  result.record_header.resize(numColumns);
+  for (unsigned int i = 0; i < numColumns; i++)
+    result.record_header[i].name = sqlite3_column_name(stmt, i);
+}
+
+void SqliteDataset::fetch_row(sqlite3_stmt *stmt, sql_record &row) {
+  const unsigned int numColumns = result.record_header.size();
+  row.resize(numColumns);
+  for (unsigned int i = 0; i < numColumns; i++)
+  {
+    field_value &v = row.at(i);
+    switch (sqlite3_column_type(stmt, i))
+    {
+    case SQLITE_INTEGER:
+      v.set_asInt64(sqlite3_column_int64(stmt, i));
+      break;
+    case SQLITE_FLOAT:
+      v.set_asDouble(sqlite3_column_double(stmt, i));
+      break;
+    case SQLITE_TEXT:
+      v.set_asString((const char *)sqlite3_column_text(stmt, i));
+      break;
+    case SQLITE_BLOB:
+      v.set_asString((const char *)sqlite3_column_text(stmt, i));
+      break;
+    case SQLITE_NULL:
+    default:
+      v.set_asString("");
+      v.set_isNull();
+      break;
+    }
+  }
+}
+
+void SqliteDataset::fetch_rows(sqlite3_stmt *stmt) {
+  fetch_header(stmt);
+
+  while (sqlite3_step(stmt) == SQLITE_ROW)
+  { // have a row of data
+    sql_record *res = new sql_record;
+    fetch_row(stmt, *res);
+    result.records.push_back(res);
+  }
+}
+
+bool SqliteDataset::step_cursor() {
+  if (cursor == NULL)
+    return false;
+
+  if (sqlite3_step(cursor) == SQLITE_ROW)
+  {
+    // reuse the single row buffer of the result set
+    if (result.records.empty())
+      result.records.push_back(new sql_record);
+    *result.records[0] = sql_record();
+    fetch_row(cursor, *result.records[0]);
+    frecno = 0;
+    fetched_rows++;
+    return true;
+  }
+
+  // done or failed, finalize returns the error of the last step
+  std::string qry = sqlite3_sql(cursor);
+  int rc = sqlite3_finalize(cursor);
+  cursor = NULL;
+  for (unsigned int i = 0; i < result.records.size(); i++)
+    delete result.records[i];
+  result.records.clear();
+  feof = true;
+
+  if (db->setErr(rc,qry.c_str()) != SQLITE_OK)
+    throw DbErrors(db->getErrorMsg());
+  return false;
+}
+
+
 //------------- public functions implementation -----------------//
 bool SqliteDataset::dropIndex(const char *table, const char *index)
 {
@@ -674,43 +856,7 @@ bool SqliteDataset::query(const std::string &query) {
   if (db->setErr(sqlite3_prepare_v2(handle(),query.c_str(),-1,&stmt, NULL),query.c_str()) != SQLITE_OK)
     throw DbErrors(db->getErrorMsg());
 
-  // column headers
-  const unsigned int numColumns = sqlite3_column_count(stmt);
-  result.record_header.resize(numColumns);
-  for (unsigned int i = 0; i < numColumns; i++)
-    result.record_header[i].name = sqlite3_column_name(stmt, i);
-
-  // returned rows
-  while (sqlite3_step(stmt) == SQLITE_ROW)
-  { // have a row of data
-    sql_record *res = new sql_record;
-    res->resize(numColumns);
-    for (unsigned int i = 0; i < numColumns; i++)
-    {
-      field_value &v = res->at(i);
-      switch (sqlite3_column_type(stmt, i))
-      {
-      case SQLITE_INTEGER:
-        v.set_asInt64(sqlite3_column_int64(stmt, i));
-        break;
-      case SQLITE_FLOAT:
-        v.set_asDouble(sqlite3_column_double(stmt, i));
-        break;
-      case SQLITE_TEXT:
-        v.set_asString((const char *)sqlite3_column_text(stmt, i));
-        break;
-      case SQLITE_BLOB:
-        v.set_asString((const char *)sqlite3_column_text(stmt, i));
-        break;
-      case SQLITE_NULL:
-      default:
-        v.set_asString("");
-        v.set_isNull();
-        break;
-      }
-    }
-    result.records.push_back(res);
-  }
+  fetch_rows(stmt);
   if (db->setErr(sqlite3_finalize(stmt),query.c_str()) == SQLITE_OK)
   {
     active = true;
@@ -724,6 +870,81 @@ bool SqliteDataset::query(const std::string &query) {
   }  
 }
 
+bool SqliteDataset::query_streaming(const std::string &query) {
+  if(!handle()) throw DbErrors("No Database Connection");
+  if (query.find("select") == std::string::npos && query.find("SELECT") == std::string::npos)
+    throw DbErrors("MUST be select SQL!");
+
+  close();
+
+  if (db->setErr(sqlite3_prepare_v2(handle(),query.c_str(),-1,&cursor, NULL),query.c_str()) != SQLITE_OK)
+  {
+    cursor = NULL;
+    throw DbErrors(db->getErrorMsg());
+  }
+
+  fetch_header(cursor);
+  fstreaming = true;
+  active = true;
+  ds_state = dsSelect;
+
+  fbof = feof = !step_cursor();
+  fill_fields();
+  return true;
+}
+
+bool SqliteDataset::query(const std::string &query, const BindList &params) {
+  if(!handle()) throw DbErrors("No Database Connection");
+  if (query.find("select") == std::string::npos && query.find("SELECT") == std::string::npos)
+    throw DbErrors("MUST be select SQL!");
+
+  close();
+
+  SqliteDatabase *sqlite = static_cast<SqliteDatabase*>(db);
+  sqlite3_stmt *stmt = NULL;
+  if (db->setErr(sqlite->acquire_statement(query, &stmt),query.c_str()) != SQLITE_OK)
+    throw DbErrors(db->getErrorMsg());
+
+  int rc = bind_statement(stmt, params);
+  if (rc == SQLITE_OK)
+  {
+    fetch_rows(stmt);
+    rc = sqlite3_reset(stmt);
+  }
+  sqlite->release_statement(query, stmt);
+
+  if (db->setErr(rc,query.c_str()) != SQLITE_OK)
+    throw DbErrors(db->getErrorMsg());
+
+  active = true;
+  ds_state = dsSelect;
+  this->first();
+  return true;
+}
+
+int SqliteDataset::exec(const std::string &sql, const BindList &params) {
+  if (!handle()) throw DbErrors("No Database Connection");
+  exec_res.clear();
+
+  SqliteDatabase *sqlite = static_cast<SqliteDatabase*>(db);
+  sqlite3_stmt *stmt = NULL;
+  if (db->setErr(sqlite->acquire_statement(sql, &stmt),sql.c_str()) != SQLITE_OK)
+    throw DbErrors(db->getErrorMsg());
+
+  int rc = bind_statement(stmt, params);
+  if (rc == SQLITE_OK)
+  {
+    while (sqlite3_step(stmt) == SQLITE_ROW)
+      ;
+    rc = sqlite3_reset(stmt);
+  }
+  sqlite->release_statement(sql, stmt);
+
+  if (db->setErr(rc,sql.c_str()) != SQLITE_OK)
+    throw DbErrors(db->getErrorMsg());
+  return rc;
+}
+
 void SqliteDataset::open(const std::string &sql) {
   set_select_sql(sql);
   open();
@@ -740,6 +961,11 @@ void SqliteDataset::open() {
 
 
 void SqliteDataset::close() {
+  if (cursor)
+  {
+    sqlite3_finalize(cursor);
+    cursor = NULL;
+  }
   Dataset::close();
   result.clear();
   edit_object->clear();
@@ -760,6 +986,8 @@ void SqliteDataset::cancel() {
 
 
 int SqliteDataset::num_rows() {
+  if (fstreaming)
+    return fetched_rows;
   return result.records.size();
 }
 
@@ -775,21 +1003,36 @@ bool SqliteDataset::bof() {
 
 
 void SqliteDataset::first() {
+  if (fstreaming)
+  {
+    if (fetched_rows > 1)
+      throw DbErrors("Can't rewind a streaming query");
+    return;
+  }
   Dataset::first();
   this->fill_fields();
 }
 
 void SqliteDataset::last() {
+  if (fstreaming) throw DbErrors("Can't seek in a streaming query");
   Dataset::last();
   fill_fields();
 }
 
 void SqliteDataset::prev(void) {
+  if (fstreaming) throw DbErrors("Can't seek in a streaming query");
   Dataset::prev();
   fill_fields();
 }
 
 void SqliteDataset::next(void) {
+  if (fstreaming)
+  {
+    fbof = false;
+    if (!feof && step_cursor())
+      fill_fields();
+    return;
+  }
   Dataset::next();
   if (!eof()) 
       fill_fields();
@@ -809,6 +1052,7 @@ void SqliteDataset::free_row(void)
 }
 
 bool SqliteDataset::seek(int pos) {
+  if (fstreaming) throw DbErrors("Can't seek in a streaming query");
   if (ds_state == dsSelect) {
     Dataset::seek(pos);
     fill_fields();
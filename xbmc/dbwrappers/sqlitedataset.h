@@ -29,6 +29,8 @@
  **********************************************************************/
 
 #include <stdio.h>
+#include <list>
+#include <unordered_map>
 #include "dataset.h"
 #include <sqlite3.h>
 
@@ -45,6 +47,15 @@ protected:
   bool _in_transaction;
   int last_err;
 
+/* compiled statements keyed by their sql, most recently used first */
+  typedef std::list<std::pair<std::string, sqlite3_stmt*> > StatementList;
+  StatementList stmt_cache;
+  std::unordered_map<std::string, StatementList::iterator> stmt_index;
+  StatementCacheStats stmt_stats;
+
+/* finalizes all cached statements */
+  void clear_statement_cache();
+
 public:
 /* default constructor */
   SqliteDatabase();
@@ -96,6 +107,14 @@ public:
 
   bool in_transaction() {return _in_transaction;}; 	
 
+/* returns a compiled statement for sql in stmt, taken from the cache when possible.
+   The caller owns the statement until it is handed back with release_statement() */
+  int acquire_statement(const std::string &sql, sqlite3_stmt **stmt);
+/* resets stmt and puts it back into the cache, evicting the least recently used one if full */
+  void release_statement(const std::string &sql, sqlite3_stmt *stmt);
+
+  virtual bool getStatementCacheStats(StatementCacheStats &stats) const;
+
 };
 
 
@@ -121,6 +140,20 @@ protected:
 
   //static int sqlite_callback(void* res_ptr,int ncol, char** reslt, char** cols);
 
+/* binds params in order to the placeholders of stmt */
+  int bind_statement(sqlite3_stmt *stmt, const BindList &params);
+/* copies the column names of stmt into the result set header */
+  void fetch_header(sqlite3_stmt *stmt);
+/* copies the current row of stmt into row */
+  void fetch_row(sqlite3_stmt *stmt, sql_record &row);
+/* steps through stmt and copies the rows into the result set */
+  void fetch_rows(sqlite3_stmt *stmt);
+/* steps the forward-only cursor to the next row, returns false once it is exhausted */
+  bool step_cursor();
+
+/* statement of an open forward-only cursor */
+  sqlite3_stmt *cursor;
+
 /* This function works only with MySQL database
   Filling the fields information from select statement */
   virtual void fill_fields();
@@ -148,6 +181,10 @@ or insert() operations default = false) */
   virtual const void* getExecRes();
 /* as open, but with our query exept Sql */
   virtual bool query(const std::string &query);
+  virtual bool query_streaming(const std::string &query);
+/* as query/exec, but using a cached compiled statement with params bound */
+  virtual bool query(const std::string &query, const BindList &params);
+  virtual int  exec (const std::string &sql, const BindList &params);
 /* func. closes a query */
   virtual void close(void);
 /* Cancel changes, made in insert or edit states of dataset */
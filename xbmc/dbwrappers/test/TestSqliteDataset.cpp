@@ -0,0 +1,93 @@
+/*
+ *      Copyright (C) 2005-2013 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <memory>
+
+#include "dbwrappers/sqlitedataset.h"
+#include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
+
+#include "gtest/gtest.h"
+
+using namespace dbiplus;
+
+class TestSqliteDataset : public ::testing::Test
+{
+protected:
+  SqliteDatabase database;
+  std::unique_ptr<Dataset> dataset;
+
+  void SetUp() override
+  {
+    database.setHostName(CSpecialProtocol::TranslatePath("special://temp/").c_str());
+    database.setDatabase("TestSqliteDataset");
+    ASSERT_EQ(DB_CONNECTION_OK, database.connect(true));
+
+    dataset.reset(database.CreateDataset());
+    dataset->exec("CREATE TABLE test (id INTEGER PRIMARY KEY, value TEXT)");
+    dataset->exec("INSERT INTO test VALUES (1, NULL)");
+    dataset->exec("INSERT INTO test VALUES (2, 'two')");
+    dataset->exec("INSERT INTO test VALUES (3, NULL)");
+  }
+
+  void TearDown() override
+  {
+    dataset.reset();
+    database.disconnect();
+    XFILE::CFile::Delete("special://temp/TestSqliteDataset.db");
+  }
+};
+
+TEST_F(TestSqliteDataset, Query)
+{
+  ASSERT_TRUE(dataset->query("SELECT id, value FROM test ORDER BY id"));
+  EXPECT_FALSE(dataset->is_streaming());
+  EXPECT_EQ(3, dataset->num_rows());
+  EXPECT_TRUE(dataset->fv(1).get_isNull());
+  dataset->next();
+  EXPECT_FALSE(dataset->fv(1).get_isNull());
+  EXPECT_EQ("two", dataset->fv(1).get_asString());
+}
+
+TEST_F(TestSqliteDataset, QueryStreaming)
+{
+  ASSERT_TRUE(dataset->query_streaming("SELECT id, value FROM test ORDER BY id"));
+  EXPECT_TRUE(dataset->is_streaming());
+
+  ASSERT_FALSE(dataset->eof());
+  EXPECT_EQ(1, dataset->fv(0).get_asInt());
+  EXPECT_TRUE(dataset->fv(1).get_isNull());
+
+  // the row buffer is reused, a NULL must not stick to the next row
+  dataset->next();
+  ASSERT_FALSE(dataset->eof());
+  EXPECT_EQ(2, dataset->fv(0).get_asInt());
+  EXPECT_FALSE(dataset->fv(1).get_isNull());
+  EXPECT_EQ("two", dataset->fv(1).get_asString());
+
+  dataset->next();
+  ASSERT_FALSE(dataset->eof());
+  EXPECT_EQ(3, dataset->fv(0).get_asInt());
+  EXPECT_TRUE(dataset->fv(1).get_isNull());
+
+  dataset->next();
+  EXPECT_TRUE(dataset->eof());
+  EXPECT_EQ(3, dataset->num_rows());
+}
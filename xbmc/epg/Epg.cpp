@@ -20,6 +20,7 @@
 
 #include "Epg.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "addons/kodi-addon-dev-kit/include/kodi/xbmc_epg_types.h"
@@ -94,6 +95,7 @@ CEpg &CEpg::operator =(const CEpg &right)
 
   for (std::map<CDateTime, CEpgInfoTagPtr>::const_iterator it = right.m_tags.begin(); it != right.m_tags.end(); ++it)
     m_tags.insert(make_pair(it->first, it->second));
+  InvalidateTagIndex();
 
   return *this;
 }
@@ -141,6 +143,7 @@ void CEpg::Clear(void)
 {
   CSingleLock lock(m_critSection);
   m_tags.clear();
+  m_tagIndex = TagIndex();
 }
 
 void CEpg::Cleanup(void)
@@ -163,6 +166,7 @@ void CEpg::Cleanup(const CDateTime &Time)
       it->second->ClearTimer();
       it->second->ClearRecording();
       it = m_tags.erase(it);
+      InvalidateTagIndex();
     }
     else
     {
@@ -181,20 +185,35 @@ CEpgInfoTagPtr CEpg::GetTagNow(bool bUpdateIfNeeded /* = true */) const
       return it->second;
   }
 
-  if (bUpdateIfNeeded)
+  if (bUpdateIfNeeded && !m_tags.empty())
   {
     CEpgInfoTagPtr lastActiveTag;
 
-    /* one of the first items will always match if the list is sorted */
-    for (std::map<CDateTime, CEpgInfoTagPtr>::const_iterator it = m_tags.begin(); it != m_tags.end(); ++it)
+    UpdateTagIndex();
+    const CDateTime now(m_tagIndex.tags.front()->GetCurrentPlayingTime());
+    time_t iNow;
+    now.GetAsTime(iNow);
+
+    /* only the tags in this range can be active, everything before it ended and everything after it didn't start yet */
+    const std::pair<size_t, size_t> range(FindTagIndexRange(iNow, iNow));
+    for (size_t i = range.first; i < range.second; ++i)
     {
-      if (it->second->IsActive())
+      const CEpgInfoTagPtr &tag = m_tagIndex.tags[i];
+      if (tag->StartAsUTC() <= now && tag->EndAsUTC() > now)
       {
-        m_nowActiveStart = it->first;
-        return it->second;
+        m_nowActiveStart = tag->StartAsUTC();
+        return tag;
+      }
+    }
+
+    /* the last tag that ended before now, if any */
+    for (size_t i = range.second; i > 0; --i)
+    {
+      if (m_tagIndex.tags[i - 1]->EndAsUTC() < now)
+      {
+        lastActiveTag = m_tagIndex.tags[i - 1];
+        break;
       }
-      else if (it->second->WasActive())
-        lastActiveTag = it->second;
     }
 
     /* there might be a gap between the last and next event. return the last if found and it ended not more than 5 minutes ago */
@@ -216,13 +235,23 @@ CEpgInfoTagPtr CEpg::GetTagNext() const
     if (it != m_tags.end() && ++it != m_tags.end())
       return it->second;
   }
-  else if (Size() > 0)
+  else
   {
-    /* return the first event that is in the future */
-    for (std::map<CDateTime, CEpgInfoTagPtr>::const_iterator it = m_tags.begin(); it != m_tags.end(); ++it)
+    CSingleLock lock(m_critSection);
+    if (!m_tags.empty())
     {
-      if (it->second->IsUpcoming())
-        return it->second;
+      /* return the first event that is in the future */
+      UpdateTagIndex();
+      const CDateTime now(m_tagIndex.tags.front()->GetCurrentPlayingTime());
+      time_t iNow;
+      now.GetAsTime(iNow);
+
+      for (size_t i = std::lower_bound(m_tagIndex.start.begin(), m_tagIndex.start.end(), iNow) - m_tagIndex.start.begin();
+           i < m_tagIndex.tags.size(); ++i)
+      {
+        if (m_tagIndex.tags[i]->StartAsUTC() > now)
+          return m_tagIndex.tags[i];
+      }
     }
   }
 
@@ -260,11 +289,20 @@ CEpgInfoTagPtr CEpg::GetTagByBroadcastId(unsigned int iUniqueBroadcastId) const
 
 CEpgInfoTagPtr CEpg::GetTagBetween(const CDateTime &beginTime, const CDateTime &endTime) const
 {
+  time_t iBegin, iEnd;
+  beginTime.GetAsTime(iBegin);
+  endTime.GetAsTime(iEnd);
+
   CSingleLock lock(m_critSection);
-  for (std::map<CDateTime, CEpgInfoTagPtr>::const_iterator it = m_tags.begin(); it != m_tags.end(); ++it)
+  UpdateTagIndex();
+
+  /* tags that start after endTime can't end before it */
+  for (size_t i = std::lower_bound(m_tagIndex.start.begin(), m_tagIndex.start.end(), iBegin) - m_tagIndex.start.begin();
+       i < m_tagIndex.tags.size() && m_tagIndex.start[i] <= iEnd; ++i)
   {
-    if (it->second->StartAsUTC() >= beginTime && it->second->EndAsUTC() <= endTime)
-      return it->second;
+    const CEpgInfoTagPtr &tag = m_tagIndex.tags[i];
+    if (tag->StartAsUTC() >= beginTime && tag->EndAsUTC() <= endTime)
+      return tag;
   }
 
   return CEpgInfoTagPtr();
@@ -274,13 +312,20 @@ std::vector<CEpgInfoTagPtr> CEpg::GetTagsBetween(const CDateTime &beginTime, con
 {
   std::vector<CEpgInfoTagPtr> epgTags;
 
+  time_t iBegin;
+  beginTime.GetAsTime(iBegin);
+
   CSingleLock lock(m_critSection);
-  for (const auto &infoTag : m_tags)
+  UpdateTagIndex();
+
+  for (size_t i = std::lower_bound(m_tagIndex.start.begin(), m_tagIndex.start.end(), iBegin) - m_tagIndex.start.begin();
+       i < m_tagIndex.tags.size(); ++i)
   {
-    if (infoTag.second->StartAsUTC() >= beginTime)
+    const CEpgInfoTagPtr &tag = m_tagIndex.tags[i];
+    if (tag->StartAsUTC() >= beginTime)
     {
-      if (infoTag.second->EndAsUTC() <= endTime)
-        epgTags.emplace_back(infoTag.second);
+      if (tag->EndAsUTC() <= endTime)
+        epgTags.emplace_back(tag);
       else
         break; // done.
     }
@@ -310,6 +355,10 @@ void CEpg::AddEntry(const CEpgInfoTag &tag)
   if (newTag)
   {
     newTag->Update(tag);
+    {
+      CSingleLock lock(m_critSection);
+      InvalidateTagIndex();
+    }
     newTag->SetPVRChannel(channel);
     newTag->SetEpg(this);
     newTag->SetTimer(g_PVRTimers->GetTimerForEpgTag(newTag));
@@ -436,11 +485,15 @@ bool CEpg::UpdateEntry(const CEpgInfoTagPtr &tag, bool bUpdateDatabase /* = fals
       bNewTag = true;
     }
 
+    /* only write tags that are new or whose stored values changed */
+    const bool bPersist(bNewTag || infoTag->DatabaseValuesDiffer(*tag));
+
     infoTag->Update(*tag, bNewTag);
+    InvalidateTagIndex();
     infoTag->SetEpg(this);
     infoTag->SetPVRChannel(m_pvrChannel);
 
-    if (bUpdateDatabase)
+    if (bUpdateDatabase && bPersist)
       m_changedTags.insert(std::make_pair(infoTag->UniqueBroadcastID(), infoTag));
   }
 
@@ -486,6 +539,7 @@ bool CEpg::UpdateEntry(const CEpgInfoTagPtr &tag, EPG_EVENT_STATE newState, bool
         it->second->ClearTimer();
         it->second->ClearRecording();
         m_tags.erase(it);
+        InvalidateTagIndex();
       }
       else
       {
@@ -572,6 +626,28 @@ int CEpg::Get(CFileItemList &results) const
   return results.Size() - iInitialSize;
 }
 
+int CEpg::Get(CFileItemList &results, const CDateTime &windowStart, const CDateTime &windowEnd) const
+{
+  int iInitialSize = results.Size();
+
+  time_t iStart, iEnd;
+  windowStart.GetAsTime(iStart);
+  windowEnd.GetAsTime(iEnd);
+
+  CSingleLock lock(m_critSection);
+  UpdateTagIndex();
+
+  const std::pair<size_t, size_t> range(FindTagIndexRange(iStart, iEnd));
+  for (size_t i = range.first; i < range.second; ++i)
+  {
+    const CEpgInfoTagPtr &tag = m_tagIndex.tags[i];
+    if (tag->EndAsUTC() > windowStart && tag->StartAsUTC() <= windowEnd)
+      results.Add(CFileItemPtr(new CFileItem(tag)));
+  }
+
+  return results.Size() - iInitialSize;
+}
+
 int CEpg::Get(CFileItemList &results, const EpgSearchFilter &filter) const
 {
   int iInitialSize = results.Size();
@@ -590,8 +666,11 @@ int CEpg::Get(CFileItemList &results, const EpgSearchFilter &filter) const
   return results.Size() - iInitialSize;
 }
 
-bool CEpg::Persist(void)
+bool CEpg::Persist(bool bCommit /* = true */, int *iPersistedTags /* = NULL */)
 {
+  if (iPersistedTags)
+    *iPersistedTags = 0;
+
   if (CSettings::GetInstance().GetBool(CSettings::SETTING_EPG_IGNOREDBFORCLIENT) || !NeedsSave())
     return true;
 
@@ -615,11 +694,20 @@ bool CEpg::Persist(void)
         m_iEpgID = iId;
     }
 
+    std::vector<CEpgInfoTagPtr> tags;
+    tags.reserve(std::max(m_deletedTags.size(), m_changedTags.size()));
+
     for (std::map<int, CEpgInfoTagPtr>::iterator it = m_deletedTags.begin(); it != m_deletedTags.end(); ++it)
-      database->Delete(*it->second);
+      tags.push_back(it->second);
+    int iPersisted = database->QueueDelete(tags);
 
+    tags.clear();
     for (std::map<int, CEpgInfoTagPtr>::iterator it = m_changedTags.begin(); it != m_changedTags.end(); ++it)
-      it->second->Persist(false);
+      tags.push_back(it->second);
+    iPersisted += database->QueuePersist(tags);
+
+    if (iPersistedTags)
+      *iPersistedTags = iPersisted;
 
     if (m_bUpdateLastScanTime)
       database->PersistLastEpgScanTime(m_iEpgID, true);
@@ -631,7 +719,7 @@ bool CEpg::Persist(void)
     m_bUpdateLastScanTime = false;
   }
 
-  return database->CommitInsertQueries();
+  return !bCommit || database->CommitInsertQueries();
 }
 
 CDateTime CEpg::GetFirstDate(void) const
@@ -666,6 +754,9 @@ bool CEpg::FixOverlappingEvents(bool bUpdateDb /* = false */)
   bool bReturn(true);
   CEpgInfoTagPtr previousTag, currentTag;
 
+  /* end times are changed and tags are removed below */
+  InvalidateTagIndex();
+
   for (std::map<CDateTime, CEpgInfoTagPtr>::iterator it = m_tags.begin(); it != m_tags.end(); it != m_tags.end() ? it++ : it)
   {
     if (!previousTag)
@@ -705,6 +796,45 @@ bool CEpg::FixOverlappingEvents(bool bUpdateDb /* = false */)
   return bReturn;
 }
 
+void CEpg::UpdateTagIndex(void) const
+{
+  if (m_tagIndex.bValid)
+    return;
+
+  m_tagIndex.start.clear();
+  m_tagIndex.maxEnd.clear();
+  m_tagIndex.tags.clear();
+  m_tagIndex.start.reserve(m_tags.size());
+  m_tagIndex.maxEnd.reserve(m_tags.size());
+  m_tagIndex.tags.reserve(m_tags.size());
+
+  time_t iMaxEnd = 0;
+  for (std::map<CDateTime, CEpgInfoTagPtr>::const_iterator it = m_tags.begin(); it != m_tags.end(); ++it)
+  {
+    time_t iStart, iEnd;
+    it->first.GetAsTime(iStart);
+    it->second->EndAsUTC().GetAsTime(iEnd);
+
+    if (m_tagIndex.tags.empty() || iEnd > iMaxEnd)
+      iMaxEnd = iEnd;
+
+    m_tagIndex.start.push_back(iStart);
+    m_tagIndex.maxEnd.push_back(iMaxEnd);
+    m_tagIndex.tags.push_back(it->second);
+  }
+
+  m_tagIndex.bValid = true;
+}
+
+std::pair<size_t, size_t> CEpg::FindTagIndexRange(time_t start, time_t end) const
+{
+  /* maxEnd is ascending, so every tag before the first one with maxEnd > start ended before start */
+  size_t first = std::upper_bound(m_tagIndex.maxEnd.begin(), m_tagIndex.maxEnd.end(), start) - m_tagIndex.maxEnd.begin();
+  size_t last = std::upper_bound(m_tagIndex.start.begin(), m_tagIndex.start.end(), end) - m_tagIndex.start.begin();
+
+  return std::make_pair(std::min(first, last), last);
+}
+
 bool CEpg::UpdateFromScraper(time_t start, time_t end)
 {
   bool bGrabSuccess = false;
@@ -28,6 +28,8 @@
 #include "EpgSearchFilter.h"
 
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace PVR
 {
@@ -231,6 +233,15 @@ namespace EPG
      */
     int Get(CFileItemList &results) const;
 
+    /*!
+     * @brief Get all EPG entries that are on air at some point in the given window.
+     * @param results The file list to store the results in.
+     * @param windowStart The start of the window (UTC).
+     * @param windowEnd The end of the window (UTC).
+     * @return The amount of entries that were added.
+     */
+    int Get(CFileItemList &results, const CDateTime &windowStart, const CDateTime &windowEnd) const;
+
     /*!
      * @brief Get all EPG entries that and apply a filter.
      * @param results The file list to store the results in.
@@ -240,10 +251,12 @@ namespace EPG
     int Get(CFileItemList &results, const EpgSearchFilter &filter) const;
 
     /*!
-     * @brief Persist this table in the database.
+     * @brief Persist this table in the database. Only tags that changed or were deleted since the last call are written.
+     * @param bCommit True to commit the queued queries, false to leave that to the caller so that several tables are written in one transaction.
+     * @param iPersistedTags If not NULL, set to the amount of tags that were queued for writing or deletion.
      * @return True if the table was persisted, false otherwise.
      */
-    bool Persist(void);
+    bool Persist(bool bCommit = true, int *iPersistedTags = NULL);
 
     /*!
      * @brief Get the start time of the first entry in this table.
@@ -327,6 +340,39 @@ namespace EPG
      */
     bool UpdateEntries(const CEpg &epg, bool bStoreInDb = true);
 
+    /*!
+     * @brief Rebuild the time index if the tags changed since it was last built.
+     */
+    void UpdateTagIndex(void) const;
+
+    /*!
+     * @brief Mark the time index as outdated. Must be called whenever a tag is added, removed or its times changed.
+     */
+    void InvalidateTagIndex(void) { m_tagIndex.bValid = false; }
+
+    /*!
+     * @brief Find the range of indexed tags that are on air at some point between start and end.
+     * @param start The start of the range (UTC).
+     * @param end The end of the range (UTC).
+     * @return The first and one past the last index in m_tagIndex to check. Tags in this range start before end,
+     *         but the caller still has to check whether they end after start.
+     */
+    std::pair<size_t, size_t> FindTagIndexRange(time_t start, time_t end) const;
+
+    /*!
+     * @brief Compact time index of m_tags, ordered by start time, so that range queries are a binary search
+     *        instead of a walk over the whole map.
+     */
+    struct TagIndex
+    {
+      TagIndex(void) : bValid(false) {}
+
+      std::vector<time_t>         start;  /*!< start times (UTC), ascending */
+      std::vector<time_t>         maxEnd; /*!< maxEnd[i] is the latest end time (UTC) of the tags 0..i */
+      std::vector<CEpgInfoTagPtr> tags;   /*!< the tags, in the same order */
+      bool                        bValid; /*!< false when m_tags changed after the index was built */
+    };
+
     std::map<CDateTime, CEpgInfoTagPtr> m_tags;
     std::map<int, CEpgInfoTagPtr>       m_changedTags;
     std::map<int, CEpgInfoTagPtr>       m_deletedTags;
@@ -338,6 +384,7 @@ namespace EPG
     std::string                         m_strName;         /*!< the name of this table */
     std::string                         m_strScraperName;  /*!< the name of the scraper to use */
     mutable CDateTime                   m_nowActiveStart;  /*!< the start time of the tag that is currently active */
+    mutable TagIndex                    m_tagIndex;        /*!< time index of m_tags, see UpdateTagIndex() */
 
     CDateTime                           m_lastScanTime;    /*!< the last time the EPG has been updated */
 
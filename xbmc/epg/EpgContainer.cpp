@@ -37,6 +37,7 @@
 #include "settings/Settings.h"
 #include "threads/SingleLock.h"
 #include "utils/log.h"
+#include "utils/Stopwatch.h"
 
 
 using namespace EPG;
@@ -297,15 +298,28 @@ bool CEpgContainer::PersistAll(void)
   auto copy = m_epgs;
   m_critSection.unlock();
 
+  CStopWatch timer;
+  timer.StartZero();
+  int iTables(0), iTags(0);
+
   for (EPGMAP::const_iterator it = copy.begin(); it != copy.end() && !m_bStop; ++it)
   {
     CEpgPtr epg = it->second;
     if (epg && epg->NeedsSave())
     {
-      bReturn &= epg->Persist();
+      int iPersistedTags(0);
+      bReturn &= epg->Persist(false, &iPersistedTags);
+      iTags += iPersistedTags;
+      ++iTables;
     }
   }
 
+  /* the changes of all tables are written in a single transaction */
+  bReturn &= m_database.CommitInsertQueries();
+
+  if (iTables > 0)
+    CLog::Log(LOGDEBUG, "EPG - %s - persisted %d changed tags of %d tables in %.2fs", __FUNCTION__, iTags, iTables, timer.GetElapsedSeconds());
+
   return bReturn;
 }
 
@@ -222,7 +222,7 @@ namespace EPG
     void SetHasPendingUpdates(bool bHasPendingUpdates = true);
 
     /*!
-     * @brief Call Persist() on each table
+     * @brief Call Persist() on each table and write all changes in one transaction.
      * @return True when they all were persisted, false otherwise.
      */
     bool PersistAll(void);
@@ -33,6 +33,14 @@
 using namespace dbiplus;
 using namespace EPG;
 
+/* the columns written by CEpgDatabase::PrepareTagValues() */
+#define EPG_TAG_COLUMNS "idEpg, iStartTime, iEndTime, sTitle, sPlotOutline, sPlot, sOriginalTitle, sCast, sDirector, sWriter, " \
+                        "iYear, sIMDBNumber, sIconPath, iGenreType, iGenreSubType, sGenre, iFirstAired, iParentalRating, " \
+                        "iStarRating, bNotify, iSeriesId, iEpisodeId, iEpisodePart, sEpisodeName, iFlags, iBroadcastUid, idBroadcast"
+
+/* maximum number of rows written or deleted by a single batched statement */
+#define EPG_DB_ROWS_PER_QUERY 200
+
 bool CEpgDatabase::Open(void)
 {
   return CDatabase::Open(g_advancedSettings.m_databaseEpg);
@@ -337,58 +345,41 @@ int CEpgDatabase::Persist(const CEpg &epg, bool bQueueWrite /* = false */)
   return iReturn;
 }
 
-int CEpgDatabase::Persist(const CEpgInfoTag &tag, bool bSingleUpdate /* = true */)
+std::string CEpgDatabase::PrepareTagValues(const CEpgInfoTag &tag)
 {
-  int iReturn(-1);
-
-  if (tag.EpgID() <= 0)
-  {
-    CLog::Log(LOGERROR, "%s - tag '%s' does not have a valid table", __FUNCTION__, tag.Title(true).c_str());
-    return iReturn;
-  }
-
   time_t iStartTime, iEndTime, iFirstAired;
   tag.StartAsUTC().GetAsTime(iStartTime);
   tag.EndAsUTC().GetAsTime(iEndTime);
   tag.FirstAiredAsUTC().GetAsTime(iFirstAired);
 
-  int iBroadcastId = tag.BroadcastId();
-  std::string strQuery;
-
   /* Only store the genre string when needed */
   std::string strGenre = (tag.GenreType() == EPG_GENRE_USE_STRING) ? StringUtils::Join(tag.Genre(), g_advancedSettings.m_videoItemSeparator) : "";
 
-  if (iBroadcastId < 0)
-  {
-    strQuery = PrepareSQL("REPLACE INTO epgtags (idEpg, iStartTime, "
-        "iEndTime, sTitle, sPlotOutline, sPlot, sOriginalTitle, sCast, sDirector, sWriter, iYear, sIMDBNumber, "
-        "sIconPath, iGenreType, iGenreSubType, sGenre, iFirstAired, iParentalRating, iStarRating, bNotify, iSeriesId, "
-        "iEpisodeId, iEpisodePart, sEpisodeName, iFlags, iBroadcastUid) "
-        "VALUES (%u, %u, %u, '%s', '%s', '%s', '%s', '%s', '%s', '%s', %i, '%s', '%s', %i, %i, '%s', %u, %i, %i, %i, %i, %i, %i, '%s', %i, %i);",
-        tag.EpgID(), iStartTime, iEndTime,
-        tag.Title(true).c_str(), tag.PlotOutline(true).c_str(), tag.Plot(true).c_str(),
-        tag.OriginalTitle(true).c_str(), tag.Cast().c_str(), tag.Director().c_str(), tag.Writer().c_str(), tag.Year(), tag.IMDBNumber().c_str(),
-        tag.Icon().c_str(), tag.GenreType(), tag.GenreSubType(), strGenre.c_str(),
-        iFirstAired, tag.ParentalRating(), tag.StarRating(), tag.Notify(),
-        tag.SeriesNumber(), tag.EpisodeNumber(), tag.EpisodePart(), tag.EpisodeName().c_str(), tag.Flags(),
-        tag.UniqueBroadcastID());
-  }
-  else
+  /* a tag without a database ID gets a new one assigned */
+  std::string strBroadcastId = tag.BroadcastId() < 0 ? "NULL" : StringUtils::Format("%i", tag.BroadcastId());
+
+  return PrepareSQL("(%u, %u, %u, '%s', '%s', '%s', '%s', '%s', '%s', '%s', %i, '%s', '%s', %i, %i, '%s', %u, %i, %i, %i, %i, %i, %i, '%s', %i, %i, %s)",
+      tag.EpgID(), iStartTime, iEndTime,
+      tag.Title(true).c_str(), tag.PlotOutline(true).c_str(), tag.Plot(true).c_str(),
+      tag.OriginalTitle(true).c_str(), tag.Cast().c_str(), tag.Director().c_str(), tag.Writer().c_str(), tag.Year(), tag.IMDBNumber().c_str(),
+      tag.Icon().c_str(), tag.GenreType(), tag.GenreSubType(), strGenre.c_str(),
+      iFirstAired, tag.ParentalRating(), tag.StarRating(), tag.Notify(),
+      tag.SeriesNumber(), tag.EpisodeNumber(), tag.EpisodePart(), tag.EpisodeName().c_str(), tag.Flags(),
+      tag.UniqueBroadcastID(), strBroadcastId.c_str());
+}
+
+int CEpgDatabase::Persist(const CEpgInfoTag &tag, bool bSingleUpdate /* = true */)
+{
+  int iReturn(-1);
+
+  if (tag.EpgID() <= 0)
   {
-    strQuery = PrepareSQL("REPLACE INTO epgtags (idEpg, iStartTime, "
-        "iEndTime, sTitle, sPlotOutline, sPlot, sOriginalTitle, sCast, sDirector, sWriter, iYear, sIMDBNumber, "
-        "sIconPath, iGenreType, iGenreSubType, sGenre, iFirstAired, iParentalRating, iStarRating, bNotify, iSeriesId, "
-        "iEpisodeId, iEpisodePart, sEpisodeName, iFlags, iBroadcastUid, idBroadcast) "
-        "VALUES (%u, %u, %u, '%s', '%s', '%s', '%s', '%s', '%s', '%s', %i, '%s', '%s', %i, %i, '%s', %u, %i, %i, %i, %i, %i, %i, '%s', %i, %i, %i);",
-        tag.EpgID(), iStartTime, iEndTime,
-        tag.Title(true).c_str(), tag.PlotOutline(true).c_str(), tag.Plot(true).c_str(),
-        tag.OriginalTitle(true).c_str(), tag.Cast().c_str(), tag.Director().c_str(), tag.Writer().c_str(), tag.Year(), tag.IMDBNumber().c_str(),
-        tag.Icon().c_str(), tag.GenreType(), tag.GenreSubType(), strGenre.c_str(),
-        iFirstAired, tag.ParentalRating(), tag.StarRating(), tag.Notify(),
-        tag.SeriesNumber(), tag.EpisodeNumber(), tag.EpisodePart(), tag.EpisodeName().c_str(), tag.Flags(),
-        tag.UniqueBroadcastID(), iBroadcastId);
+    CLog::Log(LOGERROR, "%s - tag '%s' does not have a valid table", __FUNCTION__, tag.Title(true).c_str());
+    return iReturn;
   }
 
+  std::string strQuery = "REPLACE INTO epgtags (" EPG_TAG_COLUMNS ") VALUES " + PrepareTagValues(tag) + ";";
+
   if (bSingleUpdate)
   {
     if (ExecuteQuery(strQuery))
@@ -403,6 +394,66 @@ int CEpgDatabase::Persist(const CEpgInfoTag &tag, bool bSingleUpdate /* = true *
   return iReturn;
 }
 
+int CEpgDatabase::QueuePersist(const std::vector<CEpgInfoTagPtr> &tags)
+{
+  int iQueued(0);
+  int iRows(0);
+  std::string strQuery;
+
+  for (const auto &tag : tags)
+  {
+    if (tag->EpgID() <= 0)
+    {
+      CLog::Log(LOGERROR, "%s - tag '%s' does not have a valid table", __FUNCTION__, tag->Title(true).c_str());
+      continue;
+    }
+
+    strQuery += (iRows == 0 ? "REPLACE INTO epgtags (" EPG_TAG_COLUMNS ") VALUES " : ", ") + PrepareTagValues(*tag);
+    ++iQueued;
+
+    if (++iRows == EPG_DB_ROWS_PER_QUERY)
+    {
+      QueueInsertQuery(strQuery + ";");
+      strQuery.clear();
+      iRows = 0;
+    }
+  }
+
+  if (iRows > 0)
+    QueueInsertQuery(strQuery + ";");
+
+  return iQueued;
+}
+
+int CEpgDatabase::QueueDelete(const std::vector<CEpgInfoTagPtr> &tags)
+{
+  int iQueued(0);
+  int iRows(0);
+  std::string strQuery;
+
+  for (const auto &tag : tags)
+  {
+    /* tag without a database ID was not persisted */
+    if (tag->BroadcastId() <= 0)
+      continue;
+
+    strQuery += StringUtils::Format(iRows == 0 ? "DELETE FROM epgtags WHERE idBroadcast IN (%i" : ", %i", tag->BroadcastId());
+    ++iQueued;
+
+    if (++iRows == EPG_DB_ROWS_PER_QUERY)
+    {
+      QueueInsertQuery(strQuery + ");");
+      strQuery.clear();
+      iRows = 0;
+    }
+  }
+
+  if (iRows > 0)
+    QueueInsertQuery(strQuery + ");");
+
+  return iQueued;
+}
+
 int CEpgDatabase::GetLastEPGId(void)
 {
   std::string strQuery = PrepareSQL("SELECT MAX(idEpg) FROM epg");
@@ -21,6 +21,8 @@
 
 #include <map>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "XBDateTime.h"
 #include "dbwrappers/Database.h"
@@ -145,6 +147,22 @@ namespace EPG
      */
     virtual int Persist(const CEpgInfoTag &tag, bool bSingleUpdate = true);
 
+    /*!
+     * @brief Queue the given infotags to be written with multi-row REPLACE statements.
+     *        The queries are executed in a single transaction by CommitInsertQueries().
+     * @param tags The tags to persist.
+     * @return The amount of tags that were queued.
+     */
+    int QueuePersist(const std::vector<CEpgInfoTagPtr> &tags);
+
+    /*!
+     * @brief Queue the removal of the given infotags, batched into DELETE ... IN (...) statements.
+     *        The queries are executed in a single transaction by CommitInsertQueries().
+     * @param tags The tags to delete. Tags that were never persisted are skipped.
+     * @return The amount of tags that were queued.
+     */
+    int QueueDelete(const std::vector<CEpgInfoTagPtr> &tags);
+
     /*!
      * @return Last EPG id in the database
      */
@@ -153,6 +171,13 @@ namespace EPG
     //@}
 
   protected:
+    /*!
+     * @brief Get the values of a tag for the column list used by Persist() and QueuePersist().
+     * @param tag The tag.
+     * @return The values, including the surrounding parentheses.
+     */
+    std::string PrepareTagValues(const CEpgInfoTag &tag);
+
     /*!
      * @brief Create the EPG database tables.
      */
@@ -659,6 +659,35 @@ bool CEpgInfoTag::Update(const CEpgInfoTag &tag, bool bUpdateBroadcastId /* = tr
   return bChanged;
 }
 
+bool CEpgInfoTag::DatabaseValuesDiffer(const CEpgInfoTag &tag) const
+{
+  return (m_strTitle           != tag.m_strTitle ||
+          m_strPlotOutline     != tag.m_strPlotOutline ||
+          m_strPlot            != tag.m_strPlot ||
+          m_strOriginalTitle   != tag.m_strOriginalTitle ||
+          m_strCast            != tag.m_strCast ||
+          m_strDirector        != tag.m_strDirector ||
+          m_strWriter          != tag.m_strWriter ||
+          m_iYear              != tag.m_iYear ||
+          m_strIMDBNumber      != tag.m_strIMDBNumber ||
+          m_startTime          != tag.m_startTime ||
+          m_endTime            != tag.m_endTime ||
+          m_iGenreType         != tag.m_iGenreType ||
+          m_iGenreSubType      != tag.m_iGenreSubType ||
+          m_firstAired         != tag.m_firstAired ||
+          m_iParentalRating    != tag.m_iParentalRating ||
+          m_iStarRating        != tag.m_iStarRating ||
+          m_bNotify            != tag.m_bNotify ||
+          m_iEpisodeNumber     != tag.m_iEpisodeNumber ||
+          m_iEpisodePart       != tag.m_iEpisodePart ||
+          m_iSeriesNumber      != tag.m_iSeriesNumber ||
+          m_strEpisodeName     != tag.m_strEpisodeName ||
+          m_iUniqueBroadcastID != tag.m_iUniqueBroadcastID ||
+          m_genre              != tag.m_genre ||
+          m_strIconPath        != tag.m_strIconPath ||
+          m_iFlags             != tag.m_iFlags);
+}
+
 bool CEpgInfoTag::Persist(bool bSingleUpdate /* = true */)
 {
   bool bReturn = false;
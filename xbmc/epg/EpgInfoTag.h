@@ -399,11 +399,23 @@ namespace EPG
      */
     bool Update(const CEpgInfoTag &tag, bool bUpdateBroadcastId = true);
 
+    /*!
+     * @brief Check whether any of the values that are stored in the database differ from another tag.
+     * @param tag The tag to compare with.
+     * @return True if the tag has to be persisted again after an update with the given tag, false otherwise.
+     */
+    bool DatabaseValuesDiffer(const CEpgInfoTag &tag) const;
+
     /*!
      * @return True if this tag has any series attributes, false otherwise
      */
     bool IsSeries() const;
 
+    /*!
+     * @brief Get current time, taking timeshifting into account.
+     */
+    CDateTime GetCurrentPlayingTime(void) const;
+
   private:
 
     /*!
@@ -418,11 +430,6 @@ namespace EPG
      */
     void UpdatePath(void);
 
-    /*!
-     * @brief Get current time, taking timeshifting into account.
-     */
-    CDateTime GetCurrentPlayingTime(void) const;
-
     /*!
      *  @brief Return the m_iFlags as an unsigned int bitfield (for database use).
      */
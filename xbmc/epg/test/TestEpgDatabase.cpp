@@ -0,0 +1,151 @@
+/*
+ *      Copyright (C) 2005-2013 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "epg/Epg.h"
+#include "epg/EpgDatabase.h"
+#include "epg/EpgInfoTag.h"
+#include "filesystem/SpecialProtocol.h"
+#include "settings/AdvancedSettings.h"
+#include "utils/Stopwatch.h"
+#include "utils/StringUtils.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace EPG;
+
+#define GUIDE_CHANNELS         500
+#define GUIDE_TAGS_PER_CHANNEL 2000
+#define GUIDE_TAG_DURATION     1800
+#define GUIDE_START_TIME       1450000000
+
+class TestEpgDatabase : public testing::Test
+{
+protected:
+  static CEpgDatabase *database;
+
+  /* writes a synthetic guide of GUIDE_CHANNELS * GUIDE_TAGS_PER_CHANNEL tags once for all tests */
+  static void SetUpTestCase()
+  {
+    DatabaseSettings settings;
+    settings.type = "sqlite3";
+    settings.name = "EpgTest";
+    settings.host = CSpecialProtocol::TranslatePath("special://temp/");
+
+    database = new CEpgDatabase();
+    database->Connect("EpgTest", settings, true);
+    database->DeleteEpg();
+
+    CStopWatch timer;
+    timer.StartZero();
+    for (int iChannel = 1; iChannel <= GUIDE_CHANNELS; iChannel++)
+    {
+      CEpg epg(iChannel, StringUtils::Format("Channel %i", iChannel), "client", true);
+      std::vector<CEpgInfoTagPtr> tags;
+      tags.reserve(GUIDE_TAGS_PER_CHANNEL);
+      for (int iTag = 0; iTag < GUIDE_TAGS_PER_CHANNEL; iTag++)
+        tags.push_back(CreateTag(epg, iTag, StringUtils::Format("Programme %i", iTag)));
+
+      database->QueuePersist(tags);
+      database->CommitInsertQueries();
+    }
+    std::cout << "Persist " << GUIDE_CHANNELS * GUIDE_TAGS_PER_CHANNEL << " tags (s): "
+              << testing::PrintToString(timer.GetElapsedSeconds()) << std::endl;
+  }
+
+  static void TearDownTestCase()
+  {
+    database->DeleteEpg();
+    database->Close();
+    delete database;
+    database = NULL;
+  }
+
+  static CEpgInfoTagPtr CreateTag(CEpg &epg, int iTag, const std::string &strTitle)
+  {
+    EPG_TAG data;
+    memset(&data, 0, sizeof(data));
+    data.iUniqueBroadcastId = iTag + 1;
+    data.strTitle = strTitle.c_str();
+    data.startTime = GUIDE_START_TIME + iTag * GUIDE_TAG_DURATION;
+    data.endTime = data.startTime + GUIDE_TAG_DURATION;
+    data.strPlot = "Synthetic guide entry";
+
+    CEpgInfoTagPtr tag(new CEpgInfoTag(data));
+    tag->SetEpg(&epg);
+    return tag;
+  }
+
+  static int CountTags(const std::string &strWhereClause = std::string())
+  {
+    return atoi(database->GetSingleValue("epgtags", "COUNT(1)", strWhereClause).c_str());
+  }
+};
+
+CEpgDatabase *TestEpgDatabase::database = NULL;
+
+TEST_F(TestEpgDatabase, LoadGuide)
+{
+  EXPECT_EQ(GUIDE_CHANNELS * GUIDE_TAGS_PER_CHANNEL, CountTags());
+  EXPECT_EQ(GUIDE_TAGS_PER_CHANNEL, CountTags("idEpg = 1"));
+  EXPECT_EQ(GUIDE_CHANNELS, CountTags(StringUtils::Format("iStartTime = %i", GUIDE_START_TIME)));
+}
+
+TEST_F(TestEpgDatabase, IncrementalPersist)
+{
+  static const int channels = 10;
+  static const int changedTags = 100;
+
+  /* rewrite a few tags per channel in one transaction, the rest of the guide is untouched */
+  CStopWatch timer;
+  timer.StartZero();
+  int iQueued = 0;
+  for (int iChannel = 1; iChannel <= channels; iChannel++)
+  {
+    CEpg epg(iChannel, "", "client", true);
+    std::vector<CEpgInfoTagPtr> tags;
+    for (int iTag = 0; iTag < changedTags; iTag++)
+      tags.push_back(CreateTag(epg, iTag * 3, "Changed"));
+    iQueued += database->QueuePersist(tags);
+  }
+  EXPECT_TRUE(database->CommitInsertQueries());
+  std::cout << "Persist " << iQueued << " changed tags (ms): "
+            << testing::PrintToString(timer.GetElapsedMilliseconds()) << std::endl;
+
+  EXPECT_EQ(channels * changedTags, iQueued);
+  EXPECT_EQ(GUIDE_CHANNELS * GUIDE_TAGS_PER_CHANNEL, CountTags());
+  EXPECT_EQ(channels * changedTags, CountTags("sTitle = 'Changed'"));
+  EXPECT_EQ(changedTags, CountTags("sTitle = 'Changed' AND idEpg = 1"));
+}
+
+TEST_F(TestEpgDatabase, DeleteSkipsUnpersistedTags)
+{
+  CEpg epg(1, "", "client", true);
+  std::vector<CEpgInfoTagPtr> tags;
+  tags.push_back(CreateTag(epg, 1, "Not persisted"));
+
+  EXPECT_EQ(0, database->QueueDelete(tags));
+  EXPECT_TRUE(database->CommitInsertQueries());
+  EXPECT_EQ(GUIDE_CHANNELS * GUIDE_TAGS_PER_CHANNEL, CountTags());
+}
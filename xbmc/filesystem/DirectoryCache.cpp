@@ -25,18 +25,33 @@
 #include "utils/URIUtils.h"
 #include "utils/StringUtils.h"
 #include "URL.h"
-#include "climits"
 
-#include <algorithm>
+#include <functional>
 
-// Maximum number of directories to keep in our cache
-#define MAX_CACHED_DIRS 50
+// Approximate amount of memory to spend on cached directory listings
+#define MAX_CACHE_SIZE (16 * 1024 * 1024)
 
 using namespace XFILE;
 
-CDirectoryCache::CDir::CDir(DIR_CACHE_TYPE cacheType)
+// rough estimate of what a cached item costs, the path is held twice due to the fast lookup map
+static size_t EstimateSize(const CFileItem& item)
+{
+  return sizeof(CFileItem) + 2 * item.GetPath().size() + item.GetLabel().size() + item.GetLabel2().size();
+}
+
+static size_t EstimateSize(const CFileItemList& items)
+{
+  size_t size = sizeof(CFileItemList);
+  for (int i = 0; i < items.Size(); i++)
+    size += EstimateSize(*items.Get(i));
+  return size;
+}
+
+CDirectoryCache::CDir::CDir(const std::string& path, DIR_CACHE_TYPE cacheType) :
+  m_path(path)
 {
   m_cacheType = cacheType;
+  m_size = 0;
   m_lastAccess = 0;
   m_Items = new CFileItemList;
   m_Items->SetIgnoreURLOptions(true);
@@ -48,47 +63,54 @@ CDirectoryCache::CDir::~CDir()
   delete m_Items;
 }
 
-void CDirectoryCache::CDir::SetLastAccess(unsigned int &accessCounter)
+void CDirectoryCache::CDir::SetLastAccess(std::atomic<unsigned int> &accessCounter)
 {
   m_lastAccess = accessCounter++;
 }
 
-CDirectoryCache::CDirectoryCache(void)
+CDirectoryCache::CDirectoryCache(void) :
+  CDirectoryCache(MAX_CACHE_SIZE)
+{
+}
+
+CDirectoryCache::CDirectoryCache(size_t maxBytes) :
+  m_maxBytes(maxBytes),
+  m_bytes(0),
+  m_accessCounter(0),
+  m_cacheHits(0),
+  m_cacheMisses(0),
+  m_evictions(0)
 {
-  m_accessCounter = 0;
-#ifdef _DEBUG
-  m_cacheHits = 0;
-  m_cacheMisses = 0;
-#endif
 }
 
 CDirectoryCache::~CDirectoryCache(void)
 {
+  Clear();
 }
 
 bool CDirectoryCache::GetDirectory(const std::string& strPath, CFileItemList &items, bool retrieveAll)
 {
-  CSingleLock lock (m_cs);
-
   // Get rid of any URL options, else the compare may be wrong
   std::string storedPath = CURL(strPath).GetWithoutOptions();
   URIUtils::RemoveSlashAtEnd(storedPath);
 
-  ciCache i = m_cache.find(storedPath);
-  if (i != m_cache.end())
+  CShard& shard = GetShard(storedPath);
+  CSingleLock lock(shard.m_cs);
+
+  auto i = shard.m_dirs.find(storedPath);
+  if (i != shard.m_dirs.end())
   {
     CDir* dir = i->second;
     if (dir->m_cacheType == XFILE::DIR_CACHE_ALWAYS ||
        (dir->m_cacheType == XFILE::DIR_CACHE_ONCE && retrieveAll))
     {
       items.Copy(*dir->m_Items);
-      dir->SetLastAccess(m_accessCounter);
-#ifdef _DEBUG
-      m_cacheHits+=items.Size();
-#endif
+      Touch(shard, dir);
+      m_cacheHits++;
       return true;
     }
   }
+  m_cacheMisses++;
   return false;
 }
 
@@ -108,20 +130,35 @@ void CDirectoryCache::SetDirectory(const std::string& strPath, const CFileItemLi
   // IDEALLY, any further processing on the item would actually create a new item
   // instead of altering it, but we can't really enforce that in an easy way, so
   // this is the best solution for now.
-  CSingleLock lock (m_cs);
 
   // Get rid of any URL options, else the compare may be wrong
   std::string storedPath = CURL(strPath).GetWithoutOptions();
   URIUtils::RemoveSlashAtEnd(storedPath);
 
-  ClearDirectory(storedPath);
+  // copy outside of the lock, listings can be large
+  CDir* dir = new CDir(storedPath, cacheType);
+  dir->m_Items->Copy(items);
+  dir->m_size = EstimateSize(*dir->m_Items) + storedPath.size();
+
+  {
+    CShard& shard = GetShard(storedPath);
+    CSingleLock lock(shard.m_cs);
 
-  CheckIfFull();
+    auto i = shard.m_dirs.find(storedPath);
+    if (i != shard.m_dirs.end())
+      Delete(shard, i->second);
 
-  CDir* dir = new CDir(cacheType);
-  dir->m_Items->Copy(items);
-  dir->SetLastAccess(m_accessCounter);
-  m_cache.insert(std::pair<std::string, CDir*>(storedPath, dir));
+    dir->SetLastAccess(m_accessCounter);
+    if (cacheType != DIR_CACHE_ALWAYS)
+    {
+      shard.m_lru.push_front(dir);
+      dir->m_lru = shard.m_lru.begin();
+    }
+    shard.m_dirs.insert(std::make_pair(storedPath, dir));
+    m_bytes += dir->m_size;
+  }
+
+  CheckIfFull(dir);
 }
 
 void CDirectoryCache::ClearFile(const std::string& strFile)
@@ -134,55 +171,62 @@ void CDirectoryCache::ClearFile(const std::string& strFile)
 
 void CDirectoryCache::ClearDirectory(const std::string& strPath)
 {
-  CSingleLock lock (m_cs);
-
   // Get rid of any URL options, else the compare may be wrong
   std::string storedPath = CURL(strPath).GetWithoutOptions();
   URIUtils::RemoveSlashAtEnd(storedPath);
 
-  iCache i = m_cache.find(storedPath);
-  if (i != m_cache.end())
-    Delete(i);
+  CShard& shard = GetShard(storedPath);
+  CSingleLock lock(shard.m_cs);
+
+  auto i = shard.m_dirs.find(storedPath);
+  if (i != shard.m_dirs.end())
+    Delete(shard, i->second);
 }
 
 void CDirectoryCache::ClearSubPaths(const std::string& strPath)
 {
-  CSingleLock lock (m_cs);
-
   // Get rid of any URL options, else the compare may be wrong
   std::string storedPath = CURL(strPath).GetWithoutOptions();
 
-  iCache i = m_cache.begin();
-  while (i != m_cache.end())
+  for (CShard& shard : m_shards)
   {
-    if (URIUtils::PathHasParent(i->first, storedPath))
-      Delete(i++);
-    else
-      i++;
+    CSingleLock lock(shard.m_cs);
+
+    auto i = shard.m_dirs.begin();
+    while (i != shard.m_dirs.end())
+    {
+      CDir* dir = i->second;
+      ++i;
+      if (URIUtils::PathHasParent(dir->m_path, storedPath))
+        Delete(shard, dir);
+    }
   }
 }
 
 void CDirectoryCache::AddFile(const std::string& strFile)
 {
-  CSingleLock lock (m_cs);
-
   // Get rid of any URL options, else the compare may be wrong
   std::string strPath = URIUtils::GetDirectory(CURL(strFile).GetWithoutOptions());
   URIUtils::RemoveSlashAtEnd(strPath);
 
-  ciCache i = m_cache.find(strPath);
-  if (i != m_cache.end())
+  CShard& shard = GetShard(strPath);
+  CSingleLock lock(shard.m_cs);
+
+  auto i = shard.m_dirs.find(strPath);
+  if (i != shard.m_dirs.end())
   {
     CDir *dir = i->second;
     CFileItemPtr item(new CFileItem(strFile, false));
     dir->m_Items->Add(item);
-    dir->SetLastAccess(m_accessCounter);
+    const size_t size = EstimateSize(*item);
+    dir->m_size += size;
+    m_bytes += size;
+    Touch(shard, dir);
   }
 }
 
 bool CDirectoryCache::FileExists(const std::string& strFile, bool& bInCache)
 {
-  CSingleLock lock (m_cs);
   bInCache = false;
 
   // Get rid of any URL options, else the compare may be wrong
@@ -191,31 +235,33 @@ bool CDirectoryCache::FileExists(const std::string& strFile, bool& bInCache)
   std::string storedPath = URIUtils::GetDirectory(strPath);
   URIUtils::RemoveSlashAtEnd(storedPath);
 
-  ciCache i = m_cache.find(storedPath);
-  if (i != m_cache.end())
+  CShard& shard = GetShard(storedPath);
+  CSingleLock lock(shard.m_cs);
+
+  auto i = shard.m_dirs.find(storedPath);
+  if (i != shard.m_dirs.end())
   {
     bInCache = true;
     CDir *dir = i->second;
-    dir->SetLastAccess(m_accessCounter);
-#ifdef _DEBUG
+    Touch(shard, dir);
     m_cacheHits++;
-#endif
     return (URIUtils::PathEquals(strPath, storedPath) || dir->m_Items->Contains(strFile));
   }
-#ifdef _DEBUG
   m_cacheMisses++;
-#endif
   return false;
 }
 
 void CDirectoryCache::Clear()
 {
   // this routine clears everything
-  CSingleLock lock (m_cs);
+  for (CShard& shard : m_shards)
+  {
+    CSingleLock lock(shard.m_cs);
 
-  iCache i = m_cache.begin();
-  while (i != m_cache.end() )
-    Delete(i++);
+    auto i = shard.m_dirs.begin();
+    while (i != shard.m_dirs.end())
+      Delete(shard, (i++)->second);
+  }
 }
 
 void CDirectoryCache::InitCache(std::set<std::string>& dirs)
@@ -232,60 +278,93 @@ void CDirectoryCache::InitCache(std::set<std::string>& dirs)
 
 void CDirectoryCache::ClearCache(std::set<std::string>& dirs)
 {
-  iCache i = m_cache.begin();
-  while (i != m_cache.end())
+  for (std::set<std::string>::const_iterator it = dirs.begin(); it != dirs.end(); ++it)
   {
-    if (dirs.find(i->first) != dirs.end())
-      Delete(i++);
-    else
-      i++;
+    CShard& shard = GetShard(*it);
+    CSingleLock lock(shard.m_cs);
+
+    auto i = shard.m_dirs.find(*it);
+    if (i != shard.m_dirs.end())
+      Delete(shard, i->second);
   }
 }
 
-void CDirectoryCache::CheckIfFull()
+void CDirectoryCache::CheckIfFull(const CDir* keep)
 {
-  CSingleLock lock (m_cs);
-
-  // find the last accessed folder, and remove if the number of cached folders is too many
-  iCache lastAccessed = m_cache.end();
-  unsigned int numCached = 0;
-  for (iCache i = m_cache.begin(); i != m_cache.end(); i++)
+  // drop the least recently accessed folders until we're back within our budget.
+  // Each shard keeps its folders in access order, so the oldest folder overall
+  // is the oldest tail of the shards.
+  while (m_bytes > m_maxBytes)
   {
-    // ensure dirs that are always cached aren't cleared
-    if (i->second->m_cacheType != DIR_CACHE_ALWAYS)
+    CShard* oldestShard = NULL;
+    unsigned int oldestAccess = 0;
+    for (CShard& shard : m_shards)
     {
-      if (lastAccessed == m_cache.end() || i->second->GetLastAccess() < lastAccessed->second->GetLastAccess())
-        lastAccessed = i;
-      numCached++;
+      CSingleLock lock(shard.m_cs);
+      // ensure dirs that are always cached aren't cleared, they're not in the LRU list
+      if (shard.m_lru.empty())
+        continue;
+
+      const CDir* dir = shard.m_lru.back();
+      if (dir != keep && (!oldestShard || dir->GetLastAccess() < oldestAccess))
+      {
+        oldestShard = &shard;
+        oldestAccess = dir->GetLastAccess();
+      }
+    }
+    if (!oldestShard)
+      break;
+
+    CSingleLock lock(oldestShard->m_cs);
+    if (!oldestShard->m_lru.empty() && oldestShard->m_lru.back() != keep)
+    {
+      Delete(*oldestShard, oldestShard->m_lru.back());
+      m_evictions++;
     }
   }
-  if (lastAccessed != m_cache.end() && numCached >= MAX_CACHED_DIRS)
-    Delete(lastAccessed);
 }
 
-void CDirectoryCache::Delete(iCache it)
+CDirectoryCache::CShard& CDirectoryCache::GetShard(const std::string& strPath)
+{
+  return m_shards[std::hash<std::string>()(strPath) % NUM_SHARDS];
+}
+
+void CDirectoryCache::Touch(CShard& shard, CDir* dir)
+{
+  dir->SetLastAccess(m_accessCounter);
+  if (dir->m_cacheType != DIR_CACHE_ALWAYS)
+    shard.m_lru.splice(shard.m_lru.begin(), shard.m_lru, dir->m_lru);
+}
+
+void CDirectoryCache::Delete(CShard& shard, CDir* dir)
 {
-  CDir* dir = it->second;
+  if (dir->m_cacheType != DIR_CACHE_ALWAYS)
+    shard.m_lru.erase(dir->m_lru);
+  shard.m_dirs.erase(dir->m_path);
+  m_bytes -= dir->m_size;
   delete dir;
-  m_cache.erase(it);
 }
 
-#ifdef _DEBUG
-void CDirectoryCache::PrintStats() const
+void CDirectoryCache::GetStats(DirectoryCacheStats& stats)
 {
-  CSingleLock lock (m_cs);
-  CLog::Log(LOGDEBUG, "%s - total of %u cache hits, and %u cache misses", __FUNCTION__, m_cacheHits, m_cacheMisses);
-  // run through and find the oldest and the number of items cached
-  unsigned int oldest = UINT_MAX;
-  unsigned int numItems = 0;
-  unsigned int numDirs = 0;
-  for (ciCache i = m_cache.begin(); i != m_cache.end(); i++)
+  stats.hits = m_cacheHits;
+  stats.misses = m_cacheMisses;
+  stats.evictions = m_evictions;
+  stats.bytes = m_bytes;
+  stats.dirs = 0;
+  for (CShard& shard : m_shards)
   {
-    CDir *dir = i->second;
-    oldest = std::min(oldest, dir->GetLastAccess());
-    numItems += dir->m_Items->Size();
-    numDirs++;
+    CSingleLock lock(shard.m_cs);
+    stats.dirs += shard.m_dirs.size();
   }
-  CLog::Log(LOGDEBUG, "%s - %u folders cached, with %u items total.  Oldest is %u, current is %u", __FUNCTION__, numDirs, numItems, oldest, m_accessCounter);
 }
-#endif
+
+void CDirectoryCache::PrintStats()
+{
+  DirectoryCacheStats stats;
+  GetStats(stats);
+  CLog::Log(LOGDEBUG, "%s - total of %" PRIu64" cache hits, %" PRIu64" cache misses and %" PRIu64" evictions", __FUNCTION__,
+            stats.hits, stats.misses, stats.evictions);
+  CLog::Log(LOGDEBUG, "%s - %u folders cached, using about %" PRIu64" of %" PRIu64" bytes, current access is %u", __FUNCTION__,
+            stats.dirs, (uint64_t)stats.bytes, (uint64_t)m_maxBytes, (unsigned int)m_accessCounter);
+}
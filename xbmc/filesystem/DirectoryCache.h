@@ -23,31 +23,59 @@
 #include "Directory.h"
 #include "threads/CriticalSection.h"
 
-#include <map>
+#include <atomic>
+#include <list>
 #include <set>
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
 
 class CFileItem;
 
 namespace XFILE
 {
+  struct DirectoryCacheStats
+  {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    size_t bytes;         ///< approximate memory used by the cached listings
+    unsigned int dirs;
+  };
+
   class CDirectoryCache
   {
     class CDir
     {
     public:
-      CDir(DIR_CACHE_TYPE cacheType);
+      CDir(const std::string& path, DIR_CACHE_TYPE cacheType);
       virtual ~CDir();
 
-      void SetLastAccess(unsigned int &accessCounter);
+      void SetLastAccess(std::atomic<unsigned int> &accessCounter);
       unsigned int GetLastAccess() const { return m_lastAccess; };
 
       CFileItemList* m_Items;
       DIR_CACHE_TYPE m_cacheType;
+      std::string m_path;
+      size_t m_size;                         ///< approximate memory used by m_Items
+      std::list<CDir*>::iterator m_lru;      ///< position in the shard's LRU list, DIR_CACHE_ALWAYS dirs aren't in it
     private:
       unsigned int m_lastAccess;
     };
+
+    /*! \brief A slice of the cache with its own lock, paths are spread over the shards by hash */
+    class CShard
+    {
+    public:
+      CCriticalSection m_cs;
+      std::unordered_map<std::string, CDir*> m_dirs;
+      std::list<CDir*> m_lru;                ///< evictable dirs, most recently used first
+    };
+
   public:
     CDirectoryCache(void);
+    /*! \brief Create a cache holding roughly up to maxBytes of directory listings */
+    explicit CDirectoryCache(size_t maxBytes);
     virtual ~CDirectoryCache(void);
     bool GetDirectory(const std::string& strPath, CFileItemList &items, bool retrieveAll = false);
     void SetDirectory(const std::string& strPath, const CFileItemList &items, DIR_CACHE_TYPE cacheType);
@@ -57,27 +85,27 @@ namespace XFILE
     void Clear();
     void AddFile(const std::string& strFile);
     bool FileExists(const std::string& strPath, bool& bInCache);
-#ifdef _DEBUG
-    void PrintStats() const;
-#endif
+    void GetStats(DirectoryCacheStats& stats);
+    void PrintStats();
   protected:
+    static const unsigned int NUM_SHARDS = 16;
+
     void InitCache(std::set<std::string>& dirs);
     void ClearCache(std::set<std::string>& dirs);
-    void CheckIfFull();
-
-    std::map<std::string, CDir*> m_cache;
-    typedef std::map<std::string, CDir*>::iterator iCache;
-    typedef std::map<std::string, CDir*>::const_iterator ciCache;
-    void Delete(iCache i);
+    void CheckIfFull(const CDir* keep);
 
-    CCriticalSection m_cs;
+    CShard& GetShard(const std::string& strPath);
+    void Touch(CShard& shard, CDir* dir);
+    void Delete(CShard& shard, CDir* dir);
 
-    unsigned int m_accessCounter;
+    CShard m_shards[NUM_SHARDS];
+    const size_t m_maxBytes;
+    std::atomic<size_t> m_bytes;
+    std::atomic<unsigned int> m_accessCounter;
 
-#ifdef _DEBUG
-    unsigned int m_cacheHits;
-    unsigned int m_cacheMisses;
-#endif
+    std::atomic<uint64_t> m_cacheHits;
+    std::atomic<uint64_t> m_cacheMisses;
+    std::atomic<uint64_t> m_evictions;
   };
 }
 extern XFILE::CDirectoryCache g_directoryCache;
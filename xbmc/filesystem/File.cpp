@@ -27,6 +27,10 @@
 #include "DirectoryCache.h"
 #include "Directory.h"
 #include "FileCache.h"
+#include "SpecialProtocol.h"
+#if defined(TARGET_POSIX)
+#include "posix/PosixMappedFile.h"
+#endif
 #include "utils/log.h"
 #include "utils/URIUtils.h"
 #include "utils/BitstreamStats.h"
@@ -308,14 +312,32 @@ bool CFile::Open(const CURL& file, const unsigned int flags)
         return m_pFile->Open(url);
       }
     }
-    m_pFile = CFileFactory::CreateLoader(url);
+    bool bOpened = false;
+#if defined(TARGET_POSIX)
+    if (m_flags & READ_MAPPED)
+    {
+      // special:// paths of local files, e.g. the texture cache, are mapped as well
+      CURL mappedUrl(url.IsProtocol("special") ? CURL(CSpecialProtocol::TranslatePath(url)) : url);
+      if (mappedUrl.IsProtocol("file") || mappedUrl.GetProtocol().empty())
+      {
+        // files that can't be mapped are opened the regular way
+        m_pFile = new CPosixMappedFile();
+        bOpened = m_pFile->Open(mappedUrl);
+        if (!bOpened)
+          SAFE_DELETE(m_pFile);
+      }
+    }
+#endif
+
+    if (!m_pFile)
+      m_pFile = CFileFactory::CreateLoader(url);
 
     if (!m_pFile)
       return false;
 
     try
     {
-      if (!m_pFile->Open(url))
+      if (!bOpened && !m_pFile->Open(url))
       {
         SAFE_DELETE(m_pFile);
         return false;
@@ -25,6 +25,7 @@
 #include "URL.h"
 
 #include "CircularCache.h"
+#include "ParallelFileReader.h"
 #include "threads/SingleLock.h"
 #include "utils/log.h"
 #include "settings/AdvancedSettings.h"
@@ -44,6 +45,7 @@
 using namespace XFILE;
 
 #define READ_CACHE_CHUNK_SIZE (128*1024)
+#define READ_AHEAD_CHUNK_SIZE (1024*1024)
 
 class CWriteRate
 {
@@ -177,6 +179,18 @@ bool CFileCache::Open(const CURL& url)
   m_chunkSize = CFile::GetChunkSize(m_source.GetChunkSize(), READ_CACHE_CHUNK_SIZE);
   m_fileSize = m_source.GetLength();
 
+  // keep several range reads in flight, a single one can't fill the pipe of high latency sources
+  if (g_advancedSettings.m_cacheReadAheadStreams > 1 && m_seekPossible > 0 && m_fileSize > 0)
+  {
+    m_reader.reset(new CParallelFileReader(g_advancedSettings.m_cacheReadAheadStreams,
+                                           std::max(m_chunkSize, (unsigned)READ_AHEAD_CHUNK_SIZE)));
+    if (!m_reader->Open(m_sourcePath, READ_NO_CACHE | READ_TRUNCATED | READ_CHUNKED, m_fileSize))
+    {
+      CLog::Log(LOGWARNING, "CFileCache::Open - failed to open read ahead streams, reading sequentially");
+      m_reader.reset();
+    }
+  }
+
   if (!m_pCache)
   {
     if (g_advancedSettings.m_cacheMemSize == 0)
@@ -272,7 +286,7 @@ void CFileCache::Process()
       bool sourceSeekFailed = false;
       if (!cacheReachEOF)
       {
-        m_nSeekResult = m_source.Seek(cacheMaxPos, SEEK_SET);
+        m_nSeekResult = SeekSource(cacheMaxPos);
         if (m_nSeekResult != cacheMaxPos)
         {
           CLog::Log(LOGERROR,"CFileCache::Process - Error %d seeking. Seek returned %" PRId64, (int)GetLastError(), m_nSeekResult);
@@ -326,7 +340,7 @@ void CFileCache::Process()
 
     ssize_t iRead = 0;
     if (!cacheReachEOF)
-      iRead = m_source.Read(buffer.get(), maxWrite);
+      iRead = ReadSource(buffer.get(), maxWrite);
     if (iRead == 0)
     {
       // Check for actual EOF and retry as long as we still have data in our cache
@@ -414,6 +428,22 @@ void CFileCache::Process()
   }
 }
 
+ssize_t CFileCache::ReadSource(char *buffer, size_t size)
+{
+  if (m_reader)
+    return m_reader->Read(buffer, size);
+
+  return m_source.Read(buffer, size);
+}
+
+int64_t CFileCache::SeekSource(int64_t position)
+{
+  if (m_reader)
+    return m_reader->Seek(position);
+
+  return m_source.Seek(position, SEEK_SET);
+}
+
 void CFileCache::OnExit()
 {
   m_bStop = true;
@@ -545,6 +575,7 @@ void CFileCache::Close()
   if (m_pCache)
     m_pCache->Close();
 
+  m_reader.reset();
   m_source.Close();
 }
 
@@ -563,6 +594,9 @@ void CFileCache::StopThread(bool bWait /*= true*/)
   m_bStop = true;
   //Process could be waiting for seekEvent
   m_seekEvent.Set();
+  //or for a read ahead stream
+  if (m_reader)
+    m_reader->Abort();
   CThread::StopThread(bWait);
 }
 
@@ -592,6 +626,8 @@ int CFileCache::IoControl(EIoControl request, void* param)
     status->level   = (m_forwardCacheSize == 0) ? 0.0 : (float) status->forward / m_forwardCacheSize;
     status->maxrate = m_writeRate;
     status->currate = m_writeRateActual;
+    status->streams = m_reader ? m_reader->GetStreams() : 1;
+    status->streamrate = m_reader ? m_reader->GetStreamRate() : m_writeRateActual;
     return 0;
   }
 
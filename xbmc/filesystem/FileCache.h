@@ -25,9 +25,11 @@
 #include "File.h"
 #include "threads/Thread.h"
 #include <atomic>
+#include <memory>
 
 namespace XFILE
 {
+  class CParallelFileReader;
 
   class CFileCache : public IFile, public CThread
   {
@@ -63,10 +65,14 @@ namespace XFILE
     virtual std::string GetContentCharset(void);
 
   private:
+    ssize_t ReadSource(char *buffer, size_t size);
+    int64_t SeekSource(int64_t position);
+
     CCacheStrategy *m_pCache;
     bool      m_bDeleteCache;
     int        m_seekPossible;
     CFile      m_source;
+    std::unique_ptr<CParallelFileReader> m_reader; // set when several source reads are kept in flight
     std::string    m_sourcePath;
     CEvent      m_seekEvent;
     CEvent      m_seekEnded;
@@ -52,6 +52,9 @@ namespace XFILE
 /* indicate that caller want to reopen a file if its already open  */
   static const unsigned int READ_REOPEN = 0x100;
 
+/* memory map local files, reads don't need a syscall. falls back to a regular file if the file can't be mapped */
+  static const unsigned int READ_MAPPED = 0x200;
+
 struct SNativeIoControl
 {
   unsigned long int   request;
@@ -64,6 +67,14 @@ struct SCacheStatus
   unsigned maxrate;  /**< maximum number of bytes per second cache is allowed to fill */
   unsigned currate;  /**< average read rate from source file since last position change */
   float    level;    /**< cache level (0.0 - 1.0) */
+  unsigned streams;  /**< number of reads kept in flight on the source file */
+  unsigned streamrate; /**< average read rate of a single source read while it is reading */
+};
+
+struct SMappedData
+{
+  const uint8_t* data; /**< contents of the file */
+  int64_t        size; /**< number of bytes mapped */
 };
 
 typedef enum {
@@ -73,6 +84,7 @@ typedef enum {
   IOCTRL_CACHE_SETRATE = 4,  /**< unsigned int with speed limit for caching in bytes per second */
   IOCTRL_SET_CACHE     = 8,  /**< CFileCache */
   IOCTRL_SET_RETRY     = 16, /**< Enable/disable retry within the protocol handler (if supported) */
+  IOCTRL_MAPPED_DATA   = 32, /**< SMappedData structure, succeeds if the file is memory mapped. param may be NULL */
 } EIoControl;
 
 enum CURLOPTIONTYPE
@@ -0,0 +1,259 @@
+/*
+ *      Copyright (C) 2005-2013 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "ParallelFileReader.h"
+#include "URL.h"
+#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace XFILE;
+
+CParallelFileReader::CParallelFileReader(unsigned int streams, unsigned int chunkSize)
+  : m_streamCount(std::max(streams, 1u))
+  , m_chunkSize(std::max(chunkSize, 1u))
+  , m_stop(true)
+  , m_abort(false)
+  , m_length(0)
+  , m_readPos(0)
+  , m_requestPos(0)
+  , m_readBytes(0)
+  , m_readTime(0)
+{
+}
+
+CParallelFileReader::~CParallelFileReader()
+{
+  Close();
+}
+
+bool CParallelFileReader::Open(const std::string &path, unsigned int flags, int64_t length)
+{
+  Close();
+
+  for (unsigned int i = 0; i < m_streamCount; i++)
+  {
+    std::unique_ptr<CStream> stream(new CStream(*this));
+    if (!stream->m_file.Open(path, flags))
+    {
+      // servers may limit the number of connections, go on with the streams we got
+      CLog::Log(LOGDEBUG, "CParallelFileReader::Open - failed to open stream %u of <%s>", i, CURL::GetRedacted(path).c_str());
+      break;
+    }
+
+    bool retry = false;
+    stream->m_file.IoControl(IOCTRL_SET_RETRY, &retry);
+    m_streams.push_back(std::move(stream));
+  }
+
+  if (m_streams.empty())
+    return false;
+
+  m_stop = false;
+  m_abort = false;
+  m_length = length;
+  m_readPos = 0;
+  m_requestPos = 0;
+  m_readBytes = 0;
+  m_readTime = 0;
+
+  for (auto &stream : m_streams)
+  {
+    stream->m_thread.reset(new CThread(stream.get(), "ParallelFileReader"));
+    stream->m_thread->Create();
+  }
+
+  CLog::Log(LOGDEBUG, "CParallelFileReader::Open - reading <%s> with %u streams", CURL::GetRedacted(path).c_str(), GetStreams());
+  return true;
+}
+
+void CParallelFileReader::Close()
+{
+  {
+    CSingleLock lock(m_section);
+    m_stop = true;
+    m_cond.notifyAll();
+  }
+
+  for (auto &stream : m_streams)
+  {
+    if (stream->m_thread)
+      stream->m_thread->StopThread();
+    stream->m_file.Close();
+  }
+  m_streams.clear();
+  m_chunks.clear();
+}
+
+int64_t CParallelFileReader::Seek(int64_t position)
+{
+  CSingleLock lock(m_section);
+  if (position < 0 || position > m_length)
+    return -1;
+
+  m_abort = false;
+  Restart(position);
+  return position;
+}
+
+void CParallelFileReader::Restart(int64_t position)
+{
+  // streams still reading a dropped chunk finish into their own reference of it
+  m_chunks.clear();
+  m_readPos = position;
+  m_requestPos = position;
+  m_cond.notifyAll();
+}
+
+ssize_t CParallelFileReader::Read(void *buffer, size_t size)
+{
+  CSingleLock lock(m_section);
+  while (true)
+  {
+    if (m_stop || m_abort)
+      return -1;
+
+    if (m_readPos >= m_length || size == 0)
+      return 0;
+
+    auto it = m_chunks.upper_bound(m_readPos);
+    if (it != m_chunks.begin())
+    {
+      --it;
+      SChunk &chunk = *it->second;
+      if (chunk.done)
+      {
+        if (chunk.length < 0)
+          return -1;
+
+        int64_t offset = m_readPos - it->first;
+        size_t count = (size_t)std::min((int64_t)size, chunk.length - offset);
+        if (count > 0)
+          memcpy(buffer, &chunk.data[offset], count);
+        m_readPos += count;
+
+        if (m_readPos == it->first + chunk.length)
+        {
+          bool shortRead = (size_t)chunk.length < chunk.size;
+          m_chunks.erase(it);
+
+          // the chunks behind a short read do not follow on, request them again
+          if (shortRead)
+            Restart(m_readPos);
+          else
+            m_cond.notifyAll();
+        }
+        return count;
+      }
+    }
+
+    m_cond.wait(lock);
+  }
+}
+
+void CParallelFileReader::Abort()
+{
+  CSingleLock lock(m_section);
+  m_abort = true;
+  m_cond.notifyAll();
+}
+
+unsigned int CParallelFileReader::GetStreamRate()
+{
+  CSingleLock lock(m_section);
+  if (m_readTime == 0)
+    return 0;
+
+  return (unsigned int)(1000 * m_readBytes / m_readTime);
+}
+
+void CParallelFileReader::Process(CStream &stream)
+{
+  const int64_t window = 2 * (int64_t)m_streams.size() * m_chunkSize;
+
+  CSingleLock lock(m_section);
+  while (!m_stop)
+  {
+    if (m_requestPos >= m_length || m_requestPos - m_readPos >= window)
+    {
+      m_cond.wait(lock);
+      continue;
+    }
+
+    int64_t offset = m_requestPos;
+    std::shared_ptr<SChunk> chunk(new SChunk);
+    chunk->size = (size_t)std::min((int64_t)m_chunkSize, m_length - offset);
+    m_chunks[offset] = chunk;
+    m_requestPos += chunk->size;
+
+    lock.Leave();
+
+    // the chunk is only looked at by Read once it is done
+    chunk->data.resize(chunk->size);
+    unsigned int start = XbmcThreads::SystemClockMillis();
+    ssize_t length = ReadChunk(stream, offset, &chunk->data[0], chunk->size);
+    unsigned int elapsed = XbmcThreads::SystemClockMillis() - start;
+
+    lock.Enter();
+
+    chunk->length = length;
+    chunk->done = true;
+    if (length > 0)
+    {
+      m_readBytes += length;
+      m_readTime += std::max(elapsed, 1u);
+    }
+    m_cond.notifyAll();
+  }
+}
+
+ssize_t CParallelFileReader::ReadChunk(CStream &stream, int64_t offset, char *buffer, size_t size)
+{
+  if (stream.m_position != offset)
+  {
+    if (stream.m_file.Seek(offset, SEEK_SET) != offset)
+    {
+      CLog::Log(LOGERROR, "CParallelFileReader::ReadChunk - failed to seek to %" PRId64, offset);
+      stream.m_position = -1;
+      return -1;
+    }
+    stream.m_position = offset;
+  }
+
+  size_t total = 0;
+  while (total < size)
+  {
+    ssize_t read = stream.m_file.Read(buffer + total, size - total);
+    if (read < 0)
+    {
+      stream.m_position = -1;
+      return total > 0 ? (ssize_t)total : -1;
+    }
+    if (read == 0)
+      break;
+
+    total += read;
+    stream.m_position += read;
+  }
+  return total;
+}
@@ -0,0 +1,122 @@
+#pragma once
+/*
+ *      Copyright (C) 2005-2013 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "File.h"
+#include "threads/Condition.h"
+#include "threads/CriticalSection.h"
+#include "threads/Thread.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace XFILE
+{
+
+  /*!
+   \brief Reads a file sequentially while keeping several range reads in flight.
+
+   Every stream opens its own handle on the file and reads the chunk following the
+   last requested one, the chunks are handed out in file order. This keeps high
+   latency sources (smb, http) busy where a single outstanding read cannot fill the
+   pipe. Reads never get further than two chunks per stream ahead of the read position.
+   */
+  class CParallelFileReader
+  {
+  public:
+    CParallelFileReader(unsigned int streams, unsigned int chunkSize);
+    ~CParallelFileReader();
+
+    /*!
+     \brief Open a handle per stream and start reading at position 0.
+     \param length the file length, reads stop there
+     \return false if not a single handle could be opened
+     */
+    bool Open(const std::string &path, unsigned int flags, int64_t length);
+    void Close();
+
+    /*!
+     \brief Drop the chunks that were read ahead and continue reading at position.
+     */
+    int64_t Seek(int64_t position);
+
+    /*!
+     \brief Read the data at the current position, blocks until its chunk is complete.
+     \return bytes read, 0 at the end of the file or -1 if the source failed
+     */
+    ssize_t Read(void *buffer, size_t size);
+
+    /*!
+     \brief Wake a blocked Read(), which returns -1. Reads fail until the next Seek().
+     */
+    void Abort();
+
+    unsigned int GetStreams() const { return m_streams.size(); }
+
+    /*!
+     \brief Average throughput of a single stream while it is reading, in bytes per second.
+     */
+    unsigned int GetStreamRate();
+
+  private:
+    struct SChunk
+    {
+      std::vector<char> data;
+      size_t size = 0;       // bytes requested
+      ssize_t length = 0;    // bytes read, -1 on error
+      bool done = false;
+    };
+
+    class CStream : public IRunnable
+    {
+    public:
+      CStream(CParallelFileReader &reader) : m_reader(reader), m_position(0) {}
+      virtual void Run() { m_reader.Process(*this); }
+
+      CParallelFileReader &m_reader;
+      CFile m_file;
+      int64_t m_position;
+      std::unique_ptr<CThread> m_thread;
+    };
+
+    void Process(CStream &stream);
+    ssize_t ReadChunk(CStream &stream, int64_t offset, char *buffer, size_t size);
+    void Restart(int64_t position);
+
+    unsigned int m_streamCount;
+    unsigned int m_chunkSize;
+    std::vector<std::unique_ptr<CStream>> m_streams;
+
+    CCriticalSection m_section;
+    XbmcThreads::ConditionVariable m_cond;
+    bool m_stop;
+    bool m_abort;
+    int64_t m_length;
+    int64_t m_readPos;     // position handed out by Read
+    int64_t m_requestPos;  // start of the next chunk to request
+    std::map<int64_t, std::shared_ptr<SChunk>> m_chunks; // requested chunks by offset, shared with the stream reading them
+
+    uint64_t m_readBytes;  // totals of the completed source reads
+    uint64_t m_readTime;
+  };
+
+}
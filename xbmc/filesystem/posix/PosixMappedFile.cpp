@@ -0,0 +1,207 @@
+/*
+ *      Copyright (C) 2005-2013 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#if defined(TARGET_POSIX)
+
+#include "PosixMappedFile.h"
+#include "URL.h"
+#include "utils/log.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <assert.h>
+#include <limits.h>
+#include <stdint.h>
+#include <string.h>
+
+// pages requested ahead of the read position, a new request is made once half of them are read
+#define MAPPED_READ_AHEAD (4 * 1024 * 1024)
+
+using namespace XFILE;
+
+CPosixMappedFile::CPosixMappedFile() :
+  m_data(NULL), m_size(0), m_adviseStart(0), m_adviseEnd(0)
+{ }
+
+CPosixMappedFile::~CPosixMappedFile()
+{
+  Unmap();
+}
+
+bool CPosixMappedFile::Open(const CURL& url)
+{
+  if (!CPosixFile::Open(url))
+    return false;
+
+  if (!Map())
+  {
+    CLog::Log(LOGDEBUG, "CPosixMappedFile::Open - can't map <%s>", url.GetRedacted().c_str());
+    CPosixFile::Close();
+    return false;
+  }
+
+  m_filePos = 0;
+  return true;
+}
+
+void CPosixMappedFile::Close()
+{
+  Unmap();
+  CPosixFile::Close();
+}
+
+bool CPosixMappedFile::Map()
+{
+  // only regular files have a size to map, mapping an empty file fails
+  struct stat64 st;
+  if (fstat64(m_fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0)
+    return false;
+
+  if ((uint64_t)st.st_size > SIZE_MAX)
+    return false;
+
+  void* data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+  if (data == MAP_FAILED)
+    return false;
+
+  Unmap();
+  m_data = (uint8_t*)data;
+  m_size = st.st_size;
+  m_adviseStart = m_adviseEnd = 0;
+  madvise(m_data, (size_t)m_size, MADV_SEQUENTIAL);
+  return true;
+}
+
+void CPosixMappedFile::Unmap()
+{
+  if (m_data)
+    munmap(m_data, (size_t)m_size);
+  m_data = NULL;
+  m_size = 0;
+}
+
+void CPosixMappedFile::Advise()
+{
+  if (m_filePos >= m_adviseStart && m_filePos + MAPPED_READ_AHEAD / 2 < m_adviseEnd)
+    return;
+
+  static const int64_t pageSize = sysconf(_SC_PAGESIZE);
+  const int64_t start = m_filePos - m_filePos % pageSize;
+  const int64_t end = std::min(m_size, m_filePos + MAPPED_READ_AHEAD);
+  if (end > start && madvise(m_data + start, (size_t)(end - start), MADV_WILLNEED) == 0)
+  {
+    m_adviseStart = start;
+    m_adviseEnd = end;
+  }
+}
+
+ssize_t CPosixMappedFile::Read(void* lpBuf, size_t uiBufSize)
+{
+  if (!m_data)
+    return -1;
+
+  assert(lpBuf != NULL || uiBufSize == 0);
+  if (lpBuf == NULL && uiBufSize != 0)
+    return -1;
+
+  if (uiBufSize > SSIZE_MAX)
+    uiBufSize = SSIZE_MAX;
+
+  // the file may still be growing, e.g. a recording
+  if (m_filePos >= m_size)
+  {
+    struct stat64 st;
+    if (fstat64(m_fd, &st) != 0 || st.st_size <= m_size || !Map() || m_filePos >= m_size)
+      return 0;
+  }
+
+  Advise();
+
+  const size_t size = (size_t)std::min((int64_t)uiBufSize, m_size - m_filePos);
+  memcpy(lpBuf, m_data + m_filePos, size);
+  m_filePos += size;
+
+  return size;
+}
+
+int64_t CPosixMappedFile::Seek(int64_t iFilePosition, int iWhence /* = SEEK_SET*/)
+{
+  if (!m_data)
+    return -1;
+
+  int64_t position;
+  if (iWhence == SEEK_SET)
+    position = iFilePosition;
+  else if (iWhence == SEEK_CUR)
+    position = m_filePos + iFilePosition;
+  else if (iWhence == SEEK_END)
+    position = GetLength() + iFilePosition;
+  else
+    return -1;
+
+  if (position < 0)
+    return -1;
+
+  m_filePos = position;
+  return m_filePos;
+}
+
+int64_t CPosixMappedFile::GetPosition()
+{
+  if (!m_data)
+    return -1;
+
+  return m_filePos;
+}
+
+int64_t CPosixMappedFile::GetLength()
+{
+  if (!m_data)
+    return -1;
+
+  // not the size of the mapping, the file may grow
+  return CPosixFile::GetLength();
+}
+
+int CPosixMappedFile::IoControl(EIoControl request, void* param)
+{
+  if (!m_data)
+    return -1;
+
+  if (request == IOCTRL_SEEK_POSSIBLE)
+    return 1;
+
+  if (request == IOCTRL_MAPPED_DATA)
+  {
+    if (param)
+    {
+      SMappedData* mapped = (SMappedData*)param;
+      mapped->data = m_data;
+      mapped->size = m_size;
+    }
+    return 0;
+  }
+
+  return CPosixFile::IoControl(request, param);
+}
+
+#endif // TARGET_POSIX
@@ -0,0 +1,68 @@
+#pragma once
+/*
+ *      Copyright (C) 2005-2013 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "PosixFile.h"
+
+namespace XFILE
+{
+
+  /*!
+   \brief Read only local file that is memory mapped, reads are a copy out of the mapping.
+
+   Open fails for files that can't be mapped (not a regular file, empty, too large for
+   the address space), CFile then opens a CPosixFile instead. The kernel is told that the
+   file is read sequentially and the pages ahead of the read position are requested in
+   advance. A file that grows is mapped again when a read reaches the end of the mapping.
+
+   IOCTRL_MAPPED_DATA hands out the mapping itself. It stays valid until the file is
+   closed or read past the end of the mapping.
+   */
+  class CPosixMappedFile : public CPosixFile
+  {
+  public:
+    CPosixMappedFile();
+    virtual ~CPosixMappedFile();
+
+    virtual bool Open(const CURL& url);
+    virtual bool OpenForWrite(const CURL& url, bool bOverWrite = false) { return false; }
+    virtual void Close();
+
+    virtual ssize_t Read(void* lpBuf, size_t uiBufSize);
+    virtual ssize_t Write(const void* lpBuf, size_t uiBufSize) { return -1; }
+    virtual int64_t Seek(int64_t iFilePosition, int iWhence = SEEK_SET);
+    virtual int Truncate(int64_t size) { return -1; }
+    virtual int64_t GetPosition();
+    virtual int64_t GetLength();
+    virtual void Flush() {}
+    virtual int IoControl(EIoControl request, void* param);
+
+  protected:
+    bool Map();
+    void Unmap();
+    void Advise();
+
+    uint8_t* m_data;
+    int64_t  m_size;
+    int64_t  m_adviseStart; // range last requested with MADV_WILLNEED
+    int64_t  m_adviseEnd;
+  };
+
+}
@@ -0,0 +1,119 @@
+/*
+ *      Copyright (C) 2005-2013 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "filesystem/DirectoryCache.h"
+#include "FileItem.h"
+#include "utils/StringUtils.h"
+
+#include "gtest/gtest.h"
+
+using namespace XFILE;
+
+static void FillDirectory(const std::string& path, int count, CFileItemList& items)
+{
+  for (int i = 0; i < count; i++)
+    items.Add(CFileItemPtr(new CFileItem(StringUtils::Format("%sfile%d.mkv", path.c_str(), i), false)));
+}
+
+TEST(TestDirectoryCache, SetGet)
+{
+  CDirectoryCache cache;
+  CFileItemList items, cached;
+  FillDirectory("smb://server/share/movies/", 10, items);
+  cache.SetDirectory("smb://server/share/movies/", items, DIR_CACHE_ALWAYS);
+
+  EXPECT_TRUE(cache.GetDirectory("smb://server/share/movies", cached));
+  EXPECT_EQ(10, cached.Size());
+  EXPECT_FALSE(cache.GetDirectory("smb://server/share/tv/", cached));
+
+  bool inCache;
+  EXPECT_TRUE(cache.FileExists("smb://server/share/movies/file3.mkv", inCache));
+  EXPECT_TRUE(inCache);
+  EXPECT_FALSE(cache.FileExists("smb://server/share/movies/file42.mkv", inCache));
+  EXPECT_TRUE(inCache);
+
+  cache.AddFile("smb://server/share/movies/file42.mkv");
+  EXPECT_TRUE(cache.FileExists("smb://server/share/movies/file42.mkv", inCache));
+
+  cache.ClearFile("smb://server/share/movies/file42.mkv");
+  EXPECT_FALSE(cache.GetDirectory("smb://server/share/movies/", cached));
+
+  DirectoryCacheStats stats;
+  cache.GetStats(stats);
+  EXPECT_EQ(4U, stats.hits);
+  EXPECT_EQ(2U, stats.misses);
+  EXPECT_EQ(0U, stats.dirs);
+  EXPECT_EQ(0U, stats.bytes);
+}
+
+TEST(TestDirectoryCache, ClearSubPaths)
+{
+  CDirectoryCache cache;
+  CFileItemList items, cached;
+  FillDirectory("nfs://server/export/", 5, items);
+  cache.SetDirectory("nfs://server/export/", items, DIR_CACHE_ALWAYS);
+  cache.SetDirectory("nfs://server/export/a/", items, DIR_CACHE_ALWAYS);
+  cache.SetDirectory("nfs://server/export/a/b/", items, DIR_CACHE_ALWAYS);
+  cache.SetDirectory("nfs://server/other/", items, DIR_CACHE_ALWAYS);
+
+  cache.ClearSubPaths("nfs://server/export/a/");
+  EXPECT_TRUE(cache.GetDirectory("nfs://server/export/", cached));
+  EXPECT_FALSE(cache.GetDirectory("nfs://server/export/a/", cached));
+  EXPECT_FALSE(cache.GetDirectory("nfs://server/export/a/b/", cached));
+  EXPECT_TRUE(cache.GetDirectory("nfs://server/other/", cached));
+
+  cache.Clear();
+  DirectoryCacheStats stats;
+  cache.GetStats(stats);
+  EXPECT_EQ(0U, stats.dirs);
+  EXPECT_EQ(0U, stats.bytes);
+}
+
+TEST(TestDirectoryCache, EvictLeastRecentlyUsed)
+{
+  CFileItemList items, cached;
+  FillDirectory("smb://server/share/", 100, items);
+
+  // measure a single listing, then allow for three of them
+  DirectoryCacheStats stats;
+  {
+    CDirectoryCache cache;
+    cache.SetDirectory("smb://server/share/0/", items, DIR_CACHE_ONCE);
+    cache.GetStats(stats);
+  }
+  CDirectoryCache cache(stats.bytes * 3 + stats.bytes / 2);
+
+  cache.SetDirectory("smb://server/pinned/", items, DIR_CACHE_ALWAYS);
+  cache.SetDirectory("smb://server/share/0/", items, DIR_CACHE_ONCE);
+  cache.SetDirectory("smb://server/share/1/", items, DIR_CACHE_ONCE);
+
+  // touch 0 so 1 is the oldest, pinned listings are never evicted
+  EXPECT_TRUE(cache.GetDirectory("smb://server/share/0/", cached, true));
+  cache.SetDirectory("smb://server/share/2/", items, DIR_CACHE_ONCE);
+
+  EXPECT_TRUE(cache.GetDirectory("smb://server/pinned/", cached));
+  EXPECT_TRUE(cache.GetDirectory("smb://server/share/0/", cached, true));
+  EXPECT_FALSE(cache.GetDirectory("smb://server/share/1/", cached, true));
+  EXPECT_TRUE(cache.GetDirectory("smb://server/share/2/", cached, true));
+
+  cache.GetStats(stats);
+  EXPECT_EQ(1U, stats.evictions);
+  EXPECT_EQ(3U, stats.dirs);
+}
@@ -0,0 +1,118 @@
+/*
+ *      Copyright (C) 2005-2013 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "filesystem/File.h"
+#include "filesystem/ParallelFileReader.h"
+#include "test/TestUtils.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#define TEST_FILE_SIZE  (3 * 1024 * 1024 + 4321)
+#define TEST_CHUNK_SIZE (64 * 1024)
+
+class TestParallelFileReader : public testing::Test
+{
+protected:
+  TestParallelFileReader()
+  {
+    data.resize(TEST_FILE_SIZE);
+    for (size_t i = 0; i < data.size(); i++)
+      data[i] = (char)(i * 131 + (i >> 12));
+
+    file = XBMC_CREATETEMPFILE("");
+    if (file)
+    {
+      file->Close();
+      file->OpenForWrite(XBMC_TEMPFILEPATH(file), true);
+      file->Write(&data[0], data.size());
+      file->Close();
+    }
+  }
+
+  ~TestParallelFileReader()
+  {
+    if (file)
+      XBMC_DELETETEMPFILE(file);
+  }
+
+  /* reads to the end of the file in odd sized pieces and checks the data */
+  void ReadToEnd(XFILE::CParallelFileReader &reader, int64_t position)
+  {
+    std::vector<char> buffer(50000);
+    ssize_t read;
+    while ((read = reader.Read(&buffer[0], buffer.size())) > 0)
+    {
+      ASSERT_LE(position + read, (int64_t)data.size());
+      ASSERT_EQ(0, memcmp(&buffer[0], &data[position], read)) << "at position " << position;
+      position += read;
+    }
+    EXPECT_EQ(0, read);
+    EXPECT_EQ((int64_t)data.size(), position);
+  }
+
+  XFILE::CFile *file;
+  std::vector<char> data;
+};
+
+TEST_F(TestParallelFileReader, Read)
+{
+  ASSERT_NE(nullptr, file);
+
+  XFILE::CParallelFileReader reader(4, TEST_CHUNK_SIZE);
+  ASSERT_TRUE(reader.Open(XBMC_TEMPFILEPATH(file), XFILE::READ_NO_CACHE, data.size()));
+  EXPECT_EQ(4U, reader.GetStreams());
+  ReadToEnd(reader, 0);
+  EXPECT_LT(0U, reader.GetStreamRate());
+}
+
+TEST_F(TestParallelFileReader, Seek)
+{
+  ASSERT_NE(nullptr, file);
+
+  XFILE::CParallelFileReader reader(3, TEST_CHUNK_SIZE);
+  ASSERT_TRUE(reader.Open(XBMC_TEMPFILEPATH(file), XFILE::READ_NO_CACHE, data.size()));
+
+  // seek while chunks are in flight, backwards and into the middle of a chunk
+  char buffer[100];
+  EXPECT_EQ(100, reader.Read(buffer, sizeof(buffer)));
+  EXPECT_EQ(2000000, reader.Seek(2000000));
+  ReadToEnd(reader, 2000000);
+  EXPECT_EQ(12345, reader.Seek(12345));
+  ReadToEnd(reader, 12345);
+  EXPECT_EQ(-1, reader.Seek(data.size() + 1));
+}
+
+TEST_F(TestParallelFileReader, Abort)
+{
+  ASSERT_NE(nullptr, file);
+
+  XFILE::CParallelFileReader reader(2, TEST_CHUNK_SIZE);
+  ASSERT_TRUE(reader.Open(XBMC_TEMPFILEPATH(file), XFILE::READ_NO_CACHE, data.size()));
+
+  char buffer[100];
+  reader.Abort();
+  EXPECT_EQ(-1, reader.Read(buffer, sizeof(buffer)));
+  EXPECT_EQ(0, reader.Seek(0));
+  EXPECT_EQ(100, reader.Read(buffer, sizeof(buffer)));
+}
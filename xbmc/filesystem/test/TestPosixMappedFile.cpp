@@ -0,0 +1,202 @@
+/*
+ *      Copyright (C) 2005-2013 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "system.h"
+#if defined(TARGET_POSIX)
+#include "filesystem/File.h"
+#include "filesystem/posix/PosixMappedFile.h"
+#include "test/TestUtils.h"
+#include "URL.h"
+#include "utils/Stopwatch.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#define TEST_FILE_SIZE      (1024 * 1024 + 777)
+#define BENCHMARK_FILE_SIZE (64 * 1024 * 1024)
+#define BENCHMARK_READ_SIZE (32 * 1024)
+#define BENCHMARK_LOOPS     4
+
+/* read syscalls made by the process so far, 0 where the kernel doesn't tell */
+static uint64_t GetReadSyscalls()
+{
+  uint64_t count = 0;
+#if defined(TARGET_LINUX)
+  std::ifstream io("/proc/self/io");
+  std::string key;
+  while (io >> key)
+  {
+    if (key == "syscr:")
+    {
+      io >> count;
+      break;
+    }
+  }
+#endif
+  return count;
+}
+
+static XFILE::CFile* CreateFile(size_t size, std::vector<char> &data)
+{
+  data.resize(size);
+  for (size_t i = 0; i < data.size(); i++)
+    data[i] = (char)(i * 131 + (i >> 12));
+
+  XFILE::CFile *file = XBMC_CREATETEMPFILE("");
+  if (!file)
+    return NULL;
+
+  file->Close();
+  if (file->OpenForWrite(XBMC_TEMPFILEPATH(file), true))
+  {
+    if (!data.empty())
+      file->Write(&data[0], data.size());
+    file->Close();
+  }
+  return file;
+}
+
+TEST(TestPosixMappedFile, Read)
+{
+  std::vector<char> data;
+  XFILE::CFile *file;
+  ASSERT_NE(nullptr, file = CreateFile(TEST_FILE_SIZE, data));
+
+  XFILE::CPosixMappedFile mapped;
+  ASSERT_TRUE(mapped.Open(CURL(XBMC_TEMPFILEPATH(file))));
+  EXPECT_EQ(TEST_FILE_SIZE, mapped.GetLength());
+  EXPECT_EQ(1, mapped.IoControl(XFILE::IOCTRL_SEEK_POSSIBLE, NULL));
+
+  XFILE::SMappedData contents;
+  ASSERT_EQ(0, mapped.IoControl(XFILE::IOCTRL_MAPPED_DATA, &contents));
+  EXPECT_EQ(TEST_FILE_SIZE, contents.size);
+  EXPECT_EQ(0, memcmp(&data[0], contents.data, data.size()));
+
+  std::vector<char> buffer(100000);
+  int64_t position = 0;
+  ssize_t read;
+  while ((read = mapped.Read(&buffer[0], buffer.size())) > 0)
+  {
+    ASSERT_EQ(0, memcmp(&data[position], &buffer[0], read));
+    position += read;
+  }
+  EXPECT_EQ(0, read);
+  EXPECT_EQ(TEST_FILE_SIZE, position);
+
+  EXPECT_EQ(TEST_FILE_SIZE - 10, mapped.Seek(-10, SEEK_END));
+  EXPECT_EQ(10, mapped.Read(&buffer[0], buffer.size()));
+  EXPECT_EQ(0, memcmp(&data[TEST_FILE_SIZE - 10], &buffer[0], 10));
+  EXPECT_EQ(12345, mapped.Seek(12345, SEEK_SET));
+  EXPECT_EQ(12355, mapped.Seek(10, SEEK_CUR));
+  EXPECT_EQ(12355, mapped.GetPosition());
+  EXPECT_EQ(-1, mapped.Seek(-1, SEEK_SET));
+
+  mapped.Close();
+  EXPECT_TRUE(XBMC_DELETETEMPFILE(file));
+}
+
+TEST(TestPosixMappedFile, Grow)
+{
+  std::vector<char> data;
+  XFILE::CFile *file;
+  ASSERT_NE(nullptr, file = CreateFile(TEST_FILE_SIZE, data));
+
+  XFILE::CPosixMappedFile mapped;
+  ASSERT_TRUE(mapped.Open(CURL(XBMC_TEMPFILEPATH(file))));
+  EXPECT_EQ(TEST_FILE_SIZE, mapped.Seek(0, SEEK_END));
+  char buffer[16];
+  EXPECT_EQ(0, mapped.Read(buffer, sizeof(buffer)));
+
+  const char tail[] = "appended";
+  XFILE::CFile writer;
+  ASSERT_TRUE(writer.OpenForWrite(XBMC_TEMPFILEPATH(file), false));
+  EXPECT_EQ(TEST_FILE_SIZE, writer.Seek(0, SEEK_END));
+  EXPECT_EQ((ssize_t)sizeof(tail), writer.Write(tail, sizeof(tail)));
+  writer.Close();
+
+  EXPECT_EQ((ssize_t)sizeof(tail), mapped.Read(buffer, sizeof(buffer)));
+  EXPECT_STREQ(tail, buffer);
+
+  mapped.Close();
+  EXPECT_TRUE(XBMC_DELETETEMPFILE(file));
+}
+
+TEST(TestPosixMappedFile, Fallback)
+{
+  std::vector<char> data;
+  XFILE::CFile *file;
+  ASSERT_NE(nullptr, file = CreateFile(0, data));
+
+  // an empty file can't be mapped, CFile opens it as a regular file
+  XFILE::CPosixMappedFile mapped;
+  EXPECT_FALSE(mapped.Open(CURL(XBMC_TEMPFILEPATH(file))));
+
+  XFILE::CFile regular;
+  ASSERT_TRUE(regular.Open(XBMC_TEMPFILEPATH(file), XFILE::READ_MAPPED));
+  EXPECT_EQ(-1, regular.IoControl(XFILE::IOCTRL_MAPPED_DATA, NULL));
+  regular.Close();
+
+  EXPECT_TRUE(XBMC_DELETETEMPFILE(file));
+}
+
+TEST(TestPosixMappedFile, Benchmark)
+{
+  std::vector<char> data;
+  XFILE::CFile *file;
+  ASSERT_NE(nullptr, file = CreateFile(BENCHMARK_FILE_SIZE, data));
+  data.clear();
+
+  std::vector<char> buffer(BENCHMARK_READ_SIZE);
+  for (int mode = 0; mode < 2; mode++)
+  {
+    XFILE::CFile reader;
+    ASSERT_TRUE(reader.Open(XBMC_TEMPFILEPATH(file), XFILE::READ_NO_CACHE | XFILE::READ_CHUNKED | (mode ? XFILE::READ_MAPPED : 0)));
+    EXPECT_EQ(mode ? 0 : -1, reader.IoControl(XFILE::IOCTRL_MAPPED_DATA, NULL));
+
+    uint64_t syscalls = GetReadSyscalls();
+    CStopWatch timer;
+    timer.StartZero();
+    for (int loop = 0; loop < BENCHMARK_LOOPS; loop++)
+    {
+      reader.Seek(0, SEEK_SET);
+      int64_t total = 0;
+      ssize_t read;
+      while ((read = reader.Read(&buffer[0], buffer.size())) > 0)
+        total += read;
+      EXPECT_EQ(BENCHMARK_FILE_SIZE, total);
+    }
+    float elapsed = timer.GetElapsedSeconds();
+    syscalls = GetReadSyscalls() - syscalls;
+
+    std::cout << (mode ? "mapped" : "posix ") << " file, " << BENCHMARK_READ_SIZE / 1024 << " KiB reads: "
+              << testing::PrintToString(BENCHMARK_LOOPS * (BENCHMARK_FILE_SIZE / (1024 * 1024)) / elapsed) << " MiB/s, "
+              << syscalls << " read syscalls" << std::endl;
+    reader.Close();
+  }
+
+  EXPECT_TRUE(XBMC_DELETETEMPFILE(file));
+}
+
+#endif // TARGET_POSIX
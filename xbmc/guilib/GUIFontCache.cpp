@@ -19,6 +19,8 @@
  */
 
 #include <stdint.h>
+#include <list>
+#include <unordered_map>
 #include <vector>
 #include "GUIFontTTF.h"
 #include "GraphicContext.h"
@@ -26,75 +28,87 @@
 template<class Position, class Value>
 class CGUIFontCacheImpl
 {
-  struct EntryList
-  {
-    using HashMap = std::multimap<size_t, CGUIFontCacheEntry<Position, Value>*>;
-    using HashIter = typename HashMap::iterator;
-    using AgeMap = std::multimap<size_t, HashIter>;
+  typedef CGUIFontCacheEntry<Position, Value> Entry;
+  typedef std::list<Entry*> EntryList; // most recently used first
+  typedef std::unordered_multimap<size_t, typename EntryList::iterator> HashMap;
+
+  EntryList m_lru;
+  HashMap m_hashMap;
+  Entry *m_lastUsed;                   ///< its value may have been filled in since it was returned
+  size_t m_bytes;
+  uint64_t m_hits;
+  uint64_t m_misses;
+  uint64_t m_evictions;
+  CGUIFontCache<Position, Value> *m_parent;
 
-    ~EntryList()
-    {
-      Flush();
-    }
-    HashIter Insert(size_t hash, CGUIFontCacheEntry<Position, Value> *v)
-    {
-      auto r (hashMap.insert(typename HashMap::value_type(hash, v)));
-      if (r->second)
-        ageMap.insert(typename AgeMap::value_type(r->second->m_lastUsedMillis, r));
-      return r;
-    }
-    void Flush()
+  typename HashMap::iterator FindKey(const CGUIFontCacheKey<Position> &key, size_t hash)
+  {
+    CGUIFontCacheKeysMatch<Position> keyMatch;
+    auto range = m_hashMap.equal_range(hash);
+    for (auto ret = range.first; ret != range.second; ++ret)
     {
-      ageMap.clear();
-      for (auto it = hashMap.begin(); it != hashMap.end(); ++it)
-        delete(it->second);
-      hashMap.clear();
+      if (keyMatch((*ret->second)->m_key, key))
+        return ret;
     }
-    typename HashMap::iterator FindKey(CGUIFontCacheKey<Position> key)
+    return m_hashMap.end();
+  }
+  void UpdateMemoryUsage()
+  {
+    if (m_lastUsed)
     {
-      CGUIFontCacheHash<Position> hashGen;
-      CGUIFontCacheKeysMatch<Position> keyMatch;
-      auto range = hashMap.equal_range(hashGen(key));
-      for (auto ret = range.first; ret != range.second; ++ret)
-      {
-        if (keyMatch(ret->second->m_key, key))
-        {
-          return ret;
-        }
-      }
-      return hashMap.end();
+      size_t bytes = m_lastUsed->GetMemoryUsage();
+      m_bytes = m_bytes - m_lastUsed->m_bytes + bytes;
+      m_lastUsed->m_bytes = bytes;
     }
-    void UpdateAge(HashIter it, size_t millis)
+  }
+  void Evict(unsigned int nowMillis)
+  {
+    // entries used recently may still be referenced by the current frame, keep those
+    while (m_bytes > FONT_CACHE_MAX_BYTES && !m_lru.empty() &&
+           nowMillis - m_lru.back()->m_lastUsedMillis > FONT_CACHE_TIME_LIMIT)
     {
-      auto range = ageMap.equal_range(it->second->m_lastUsedMillis);
-      for (auto ageit = range.first; ageit != range.second; ++ageit)
+      Entry *entry = m_lru.back();
+      auto range = m_hashMap.equal_range(entry->m_hash);
+      for (auto it = range.first; it != range.second; ++it)
       {
-        if (ageit->second == it)
+        if (*it->second == entry)
         {
-          ageMap.erase(ageit);
-          ageMap.insert(typename AgeMap::value_type(millis, it));
-          it->second->m_lastUsedMillis = millis;
-          return;
+          m_hashMap.erase(it);
+          break;
         }
       }
+      m_lru.pop_back();
+      m_bytes -= entry->m_bytes;
+      if (m_lastUsed == entry)
+        m_lastUsed = nullptr;
+      delete entry;
+      m_evictions++;
     }
+  }
 
-    HashMap hashMap;
-    AgeMap ageMap;
-  };
-
-  EntryList m_list;
-  CGUIFontCache<Position, Value> *m_parent;
-  
 public:
 
-  CGUIFontCacheImpl(CGUIFontCache<Position, Value>* parent) : m_parent(parent) {}
+  CGUIFontCacheImpl(CGUIFontCache<Position, Value>* parent)
+  : m_lastUsed(nullptr), m_bytes(0), m_hits(0), m_misses(0), m_evictions(0), m_parent(parent) {}
+  ~CGUIFontCacheImpl()
+  {
+    Flush();
+  }
   Value &Lookup(Position &pos,
                 const vecColors &colors, const vecText &text,
                 uint32_t alignment, float maxPixelWidth,
                 bool scrolling,
                 unsigned int nowMillis, bool &dirtyCache);
   void Flush();
+  void GetStats(CGUIFontCacheStats &stats)
+  {
+    UpdateMemoryUsage();
+    stats.hits += m_hits;
+    stats.misses += m_misses;
+    stats.evictions += m_evictions;
+    stats.entries += m_lru.size();
+    stats.bytes += m_bytes;
+  }
 };
 
 template<class Position, class Value>
@@ -106,19 +120,12 @@ CGUIFontCacheEntry<Position, Value>::~CGUIFontCacheEntry()
 }
 
 template<class Position, class Value>
-void CGUIFontCacheEntry<Position, Value>::Assign(const CGUIFontCacheKey<Position> &key, unsigned int nowMillis)
+size_t CGUIFontCacheEntry<Position, Value>::GetMemoryUsage() const
 {
-  m_key.m_pos = key.m_pos;
-  m_key.m_colors.assign(key.m_colors.begin(), key.m_colors.end());
-  m_key.m_text.assign(key.m_text.begin(), key.m_text.end());
-  m_key.m_alignment = key.m_alignment;
-  m_key.m_maxPixelWidth = key.m_maxPixelWidth;
-  m_key.m_scrolling = key.m_scrolling;
-  m_matrix = key.m_matrix;
-  m_key.m_scaleX = key.m_scaleX;
-  m_key.m_scaleY = key.m_scaleY;
-  m_lastUsedMillis = nowMillis;
-  m_value.clear();
+  return sizeof(*this) +
+         m_key.m_text.capacity() * sizeof(character_t) +
+         m_key.m_colors.capacity() * sizeof(color_t) +
+         MemoryUsage(m_value);
 }
 
 template<class Position, class Value>
@@ -160,39 +167,44 @@ Value &CGUIFontCacheImpl<Position, Value>::Lookup(Position &pos,
                                        scrolling, g_graphicsContext.GetGUIMatrix(),
                                        g_graphicsContext.GetGUIScaleX(), g_graphicsContext.GetGUIScaleY());
 
-  auto i = m_list.FindKey(key);
-  if (i == m_list.hashMap.end())
+  // account for whatever the caller stored in the entry we returned last time
+  UpdateMemoryUsage();
+
+  CGUIFontCacheHash<Position> hashGen;
+  size_t hash = hashGen(key);
+  auto i = FindKey(key, hash);
+  if (i == m_hashMap.end())
   {
     // Cache miss
     dirtyCache = true;
-    CGUIFontCacheEntry<Position, Value> *entry = nullptr;
-    if (!m_list.ageMap.empty() && (nowMillis - m_list.ageMap.begin()->first) > FONT_CACHE_TIME_LIMIT)
-    {
-      entry = m_list.ageMap.begin()->second->second;
-      m_list.hashMap.erase(m_list.ageMap.begin()->second);
-      m_list.ageMap.erase(m_list.ageMap.begin());
-    }
+    m_misses++;
+    Evict(nowMillis);
 
     // add new entry
-    CGUIFontCacheHash<Position> hashgen;
-    if (!entry)
-      entry = new CGUIFontCacheEntry<Position, Value>(*m_parent, key, nowMillis);
-    else
-      entry->Assign(key, nowMillis);
-    return m_list.Insert(hashgen(key), entry)->second->m_value;
+    Entry *entry = new Entry(*m_parent, key, hash, nowMillis);
+    entry->m_bytes = entry->GetMemoryUsage();
+    m_bytes += entry->m_bytes;
+    m_lru.push_front(entry);
+    m_hashMap.insert(typename HashMap::value_type(hash, m_lru.begin()));
+    m_lastUsed = entry;
+    return entry->m_value;
   }
   else
   {
     // Cache hit
     // Update the translation arguments so that they hold the offset to apply
     // to the cached values (but only in the dynamic case)
-    pos.UpdateWithOffsets(i->second->m_key.m_pos, scrolling);
+    Entry *entry = *i->second;
+    pos.UpdateWithOffsets(entry->m_key.m_pos, scrolling);
 
-    // Update time in entry and move to the back of the list
-    m_list.UpdateAge(i, nowMillis);
+    // Update time in entry and move to the front of the list
+    entry->m_lastUsedMillis = nowMillis;
+    m_lru.splice(m_lru.begin(), m_lru, i->second);
+    m_lastUsed = entry;
 
     dirtyCache = false;
-    return i->second->m_value;
+    m_hits++;
+    return entry->m_value;
   }
 }
 
@@ -202,10 +214,22 @@ void CGUIFontCache<Position, Value>::Flush()
   m_impl->Flush();
 }
 
+template<class Position, class Value>
+void CGUIFontCache<Position, Value>::GetStats(CGUIFontCacheStats &stats) const
+{
+  if (m_impl)
+    m_impl->GetStats(stats);
+}
+
 template<class Position, class Value>
 void CGUIFontCacheImpl<Position, Value>::Flush()
 {
-  m_list.Flush();
+  m_hashMap.clear();
+  for (auto it = m_lru.begin(); it != m_lru.end(); ++it)
+    delete *it;
+  m_lru.clear();
+  m_lastUsed = nullptr;
+  m_bytes = 0;
 }
 
 template CGUIFontCache<CGUIFontCacheStaticPosition, CGUIFontCacheStaticValue>::CGUIFontCache(CGUIFontTTFBase &font);
@@ -213,12 +237,14 @@ template CGUIFontCache<CGUIFontCacheStaticPosition, CGUIFontCacheStaticValue>::~
 template CGUIFontCacheEntry<CGUIFontCacheStaticPosition, CGUIFontCacheStaticValue>::~CGUIFontCacheEntry();
 template CGUIFontCacheStaticValue &CGUIFontCache<CGUIFontCacheStaticPosition, CGUIFontCacheStaticValue>::Lookup(CGUIFontCacheStaticPosition &, const vecColors &, const vecText &, uint32_t, float, bool, unsigned int, bool &);
 template void CGUIFontCache<CGUIFontCacheStaticPosition, CGUIFontCacheStaticValue>::Flush();
+template void CGUIFontCache<CGUIFontCacheStaticPosition, CGUIFontCacheStaticValue>::GetStats(CGUIFontCacheStats &) const;
 
 template CGUIFontCache<CGUIFontCacheDynamicPosition, CGUIFontCacheDynamicValue>::CGUIFontCache(CGUIFontTTFBase &font);
 template CGUIFontCache<CGUIFontCacheDynamicPosition, CGUIFontCacheDynamicValue>::~CGUIFontCache();
 template CGUIFontCacheEntry<CGUIFontCacheDynamicPosition, CGUIFontCacheDynamicValue>::~CGUIFontCacheEntry();
 template CGUIFontCacheDynamicValue &CGUIFontCache<CGUIFontCacheDynamicPosition, CGUIFontCacheDynamicValue>::Lookup(CGUIFontCacheDynamicPosition &, const vecColors &, const vecText &, uint32_t, float, bool, unsigned int, bool &);
 template void CGUIFontCache<CGUIFontCacheDynamicPosition, CGUIFontCacheDynamicValue>::Flush();
+template void CGUIFontCache<CGUIFontCacheDynamicPosition, CGUIFontCacheDynamicValue>::GetStats(CGUIFontCacheStats &) const;
 
 void CVertexBuffer::clear()
 {
@@ -32,6 +32,7 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <functional>
 #include <vector>
 #include <memory>
 #include <cassert>
@@ -41,6 +42,8 @@
 
 #define FONT_CACHE_TIME_LIMIT (1000)
 #define FONT_CACHE_DIST_LIMIT (0.01f)
+#define FONT_CACHE_MAX_BYTES (2 * 1024 * 1024) // per cache, entries used within FONT_CACHE_TIME_LIMIT are always kept
+#define FONT_CACHE_HASH_SAMPLES (16)           // max characters of the text that contribute to the hash
 
 template<class Position, class Value> class CGUIFontCache;
 class CGUIFontTTFBase;
@@ -81,16 +84,20 @@ struct CGUIFontCacheEntry
   CGUIFontCacheKey<Position> m_key;
   TransformMatrix m_matrix;
   unsigned int m_lastUsedMillis;
+  size_t m_hash;
+  size_t m_bytes; ///< memory accounted to this entry, including its value
   Value m_value;
 
-  CGUIFontCacheEntry(const CGUIFontCache<Position, Value> &cache, const CGUIFontCacheKey<Position> &key, unsigned int nowMillis) :
+  CGUIFontCacheEntry(const CGUIFontCache<Position, Value> &cache, const CGUIFontCacheKey<Position> &key, size_t hash, unsigned int nowMillis) :
     m_cache(cache),
     m_key(key.m_pos,
           *new vecColors, *new vecText,
           key.m_alignment, key.m_maxPixelWidth,
           key.m_scrolling, m_matrix,
           key.m_scaleX, key.m_scaleY),
-    m_lastUsedMillis(nowMillis)
+    m_lastUsedMillis(nowMillis),
+    m_hash(hash),
+    m_bytes(0)
   {
     m_key.m_colors.assign(key.m_colors.begin(), key.m_colors.end());
     m_key.m_text.assign(key.m_text.begin(), key.m_text.end());
@@ -99,7 +106,7 @@ struct CGUIFontCacheEntry
 
   ~CGUIFontCacheEntry();
 
-  void Assign(const CGUIFontCacheKey<Position> &key, unsigned int nowMillis);
+  size_t GetMemoryUsage() const;
 };
 
 template<class Position>
@@ -107,13 +114,19 @@ struct CGUIFontCacheHash
 {
   size_t operator()(const CGUIFontCacheKey<Position> &key) const
   {
-    /* Not much effort has gone into choosing this hash function */
-    size_t hash = 0, i;
-    for (i = 0; i < 3 && i < key.m_text.size(); ++i)
-      hash += key.m_text[i];
+    /* Sample a bounded number of characters spread over the whole text, so
+     * long strings cost no more to hash but rarely end up in the same bucket */
+    const size_t size = key.m_text.size();
+    const size_t step = size / FONT_CACHE_HASH_SAMPLES + 1;
+    size_t hash = size;
+    for (size_t i = 0; i < size; i += step)
+      hash = hash * 31 + key.m_text[i];
+    if (size)
+      hash = hash * 31 + key.m_text[size - 1];
     if (key.m_colors.size())
-      hash += key.m_colors[0];
-    hash += MatrixHashContribution(key);
+      hash = hash * 31 + key.m_colors[0];
+    hash = hash * 31 + key.m_alignment + (key.m_scrolling ? 1 : 0);
+    hash ^= std::hash<float>()(MatrixHashContribution(key));
     return hash;
   }
 };
@@ -135,6 +148,22 @@ struct CGUIFontCacheKeysMatch
 };
 
 
+/*!
+ \brief Counters of a font's caches
+ \sa CGUIFontTTFBase::GetCacheStats
+ */
+struct CGUIFontCacheStats
+{
+  CGUIFontCacheStats() : hits(0), misses(0), evictions(0), entries(0), bytes(0), atlasBytes(0), atlasResets(0) {}
+  uint64_t hits;
+  uint64_t misses;
+  uint64_t evictions;
+  size_t entries;
+  size_t bytes;             ///< memory held by the cached text layouts
+  size_t atlasBytes;        ///< size of the glyph texture
+  unsigned int atlasResets; ///< times the glyph texture was full and started over
+};
+
 template<class Position, class Value>
 class CGUIFontCache
 {
@@ -153,6 +182,7 @@ public:
                 bool scrolling,
                 unsigned int nowMillis, bool &dirtyCache);
   void Flush();
+  void GetStats(CGUIFontCacheStats &stats) const;
 };
 
 struct CGUIFontCacheStaticPosition
@@ -172,6 +202,11 @@ struct CGUIFontCacheStaticValue : public std::shared_ptr<std::vector<SVertex> >
   }
 };
 
+inline size_t MemoryUsage(const CGUIFontCacheStaticValue &value)
+{
+  return value ? value->capacity() * sizeof(SVertex) : 0;
+}
+
 inline bool Match(const CGUIFontCacheStaticPosition &a, const TransformMatrix &a_m,
                   const CGUIFontCacheStaticPosition &b, const TransformMatrix &b_m,
                   bool scrolling)
@@ -240,6 +275,12 @@ private:
 
 typedef CVertexBuffer CGUIFontCacheDynamicValue;
 
+inline size_t MemoryUsage(const CGUIFontCacheDynamicValue &value)
+{
+  // size is in quads
+  return value.size * 4 * sizeof(SVertex);
+}
+
 inline bool Match(const CGUIFontCacheDynamicPosition &a, const TransformMatrix &a_m,
                   const CGUIFontCacheDynamicPosition &b, const TransformMatrix &b_m,
                   bool scrolling)
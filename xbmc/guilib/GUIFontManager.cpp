@@ -322,8 +322,20 @@ CGUIFont* GUIFontManager::GetDefaultFont(bool border)
   return m_vecFonts[font13index];
 }
 
+void GUIFontManager::GetCacheStats(CGUIFontCacheStats &stats) const
+{
+  for (std::vector<CGUIFontTTFBase*>::const_iterator i = m_vecFontFiles.begin(); i != m_vecFontFiles.end(); ++i)
+    (*i)->GetCacheStats(stats);
+}
+
 void GUIFontManager::Clear()
 {
+  CGUIFontCacheStats stats;
+  GetCacheStats(stats);
+  CLog::Log(LOGDEBUG, "%s - font caches: %" PRIu64" hits, %" PRIu64" misses, %" PRIu64" evictions, %u entries using %u bytes, glyph textures %u bytes, %u resets",
+            __FUNCTION__, stats.hits, stats.misses, stats.evictions, (unsigned int)stats.entries, (unsigned int)stats.bytes,
+            (unsigned int)stats.atlasBytes, stats.atlasResets);
+
   for (int i = 0; i < (int)m_vecFonts.size(); ++i)
   {
     CGUIFont* pFont = m_vecFonts[i];
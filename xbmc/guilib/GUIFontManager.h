@@ -38,6 +38,7 @@
 // Forward
 class CGUIFont;
 class CGUIFontTTFBase;
+struct CGUIFontCacheStats;
 class CXBMCTinyXML;
 class TiXmlNode;
 class CSetting;
@@ -79,6 +80,12 @@ public:
   void Clear();
   void FreeFontFile(CGUIFontTTFBase *pFont);
 
+  /*! \brief Get hit/miss and memory counters summed over the caches of all loaded fonts
+   \param stats [out] the counters
+   \sa CGUIFontTTFBase::GetCacheStats
+   */
+  void GetCacheStats(CGUIFontCacheStats &stats) const;
+
   static void SettingOptionsFontsFiller(const CSetting *setting, std::vector< std::pair<std::string, std::string> > &list, std::string &current, void *data);
 
 protected:
@@ -52,6 +52,7 @@
 
 #define CHARS_PER_TEXTURE_LINE 20 // number of characters to cache per texture line
 #define CHAR_CHUNK    64      // 64 chars allocated at a time (1024 bytes)
+#define MAX_ATLAS_BYTES (8 * 1024 * 1024) // glyph texture size (8bit alpha) above which we start over
 #define GLYPH_STRENGTH_BOLD 24
 #define GLYPH_STRENGTH_LIGHT -48
 
@@ -171,6 +172,7 @@ CGUIFontTTFBase::CGUIFontTTFBase(const std::string& strFileName) : m_staticCache
   m_originX = m_originY = 0.0f;
   m_cellBaseLine = m_cellHeight = 0;
   m_numChars = 0;
+  m_atlasResets = 0;
   m_posX = m_posY = 0;
   m_textureHeight = m_textureWidth = 0;
   m_textureScaleX = m_textureScaleY = 0.0;
@@ -555,6 +557,14 @@ void CGUIFontTTFBase::DrawTextInternal(float x, float y, const vecColors &colors
   End();
 }
 
+void CGUIFontTTFBase::GetCacheStats(CGUIFontCacheStats &stats) const
+{
+  m_staticCache.GetStats(stats);
+  m_dynamicCache.GetStats(stats);
+  stats.atlasBytes += (size_t)m_textureWidth * m_textureHeight;
+  stats.atlasResets += m_atlasResets;
+}
+
 // this routine assumes a single line (i.e. it was called from GUITextLayout)
 float CGUIFontTTFBase::GetTextWidthInternal(vecText::const_iterator start, vecText::const_iterator end)
 {
@@ -663,6 +673,7 @@ CGUIFontTTFBase::Character* CGUIFontTTFBase::GetCharacter(character_t chr)
   { // unable to cache character - try clearing them all out and starting over
     CLog::Log(LOGDEBUG, "%s: Unable to cache character.  Clearing character cache of %i characters", __FUNCTION__, m_numChars);
     ClearCharacterCache();
+    m_atlasResets++;
     low = 0;
     if (!CacheCharacter(letter, style, m_char + low))
     {
@@ -750,6 +761,13 @@ bool CGUIFontTTFBase::CacheCharacter(wchar_t letter, uint32_t style, Character *
           FT_Done_Glyph(glyph);
           return false;
         }
+        // and for our memory budget, so fonts used for lots of different characters don't grow without bounds
+        if ((size_t)newHeight * m_textureWidth > MAX_ATLAS_BYTES)
+        {
+          CLog::Log(LOGDEBUG, "%s: New cache texture is too large (%ux%u exceeds %u bytes)", __FUNCTION__, m_textureWidth, newHeight, MAX_ATLAS_BYTES);
+          FT_Done_Glyph(glyph);
+          return false;
+        }
 
         CBaseTexture* newTexture = NULL;
         newTexture = ReallocTexture(newHeight);
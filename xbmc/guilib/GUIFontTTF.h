@@ -104,6 +104,11 @@ public:
 
   const std::string& GetFileName() const { return m_strFileName; };
 
+  /*! \brief Get hit/miss and memory counters of this font's text and glyph caches
+   \param stats [out] counters, added to what is already in stats
+   */
+  void GetCacheStats(CGUIFontCacheStats &stats) const;
+
 protected:
   struct Character
   {
@@ -161,6 +166,7 @@ protected:
   Character *m_charquick[LOOKUPTABLE_SIZE];     // ascii chars (7 styles) here
   int m_maxChars;                    // size of character array (can be incremented)
   int m_numChars;                    // the current number of cached characters
+  unsigned int m_atlasResets;        // number of times the character cache was cleared because it was full
 
   float m_ellipsesWidth;               // this is used every character (width of '.')
 
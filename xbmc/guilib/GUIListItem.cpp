@@ -113,7 +113,7 @@ const std::wstring& CGUIListItem::GetSortLabel() const
 
 void CGUIListItem::SetArt(const std::string &type, const std::string &url)
 {
-  ArtMap::iterator i = m_art.find(type);
+  ArtStore::iterator i = m_art.find(type);
   if (i == m_art.end() || i->second != url)
   {
     m_art[type] = url;
@@ -123,7 +123,7 @@ void CGUIListItem::SetArt(const std::string &type, const std::string &url)
 
 void CGUIListItem::SetArt(const ArtMap &art)
 {
-  m_art = art;
+  m_art.assign(art.begin(), art.end());
   SetInvalid();
 }
 
@@ -146,22 +146,22 @@ void CGUIListItem::AppendArt(const ArtMap &art, const std::string &prefix)
 
 std::string CGUIListItem::GetArt(const std::string &type) const
 {
-  ArtMap::const_iterator i = m_art.find(type);
+  ArtStore::const_iterator i = m_art.find(type);
   if (i != m_art.end())
     return i->second;
   i = m_artFallbacks.find(type);
   if (i != m_artFallbacks.end())
   {
-    ArtMap::const_iterator j = m_art.find(i->second);
+    ArtStore::const_iterator j = m_art.find(i->second);
     if (j != m_art.end())
       return j->second;
   }
   return "";
 }
 
-const CGUIListItem::ArtMap &CGUIListItem::GetArt() const
+CGUIListItem::ArtMap CGUIListItem::GetArt() const
 {
-  return m_art;
+  return ArtMap(m_art.begin(), m_art.end());
 }
 
 bool CGUIListItem::HasArt(const std::string &type) const
@@ -268,15 +268,15 @@ void CGUIListItem::Archive(CArchive &ar)
       ar << it->second;
     }
     ar << (int)m_art.size();
-    for (ArtMap::const_iterator i = m_art.begin(); i != m_art.end(); ++i)
+    for (ArtStore::const_iterator i = m_art.begin(); i != m_art.end(); ++i)
     {
-      ar << i->first;
+      ar << i->first.str();
       ar << i->second;
     }
     ar << (int)m_artFallbacks.size();
-    for (ArtMap::const_iterator i = m_artFallbacks.begin(); i != m_artFallbacks.end(); ++i)
+    for (ArtStore::const_iterator i = m_artFallbacks.begin(); i != m_artFallbacks.end(); ++i)
     {
-      ar << i->first;
+      ar << i->first.str();
       ar << i->second;
     }
   }
@@ -335,7 +335,7 @@ void CGUIListItem::Serialize(CVariant &value)
   {
     value["properties"][it->first] = it->second;
   }
-  for (ArtMap::const_iterator it = m_art.begin(); it != m_art.end(); ++it)
+  for (ArtStore::const_iterator it = m_art.begin(); it != m_art.end(); ++it)
     value["art"][it->first] = it->second;
 }
 
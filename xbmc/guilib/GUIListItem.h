@@ -31,6 +31,9 @@
 #include <map>
 #include <string>
 
+#include "utils/FlatMap.h"
+#include "utils/InternedString.h"
+
 //  Forward
 class CGUIListItemLayout;
 class CArchive;
@@ -118,11 +121,11 @@ public:
   std::string GetArt(const std::string &type) const;
 
   /*! \brief get artwork for an item
-   Retrieves artwork in a type:url map
+   Retrieves a copy of the artwork in a type:url map
    \return a type:url map for artwork
    \sa SetArt
    */
-  const ArtMap &GetArt() const;
+  ArtMap GetArt() const;
 
   /*! \brief Check whether an item has a particular piece of art
    Equivalent to !GetArt(type).empty()
@@ -131,6 +134,11 @@ public:
    */
   bool HasArt(const std::string &type) const;
 
+  /*! \brief Check whether an item has any art set
+   Equivalent to !GetArt().empty(), without copying the art
+   */
+  bool HasArt() const { return !m_art.empty(); }
+
   void SetSortLabel(const std::string &label);
   void SetSortLabel(const std::wstring &label);
   const std::wstring &GetSortLabel() const;
@@ -191,14 +199,16 @@ protected:
     bool operator()(const std::string &s1, const std::string &s2) const;
   };
 
-  typedef std::map<std::string, CVariant, icompare> PropertyMap;
+  typedef CFlatMap<std::string, CVariant, icompare> PropertyMap;
   PropertyMap m_mapProperties;
 private:
   std::wstring m_sortLabel;    // text for sorting. Need to be UTF16 for proper sorting
   std::string m_strLabel;      // text of column1
 
-  ArtMap m_art;
-  ArtMap m_artFallbacks;
+  // art types are a small set shared by all items, see CInternedString
+  typedef CFlatMap<CInternedString, std::string, std::less<std::string> > ArtStore;
+  ArtStore m_art;
+  ArtStore m_artFallbacks;
 };
 #endif
 
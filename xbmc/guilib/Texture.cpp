@@ -26,6 +26,7 @@
 #include "filesystem/File.h"
 #include "filesystem/ResourceFile.h"
 #include "filesystem/XbtFile.h"
+#include "settings/AdvancedSettings.h"
 #if defined(TARGET_DARWIN_IOS)
 #include <ImageIO/ImageIO.h>
 #include "filesystem/File.h"
@@ -246,9 +247,20 @@ bool CBaseTexture::LoadFromFileInternal(const std::string& texturePath, unsigned
   // Read image into memory to use our vfs
   XFILE::CFile file;
   XFILE::auto_buffer buf;
+  XFILE::SMappedData mapped;
 
-  if (file.LoadFile(texturePath, buf) <= 0)
-    return false;
+  // local images are decoded straight from the mapped file
+  if (!g_advancedSettings.m_cacheMemoryMapping || !URIUtils::IsHD(texturePath) ||
+      !file.Open(texturePath, XFILE::READ_TRUNCATED | XFILE::READ_MAPPED) ||
+      file.IoControl(XFILE::IOCTRL_MAPPED_DATA, &mapped) != 0)
+  {
+    file.Close();
+    if (file.LoadFile(texturePath, buf) <= 0)
+      return false;
+
+    mapped.data = (const uint8_t*)buf.get();
+    mapped.size = buf.size();
+  }
 
   CURL url(texturePath);
   // make sure resource:// paths are properly resolved
@@ -267,7 +279,7 @@ bool CBaseTexture::LoadFromFileInternal(const std::string& texturePath, unsigned
       return false;
 
     return LoadFromMemory(xbtFile.GetImageWidth(), xbtFile.GetImageHeight(), 0, xbtFile.GetImageFormat(),
-                          xbtFile.HasImageAlpha(), reinterpret_cast<unsigned char*>(buf.get()));
+                          xbtFile.HasImageAlpha(), const_cast<unsigned char*>(mapped.data));
   }
 
   IImage* pImage;
@@ -277,7 +289,8 @@ bool CBaseTexture::LoadFromFileInternal(const std::string& texturePath, unsigned
   else
     pImage = ImageFactory::CreateLoaderFromMimeType(strMimeType);
 
-  if (!LoadIImage(pImage, (unsigned char *)buf.get(), buf.size(), width, height))
+  // the loaders only read from the buffer
+  if (!LoadIImage(pImage, const_cast<unsigned char*>(mapped.data), (unsigned int)mapped.size, width, height))
   {
     CLog::Log(LOGDEBUG, "%s - Load of %s failed.", __FUNCTION__, CURL::GetRedacted(texturePath).c_str());
     delete pImage;
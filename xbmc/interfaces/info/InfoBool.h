@@ -72,6 +72,7 @@ public:
   virtual void Update(const CGUIListItem *item) {};
 
   const std::string &GetExpression() const { return m_expression; }
+  int GetContext() const { return m_context; }
   bool ListItemDependent() const { return m_listItemDependent; }
 protected:
 
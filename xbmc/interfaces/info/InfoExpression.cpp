@@ -22,6 +22,7 @@
 #include <stack>
 #include "utils/log.h"
 #include "GUIInfoManager.h"
+#include <algorithm>
 #include <list>
 #include <memory>
 
@@ -44,13 +45,13 @@ InfoExpression::InfoExpression(const std::string &expression, int context)
   if (!Parse(expression))
   {
     CLog::Log(LOGERROR, "Error parsing boolean expression %s", expression.c_str());
-    m_expression_tree = std::make_shared<InfoLeaf>(g_infoManager.Register("false", 0), false);
+    Compile(std::make_shared<InfoLeaf>(g_infoManager.Register("false", 0), false));
   }
 }
 
 void InfoExpression::Update(const CGUIListItem *item)
 {
-  m_value = m_expression_tree->Evaluate(item);
+  m_value = Evaluate(item);
 }
 
 /* Expressions are rewritten at parse time into a form which favours the
@@ -71,9 +72,11 @@ void InfoExpression::Update(const CGUIListItem *item)
  *    operations. So [A|B]|[C|D+[[E|F]|G] becomes A|B|C|[D+[E|F|G]].
  */
 
-bool InfoExpression::InfoLeaf::Evaluate(const CGUIListItem *item)
+void InfoExpression::InfoLeaf::Compile(InfoExpression &expression) const
 {
-  return m_invert ^ m_info->Get(item);
+  Instruction leaf = { NODE_LEAF, m_invert, static_cast<unsigned int>(expression.m_leaves.size()) };
+  expression.m_program.push_back(leaf);
+  expression.m_leaves.push_back(m_info);
 }
 
 InfoExpression::InfoAssociativeGroup::InfoAssociativeGroup(
@@ -96,27 +99,66 @@ void InfoExpression::InfoAssociativeGroup::Merge(std::shared_ptr<InfoAssociative
   m_children.splice(m_children.end(), other->m_children);
 }
 
-bool InfoExpression::InfoAssociativeGroup::Evaluate(const CGUIListItem *item)
+void InfoExpression::InfoAssociativeGroup::Compile(InfoExpression &expression) const
 {
-  /* Handle either AND or OR by using the relation
-   * A AND B == !(!A OR !B)
-   * to convert ANDs into ORs
-   */
-  std::list<InfoSubexpressionPtr>::iterator last = m_children.end();
-  std::list<InfoSubexpressionPtr>::iterator it = m_children.begin();
-  bool use_and = (m_type == NODE_AND);
-  bool result = use_and ^ (*it)->Evaluate(item);
-  while (!result && ++it != last)
+  size_t header = expression.m_program.size();
+  Instruction group = { m_type, false, 0 };
+  expression.m_program.push_back(group);
+  for (std::list<InfoSubexpressionPtr>::const_iterator it = m_children.begin(); it != m_children.end(); ++it)
+    (*it)->Compile(expression);
+  expression.m_program[header].arg = static_cast<unsigned int>(expression.m_program.size() - header - 1);
+}
+
+void InfoExpression::Compile(const InfoSubexpressionPtr &tree)
+{
+  m_program.clear();
+  m_leaves.clear();
+  tree->Compile(*this);
+}
+
+/* Evaluates the compiled program in the same way as the tree would be, i.e.
+ * each group stops at the first child that decides its value, and that child
+ * is moved to the head of the group. Moving a child is a rotation of the
+ * group's instructions, which is fine as children only refer to their own
+ * length.
+ */
+bool InfoExpression::Evaluate(const CGUIListItem *item)
+{
+  size_t pc = 0;
+  bool result = false;
+  m_frames.clear();
+  while (true)
   {
-    result = use_and ^ (*it)->Evaluate(item);
-    if (result)
+    const Instruction &instruction = m_program[pc++];
+    if (instruction.type != NODE_LEAF)
     {
-      /* Move this child to the head of the list so we evaluate faster next time */
-      m_children.push_front(*it);
-      m_children.erase(it);
+      Frame frame = { instruction.type == NODE_AND, pc, pc, pc + instruction.arg };
+      m_frames.push_back(frame);
+      continue;
+    }
+    result = instruction.invert ^ m_leaves[instruction.arg]->Get(item);
+
+    // hand the value up to the enclosing groups until one needs its next child evaluated
+    while (!m_frames.empty())
+    {
+      Frame &frame = m_frames.back();
+      if (frame.use_and ^ result)
+      {
+        /* Move this child to the head of the group so we evaluate faster next time */
+        if (frame.child != frame.first)
+          std::rotate(m_program.begin() + frame.first, m_program.begin() + frame.child, m_program.begin() + pc);
+        pc = frame.end;
+      }
+      else if (pc != frame.end)
+      {
+        frame.child = pc;
+        break;
+      }
+      m_frames.pop_back();
     }
+    if (m_frames.empty())
+      return result;
   }
-  return use_and ^ result;
 }
 
 /* Expressions are parsed using the shunting-yard algorithm. Binary operators
@@ -306,6 +348,6 @@ bool InfoExpression::Parse(const std::string &expression)
   while (!operator_stack.empty())
     OperatorPop(operator_stack, invert, nodes);
 
-  m_expression_tree = nodes.top();
+  Compile(nodes.top());
   return true;
 }
@@ -74,8 +74,8 @@ private:
   {
   public:
     virtual ~InfoSubexpression(void) {}; // so we can destruct derived classes using a pointer to their base class
-    virtual bool Evaluate(const CGUIListItem *item) = 0;
     virtual node_type_t Type() const=0;
+    virtual void Compile(InfoExpression &expression) const = 0;
   };
 
   typedef std::shared_ptr<InfoSubexpression> InfoSubexpressionPtr;
@@ -85,8 +85,8 @@ private:
   {
   public:
     InfoLeaf(InfoPtr info, bool invert) : m_info(info), m_invert(invert) {};
-    virtual bool Evaluate(const CGUIListItem *item);
     virtual node_type_t Type() const { return NODE_LEAF; };
+    virtual void Compile(InfoExpression &expression) const;
   private:
     InfoPtr m_info;
     bool m_invert;
@@ -99,8 +99,8 @@ private:
     InfoAssociativeGroup(node_type_t type, const InfoSubexpressionPtr &left, const InfoSubexpressionPtr &right);
     void AddChild(const InfoSubexpressionPtr &child);
     void Merge(std::shared_ptr<InfoAssociativeGroup> other);
-    virtual bool Evaluate(const CGUIListItem *item);
     virtual node_type_t Type() const { return m_type; };
+    virtual void Compile(InfoExpression &expression) const;
   private:
     node_type_t m_type;
     std::list<InfoSubexpressionPtr> m_children;
@@ -109,7 +109,32 @@ private:
   static operator_t GetOperator(char ch);
   static void OperatorPop(std::stack<operator_t> &operator_stack, bool &invert, std::stack<InfoSubexpressionPtr> &nodes);
   bool Parse(const std::string &expression);
-  InfoSubexpressionPtr m_expression_tree;
+  void Compile(const InfoSubexpressionPtr &tree);
+  bool Evaluate(const CGUIListItem *item);
+
+  /* The parsed tree is flattened into a program where each group is a header
+   * followed by its children, so groups can be evaluated and reordered
+   * without chasing pointers.
+   */
+  struct Instruction
+  {
+    node_type_t type;
+    bool invert;        ///< for leaves, whether to invert the leaf's value
+    unsigned int arg;   ///< index into m_leaves for leaves, number of instructions of the children for groups
+  };
+
+  // A group being evaluated
+  struct Frame
+  {
+    bool use_and;
+    size_t first;       ///< start of the group's first child
+    size_t child;       ///< start of the child being evaluated
+    size_t end;         ///< end of the group's last child
+  };
+
+  std::vector<Instruction> m_program;
+  std::vector<InfoPtr> m_leaves;
+  std::vector<Frame> m_frames;  ///< kept to avoid reallocating on every evaluation
 };
 
 };
@@ -48,7 +48,7 @@ using namespace MUSIC_INFO;
 using namespace JSONRPC;
 using namespace XFILE;
 
-bool CFileItemHandler::GetField(const std::string &field, const CVariant &info, const CFileItemPtr &item, CVariant &result, bool &fetchedArt, CThumbLoader *thumbLoader /* = NULL */)
+bool CFileItemHandler::GetField(const std::string &field, CVariant &info, const CFileItemPtr &item, CVariant &result, bool &fetchedArt, CThumbLoader *thumbLoader /* = NULL */)
 {
   if (result.isMember(field) && !result[field].empty())
     return true;
@@ -67,7 +67,7 @@ bool CFileItemHandler::GetField(const std::string &field, const CVariant &info,
   // check for serialized values
   if (info.isMember(field) && !info[field].isNull())
   {
-    result[field] = info[field];
+    result[field] = std::move(info[field]);
     return true;
   }
 
@@ -106,7 +106,7 @@ bool CFileItemHandler::GetField(const std::string &field, const CVariant &info,
 
     if (field == "art")
     {
-      if (thumbLoader != NULL && item->GetArt().size() <= 0 && !fetchedArt &&
+      if (thumbLoader != NULL && !item->HasArt() && !fetchedArt &&
         ((item->HasVideoInfoTag() && item->GetVideoInfoTag()->m_iDbId > -1) || (item->HasMusicInfoTag() && item->GetMusicInfoTag()->GetDatabaseId() > -1)))
       {
         thumbLoader->FillLibraryArt(*item);
@@ -190,8 +190,9 @@ void CFileItemHandler::FillDetails(const ISerializable *info, const CFileItemPtr
   if (info == NULL || fields.empty())
     return;
 
+  // only the requested fields are serialized, a full library tag is expensive to build
   CVariant serialization;
-  info->Serialize(serialization);
+  info->SerializeFields(serialization, fields);
 
   bool fetchedArt = false;
 
@@ -381,9 +382,9 @@ void CFileItemHandler::HandleFileItem(const char *ID, bool allowFile, const char
   if (resultname)
   {
     if (append)
-      result[resultname].append(object);
+      result[resultname].append(std::move(object));
     else
-      result[resultname] = object;
+      result[resultname] = std::move(object);
   }
 }
 
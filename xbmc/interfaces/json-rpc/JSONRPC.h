@@ -26,6 +26,7 @@
 
 #include "JSONRPCUtils.h"
 #include "JSONServiceDescription.h"
+#include "utils/JSONVariantWriter.h"
 
 class CVariant;
 
@@ -64,6 +65,21 @@ namespace JSONRPC
      */
     static std::string MethodCall(const std::string &inputString, ITransportLayer *transport, IClient *client);
 
+    /*
+     \brief Handles an incoming JSON-RPC request and writes the response to callback
+     \param inputString received JSON-RPC request
+     \param transport Transport protocol on which the request arrived
+     \param client Client which sent the request
+     \param callback Receives the JSON-RPC response as it is generated
+     \param context Passed on to callback
+     \return false if there is no response (only notifications were received)
+     or it couldn't be written, anything passed to callback has to be discarded then
+
+     Same as MethodCall above but the response isn't collected into a string,
+     which saves a copy of large responses.
+     */
+    static bool MethodCall(const std::string &inputString, ITransportLayer *transport, IClient *client, CJSONVariantWriter::OutputCallback callback, void *context);
+
     static JSONRPC_STATUS Introspect(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant& parameterObject, CVariant &result);
     static JSONRPC_STATUS Version(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant& parameterObject, CVariant &result);
     static JSONRPC_STATUS Permission(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant& parameterObject, CVariant &result);
@@ -77,7 +93,7 @@ namespace JSONRPC
     static bool HandleMethodCall(const CVariant& request, CVariant& response, ITransportLayer *transport, IClient *client);
     static inline bool IsProperJSONRPC(const CVariant& inputroot);
 
-    inline static void BuildResponse(const CVariant& request, JSONRPC_STATUS code, const CVariant& result, CVariant& response);
+    inline static void BuildResponse(const CVariant& request, JSONRPC_STATUS code, CVariant&& result, CVariant& response);
 
     static bool m_initialized;
   };
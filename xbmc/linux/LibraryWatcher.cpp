@@ -0,0 +1,413 @@
+/*
+ *      Copyright (C) 2005-2013 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "LibraryWatcher.h"
+
+#ifdef HAVE_INOTIFY
+
+#include <dirent.h>
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include "Application.h"
+#include "MediaSource.h"
+#include "URL.h"
+#include "filesystem/DirectoryCache.h"
+#include "filesystem/MultiPathDirectory.h"
+#include "interfaces/AnnouncementManager.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/MediaSourceSettings.h"
+#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "utils/log.h"
+#include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
+#include "video/VideoDatabase.h"
+#include "video/VideoLibraryQueue.h"
+
+#define WATCH_MASK (IN_CREATE | IN_DELETE | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO | \
+                    IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR)
+
+// time without events before changed folders are scanned, so copying a folder results in one scan
+#define WATCH_SETTLE_TIME 5000
+
+CLibraryWatcher::CLibraryWatcher()
+  : CThread("LibraryWatcher"),
+    m_fd(-1),
+    m_reload(false),
+    m_rebuild(false),
+    m_watchesExhausted(false),
+    m_lastEvent(0)
+{
+}
+
+CLibraryWatcher::~CLibraryWatcher()
+{
+  Stop();
+}
+
+CLibraryWatcher& CLibraryWatcher::GetInstance()
+{
+  static CLibraryWatcher s_instance;
+  return s_instance;
+}
+
+void CLibraryWatcher::Start()
+{
+  if (!g_advancedSettings.m_bVideoLibraryWatchSources && !g_advancedSettings.m_bMusicLibraryWatchSources)
+  {
+    Stop();
+    return;
+  }
+
+  {
+    CSingleLock lock(m_section);
+    m_rebuild = true;
+  }
+
+  if (!IsRunning())
+    Create();
+}
+
+void CLibraryWatcher::Stop()
+{
+  StopThread(true);
+}
+
+void CLibraryWatcher::Announce(ANNOUNCEMENT::AnnouncementFlag flag, const char *sender, const char *message, const CVariant &data)
+{
+  // new folders are in the library once a scan has finished
+  if ((flag & (ANNOUNCEMENT::VideoLibrary | ANNOUNCEMENT::AudioLibrary)) && strcmp(message, "OnScanFinished") == 0)
+  {
+    CSingleLock lock(m_section);
+    m_reload = true;
+  }
+}
+
+void CLibraryWatcher::Process()
+{
+  m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (m_fd < 0)
+  {
+    CLog::Log(LOGERROR, "LibraryWatcher: unable to initialize inotify (%s)", strerror(errno));
+    return;
+  }
+
+  ANNOUNCEMENT::CAnnouncementManager::GetInstance().AddAnnouncer(this);
+
+  while (!m_bStop)
+  {
+    bool reload, rebuild;
+    {
+      CSingleLock lock(m_section);
+      reload = m_reload;
+      rebuild = m_rebuild;
+      m_reload = m_rebuild = false;
+    }
+
+    if (rebuild)
+    {
+      RemoveAllWatches();
+      m_changed.clear();
+      m_musicPending.clear();
+    }
+    if (reload || rebuild)
+      LoadSources();
+
+    struct pollfd pfd = { m_fd, POLLIN, 0 };
+    if (poll(&pfd, 1, 1000) > 0)
+      ReadEvents();
+
+    ScanChanges();
+  }
+
+  ANNOUNCEMENT::CAnnouncementManager::GetInstance().RemoveAnnouncer(this);
+
+  RemoveAllWatches();
+  m_changed.clear();
+  m_musicPending.clear();
+  close(m_fd);
+  m_fd = -1;
+}
+
+void CLibraryWatcher::LoadSources()
+{
+  std::set<std::string> videoPaths;
+  if (g_advancedSettings.m_bVideoLibraryWatchSources)
+  {
+    CVideoDatabase database;
+    if (database.Open())
+    {
+      database.GetPaths(videoPaths);
+      database.Close();
+    }
+  }
+
+  std::vector<std::string> musicPaths;
+  if (g_advancedSettings.m_bMusicLibraryWatchSources)
+  {
+    VECSOURCES *sources = CMediaSourceSettings::GetInstance().GetSources("music");
+    for (VECSOURCES::const_iterator source = sources->begin(); source != sources->end(); ++source)
+    {
+      if (URIUtils::IsMultiPath(source->strPath))
+        XFILE::CMultiPathDirectory::GetPaths(source->strPath, musicPaths);
+      else
+        musicPaths.push_back(source->strPath);
+    }
+  }
+
+  // inotify only sees changes made on this machine, special:// paths aren't resolved
+  m_videoPaths.clear();
+  for (std::set<std::string>::const_iterator it = videoPaths.begin(); it != videoPaths.end(); ++it)
+  {
+    if (URIUtils::IsHD(*it) && !URIUtils::IsSpecial(*it))
+      m_videoPaths.insert(URIUtils::AddFileToFolder(*it, ""));
+  }
+
+  m_musicSources.clear();
+  for (std::vector<std::string>::const_iterator it = musicPaths.begin(); it != musicPaths.end(); ++it)
+  {
+    if (URIUtils::IsHD(*it) && !URIUtils::IsSpecial(*it))
+      m_musicSources.insert(URIUtils::AddFileToFolder(*it, ""));
+  }
+
+  for (std::set<std::string>::const_iterator it = m_videoPaths.begin(); it != m_videoPaths.end(); ++it)
+    AddWatches(*it);
+  for (std::set<std::string>::const_iterator it = m_musicSources.begin(); it != m_musicSources.end(); ++it)
+    AddWatches(*it);
+
+  CLog::Log(LOGDEBUG, "LibraryWatcher: watching %u folders of %u video paths and %u music sources",
+            (unsigned int)m_paths.size(), (unsigned int)m_videoPaths.size(), (unsigned int)m_musicSources.size());
+}
+
+void CLibraryWatcher::AddWatches(const std::string &path)
+{
+  std::vector<std::string> folders(1, path);
+  while (!folders.empty() && !m_bStop && !m_watchesExhausted)
+  {
+    std::string folder = folders.back();
+    folders.pop_back();
+
+    // a watched folder's subfolders are watched as well
+    if (m_paths.find(folder) != m_paths.end())
+      continue;
+
+    int wd = inotify_add_watch(m_fd, folder.c_str(), WATCH_MASK);
+    if (wd < 0)
+    {
+      if (errno == ENOSPC)
+      {
+        CLog::Log(LOGWARNING, "LibraryWatcher: out of inotify watches after %u folders, raise fs.inotify.max_user_watches to watch all of them",
+                  (unsigned int)m_paths.size());
+        m_watchesExhausted = true;
+      }
+      continue;
+    }
+    m_watches[wd] = folder;
+    m_paths[folder] = wd;
+
+    DIR *dir = opendir(folder.c_str());
+    if (!dir)
+      continue;
+
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL)
+    {
+      if (entry->d_name[0] == '.')
+        continue;
+
+      std::string subfolder = folder + entry->d_name;
+      bool isFolder = entry->d_type == DT_DIR;
+      if (entry->d_type == DT_UNKNOWN)
+      {
+        struct stat st;
+        isFolder = lstat(subfolder.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+      }
+      if (isFolder)
+        folders.push_back(subfolder + "/");
+    }
+    closedir(dir);
+  }
+}
+
+void CLibraryWatcher::RemoveWatches(const std::string &path)
+{
+  std::map<std::string, int>::iterator it = m_paths.lower_bound(path);
+  while (it != m_paths.end() && StringUtils::StartsWith(it->first, path))
+  {
+    inotify_rm_watch(m_fd, it->second);
+    m_watches.erase(it->second);
+    m_paths.erase(it++);
+  }
+}
+
+void CLibraryWatcher::RemoveAllWatches()
+{
+  for (std::map<int, std::string>::const_iterator it = m_watches.begin(); it != m_watches.end(); ++it)
+    inotify_rm_watch(m_fd, it->first);
+  m_watches.clear();
+  m_paths.clear();
+  m_watchesExhausted = false;
+}
+
+void CLibraryWatcher::ReadEvents()
+{
+  char buffer[4096] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+  ssize_t length;
+  while ((length = read(m_fd, buffer, sizeof(buffer))) > 0)
+  {
+    const char *ptr = buffer;
+    while (ptr + sizeof(struct inotify_event) <= buffer + length)
+    {
+      const struct inotify_event *event = (const struct inotify_event *)ptr;
+      HandleEvent(*event);
+      ptr += sizeof(struct inotify_event) + event->len;
+    }
+  }
+}
+
+void CLibraryWatcher::HandleEvent(const struct inotify_event &event)
+{
+  if (event.mask & IN_Q_OVERFLOW)
+  { // events were lost, rescan everything that is watched
+    CLog::Log(LOGWARNING, "LibraryWatcher: inotify queue overflowed, scanning all watched sources");
+    m_changed.insert(m_videoPaths.begin(), m_videoPaths.end());
+    m_changed.insert(m_musicSources.begin(), m_musicSources.end());
+    m_lastEvent = XbmcThreads::SystemClockMillis();
+    return;
+  }
+
+  std::map<int, std::string>::iterator watch = m_watches.find(event.wd);
+  if (watch == m_watches.end())
+    return;
+
+  std::string folder = watch->second;
+  if (event.mask & IN_IGNORED)
+  { // the folder is gone or was unwatched
+    m_paths.erase(folder);
+    m_watches.erase(watch);
+    return;
+  }
+
+  if (event.mask & (IN_DELETE_SELF | IN_MOVE_SELF))
+  {
+    MarkChanged(folder);
+    return;
+  }
+
+  // skip hidden and temporary files
+  if (event.len == 0 || event.name[0] == '.')
+    return;
+
+  if (event.mask & IN_ISDIR)
+  {
+    std::string subfolder = folder + event.name + "/";
+    if (event.mask & (IN_CREATE | IN_MOVED_TO))
+      AddWatches(subfolder);
+    else if (event.mask & IN_MOVED_FROM)
+      RemoveWatches(subfolder);
+    g_directoryCache.ClearSubPaths(subfolder);
+  }
+
+  MarkChanged(folder);
+}
+
+void CLibraryWatcher::MarkChanged(const std::string &path)
+{
+  g_directoryCache.ClearDirectory(path);
+  m_changed.insert(path);
+  m_lastEvent = XbmcThreads::SystemClockMillis();
+}
+
+void CLibraryWatcher::ScanChanges()
+{
+  if (!m_changed.empty() && XbmcThreads::SystemClockMillis() - m_lastEvent >= WATCH_SETTLE_TIME)
+  {
+    std::set<std::string> videoPaths;
+    for (std::set<std::string>::const_iterator it = m_changed.begin(); it != m_changed.end(); ++it)
+    {
+      std::string videoPath = GetVideoScanPath(*it);
+      if (!videoPath.empty())
+        videoPaths.insert(videoPath);
+      if (IsMusicPath(*it))
+        m_musicPending.insert(*it);
+    }
+    CLog::Log(LOGDEBUG, "LibraryWatcher: %u folders changed", (unsigned int)m_changed.size());
+    m_changed.clear();
+
+    // a video scan covers the library paths below the scanned one
+    std::string scanned;
+    for (std::set<std::string>::const_iterator it = videoPaths.begin(); it != videoPaths.end(); ++it)
+    {
+      if (!scanned.empty() && StringUtils::StartsWith(*it, scanned))
+        continue;
+
+      CLog::Log(LOGNOTICE, "LibraryWatcher: scanning changed video folder %s", CURL::GetRedacted(*it).c_str());
+      CVideoLibraryQueue::GetInstance().ScanLibrary(*it, false, false);
+      scanned = *it;
+    }
+  }
+
+  // the music scanner scans one folder at a time
+  if (!m_musicPending.empty() && !g_application.IsMusicScanning())
+  {
+    std::string folder = *m_musicPending.begin();
+    std::set<std::string>::iterator it = m_musicPending.begin();
+    while (it != m_musicPending.end() && StringUtils::StartsWith(*it, folder))
+      m_musicPending.erase(it++);
+
+    CLog::Log(LOGNOTICE, "LibraryWatcher: scanning changed music folder %s", CURL::GetRedacted(folder).c_str());
+    g_application.StartMusicScan(folder, false);
+  }
+}
+
+std::string CLibraryWatcher::GetVideoScanPath(const std::string &path) const
+{
+  // the nearest path known to the video library, so a season folder is scanned as part of its show
+  std::string folder = path;
+  while (!folder.empty())
+  {
+    if (m_videoPaths.find(folder) != m_videoPaths.end())
+      return folder;
+
+    std::string parent = URIUtils::GetParentPath(folder);
+    if (parent == folder)
+      break;
+    folder = parent;
+  }
+  return "";
+}
+
+bool CLibraryWatcher::IsMusicPath(const std::string &path) const
+{
+  for (std::set<std::string>::const_iterator it = m_musicSources.begin(); it != m_musicSources.end(); ++it)
+  {
+    if (StringUtils::StartsWith(path, *it))
+      return true;
+  }
+  return false;
+}
+
+#endif
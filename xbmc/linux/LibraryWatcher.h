@@ -0,0 +1,93 @@
+#pragma once
+/*
+ *      Copyright (C) 2005-2013 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "system.h"
+
+#ifdef HAVE_INOTIFY
+
+#include <map>
+#include <set>
+#include <string>
+
+#include "interfaces/IAnnouncer.h"
+#include "threads/CriticalSection.h"
+#include "threads/Thread.h"
+
+struct inotify_event;
+
+/*!
+ \brief Watches the folders of local library sources with inotify and scans the ones that change.
+
+ Enabled with <videolibrary><watchsources> and <musiclibrary><watchsources> in advancedsettings.xml.
+ Every folder below a local video path or music source gets a watch. Changes are collected until
+ the sources have been quiet for a few seconds, then a video scan is queued for the nearest path of
+ the video library holding each changed folder and a music scan is started for each changed music
+ folder. The directory cache of a changed folder is cleared right away, its hash in the database is
+ updated by the scan.
+ */
+class CLibraryWatcher : public ANNOUNCEMENT::IAnnouncer, private CThread
+{
+public:
+  static CLibraryWatcher& GetInstance();
+
+  /*!
+   \brief Start watching the sources of the current profile, or stop if watching is disabled.
+   */
+  void Start();
+  void Stop();
+
+  virtual void Announce(ANNOUNCEMENT::AnnouncementFlag flag, const char *sender, const char *message, const CVariant &data) override;
+
+protected:
+  virtual void Process() override;
+
+private:
+  CLibraryWatcher();
+  virtual ~CLibraryWatcher();
+  CLibraryWatcher(const CLibraryWatcher&);
+  CLibraryWatcher& operator=(const CLibraryWatcher&);
+
+  void LoadSources();
+  void AddWatches(const std::string &path);
+  void RemoveWatches(const std::string &path);
+  void RemoveAllWatches();
+  void ReadEvents();
+  void HandleEvent(const struct inotify_event &event);
+  void MarkChanged(const std::string &path);
+  void ScanChanges();
+  std::string GetVideoScanPath(const std::string &path) const;
+  bool IsMusicPath(const std::string &path) const;
+
+  int m_fd;
+  bool m_reload;                          ///< sources may have changed, protected by m_section
+  bool m_rebuild;                         ///< profile changed, protected by m_section
+  bool m_watchesExhausted;
+  std::map<int, std::string> m_watches;   ///< watched folder by watch descriptor
+  std::map<std::string, int> m_paths;     ///< watch descriptor by folder
+  std::set<std::string> m_videoPaths;     ///< local paths of the video library
+  std::set<std::string> m_musicSources;   ///< local music source folders
+  std::set<std::string> m_changed;        ///< folders changed since the last scan
+  std::set<std::string> m_musicPending;   ///< changed music folders waiting for the music scanner
+  unsigned int m_lastEvent;
+  CCriticalSection m_section;
+};
+
+#endif
@@ -1902,8 +1902,8 @@ int CMusicDatabase::AddPath(const std::string& strPath1)
     if (it != m_pathCache.end())
       return it->second;
 
-    strSQL=PrepareSQL( "select * from path where strPath='%s'", strPath.c_str());
-    m_pDS->query(strSQL);
+    strSQL = "select * from path where strPath=?";
+    m_pDS->query(strSQL, { strPath });
     if (m_pDS->num_rows() == 0)
     {
       m_pDS->close();
@@ -5408,8 +5408,7 @@ bool CMusicDatabase::GetPathHash(const std::string &path, std::string &hash)
     if (NULL == m_pDB.get()) return false;
     if (NULL == m_pDS.get()) return false;
 
-    std::string strSQL=PrepareSQL("select strHash from path where strPath='%s'", path.c_str());
-    m_pDS->query(strSQL);
+    m_pDS->query("select strHash from path where strPath=?", { path });
     if (m_pDS->num_rows() == 0)
       return false;
     hash = m_pDS->fv("strHash").get_asString();
@@ -5617,8 +5616,7 @@ int CMusicDatabase::GetSongIDFromPath(const std::string &filePath)
     URIUtils::Split(filePath, strPath, strFileName);
     URIUtils::AddSlashAtEnd(strPath);
 
-    std::string sql = PrepareSQL("select idSong from song join path on song.idPath = path.idPath where song.strFileName='%s' and path.strPath='%s'", strFileName.c_str(), strPath.c_str());
-    if (!m_pDS->query(sql)) return -1;
+    if (!m_pDS->query("select idSong from song join path on song.idPath = path.idPath where song.strFileName=? and path.strPath=?", { strFileName, strPath })) return -1;
 
     if (m_pDS->num_rows() == 0)
     {
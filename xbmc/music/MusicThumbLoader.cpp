@@ -68,7 +68,7 @@ bool CMusicThumbLoader::LoadItemCached(CFileItem* pItem)
   if (pItem->m_bIsShareOrDrive)
     return false;
 
-  if (pItem->HasMusicInfoTag() && pItem->GetArt().empty())
+  if (pItem->HasMusicInfoTag() && !pItem->HasArt())
   {
     if (FillLibraryArt(*pItem))
       return true;
@@ -77,7 +77,7 @@ bool CMusicThumbLoader::LoadItemCached(CFileItem* pItem)
       return false; // No fallback
   }
 
-  if (pItem->HasVideoInfoTag() && pItem->GetArt().empty())
+  if (pItem->HasVideoInfoTag() && !pItem->HasArt())
   { // music video
     CVideoThumbLoader loader;
     if (loader.LoadItemCached(pItem))
@@ -235,7 +235,7 @@ bool CMusicThumbLoader::FillLibraryArt(CFileItem &item)
     }
     m_musicDatabase->Close();
   }
-  return !item.GetArt().empty();
+  return item.HasArt();
 }
 
 bool CMusicThumbLoader::GetEmbeddedThumb(const std::string &path, EmbeddedArt &art)
@@ -52,8 +52,10 @@
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "TextureCache.h"
+#include "threads/Event.h"
 #include "threads/SystemClock.h"
 #include "Util.h"
+#include "utils/JobManager.h"
 #include "utils/log.h"
 #include "utils/md5.h"
 #include "utils/StringUtils.h"
@@ -66,6 +68,31 @@ using namespace MUSICDATABASEDIRECTORY;
 using namespace MUSIC_GRABBER;
 using namespace ADDON;
 
+/*! \brief Reads the tags of one file on a tag reader worker
+ \sa CMusicInfoScanner::ScanTags
+ */
+class CMusicTagReaderJob : public CJob
+{
+public:
+  CMusicTagReaderJob(const CFileItemPtr& item, const std::shared_ptr<CEvent>& done)
+    : m_item(item),
+      m_done(done)
+  { }
+
+  virtual bool DoWork()
+  {
+    CMusicInfoScanner::ReadTags(*m_item);
+    m_done->Set();
+    return true;
+  }
+
+  virtual const char* GetType() const { return "musictagreader"; }
+
+private:
+  CFileItemPtr m_item;
+  std::shared_ptr<CEvent> m_done;
+};
+
 CMusicInfoScanner::CMusicInfoScanner()
 : CThread("MusicInfoScanner"),
   m_needsCleanup(false),
@@ -80,6 +107,8 @@ CMusicInfoScanner::CMusicInfoScanner()
   m_itemCount=0;
   m_flags = 0;
   m_bClean = false;
+  m_tagReaders = 1;
+  m_stats = ScanStats();
 }
 
 CMusicInfoScanner::~CMusicInfoScanner()
@@ -136,6 +165,7 @@ void CMusicInfoScanner::Process()
       // result in unexpected behaviour.
       m_bCanInterrupt = false;
       m_needsCleanup = false;
+      m_stats = ScanStats();
 
       bool commit = true;
       for (std::set<std::string>::const_iterator it = m_pathsToScan.begin(); it != m_pathsToScan.end(); ++it)
@@ -152,7 +182,9 @@ void CMusicInfoScanner::Process()
           m_seenPaths.insert(*it);
           continue;
         }
-        else if (!DoScan(*it))
+
+        m_tagReaders = GetTagReaders(*it);
+        if (!DoScan(*it))
         {
           commit = false;
           break;
@@ -186,6 +218,9 @@ void CMusicInfoScanner::Process()
       
       tick = XbmcThreads::SystemClockMillis() - tick;
       CLog::Log(LOGNOTICE, "My Music: Scanning for music info using worker thread, operation took %s", StringUtils::SecondsToTimeString(tick / 1000).c_str());
+      CLog::Log(LOGNOTICE, "My Music: Read tags of %u files in %.1fs (%.1f files/s), added %u songs in %.1fs (%.1f songs/s)",
+                m_stats.files, m_stats.readMs / 1000.0, m_stats.readMs ? m_stats.files * 1000.0 / m_stats.readMs : 0.0,
+                m_stats.songs, m_stats.writeMs / 1000.0, m_stats.writeMs ? m_stats.songs * 1000.0 / m_stats.writeMs : 0.0);
     }
     if (m_scanType == 1) // load album info
     {
@@ -532,15 +567,41 @@ bool CMusicInfoScanner::DoScan(const std::string& strDirectory)
   return !m_bStop;
 }
 
+void CMusicInfoScanner::ReadTags(CFileItem& item)
+{
+  CMusicInfoTag& tag = *item.GetMusicInfoTag();
+  if (!tag.Loaded())
+  {
+    std::unique_ptr<IMusicInfoTagLoader> pLoader (CMusicInfoTagLoaderFactory::CreateLoader(item));
+    if (NULL != pLoader.get())
+      pLoader->Load(item.GetPath(), tag);
+  }
+
+  if ((tag.Loaded() || item.HasCueDocument()) && !tag.GetCueSheet().empty())
+    item.LoadEmbeddedCue();
+}
+
+int CMusicInfoScanner::GetTagReaders(const std::string& strDirectory)
+{
+  // several readers only make an optical drive seek back and forth
+  if (URIUtils::IsOnDVD(strDirectory) || URIUtils::IsCDDA(strDirectory))
+    return 1;
+
+  if (URIUtils::IsRemote(strDirectory))
+    return g_advancedSettings.m_iMusicLibraryRemoteTagReaders;
+
+  return g_advancedSettings.m_iMusicLibraryTagReaders;
+}
+
 INFO_RET CMusicInfoScanner::ScanTags(const CFileItemList& items, CFileItemList& scannedItems)
 {
   std::vector<std::string> regexps = g_advancedSettings.m_audioExcludeFromScanRegExps;
 
+  unsigned int start = XbmcThreads::SystemClockMillis();
+
+  std::vector<std::pair<CFileItemPtr, std::shared_ptr<CEvent>>> files;
   for (int i = 0; i < items.Size(); ++i)
   {
-    if (m_bStop)
-      return INFO_CANCELLED;
-
     CFileItemPtr pItem = items[i];
 
     if (CUtil::ExcludeFileOrFolder(pItem->GetPath(), regexps))
@@ -549,35 +610,57 @@ INFO_RET CMusicInfoScanner::ScanTags(const CFileItemList& items, CFileItemList&
     if (pItem->m_bIsFolder || pItem->IsPlayList() || pItem->IsPicture() || pItem->IsLyrics())
       continue;
 
-    m_currentItem++;
+    files.push_back(std::make_pair(pItem, std::shared_ptr<CEvent>()));
+  }
+
+  size_t queued = 0;
+  for (size_t i = 0; i < files.size(); ++i)
+  {
+    if (m_bStop)
+      return INFO_CANCELLED;
 
-    CMusicInfoTag& tag = *pItem->GetMusicInfoTag();
-    if (!tag.Loaded())
+    // the tags of the next m_tagReaders files are read by workers while we wait for this one.
+    // The results are picked up in order, so the database is still only written from this thread.
+    for (; m_tagReaders > 1 && queued < files.size() && queued < i + m_tagReaders; ++queued)
     {
-      std::unique_ptr<IMusicInfoTagLoader> pLoader (CMusicInfoTagLoaderFactory::CreateLoader(*pItem));
-      if (NULL != pLoader.get())
-        pLoader->Load(pItem->GetPath(), tag);
+      if (files[queued].first->GetMusicInfoTag()->Loaded())
+        continue;
+
+      files[queued].second.reset(new CEvent());
+      CJobManager::GetInstance().AddJob(new CMusicTagReaderJob(files[queued].first, files[queued].second), NULL, CJob::PRIORITY_DEDICATED);
     }
 
+    CFileItemPtr pItem = files[i].first;
+    if (files[i].second)
+    {
+      while (!files[i].second->WaitMSec(100))
+      {
+        if (m_bStop)
+          return INFO_CANCELLED;
+      }
+    }
+    else
+      ReadTags(*pItem);
+
+    m_currentItem++;
+    m_stats.files++;
+
     if (m_handle && m_itemCount>0)
       m_handle->SetPercentage(m_currentItem / (float)m_itemCount * 100);
 
-    if (!tag.Loaded() && !pItem->HasCueDocument())
+    if (!pItem->GetMusicInfoTag()->Loaded() && !pItem->HasCueDocument())
     {
       CLog::Log(LOGDEBUG, "%s - No tag found for: %s", __FUNCTION__, pItem->GetPath().c_str());
       continue;
     }
-    else
-    {
-      if (!tag.GetCueSheet().empty())
-        pItem->LoadEmbeddedCue();
-    }
 
     if (pItem->HasCueDocument())
       pItem->LoadTracksFromCueDocument(scannedItems);
     else
       scannedItems.Add(pItem);
   }
+
+  m_stats.readMs += XbmcThreads::SystemClockMillis() - start;
   return INFO_ADDED;
 }
 
@@ -809,7 +892,10 @@ int CMusicInfoScanner::RetrieveMusicInfo(const std::string& strDirectory, CFileI
       album->releaseType = CAlbum::Single;
 
     album->strPath = strDirectory;
+    unsigned int start = XbmcThreads::SystemClockMillis();
     m_musicDatabase.AddAlbum(*album);
+    m_stats.writeMs += XbmcThreads::SystemClockMillis() - start;
+    m_stats.songs += album->songs.size();
 
     // Yuk - this is a kludgy way to do what we want to do, but it will work to sort
     // out artist fanart until we can restructure the artist fanart to work more
@@ -77,6 +77,12 @@ public:
    */
   static void FileItemsToAlbums(CFileItemList& items, VECALBUMS& albums, MAPSONGS* songsMap = NULL);
 
+  /*! \brief Read the tags of a single file, and its embedded cue sheet if it has one.
+   Called from the tag reader workers, so it must only touch the given item.
+   \param item [in/out] the file to read the tags of
+   */
+  static void ReadTags(CFileItem& item);
+
   /*! \brief Fixup albums and songs
    
    If albumartist is not available in a song, we determine it from the
@@ -182,10 +188,17 @@ protected:
     Given a list of FileItems, scan in the tags for those FileItems
    and populate a new FileItemList with the files that were successfully scanned.
    Any files which couldn't be scanned (no/bad tags) are discarded in the process.
+   The files are read on up to m_tagReaders workers, see GetTagReaders.
    \param items [in] list of FileItems to scan
    \param scannedItems [in] list to populate with the scannedItems
    */
   INFO_RET ScanTags(const CFileItemList& items, CFileItemList& scannedItems);
+
+  /*! \brief Number of files to read at once for the given source.
+   \param strDirectory the source about to be scanned
+   \sa ScanTags
+   */
+  static int GetTagReaders(const std::string& strDirectory);
   int GetPathHash(const CFileItemList &items, std::string &hash);
   void GetAlbumArtwork(long id, const CAlbum &artist);
 
@@ -223,5 +236,17 @@ protected:
   std::set<std::string> m_seenPaths;
   int m_flags;
   CThread m_fileCountReader;
+
+  int m_tagReaders; ///< files read at once for the source being scanned
+
+  /*! \brief Time spent in the tag reading and database stages, logged after the scan
+   */
+  struct ScanStats
+  {
+    unsigned int files;   ///< files whose tags were read
+    unsigned int readMs;  ///< time spent reading them
+    unsigned int songs;   ///< songs written to the database
+    unsigned int writeMs; ///< time spent adding them
+  } m_stats;
 };
 }
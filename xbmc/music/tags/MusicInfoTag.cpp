@@ -746,66 +746,117 @@ void CMusicInfoTag::SetSong(const CSong& song)
 
 void CMusicInfoTag::Serialize(CVariant& value) const
 {
-  value["url"] = m_strURL;
-  value["title"] = m_strTitle;
-  if (m_type.compare(MediaTypeArtist) == 0 && m_artist.size() == 1)
-    value["artist"] = m_artist[0];
-  else
-    value["artist"] = m_artist;
-  // There are situations where the individual artist(s) are not queried from the song_artist and artist tables e.g. playlist,
-  // only artist description from song table. Since processing of the ARTISTS tag was added the individual artists may not always
-  // be accurately derrived by simply splitting the artist desc. Hence m_artist is only populated when the individual artists are
-  // queried, whereas GetArtistString() will always return the artist description.
-  // To avoid empty artist array in JSON, when m_artist is empty then an attempt is made to split the artist desc into artists.
-  // A longer term soltion would be to ensure that when individual artists are to be returned then the song_artist and artist tables
-  // are queried.
-  if (m_artist.empty())
-    value["artist"] = StringUtils::Split(GetArtistString(), g_advancedSettings.m_musicItemSeparator);
-
-  value["displayartist"] = GetArtistString();
-  value["displayalbumartist"] = GetAlbumArtistString();
-  value["album"] = m_strAlbum;
-  value["albumartist"] = m_albumArtist;
-  value["genre"] = m_genre;
-  value["duration"] = m_iDuration;
-  value["track"] = GetTrackNumber();
-  value["disc"] = GetDiscNumber();
-  value["loaded"] = m_bLoaded;
-  value["year"] = m_dwReleaseDate.wYear;
-  value["musicbrainztrackid"] = m_strMusicBrainzTrackID;
-  value["musicbrainzartistid"] = m_musicBrainzArtistID;
-  value["musicbrainzalbumid"] = m_strMusicBrainzAlbumID;
-  value["musicbrainzalbumartistid"] = m_musicBrainzAlbumArtistID; 
-  value["comment"] = m_strComment;
-  value["contributors"] = CVariant(CVariant::VariantTypeArray);
-  for (const auto& role : m_musicRoles)
+  Serialize(value, NULL);
+}
+
+void CMusicInfoTag::SerializeFields(CVariant& value, const std::set<std::string>& fields) const
+{
+  Serialize(value, &fields);
+}
+
+void CMusicInfoTag::Serialize(CVariant& value, const std::set<std::string>* fields) const
+{
+  auto wanted = [fields](const char* field) { return fields == NULL || fields->find(field) != fields->end(); };
+
+  if (wanted("url"))
+    value["url"] = m_strURL;
+  if (wanted("title"))
+    value["title"] = m_strTitle;
+  if (wanted("artist"))
+  {
+    if (m_type.compare(MediaTypeArtist) == 0 && m_artist.size() == 1)
+      value["artist"] = m_artist[0];
+    else
+      value["artist"] = m_artist;
+    // There are situations where the individual artist(s) are not queried from the song_artist and artist tables e.g. playlist,
+    // only artist description from song table. Since processing of the ARTISTS tag was added the individual artists may not always
+    // be accurately derrived by simply splitting the artist desc. Hence m_artist is only populated when the individual artists are
+    // queried, whereas GetArtistString() will always return the artist description.
+    // To avoid empty artist array in JSON, when m_artist is empty then an attempt is made to split the artist desc into artists.
+    // A longer term soltion would be to ensure that when individual artists are to be returned then the song_artist and artist tables
+    // are queried.
+    if (m_artist.empty())
+      value["artist"] = StringUtils::Split(GetArtistString(), g_advancedSettings.m_musicItemSeparator);
+  }
+
+  if (wanted("displayartist"))
+    value["displayartist"] = GetArtistString();
+  if (wanted("displayalbumartist"))
+    value["displayalbumartist"] = GetAlbumArtistString();
+  if (wanted("album"))
+    value["album"] = m_strAlbum;
+  if (wanted("albumartist"))
+    value["albumartist"] = m_albumArtist;
+  if (wanted("genre"))
+    value["genre"] = m_genre;
+  if (wanted("duration"))
+    value["duration"] = m_iDuration;
+  if (wanted("track"))
+    value["track"] = GetTrackNumber();
+  if (wanted("disc"))
+    value["disc"] = GetDiscNumber();
+  if (wanted("loaded"))
+    value["loaded"] = m_bLoaded;
+  if (wanted("year"))
+    value["year"] = m_dwReleaseDate.wYear;
+  if (wanted("musicbrainztrackid"))
+    value["musicbrainztrackid"] = m_strMusicBrainzTrackID;
+  if (wanted("musicbrainzartistid"))
+    value["musicbrainzartistid"] = m_musicBrainzArtistID;
+  if (wanted("musicbrainzalbumid"))
+    value["musicbrainzalbumid"] = m_strMusicBrainzAlbumID;
+  if (wanted("musicbrainzalbumartistid"))
+    value["musicbrainzalbumartistid"] = m_musicBrainzAlbumArtistID; 
+  if (wanted("comment"))
+    value["comment"] = m_strComment;
+  if (wanted("contributors"))
   {
-    CVariant contributor;
-    contributor["name"] = role.GetArtist();
-    contributor["role"] = role.GetRoleDesc();
-    contributor["roleid"] = (int)(role.GetRoleId());
-    contributor["artistid"] = (int)(role.GetArtistId());
-    value["contributors"].push_back(contributor);
+    value["contributors"] = CVariant(CVariant::VariantTypeArray);
+    for (const auto& role : m_musicRoles)
+    {
+      CVariant contributor;
+      contributor["name"] = role.GetArtist();
+      contributor["role"] = role.GetRoleDesc();
+      contributor["roleid"] = (int)(role.GetRoleId());
+      contributor["artistid"] = (int)(role.GetArtistId());
+      value["contributors"].push_back(std::move(contributor));
+    }
   }
-  value["displaycomposer"] = GetArtistStringForRole("composer");   //TCOM
-  value["displayconductor"] = GetArtistStringForRole("conductor"); //TPE3
-  value["displayorchestra"] = GetArtistStringForRole("orchestra");
-  value["displaylyricist"] = GetArtistStringForRole("lyricist");   //TEXT
-  value["mood"] = StringUtils::Split(m_strMood, g_advancedSettings.m_musicItemSeparator);
-  value["recordlabel"] = m_strRecordLabel;
-  value["rating"] = m_Rating;
-  value["userrating"] = m_Userrating;
-  value["votes"] = m_Votes;
-  value["playcount"] = m_iTimesPlayed;
-  value["lastplayed"] = m_lastPlayed.IsValid() ? m_lastPlayed.GetAsDBDateTime() : StringUtils::Empty;
-  value["dateadded"] = m_dateAdded.IsValid() ? m_dateAdded.GetAsDBDateTime() : StringUtils::Empty;
-  value["lyrics"] = m_strLyrics;
-  value["albumid"] = m_iAlbumId;
-  value["compilationartist"] = m_bCompilation;
-  value["compilation"] = m_bCompilation;
-  if (m_type.compare(MediaTypeAlbum) == 0)
+  if (wanted("displaycomposer"))
+    value["displaycomposer"] = GetArtistStringForRole("composer");   //TCOM
+  if (wanted("displayconductor"))
+    value["displayconductor"] = GetArtistStringForRole("conductor"); //TPE3
+  if (wanted("displayorchestra"))
+    value["displayorchestra"] = GetArtistStringForRole("orchestra");
+  if (wanted("displaylyricist"))
+    value["displaylyricist"] = GetArtistStringForRole("lyricist");   //TEXT
+  if (wanted("mood"))
+    value["mood"] = StringUtils::Split(m_strMood, g_advancedSettings.m_musicItemSeparator);
+  if (wanted("recordlabel"))
+    value["recordlabel"] = m_strRecordLabel;
+  if (wanted("rating"))
+    value["rating"] = m_Rating;
+  if (wanted("userrating"))
+    value["userrating"] = m_Userrating;
+  if (wanted("votes"))
+    value["votes"] = m_Votes;
+  if (wanted("playcount"))
+    value["playcount"] = m_iTimesPlayed;
+  if (wanted("lastplayed"))
+    value["lastplayed"] = m_lastPlayed.IsValid() ? m_lastPlayed.GetAsDBDateTime() : StringUtils::Empty;
+  if (wanted("dateadded"))
+    value["dateadded"] = m_dateAdded.IsValid() ? m_dateAdded.GetAsDBDateTime() : StringUtils::Empty;
+  if (wanted("lyrics"))
+    value["lyrics"] = m_strLyrics;
+  if (wanted("albumid"))
+    value["albumid"] = m_iAlbumId;
+  if (wanted("compilationartist"))
+    value["compilationartist"] = m_bCompilation;
+  if (wanted("compilation"))
+    value["compilation"] = m_bCompilation;
+  if (m_type.compare(MediaTypeAlbum) == 0 && wanted("releasetype"))
     value["releasetype"] = CAlbum::ReleaseTypeToString(m_albumReleaseType);
-  else if (m_type.compare(MediaTypeSong) == 0)
+  else if (m_type.compare(MediaTypeSong) == 0 && wanted("albumreleasetype"))
     value["albumreleasetype"] = CAlbum::ReleaseTypeToString(m_albumReleaseType);
 }
 
@@ -171,6 +171,7 @@ public:
 
   virtual void Archive(CArchive& ar);
   virtual void Serialize(CVariant& ar) const;
+  virtual void SerializeFields(CVariant& value, const std::set<std::string>& fields) const;
   virtual void ToSortable(SortItem& sortable, Field field) const;
 
   void Clear();
@@ -182,6 +183,11 @@ protected:
    */
   std::string Trim(const std::string &value) const;
 
+  /*! \brief Serialize the members named in fields, or all of them if fields is NULL.
+   \sa SerializeFields
+   */
+  void Serialize(CVariant& value, const std::set<std::string>* fields) const;
+
   std::string m_strURL;
   std::string m_strTitle;
   std::vector<std::string> m_artist;
@@ -102,6 +102,18 @@ CWebServer::CWebServer()
 #endif
 }
 
+// the webserver owns the data of these responses and has to free it on every path
+static bool MustFreeResponseData(HTTPResponseType type)
+{
+  return type == HTTPMemoryDownloadFreeNoCopy || type == HTTPMemoryDownloadFreeCopy;
+}
+
+static void FreeResponseData(const HttpResponseRanges &ranges)
+{
+  for (HttpResponseRanges::const_iterator range = ranges.begin(); range != ranges.end(); ++range)
+    free(const_cast<void*>(range->GetData()));
+}
+
 static MHD_Response* create_response(size_t size, void* data, int free, int copy)
 {
 #if (MHD_VERSION >= 0x00094001)
@@ -620,6 +632,8 @@ int CWebServer::CreateMemoryDownloadResponse(const std::shared_ptr<IHTTPRequestH
      (!request.ranges.IsEmpty() && responseRanges.size() > request.ranges.Size()))
   {
     CLog::Log(LOGWARNING, "CWebServer[%hu]: response contains more ranges (%d) than the request asked for (%d)", m_port, (int)responseRanges.size(), (int)request.ranges.Size());
+    if (MustFreeResponseData(responseDetails.type))
+      FreeResponseData(responseRanges);
     return SendErrorResponse(request.connection, MHD_HTTP_INTERNAL_SERVER_ERROR, request.method);
   }
 
@@ -632,6 +646,8 @@ int CWebServer::CreateMemoryDownloadResponse(const std::shared_ptr<IHTTPRequestH
     if (!responseRange.IsValid())
     {
       CLog::Log(LOGWARNING, "CWebServer[%hu]: invalid response data with range start at %" PRId64 " and end at %" PRId64, m_port, responseRange.GetFirstPosition(), responseRange.GetLastPosition());
+      if (MustFreeResponseData(responseDetails.type))
+        FreeResponseData(responseRanges);
       return SendErrorResponse(request.connection, MHD_HTTP_INTERNAL_SERVER_ERROR, request.method);
     }
 
@@ -680,7 +696,11 @@ int CWebServer::CreateRangedMemoryDownloadResponse(const std::shared_ptr<IHTTPRe
   {
     // ignore invalid ranges
     if (!range->IsValid())
+    {
+      if (MustFreeResponseData(responseDetails.type))
+        free(const_cast<void*>(range->GetData()));
       continue;
+    }
 
     // determine the first range position
     if (ranges.empty())
@@ -920,6 +940,11 @@ int CWebServer::CreateErrorResponse(struct MHD_Connection *connection, int respo
 int CWebServer::CreateMemoryDownloadResponse(struct MHD_Connection *connection, const void *data, size_t size, bool free, bool copy, struct MHD_Response *&response) const
 {
   response = create_response(size, const_cast<void*>(data), free ? MHD_YES : MHD_NO, copy ? MHD_YES : MHD_NO);
+
+  // MHD only takes over data it doesn't copy, and only if the response was created
+  if (free && (copy || response == nullptr))
+    ::free(const_cast<void*>(data));
+
   if (response == nullptr)
   {
     CLog::Log(LOGERROR, "CWebServer[%hu]: failed to create a HTTP download response", m_port);
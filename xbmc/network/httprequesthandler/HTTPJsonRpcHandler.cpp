@@ -18,6 +18,10 @@
  *
  */
 
+#include <algorithm>
+#include <stdlib.h>
+#include <string.h>
+
 #include "HTTPJsonRpcHandler.h"
 #include "URL.h"
 #include "filesystem/File.h"
@@ -31,6 +35,13 @@
 #include "utils/Variant.h"
 
 #define MAX_HTTP_POST_SIZE 65536
+#define MIN_RESPONSE_BUFFER_SIZE 16384
+
+CHTTPJsonRpcHandler::~CHTTPJsonRpcHandler()
+{
+  // only set if the response never made it to the webserver
+  free(m_responseData);
+}
 
 bool CHTTPJsonRpcHandler::CanHandleRequest(const HTTPRequest &request)
 {
@@ -84,17 +95,27 @@ int CHTTPJsonRpcHandler::HandleRequest()
 
   if (isRequest)
   {
-    m_responseData = JSONRPC::CJSONRPC::MethodCall(m_requestData, &m_transportLayer, &client);
+    if (!jsonpCallback.empty())
+    {
+      WriteResponseData(this, jsonpCallback.c_str(), jsonpCallback.size());
+      WriteResponseData(this, "(", 1);
+    }
+
+    // drop a partially written response, like the empty string MethodCall returns
+    size_t responseStart = m_responseLength;
+    if (!JSONRPC::CJSONRPC::MethodCall(m_requestData, &m_transportLayer, &client, WriteResponseData, this))
+      m_responseLength = responseStart;
 
     if (!jsonpCallback.empty())
-      m_responseData = jsonpCallback + "(" + m_responseData + ");";
+      WriteResponseData(this, ");", 2);
   }
   else if (jsonpCallback.empty())
   {
     // get the whole output of JSONRPC.Introspect
     CVariant result;
     JSONRPC::CJSONServiceDescription::Print(result, &m_transportLayer, &client);
-    m_responseData = CJSONVariantWriter::Write(result, false);
+    if (!CJSONVariantWriter::Write(result, false, WriteResponseData, this))
+      m_responseLength = 0;
   }
   else
   {
@@ -106,16 +127,48 @@ int CHTTPJsonRpcHandler::HandleRequest()
 
   m_requestData.clear();
 
-  m_responseRange.SetData(m_responseData.c_str(), m_responseData.size());
+  if (m_responseFailed)
+    return MHD_NO;
 
-  m_response.type = HTTPMemoryDownloadNoFreeCopy;
+  // the webserver takes over the buffer and frees it, also if it fails to send it
+  m_responseRange.SetData(m_responseData, m_responseLength);
+
+  m_response.type = HTTPMemoryDownloadFreeNoCopy;
   m_response.status = MHD_HTTP_OK;
   m_response.contentType = "application/json";
-  m_response.totalLength = m_responseData.size();
+  m_response.totalLength = m_responseLength;
+
+  if (m_responseLength > 0)
+    m_responseData = nullptr;
 
   return MHD_YES;
 }
 
+void CHTTPJsonRpcHandler::WriteResponseData(void *context, const char *data, size_t length)
+{
+  CHTTPJsonRpcHandler *handler = static_cast<CHTTPJsonRpcHandler*>(context);
+  if (handler->m_responseFailed)
+    return;
+
+  if (handler->m_responseLength + length > handler->m_responseCapacity)
+  {
+    size_t capacity = std::max(std::max(handler->m_responseCapacity * 2, handler->m_responseLength + length), (size_t)MIN_RESPONSE_BUFFER_SIZE);
+    char *responseData = static_cast<char*>(realloc(handler->m_responseData, capacity));
+    if (responseData == nullptr)
+    {
+      CLog::Log(LOGERROR, "CHTTPJsonRpcHandler: failed to allocate %u bytes for the response", (unsigned int)capacity);
+      handler->m_responseFailed = true;
+      return;
+    }
+
+    handler->m_responseData = responseData;
+    handler->m_responseCapacity = capacity;
+  }
+
+  memcpy(handler->m_responseData + handler->m_responseLength, data, length);
+  handler->m_responseLength += length;
+}
+
 HttpResponseRanges CHTTPJsonRpcHandler::GetResponseData() const
 {
   HttpResponseRanges ranges;
@@ -29,7 +29,7 @@ class CHTTPJsonRpcHandler : public IHTTPRequestHandler
 {
 public:
   CHTTPJsonRpcHandler() { }
-  virtual ~CHTTPJsonRpcHandler() { }
+  virtual ~CHTTPJsonRpcHandler();
   
   // implementations of IHTTPRequestHandler
   virtual IHTTPRequestHandler* Create(const HTTPRequest &request) { return new CHTTPJsonRpcHandler(request); }
@@ -46,6 +46,11 @@ protected:
     : IHTTPRequestHandler(request)
   { }
 
+  /*!
+   \brief Appends to m_responseData, used as output callback of the JSON writer.
+   */
+  static void WriteResponseData(void *context, const char *data, size_t length);
+
 #if (MHD_VERSION >= 0x00040001)
   virtual bool appendPostData(const char *data, size_t size);
 #else
@@ -54,7 +59,12 @@ protected:
 
 private:
   std::string m_requestData;
-  std::string m_responseData;
+  /* the response is written straight into a malloc()'ed buffer that is handed over to
+     the webserver without another copy, it's freed once the response has been sent */
+  char *m_responseData = nullptr;
+  size_t m_responseLength = 0;
+  size_t m_responseCapacity = 0;
+  bool m_responseFailed = false;
   CHttpResponseRange m_responseRange;
 
   class CHTTPTransportLayer : public JSONRPC::ITransportLayer
@@ -46,6 +46,65 @@ extern "C" {
 
 using namespace XFILE;
 
+namespace
+{
+// largest scaled image (in pixels) whose buffer is kept around for reuse, enough for a 720p thumb
+const size_t MAX_SCRATCH_PIXELS = 1280 * 720;
+}
+
+/*! \brief Scaler state of a batch of images.
+ Threads caching many images reuse the swscale context while consecutive images have the same
+ geometry and algorithm, and scale into a buffer that is kept between images.
+ */
+class CScalerCache
+{
+public:
+  CScalerCache() : m_context(NULL) {}
+  ~CScalerCache() { sws_freeContext(m_context); }
+
+  struct SwsContext *GetContext(unsigned int in_width, unsigned int in_height,
+                                unsigned int out_width, unsigned int out_height, int flags)
+  {
+    m_context = sws_getCachedContext(m_context, in_width, in_height, AV_PIX_FMT_BGRA,
+                                     out_width, out_height, AV_PIX_FMT_BGRA, flags, NULL, NULL, NULL);
+    return m_context;
+  }
+
+  uint32_t *GetBuffer(size_t pixels)
+  {
+    if (pixels > MAX_SCRATCH_PIXELS)
+      return NULL;
+    if (m_buffer.size() < pixels)
+      m_buffer.resize(pixels);
+    return &m_buffer[0];
+  }
+
+private:
+  struct SwsContext *m_context;
+  std::vector<uint32_t> m_buffer;
+};
+
+namespace
+{
+// the cache of the CPicture::CScalerScope the calling thread is in, if any
+thread_local CScalerCache *t_scalerCache = NULL;
+}
+
+CPicture::CScalerScope::CScalerScope() : m_cache(NULL)
+{
+  if (!t_scalerCache)
+    t_scalerCache = m_cache = new CScalerCache;
+}
+
+CPicture::CScalerScope::~CScalerScope()
+{
+  if (m_cache)
+  {
+    t_scalerCache = NULL;
+    delete m_cache;
+  }
+}
+
 bool CPicture::GetThumbnailFromSurface(const unsigned char* buffer, int width, int height, int stride, const std::string &thumbFile, uint8_t* &result, size_t& result_size)
 {
   unsigned char *thumb = NULL;
@@ -176,7 +235,8 @@ bool CPicture::ResizeTexture(const std::string &image, uint8_t *pixels, uint32_t
   // create a buffer large enough for the resulting image
   GetScale(width, height, dest_width, dest_height);
 
-  uint8_t *buffer = new uint8_t[dest_width * dest_height * sizeof(uint32_t)];
+  uint32_t *scratch = t_scalerCache ? t_scalerCache->GetBuffer(dest_width * dest_height) : NULL;
+  uint8_t *buffer = scratch ? (uint8_t *)scratch : new uint8_t[dest_width * dest_height * sizeof(uint32_t)];
   if (buffer == NULL)
   {
     result = NULL;
@@ -186,14 +246,16 @@ bool CPicture::ResizeTexture(const std::string &image, uint8_t *pixels, uint32_t
 
   if (!ScaleImage(pixels, width, height, pitch, buffer, dest_width, dest_height, dest_width * sizeof(uint32_t), scalingAlgorithm))
   {
-    delete[] buffer;
+    if (!scratch)
+      delete[] buffer;
     result = NULL;
     result_size = 0;
     return false;
   }
 
   bool success = GetThumbnailFromSurface(buffer, dest_width, dest_height, dest_width * sizeof(uint32_t), image, result, result_size);
-  delete[] buffer;
+  if (!scratch)
+    delete[] buffer;
 
   if (!success)
   {
@@ -243,9 +305,11 @@ bool CPicture::CacheTexture(uint8_t *pixels, uint32_t width, uint32_t height, ui
     dest_width = std::min(width, dest_width);
     dest_height = std::min(height, dest_height);
 
-    // create a buffer large enough for the resulting image
+    // create a buffer large enough for the resulting image. Flips happen in place and can use
+    // this thread's scratch buffer, while rotations swap in a newly allocated one.
     GetScale(width, height, dest_width, dest_height);
-    uint32_t *buffer = new uint32_t[dest_width * dest_height];
+    uint32_t *scratch = orientation <= 3 && t_scalerCache ? t_scalerCache->GetBuffer(dest_width * dest_height) : NULL;
+    uint32_t *buffer = scratch ? scratch : new uint32_t[dest_width * dest_height];
     if (buffer)
     {
       if (ScaleImage(pixels, width, height, pitch,
@@ -257,7 +321,8 @@ bool CPicture::CacheTexture(uint8_t *pixels, uint32_t width, uint32_t height, ui
           success = CreateThumbnailFromSurface((unsigned char*)buffer, dest_width, dest_height, dest_width * 4, dest);
         }
       }
-      delete[] buffer;
+      if (buffer != scratch)
+        delete[] buffer;
     }
     return success;
   }
@@ -343,9 +408,11 @@ bool CPicture::ScaleImage(uint8_t *in_pixels, unsigned int in_width, unsigned in
                           uint8_t *out_pixels, unsigned int out_width, unsigned int out_height, unsigned int out_pitch,
                           CPictureScalingAlgorithm::Algorithm scalingAlgorithm /* = CPictureScalingAlgorithm::NoAlgorithm */)
 {
-  struct SwsContext *context = sws_getContext(in_width, in_height, AV_PIX_FMT_BGRA,
-                                                         out_width, out_height, AV_PIX_FMT_BGRA,
-                                                         CPictureScalingAlgorithm::ToSwscale(scalingAlgorithm), NULL, NULL, NULL);
+  // outside of a CScalerScope the context only lives for this image
+  CScalerCache scaler;
+  CScalerCache &cache = t_scalerCache ? *t_scalerCache : scaler;
+  struct SwsContext *context = cache.GetContext(in_width, in_height, out_width, out_height,
+                                                CPictureScalingAlgorithm::ToSwscale(scalingAlgorithm));
 
   uint8_t *src[] = { in_pixels, 0, 0, 0 };
   int     srcStride[] = { (int)in_pitch, 0, 0, 0 };
@@ -355,7 +422,6 @@ bool CPicture::ScaleImage(uint8_t *in_pixels, unsigned int in_width, unsigned in
   if (context)
   {
     sws_scale(context, src, srcStride, 0, in_height, dst, dstStride);
-    sws_freeContext(context);
     return true;
   }
   return false;
@@ -26,10 +26,26 @@
 #include "utils/Job.h"
 
 class CBaseTexture;
+class CScalerCache;
 
 class CPicture
 {
 public:
+  /*! \brief Keeps the swscale context and scratch buffer of the calling thread while it exists.
+   Scaling a batch of images inside one scope reuses them from image to image, they are freed
+   when the outermost scope of the thread goes away.
+   */
+  class CScalerScope
+  {
+  public:
+    CScalerScope();
+    ~CScalerScope();
+  private:
+    CScalerScope(const CScalerScope&);
+    CScalerScope& operator=(const CScalerScope&);
+    CScalerCache *m_cache;
+  };
+
   static bool GetThumbnailFromSurface(const unsigned char* buffer, int width, int height, int stride, const std::string &thumbFile, uint8_t* &result, size_t& result_size);
   static bool CreateThumbnailFromSurface(const unsigned char* buffer, int width, int height, int stride, const std::string &thumbFile);
 
@@ -1030,8 +1030,16 @@ int CPVRChannelGroup::GetEPGNowOrNext(CFileItemList &results, bool bGetNext) con
 }
 
 int CPVRChannelGroup::GetEPGAll(CFileItemList &results, bool bIncludeChannelsWithoutEPG /* = false */) const
+{
+  CDateTime invalidDate;
+  invalidDate.SetValid(false);
+  return GetEPGAll(results, invalidDate, invalidDate, bIncludeChannelsWithoutEPG);
+}
+
+int CPVRChannelGroup::GetEPGAll(CFileItemList &results, const CDateTime &windowStart, const CDateTime &windowEnd, bool bIncludeChannelsWithoutEPG /* = false */) const
 {
   int iInitialSize = results.Size();
+  const bool bWindow(windowStart.IsValid() && windowEnd.IsValid());
   CEpgInfoTagPtr epgTag;
   CPVRChannelPtr channel;
   CSingleLock lock(m_critSection);
@@ -1048,7 +1056,7 @@ int CPVRChannelGroup::GetEPGAll(CFileItemList &results, bool bIncludeChannelsWit
       {
         // XXX channel pointers aren't set in some occasions. this works around the issue, but is not very nice
         epg->SetChannel(channel);
-        iAdded = epg->Get(results);
+        iAdded = bWindow ? epg->Get(results, windowStart, windowEnd) : epg->Get(results);
       }
 
       if (bIncludeChannelsWithoutEPG && iAdded == 0)
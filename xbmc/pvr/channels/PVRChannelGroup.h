@@ -386,6 +386,16 @@ namespace PVR
      */
     int GetEPGAll(CFileItemList &results, bool bIncludeChannelsWithoutEPG = false) const;
 
+    /*!
+     * @brief Get the EPG entries of all channels that are on air at some point in the given window.
+     * @param results The fileitem list to store the results in.
+     * @param windowStart The start of the window (UTC).
+     * @param windowEnd The end of the window (UTC).
+     * @param bIncludeChannelsWithoutEPG, for channels without EPG data in the window, put an empty EPG tag associated with the channel into results
+     * @return The amount of entries that were added.
+     */
+    int GetEPGAll(CFileItemList &results, const CDateTime &windowStart, const CDateTime &windowEnd, bool bIncludeChannelsWithoutEPG = false) const;
+
     /*!
      * @brief Get all entries that are active now.
      * @param results The fileitem list to store the results in.
@@ -172,22 +172,52 @@ bool CPVRRecording::operator !=(const CPVRRecording& right) const
 
 void CPVRRecording::Serialize(CVariant& value) const
 {
-  CVideoInfoTag::Serialize(value);
-
-  value["channel"] = m_strChannelName;
-  value["runtime"] = m_duration.GetSecondsTotal();
-  value["lifetime"] = m_iLifetime;
-  value["streamurl"] = m_strStreamURL;
-  value["directory"] = m_strDirectory;
-  value["icon"] = m_strIconPath;
-  value["starttime"] = m_recordingTime.IsValid() ? m_recordingTime.GetAsDBDateTime() : "";
-  value["endtime"] = m_recordingTime.IsValid() ? (m_recordingTime + m_duration).GetAsDBDateTime() : "";
-  value["recordingid"] = m_iRecordingId;
-  value["isdeleted"] = m_bIsDeleted;
-  value["epgeventid"] = m_iEpgEventId;
-  value["channeluid"] = m_iChannelUid;
-  value["radio"] = m_bRadio;
+  Serialize(value, NULL);
+}
+
+void CPVRRecording::SerializeFields(CVariant& value, const std::set<std::string>& fields) const
+{
+  Serialize(value, &fields);
+}
 
+void CPVRRecording::Serialize(CVariant& value, const std::set<std::string>* fields) const
+{
+  if (fields)
+    CVideoInfoTag::SerializeFields(value, *fields);
+  else
+    CVideoInfoTag::Serialize(value);
+
+  auto wanted = [fields](const char* field) { return fields == NULL || fields->find(field) != fields->end(); };
+
+  if (wanted("channel"))
+    value["channel"] = m_strChannelName;
+  if (wanted("runtime"))
+    value["runtime"] = m_duration.GetSecondsTotal();
+  if (wanted("lifetime"))
+    value["lifetime"] = m_iLifetime;
+  if (wanted("streamurl"))
+    value["streamurl"] = m_strStreamURL;
+  if (wanted("directory"))
+    value["directory"] = m_strDirectory;
+  if (wanted("icon"))
+    value["icon"] = m_strIconPath;
+  if (wanted("starttime"))
+    value["starttime"] = m_recordingTime.IsValid() ? m_recordingTime.GetAsDBDateTime() : "";
+  if (wanted("endtime"))
+    value["endtime"] = m_recordingTime.IsValid() ? (m_recordingTime + m_duration).GetAsDBDateTime() : "";
+  if (wanted("recordingid"))
+    value["recordingid"] = m_iRecordingId;
+  if (wanted("isdeleted"))
+    value["isdeleted"] = m_bIsDeleted;
+  if (wanted("epgeventid"))
+    value["epgeventid"] = m_iEpgEventId;
+  if (wanted("channeluid"))
+    value["channeluid"] = m_iChannelUid;
+  if (wanted("radio"))
+    value["radio"] = m_bRadio;
+
+  if (!wanted("art"))
+    return;
   if (!value.isMember("art"))
     value["art"] = CVariant(CVariant::VariantTypeObject);
   if (!m_strThumbnailPath.empty())
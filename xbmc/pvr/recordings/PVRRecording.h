@@ -35,6 +35,7 @@
  *
  */
 
+#include <set>
 #include <string>
 #include <memory>
 #include <vector>
@@ -101,6 +102,7 @@ namespace PVR
     bool operator !=(const CPVRRecording& right) const;
 
     virtual void Serialize(CVariant& value) const;
+    virtual void SerializeFields(CVariant& value, const std::set<std::string>& fields) const;
 
     /*!
      * @brief Reset this tag to it's initial state.
@@ -252,6 +254,7 @@ namespace PVR
     bool         m_bRadio;        /*!< radio or tv recording */
 
     void UpdatePath(void);
+    void Serialize(CVariant& value, const std::set<std::string>* fields) const;
     void DisplayError(PVR_ERROR err) const;
   };
 }
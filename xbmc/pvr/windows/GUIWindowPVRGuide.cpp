@@ -540,11 +540,6 @@ bool CGUIWindowPVRGuide::RefreshTimelineItems()
       if (!group)
         return false;
 
-      std::unique_ptr<CFileItemList> timeline(new CFileItemList);
-
-      // can be very expensive. never call with lock acquired.
-      group->GetEPGAll(*timeline, true);
-
       CDateTime startDate(group->GetFirstEPGDate());
       CDateTime endDate(group->GetLastEPGDate());
       const CDateTime currentDate(CDateTime::GetCurrentDateTime().GetAsUTCDateTime());
@@ -560,6 +555,12 @@ bool CGUIWindowPVRGuide::RefreshTimelineItems()
       if (startDate < maxPastDate)
         startDate = maxPastDate;
 
+      // only fetch what the grid can show. tags that ended before startDate are never displayed.
+      std::unique_ptr<CFileItemList> timeline(new CFileItemList);
+
+      // can be very expensive. never call with lock acquired.
+      group->GetEPGAll(*timeline, startDate, endDate, true);
+
       // can be very expensive. never call with lock acquired.
       epgGridContainer->SetTimelineItems(timeline, startDate, endDate);
 
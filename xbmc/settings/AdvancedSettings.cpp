@@ -125,6 +125,7 @@ void CAdvancedSettings::Initialize()
 
   m_audioDefaultPlayer = "paplayer";
   m_audioPlayCountMinimumPercent = 90.0f;
+  m_audioPreDecodeItems = 1;
 
   m_videoSubsDelayRange = 60;
   m_videoAudioDelayRange = 10;
@@ -282,6 +283,9 @@ void CAdvancedSettings::Initialize()
   m_musicArtistSeparators = { ";", " feat. ", " ft. " };
   m_videoItemSeparator = " / ";
   m_iMusicLibraryDateAdded = 1; // prefer mtime over ctime and current time
+  m_iMusicLibraryTagReaders = 2;
+  m_iMusicLibraryRemoteTagReaders = 4;
+  m_bMusicLibraryWatchSources = false;
 
   m_bVideoLibraryAllItemsOnBottom = false;
   m_iVideoLibraryRecentlyAddedItems = 25;
@@ -290,6 +294,8 @@ void CAdvancedSettings::Initialize()
   m_bVideoLibraryExportAutoThumbs = false;
   m_bVideoLibraryImportWatchedState = false;
   m_bVideoLibraryImportResumePoint = false;
+  m_iVideoLibraryScanConnections = 4;
+  m_bVideoLibraryWatchSources = false;
   m_bVideoScannerIgnoreErrors = false;
   m_iVideoLibraryDateAdded = 1; // prefer mtime over ctime and current time
 
@@ -360,6 +366,10 @@ void CAdvancedSettings::Initialize()
   // the following setting determines the readRate of a player data
   // as multiply of the default data read rate
   m_cacheReadFactor = 4.0f;
+  // number of source reads the cache keeps in flight, 1 reads sequentially
+  m_cacheReadAheadStreams = 1;
+  // memory map local media and cached textures that are not buffered
+  m_cacheMemoryMapping = false;
 
   m_addonPackageFolderSize = 200;
 
@@ -509,6 +519,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetString(pElement, "defaultplayer", m_audioDefaultPlayer);
     // 101 on purpose - can be used to never automark as watched
     XMLUtils::GetFloat(pElement, "playcountminimumpercent", m_audioPlayCountMinimumPercent, 0.0f, 101.0f);
+    XMLUtils::GetInt(pElement, "predecodeitems", m_audioPreDecodeItems, 0, 5);
 
     XMLUtils::GetBoolean(pElement, "usetimeseeking", m_musicUseTimeSeeking);
     XMLUtils::GetInt(pElement, "timeseekforward", m_musicTimeSeekForward, 0, 6000);
@@ -743,6 +754,9 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetString(pElement, "albumformat", m_strMusicLibraryAlbumFormat);
     XMLUtils::GetString(pElement, "itemseparator", m_musicItemSeparator);
     XMLUtils::GetInt(pElement, "dateadded", m_iMusicLibraryDateAdded);
+    XMLUtils::GetInt(pElement, "tagreaders", m_iMusicLibraryTagReaders, 1, 16);
+    XMLUtils::GetInt(pElement, "remotetagreaders", m_iMusicLibraryRemoteTagReaders, 1, 16);
+    XMLUtils::GetBoolean(pElement, "watchsources", m_bMusicLibraryWatchSources);
     //Music artist name separators
     TiXmlElement* separators = pElement->FirstChildElement("artistseparators");
     if (separators)
@@ -770,6 +784,8 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetBoolean(pElement, "importwatchedstate", m_bVideoLibraryImportWatchedState);
     XMLUtils::GetBoolean(pElement, "importresumepoint", m_bVideoLibraryImportResumePoint);
     XMLUtils::GetInt(pElement, "dateadded", m_iVideoLibraryDateAdded);
+    XMLUtils::GetInt(pElement, "scanconnectionsperhost", m_iVideoLibraryScanConnections, 0, 16);
+    XMLUtils::GetBoolean(pElement, "watchsources", m_bVideoLibraryWatchSources);
   }
 
   pElement = pRootElement->FirstChildElement("videoscanner");
@@ -807,6 +823,8 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetUInt(pElement, "memorysize", m_cacheMemSize);
     XMLUtils::GetUInt(pElement, "buffermode", m_cacheBufferMode, 0, 4);
     XMLUtils::GetFloat(pElement, "readfactor", m_cacheReadFactor);
+    XMLUtils::GetUInt(pElement, "readaheadstreams", m_cacheReadAheadStreams, 1, 8);
+    XMLUtils::GetBoolean(pElement, "memorymapping", m_cacheMemoryMapping);
   }
 
   pElement = pRootElement->FirstChildElement("jsonrpc");
@@ -140,6 +140,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     float m_ac3Gain;
     std::string m_audioDefaultPlayer;
     float m_audioPlayCountMinimumPercent;
+    int m_audioPreDecodeItems; ///< number of upcoming playlist items the audio player decodes ahead
     bool m_VideoPlayerIgnoreDTSinWAV;
     float m_limiterHold;
     float m_limiterRelease;
@@ -254,6 +255,9 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
 
     int m_iMusicLibraryRecentlyAddedItems;
     int m_iMusicLibraryDateAdded;
+    int m_iMusicLibraryTagReaders;       ///< files read at once while scanning a local source
+    int m_iMusicLibraryRemoteTagReaders; ///< files read at once while scanning a network source
+    bool m_bMusicLibraryWatchSources;    ///< scan changed folders of local sources as they change
     bool m_bMusicLibraryAllItemsOnBottom;
     bool m_bMusicLibraryCleanOnUpdate;
     std::string m_strMusicLibraryAlbumFormat;
@@ -270,6 +274,8 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_bVideoLibraryExportAutoThumbs;
     bool m_bVideoLibraryImportWatchedState;
     bool m_bVideoLibraryImportResumePoint;
+    int m_iVideoLibraryScanConnections; ///< directories of a host listed at once while scanning, 0 lists them inline
+    bool m_bVideoLibraryWatchSources;   ///< scan changed folders of local sources as they change
 
     bool m_bVideoScannerIgnoreErrors;
     int m_iVideoLibraryDateAdded;
@@ -344,6 +350,8 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     unsigned int m_cacheMemSize;
     unsigned int m_cacheBufferMode;
     float m_cacheReadFactor;
+    unsigned int m_cacheReadAheadStreams;
+    bool m_cacheMemoryMapping;
 
     bool m_jsonOutputCompact;
     unsigned int m_jsonTcpPort;
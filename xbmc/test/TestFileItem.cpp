@@ -20,7 +20,10 @@
 
 #include "FileItem.h"
 #include "URL.h"
+#include "pvr/recordings/PVRRecording.h"
 #include "settings/AdvancedSettings.h"
+#include "utils/Variant.h"
+#include "video/VideoInfoTag.h"
 
 #include "gtest/gtest.h"
 
@@ -136,3 +139,65 @@ const TestFileData BaseMovies[] = {{ "c:\\dir\\filename.avi", false, "c:\\dir\\f
                                    { "/home/user/movies/movie_name/BDMV/index.bdmv", true, "/home/user/movies/movie_name/" }};
 
 INSTANTIATE_TEST_CASE_P(BaseNameMovies, TestFileItemBasePath, ValuesIn(BaseMovies));
+
+TEST(TestFileItem, SerializeFields)
+{
+  CFileItem item("/home/user/movies/movie.mkv", false);
+  item.GetVideoInfoTag()->m_strTitle = "Movie";
+  item.GetVideoInfoTag()->m_strPlot = "Plot";
+  item.GetVideoInfoTag()->m_iDbId = 12;
+
+  CVariant full;
+  item.GetVideoInfoTag()->Serialize(full);
+
+  std::set<std::string> fields;
+  fields.insert("title");
+  fields.insert("dbid");
+  CVariant projected;
+  item.GetVideoInfoTag()->SerializeFields(projected, fields);
+  EXPECT_EQ(2U, projected.size());
+  EXPECT_EQ(full["title"], projected["title"]);
+  EXPECT_EQ(full["dbid"], projected["dbid"]);
+  EXPECT_FALSE(projected.isMember("plot"));
+
+  // the item doesn't serialize its tags again unless they're asked for
+  CVariant serialized;
+  item.Serialize(serialized);
+  EXPECT_TRUE(serialized.isMember("videoInfoTag"));
+  CVariant projectedItem;
+  item.SerializeFields(projectedItem, fields);
+  EXPECT_FALSE(projectedItem.isMember("videoInfoTag"));
+  EXPECT_FALSE(projectedItem.isMember("strPath"));
+}
+
+TEST(TestFileItem, SerializeFieldsRecording)
+{
+  PVR::CPVRRecording recording;
+  recording.m_strTitle = "Recording";
+  recording.m_strPlot = "Plot";
+  recording.m_strChannelName = "Channel";
+  recording.m_duration.SetDateTimeSpan(0, 1, 30, 0);
+  recording.m_iLifetime = 99;
+  recording.m_iRecordingId = 7;
+  recording.m_strThumbnailPath = "thumb.jpg";
+
+  CVariant full;
+  recording.Serialize(full);
+
+  std::set<std::string> fields;
+  fields.insert("title");
+  fields.insert("channel");
+  fields.insert("runtime");
+  fields.insert("lifetime");
+  fields.insert("recordingid");
+  fields.insert("art");
+  CVariant projected;
+  static_cast<const ISerializable&>(recording).SerializeFields(projected, fields);
+  EXPECT_EQ(fields.size(), projected.size());
+  for (std::set<std::string>::const_iterator field = fields.begin(); field != fields.end(); ++field)
+    EXPECT_EQ(full[*field], projected[*field]) << *field;
+  EXPECT_EQ(5400, projected["runtime"].asInteger());
+  EXPECT_EQ("thumb.jpg", projected["art"]["thumb"].asString());
+  EXPECT_FALSE(projected.isMember("plot"));
+  EXPECT_FALSE(projected.isMember("streamurl"));
+}
@@ -0,0 +1,124 @@
+/*
+ *      Copyright (C) 2005-2013 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "GUIInfoManager.h"
+#include "utils/Stopwatch.h"
+#include "utils/StringUtils.h"
+
+#include <iostream>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+class TestInfoExpression : public testing::Test
+{
+protected:
+  ~TestInfoExpression()
+  {
+    g_infoManager.Clear();
+  }
+};
+
+TEST_F(TestInfoExpression, Evaluate)
+{
+  EXPECT_TRUE(g_infoManager.EvaluateBool("true"));
+  EXPECT_FALSE(g_infoManager.EvaluateBool("false"));
+  EXPECT_FALSE(g_infoManager.EvaluateBool("!true"));
+  EXPECT_TRUE(g_infoManager.EvaluateBool("true + !false"));
+  EXPECT_FALSE(g_infoManager.EvaluateBool("true + false"));
+  EXPECT_TRUE(g_infoManager.EvaluateBool("false | true"));
+  EXPECT_TRUE(g_infoManager.EvaluateBool("false | true + true"));
+  EXPECT_FALSE(g_infoManager.EvaluateBool("[false | true] + false"));
+  EXPECT_TRUE(g_infoManager.EvaluateBool("![false | false] + [true | false]"));
+  EXPECT_FALSE(g_infoManager.EvaluateBool("!false + !![true + false]"));
+  EXPECT_TRUE(g_infoManager.EvaluateBool("[[false | [true + true]] + true] | false"));
+}
+
+TEST_F(TestInfoExpression, EvaluateRepeated)
+{
+  // short-circuiting reorders operands, the result must not change
+  for (int i = 0; i < 10; i++)
+  {
+    EXPECT_TRUE(g_infoManager.EvaluateBool("false | false | false | true"));
+    EXPECT_FALSE(g_infoManager.EvaluateBool("true + true + true + false"));
+  }
+}
+
+TEST_F(TestInfoExpression, RegisterReturnsSameInstance)
+{
+  INFO::InfoPtr a = g_infoManager.Register("true + !false", 0);
+  INFO::InfoPtr b = g_infoManager.Register("TRUE + !False", 0);
+  INFO::InfoPtr c = g_infoManager.Register("true + !false", 1);
+  ASSERT_TRUE(a != nullptr);
+  EXPECT_EQ(a, b);
+  EXPECT_NE(a, c);
+}
+
+TEST_F(TestInfoExpression, EstuarySizedConditions)
+{
+  static const int conditions = 5000;
+  std::vector<std::string> expressions;
+  for (int i = 0; i < conditions; i++)
+  {
+    std::string alarm = StringUtils::Format("system.hasalarm(timer%i)", i);
+    switch (i % 4)
+    {
+    case 0:
+      expressions.push_back(alarm);
+      break;
+    case 1:
+      expressions.push_back("!" + alarm + " + true");
+      break;
+    case 2:
+      expressions.push_back(StringUtils::Format("[%s | system.hasalarm(timer%i)] + !false", alarm.c_str(), i / 2));
+      break;
+    default:
+      expressions.push_back(StringUtils::Format("false | [true + !%s] | [false + system.hasalarm(timer%i)]", alarm.c_str(), i / 3));
+      break;
+    }
+  }
+
+  std::vector<INFO::InfoPtr> bools;
+  CStopWatch timer;
+  timer.StartZero();
+  for (std::vector<std::string>::const_iterator i = expressions.begin(); i != expressions.end(); ++i)
+    bools.push_back(g_infoManager.Register(*i, 0));
+  float registered = timer.GetElapsedMilliseconds();
+
+  timer.StartZero();
+  for (std::vector<std::string>::const_iterator i = expressions.begin(); i != expressions.end(); ++i)
+    EXPECT_EQ(bools[i - expressions.begin()], g_infoManager.Register(*i, 0));
+  float reregistered = timer.GetElapsedMilliseconds();
+
+  timer.StartZero();
+  int trueCount = 0;
+  for (std::vector<std::string>::const_iterator i = expressions.begin(); i != expressions.end(); ++i)
+  {
+    if (g_infoManager.EvaluateBool(*i))
+      trueCount++;
+  }
+  float evaluated = timer.GetElapsedMilliseconds();
+
+  // no alarms are set, so exactly the negated conditions hold
+  EXPECT_EQ(conditions / 2, trueCount);
+  std::cout << "Register " << conditions << " conditions (ms): " << testing::PrintToString(registered) << std::endl;
+  std::cout << "Re-register (ms): " << testing::PrintToString(reregistered) << std::endl;
+  std::cout << "EvaluateBool (ms): " << testing::PrintToString(evaluated) << std::endl;
+}
@@ -76,6 +76,9 @@ public:
   /* Function to get GUI settings files. */
   std::vector<std::string> &getGUISettingsFiles();
 
+  /* Function to get the media files played by the player benchmarks. */
+  std::vector<std::string> &getBenchmarkMediaFiles();
+
   /* Function used in creating a corrupted file. The parameters are a URL
    * to the original file to be corrupted and a suffix to append to the
    * path of the newly created file. This will return a XFILE::CFile
@@ -101,6 +104,7 @@ private:
 
   std::vector<std::string> AdvancedSettingsFiles;
   std::vector<std::string> GUISettingsFiles;
+  std::vector<std::string> BenchmarkMediaFiles;
 
   double probability;
 };
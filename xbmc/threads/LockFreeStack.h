@@ -0,0 +1,110 @@
+#pragma once
+/*
+ *      Copyright (C) 2005-2013 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <atomic>
+#include <memory>
+#include <stdint.h>
+
+/*!
+ \brief Lock-free LIFO of the indices 0 .. capacity - 1.
+
+ Meant as the free list of a pool whose items are numbered. Push and Pop can be called
+ from any thread, they neither lock nor allocate. The head carries a tag that changes with
+ every update, a Pop that read the head before another thread popped and pushed the same
+ index again fails instead of installing a stale next index.
+ An index must not be pushed while it is already in the stack.
+ */
+class CLockFreeIndexStack
+{
+public:
+  explicit CLockFreeIndexStack(unsigned int capacity = 0) : m_head(Head(EMPTY, 0)), m_size(0)
+  {
+    Reset(capacity);
+  }
+
+  /*!
+   \brief Empty the stack and change the number of indices it can hold. Not thread safe.
+   */
+  void Reset(unsigned int capacity)
+  {
+    m_next.reset(capacity ? new std::atomic<uint32_t>[capacity] : NULL);
+    m_capacity = capacity;
+    m_head = Head(EMPTY, 0);
+    m_size = 0;
+  }
+
+  bool Push(unsigned int index)
+  {
+    if (index >= m_capacity)
+      return false;
+
+    uint64_t head = m_head.load(std::memory_order_relaxed);
+    do
+    {
+      m_next[index].store(Index(head), std::memory_order_relaxed);
+    } while (!m_head.compare_exchange_weak(head, Head(index, Tag(head) + 1),
+                                           std::memory_order_release, std::memory_order_relaxed));
+    m_size.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  bool Pop(unsigned int &index)
+  {
+    uint64_t head = m_head.load(std::memory_order_acquire);
+    uint32_t next;
+    do
+    {
+      if (Index(head) == EMPTY)
+        return false;
+      next = m_next[Index(head)].load(std::memory_order_relaxed);
+    } while (!m_head.compare_exchange_weak(head, Head(next, Tag(head) + 1),
+                                           std::memory_order_acquire, std::memory_order_acquire));
+    index = Index(head);
+    m_size.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /*!
+   \brief Number of indices in the stack, only a snapshot while other threads use it.
+   */
+  unsigned int Size() const
+  {
+    int size = m_size.load(std::memory_order_relaxed);
+    return size > 0 ? size : 0;
+  }
+
+  bool Empty() const { return Index(m_head.load(std::memory_order_relaxed)) == EMPTY; }
+  unsigned int Capacity() const { return m_capacity; }
+
+private:
+  CLockFreeIndexStack(const CLockFreeIndexStack&);
+  CLockFreeIndexStack& operator=(const CLockFreeIndexStack&);
+
+  static const uint32_t EMPTY = 0xFFFFFFFF;
+  static uint64_t Head(uint32_t index, uint32_t tag) { return ((uint64_t)tag << 32) | index; }
+  static uint32_t Index(uint64_t head) { return (uint32_t)head; }
+  static uint32_t Tag(uint64_t head) { return (uint32_t)(head >> 32); }
+
+  std::atomic<uint64_t> m_head;
+  std::atomic<int> m_size;
+  std::unique_ptr<std::atomic<uint32_t>[]> m_next;
+  unsigned int m_capacity;
+};
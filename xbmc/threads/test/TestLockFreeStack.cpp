@@ -0,0 +1,112 @@
+/*
+ *      Copyright (C) 2005-2013 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "TestHelpers.h"
+#include "threads/LockFreeStack.h"
+
+#include <atomic>
+#include <memory>
+#include <set>
+#include <vector>
+
+#define TESTNUM 100000
+#define NUMTHREADS 8
+#define NUMINDICES 16
+
+TEST(TestLockFreeStack, PushPop)
+{
+  CLockFreeIndexStack stack(4);
+  unsigned int index;
+
+  EXPECT_TRUE(stack.Empty());
+  EXPECT_FALSE(stack.Pop(index));
+  EXPECT_FALSE(stack.Push(4));
+
+  for (unsigned int i = 0; i < 4; i++)
+    EXPECT_TRUE(stack.Push(i));
+  EXPECT_EQ(4u, stack.Size());
+
+  for (unsigned int i = 4; i > 0; i--)
+  {
+    ASSERT_TRUE(stack.Pop(index));
+    EXPECT_EQ(i - 1, index);
+  }
+  EXPECT_TRUE(stack.Empty());
+  EXPECT_EQ(0u, stack.Size());
+
+  stack.Push(2);
+  stack.Reset(8);
+  EXPECT_TRUE(stack.Empty());
+  EXPECT_EQ(8u, stack.Capacity());
+}
+
+class DoPopPush : public IRunnable
+{
+  CLockFreeIndexStack& stack;
+  std::atomic<int>* owners;
+public:
+  std::atomic<int>& errors;
+
+  inline DoPopPush(CLockFreeIndexStack& s, std::atomic<int>* o, std::atomic<int>& e) : stack(s), owners(o), errors(e) {}
+
+  virtual void Run()
+  {
+    unsigned int index;
+    for (int i = 0; i < TESTNUM; i++)
+    {
+      if (!stack.Pop(index))
+        continue;
+      // nobody else may hold the index while we do
+      if (owners[index].fetch_add(1) != 0)
+        errors++;
+      owners[index].fetch_sub(1);
+      stack.Push(index);
+    }
+  }
+};
+
+TEST(TestLockFreeStack, Threads)
+{
+  CLockFreeIndexStack stack(NUMINDICES);
+  for (unsigned int i = 0; i < NUMINDICES; i++)
+    stack.Push(i);
+
+  std::atomic<int> owners[NUMINDICES];
+  for (int i = 0; i < NUMINDICES; i++)
+    owners[i] = 0;
+  std::atomic<int> errors(0);
+  DoPopPush dpp(stack, owners, errors);
+
+  std::vector<std::shared_ptr<thread>> t(NUMTHREADS);
+  for (size_t i = 0; i < NUMTHREADS; i++)
+    t[i].reset(new thread(dpp));
+
+  for (size_t i = 0; i < NUMTHREADS; i++)
+    t[i]->join();
+
+  EXPECT_EQ(0, errors);
+
+  // every index made it back exactly once
+  std::set<unsigned int> indices;
+  unsigned int index;
+  while (stack.Pop(index))
+    EXPECT_TRUE(indices.insert(index).second);
+  EXPECT_EQ((size_t)NUMINDICES, indices.size());
+}
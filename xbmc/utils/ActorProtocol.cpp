@@ -33,15 +33,58 @@ void Message::Release()
   if (skip)
     return;
 
-  // free data buffer
-  if (data != buffer)
-    delete [] data;
+  // payload buffer and event stay with the message for its next use
+  origin->ReturnMessage(this);
+}
 
-  // delete event in case of sync message
-  if (event)
-    delete event;
+Message::~Message()
+{
+  delete [] heapBuffer;
+  delete syncEvent;
+}
 
-  origin->ReturnMessage(this);
+void Message::SetData(void *payload, int size)
+{
+  if (size > MSG_INTERNAL_BUFFER_SIZE)
+  {
+    if (size > heapBufferSize)
+    {
+      delete [] heapBuffer;
+      heapBuffer = new uint8_t[size];
+      heapBufferSize = size;
+      origin->allocations++;
+    }
+    data = heapBuffer;
+  }
+  else
+    data = buffer;
+  memcpy(data, payload, size);
+  payloadSize = size;
+}
+
+void MessageQueue::push(Message *msg)
+{
+  msg->next = NULL;
+  if (tail)
+    tail->next = msg;
+  else
+    head = msg;
+  tail = msg;
+}
+
+void MessageQueue::push_front(Message *msg)
+{
+  msg->next = head;
+  head = msg;
+  if (!tail)
+    tail = msg;
+}
+
+void MessageQueue::pop()
+{
+  head = head->next;
+  if (!head)
+    tail = NULL;
 }
 
 bool Message::Reply(int sig, void *data /* = NULL*/, int size /* = 0 */)
@@ -63,13 +106,7 @@ bool Message::Reply(int sig, void *data /* = NULL*/, int size /* = 0 */)
     msg->isOut = !isOut;
     replyMessage = msg;
     if (data)
-    {
-      if (size > MSG_INTERNAL_BUFFER_SIZE)
-        msg->data = new uint8_t[size];
-      else
-        msg->data = msg->buffer;
-      memcpy(msg->data, data, size);
-    }
+      msg->SetData(data, size);
   }
 
   origin->Unlock();
@@ -80,6 +117,17 @@ bool Message::Reply(int sig, void *data /* = NULL*/, int size /* = 0 */)
   return true;
 }
 
+Protocol::Protocol(std::string name, CEvent* inEvent, CEvent *outEvent)
+  : portName(name), inDefered(false), outDefered(false), allocations(0)
+{
+  containerInEvent = inEvent;
+  containerOutEvent = outEvent;
+
+  // enough messages for the ports of the audio engine to never allocate
+  for (int i = 0; i < MSG_PREALLOCATED; i++)
+    freeMessageQueue.push(new Message());
+}
+
 Protocol::~Protocol()
 {
   Message *msg;
@@ -104,7 +152,10 @@ Message *Protocol::GetMessage()
     freeMessageQueue.pop();
   }
   else
+  {
     msg = new Message();
+    allocations++;
+  }
 
   msg->isSync = false;
   msg->isSyncFini = false;
@@ -122,7 +173,7 @@ void Protocol::ReturnMessage(Message *msg)
 {
   CSingleLock lock(criticalSection);
 
-  freeMessageQueue.push(msg);
+  freeMessageQueue.push_front(msg);
 }
 
 bool Protocol::SendOutMessage(int signal, void *data /* = NULL */, int size /* = 0 */, Message *outMsg /* = NULL */)
@@ -137,13 +188,7 @@ bool Protocol::SendOutMessage(int signal, void *data /* = NULL */, int size /* =
   msg->isOut = true;
 
   if (data)
-  {
-    if (size > MSG_INTERNAL_BUFFER_SIZE)
-      msg->data = new uint8_t[size];
-    else
-      msg->data = msg->buffer;
-    memcpy(msg->data, data, size);
-  }
+    msg->SetData(data, size);
 
   { CSingleLock lock(criticalSection);
     outMessages.push(msg);
@@ -165,13 +210,7 @@ bool Protocol::SendInMessage(int signal, void *data /* = NULL */, int size /* =
   msg->isOut = false;
 
   if (data)
-  {
-    if (size > MSG_INTERNAL_BUFFER_SIZE)
-      msg->data = new uint8_t[size];
-    else
-      msg->data = msg->buffer;
-    memcpy(msg->data, data, size);
-  }
+    msg->SetData(data, size);
 
   { CSingleLock lock(criticalSection);
     inMessages.push(msg);
@@ -187,7 +226,12 @@ bool Protocol::SendOutMessageSync(int signal, Message **retMsg, int timeout, voi
   Message *msg = GetMessage();
   msg->isOut = true;
   msg->isSync = true;
-  msg->event = new CEvent;
+  if (!msg->syncEvent)
+  {
+    msg->syncEvent = new CEvent;
+    allocations++;
+  }
+  msg->event = msg->syncEvent;
   msg->event->Reset();
   SendOutMessage(signal, data, size, msg);
 
@@ -255,7 +299,7 @@ void Protocol::Purge()
 void Protocol::PurgeIn(int signal)
 {
   Message *msg;
-  std::queue<Message*> msgs;
+  MessageQueue msgs;
 
   CSingleLock lock(criticalSection);
 
@@ -277,7 +321,7 @@ void Protocol::PurgeIn(int signal)
 void Protocol::PurgeOut(int signal)
 {
   Message *msg;
-  std::queue<Message*> msgs;
+  MessageQueue msgs;
 
   CSingleLock lock(criticalSection);
 
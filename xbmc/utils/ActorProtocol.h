@@ -21,10 +21,11 @@
 #pragma once
 
 #include "threads/Thread.h"
-#include <queue>
+#include <atomic>
 #include "memory.h"
 
 #define MSG_INTERNAL_BUFFER_SIZE 32
+#define MSG_PREALLOCATED 16
 
 namespace Actor
 {
@@ -34,6 +35,7 @@ class Protocol;
 class Message
 {
   friend class Protocol;
+  friend class MessageQueue;
 public:
   int signal;
   bool isSync;
@@ -51,14 +53,40 @@ public:
   bool Reply(int sig, void *data = NULL, int size = 0);
 
 private:
-  Message() {isSync = false; data = NULL; event = NULL; replyMessage = NULL;};
+  Message() {isSync = false; data = NULL; event = NULL; replyMessage = NULL; syncEvent = NULL; heapBuffer = NULL; heapBufferSize = 0; next = NULL;};
+  ~Message();
+  void SetData(void *payload, int size);
+
+  // kept while the message goes back and forth through the free queue
+  CEvent *syncEvent;
+  uint8_t *heapBuffer;
+  int heapBufferSize;
+  Message *next;
+};
+
+/*!
+ \brief Queue of messages linked through the messages themselves, queueing never allocates.
+ push_front makes it a stack, the free messages that were used last are handed out first.
+ */
+class MessageQueue
+{
+public:
+  MessageQueue() : head(NULL), tail(NULL) {};
+  bool empty() const {return head == NULL;};
+  Message *front() const {return head;};
+  void push(Message *msg);
+  void push_front(Message *msg);
+  void pop();
+
+private:
+  Message *head, *tail;
 };
 
 class Protocol
 {
+  friend class Message;
 public:
-  Protocol(std::string name, CEvent* inEvent, CEvent *outEvent)
-    : portName(name), inDefered(false), outDefered(false) {containerInEvent = inEvent; containerOutEvent = outEvent;};
+  Protocol(std::string name, CEvent* inEvent, CEvent *outEvent);
   virtual ~Protocol();
   Message *GetMessage();
   void ReturnMessage(Message *msg);
@@ -74,15 +102,23 @@ public:
   void DeferOut(bool value) {outDefered = value;};
   void Lock() {criticalSection.lock();};
   void Unlock() {criticalSection.unlock();};
+
+  /*!
+   \brief Heap allocations of messages, payloads and sync events made after the port was created.
+   Messages are recycled together with their buffers, the number stops growing once the
+   port is in steady state.
+   */
+  unsigned int GetAllocations() const {return allocations;};
   std::string portName;
 
 protected:
   CEvent *containerInEvent, *containerOutEvent;
   CCriticalSection criticalSection;
-  std::queue<Message*> outMessages;
-  std::queue<Message*> inMessages;
-  std::queue<Message*> freeMessageQueue;
+  MessageQueue outMessages;
+  MessageQueue inMessages;
+  MessageQueue freeMessageQueue;
   bool inDefered, outDefered;
+  std::atomic<unsigned int> allocations;
 };
 
 }
@@ -0,0 +1,193 @@
+#pragma once
+/*
+ *      Copyright (C) 2005-2013 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+/*!
+ \brief A map kept as a sorted vector, for the handful of entries every list item carries.
+
+ It needs a fraction of the memory of a std::map with the same entries, as there are no tree
+ nodes to allocate, at the price of linear inserts and erases. Iterators are invalidated by
+ every insert and erase. Lookups accept any key type Compare can compare with Key, so a map
+ with interned keys can be searched with a plain string.
+ */
+template<typename Key, typename Value, typename Compare = std::less<Key> >
+class CFlatMap
+{
+public:
+  typedef Key key_type;
+  typedef Value mapped_type;
+  typedef std::pair<Key, Value> value_type;
+  typedef typename std::vector<value_type>::iterator iterator;
+  typedef typename std::vector<value_type>::const_iterator const_iterator;
+  typedef typename std::vector<value_type>::size_type size_type;
+
+  CFlatMap() { }
+
+  template<typename InputIterator>
+  CFlatMap(InputIterator first, InputIterator last)
+  {
+    assign(first, last);
+  }
+
+  iterator begin() { return m_data.begin(); }
+  iterator end() { return m_data.end(); }
+  const_iterator begin() const { return m_data.begin(); }
+  const_iterator end() const { return m_data.end(); }
+
+  bool empty() const { return m_data.empty(); }
+  size_type size() const { return m_data.size(); }
+
+  /*!
+   \brief Remove all entries and release the memory.
+   */
+  void clear() { std::vector<value_type>().swap(m_data); }
+
+  /*!
+   \brief Replace the entries with the given range, later duplicates of a key are ignored.
+   */
+  template<typename InputIterator>
+  void assign(InputIterator first, InputIterator last)
+  {
+    std::vector<value_type> data;
+    data.reserve(std::distance(first, last));
+    for (; first != last; ++first)
+      data.push_back(value_type(first->first, first->second));
+    std::stable_sort(data.begin(), data.end(), ValueCompare(m_compare));
+    data.erase(std::unique(data.begin(), data.end(), ValueEquals(m_compare)), data.end());
+    m_data.swap(data);
+  }
+
+  template<typename K>
+  iterator find(const K &key)
+  {
+    iterator it = lower_bound(key);
+    if (it != m_data.end() && !m_compare(key, it->first))
+      return it;
+    return m_data.end();
+  }
+
+  template<typename K>
+  const_iterator find(const K &key) const
+  {
+    const_iterator it = lower_bound(key);
+    if (it != m_data.end() && !m_compare(key, it->first))
+      return it;
+    return m_data.end();
+  }
+
+  template<typename K>
+  size_type count(const K &key) const { return find(key) != m_data.end() ? 1 : 0; }
+
+  template<typename K>
+  Value& operator[](const K &key)
+  {
+    iterator it = lower_bound(key);
+    if (it == m_data.end() || m_compare(key, it->first))
+      it = Insert(it, value_type(key, Value()));
+    return it->second;
+  }
+
+  /*!
+   \brief Insert an entry unless the key is in the map already.
+   \return the entry of the key and whether it was inserted
+   */
+  template<typename K, typename V>
+  std::pair<iterator, bool> insert(const std::pair<K, V> &value)
+  {
+    iterator it = lower_bound(value.first);
+    if (it != m_data.end() && !m_compare(value.first, it->first))
+      return std::make_pair(it, false);
+    return std::make_pair(Insert(it, value_type(value.first, value.second)), true);
+  }
+
+  iterator erase(iterator it) { return m_data.erase(it); }
+
+  template<typename K>
+  size_type erase(const K &key)
+  {
+    iterator it = find(key);
+    if (it == m_data.end())
+      return 0;
+    m_data.erase(it);
+    return 1;
+  }
+
+  template<typename K>
+  iterator lower_bound(const K &key)
+  {
+    return std::lower_bound(m_data.begin(), m_data.end(), key, KeyCompare<K>(m_compare));
+  }
+
+  template<typename K>
+  const_iterator lower_bound(const K &key) const
+  {
+    return std::lower_bound(m_data.begin(), m_data.end(), key, KeyCompare<K>(m_compare));
+  }
+
+  bool operator==(const CFlatMap &rhs) const { return m_data == rhs.m_data; }
+  bool operator!=(const CFlatMap &rhs) const { return m_data != rhs.m_data; }
+
+private:
+  template<typename K>
+  struct KeyCompare
+  {
+    explicit KeyCompare(const Compare &compare) : m_compare(compare) { }
+    bool operator()(const value_type &lhs, const K &rhs) const { return m_compare(lhs.first, rhs); }
+    const Compare &m_compare;
+  };
+
+  struct ValueCompare
+  {
+    explicit ValueCompare(const Compare &compare) : m_compare(compare) { }
+    bool operator()(const value_type &lhs, const value_type &rhs) const { return m_compare(lhs.first, rhs.first); }
+    const Compare &m_compare;
+  };
+
+  struct ValueEquals
+  {
+    explicit ValueEquals(const Compare &compare) : m_compare(compare) { }
+    bool operator()(const value_type &lhs, const value_type &rhs) const
+    {
+      return !m_compare(lhs.first, rhs.first) && !m_compare(rhs.first, lhs.first);
+    }
+    const Compare &m_compare;
+  };
+
+  iterator Insert(iterator position, const value_type &value)
+  {
+    // grow in small steps, most items only ever get a few entries
+    if (m_data.size() == m_data.capacity())
+    {
+      size_type offset = position - m_data.begin();
+      m_data.reserve(m_data.size() + m_data.size() / 4 + 1);
+      position = m_data.begin() + offset;
+    }
+    return m_data.insert(position, value);
+  }
+
+  std::vector<value_type> m_data;
+  Compare m_compare;
+};
@@ -19,11 +19,19 @@
  *
  */
 
+#include <set>
+#include <string>
+
 class CVariant;
 
 class ISerializable
 {
 public:
   virtual void Serialize(CVariant& value) const = 0;
+  /*!
+   \brief Serialize at least the given top level members.
+   Members not in fields may be left out, by default everything is serialized.
+   */
+  virtual void SerializeFields(CVariant& value, const std::set<std::string>& fields) const { Serialize(value); }
   virtual ~ISerializable() {}
 };
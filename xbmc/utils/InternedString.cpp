@@ -0,0 +1,77 @@
+/*
+ *      Copyright (C) 2005-2013 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "InternedString.h"
+
+#include <unordered_set>
+
+#include "threads/CriticalSection.h"
+#include "threads/SingleLock.h"
+
+namespace
+{
+  // the set is node based, so the address of a pooled string never changes
+  struct StringPool
+  {
+    CCriticalSection section;
+    std::unordered_set<std::string> strings;
+  };
+
+  StringPool& GetPool()
+  {
+    static StringPool pool;
+    return pool;
+  }
+
+  const std::string* Intern(const std::string &str)
+  {
+    StringPool &pool = GetPool();
+    CSingleLock lock(pool.section);
+    return &*pool.strings.insert(str).first;
+  }
+
+  const std::string* GetEmpty()
+  {
+    static const std::string *empty = Intern("");
+    return empty;
+  }
+}
+
+CInternedString::CInternedString()
+  : m_str(GetEmpty())
+{
+}
+
+CInternedString::CInternedString(const std::string &str)
+  : m_str(str.empty() ? GetEmpty() : Intern(str))
+{
+}
+
+CInternedString::CInternedString(const char *str)
+  : m_str(str && *str ? Intern(str) : GetEmpty())
+{
+}
+
+size_t CInternedString::GetPoolSize()
+{
+  StringPool &pool = GetPool();
+  CSingleLock lock(pool.section);
+  return pool.strings.size();
+}
@@ -0,0 +1,56 @@
+#pragma once
+/*
+ *      Copyright (C) 2005-2013 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stddef.h>
+#include <string>
+
+/*!
+ \brief A string kept once in a process wide pool, the size of a pointer.
+
+ Meant for the small vocabulary of keys repeated in every item of a listing, like art
+ types. Pooled strings are never freed, so don't intern arbitrary values or keys.
+ Equal strings share the same pool entry, so comparing for equality is a pointer compare.
+ */
+class CInternedString
+{
+public:
+  CInternedString();
+  CInternedString(const std::string &str);
+  CInternedString(const char *str);
+
+  const std::string& str() const { return *m_str; }
+  operator const std::string&() const { return *m_str; }
+
+  bool empty() const { return m_str->empty(); }
+  const char* c_str() const { return m_str->c_str(); }
+
+  bool operator==(const CInternedString &rhs) const { return m_str == rhs.m_str; }
+  bool operator!=(const CInternedString &rhs) const { return m_str != rhs.m_str; }
+  bool operator<(const CInternedString &rhs) const { return *m_str < *rhs.m_str; }
+
+  /*!
+   \brief Number of distinct strings in the pool.
+   */
+  static size_t GetPoolSize();
+
+private:
+  const std::string *m_str;
+};
@@ -23,13 +23,27 @@
 #include "JSONVariantWriter.h"
 #include "utils/Variant.h"
 
+static void AppendToString(void *context, const char *data, size_t length)
+{
+  static_cast<std::string*>(context)->append(data, length);
+}
+
 std::string CJSONVariantWriter::Write(const CVariant &value, bool compact)
 {
   std::string output;
+  if (!Write(value, compact, AppendToString, &output))
+    output.clear();
+
+  return output;
+}
 
+bool CJSONVariantWriter::Write(const CVariant &value, bool compact, OutputCallback callback, void *context)
+{
   yajl_gen g = yajl_gen_alloc(NULL);
   yajl_gen_config(g, yajl_gen_beautify, compact ? 0 : 1);
   yajl_gen_config(g, yajl_gen_indent_string, "\t");
+  // hand the output over as it's generated instead of buffering all of it in yajl
+  yajl_gen_config(g, yajl_gen_print_callback, callback, context);
 
   // Set locale to classic ("C") to ensure valid JSON numbers
 #ifndef TARGET_WINDOWS
@@ -50,14 +64,7 @@ std::string CJSONVariantWriter::Write(const CVariant &value, bool compact)
   }
 #endif // TARGET_WINDOWS
 
-  if (InternalWrite(g, value))
-  {
-    const unsigned char * buffer;
-
-    size_t length;
-    yajl_gen_get_buf(g, &buffer, &length);
-    output = std::string((const char *)buffer, length);
-  }
+  bool success = InternalWrite(g, value);
 
   // Re-set locale to what it was before using yajl
 #ifndef TARGET_WINDOWS
@@ -68,10 +75,9 @@ std::string CJSONVariantWriter::Write(const CVariant &value, bool compact)
     _wsetlocale(LC_NUMERIC, backupLocale.c_str());
 #endif // TARGET_WINDOWS
 
-  yajl_gen_clear(g);
   yajl_gen_free(g);
 
-  return output;
+  return success;
 }
 
 bool CJSONVariantWriter::InternalWrite(yajl_gen g, const CVariant &value)
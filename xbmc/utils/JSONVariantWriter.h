@@ -27,7 +27,17 @@ class CVariant;
 class CJSONVariantWriter
 {
 public:
+  /*!
+   \brief Receives the generated JSON piece by piece
+   */
+  typedef void (*OutputCallback)(void *context, const char *data, size_t length);
+
   static std::string Write(const CVariant &value, bool compact);
+  /*!
+   \brief Write the JSON for value to callback as it is generated instead of collecting it in a string
+   \return false if value couldn't be written, the output is incomplete then
+   */
+  static bool Write(const CVariant &value, bool compact, OutputCallback callback, void *context);
 private:
   static bool InternalWrite(yajl_gen g, const CVariant &value);
 };
@@ -37,10 +37,15 @@ bool CJob::ShouldCancel(unsigned int progress, unsigned int total) const
   return false;
 }
 
-CJobWorker::CJobWorker(CJobManager *manager) : CThread("JobWorker")
+// pool worker running on this thread, jobs added from a worker stay local
+static thread_local const CJobWorker *t_poolWorker = NULL;
+
+CJobWorker::CJobWorker(CJobManager *manager, CJobManager::CWorkQueue *queue, bool dedicated) : CThread("JobWorker")
 {
   m_jobManager = manager;
-  Create(true); // start work immediately, and kill ourselves when we're done
+  m_queue = queue;
+  m_dedicated = dedicated;
+  Create(dedicated); // start work immediately, dedicated workers kill themselves when they're done
 }
 
 CJobWorker::~CJobWorker()
@@ -51,11 +56,15 @@ CJobWorker::~CJobWorker()
   m_jobManager->RemoveWorker(this);
   if(!IsAutoDelete())
     StopThread();
+  if (m_dedicated)
+    delete m_queue;
 }
 
 void CJobWorker::Process()
 {
   SetPriority( GetMinPriority() );
+  if (!m_dedicated)
+    t_poolWorker = this;
   while (true)
   {
     // request an item from our manager (this call is blocking)
@@ -74,6 +83,7 @@ void CJobWorker::Process()
     }
     m_jobManager->OnJobComplete(success, job);
   }
+  t_poolWorker = NULL;
 }
 
 void CJobQueue::CJobPointer::CancelJob()
@@ -182,8 +192,17 @@ CJobManager &CJobManager::GetInstance()
 CJobManager::CJobManager()
 {
   m_jobCounter = 0;
+  m_nextQueue = 0;
+  m_processing = 0;
+  for (unsigned int priority = CJob::PRIORITY_LOW_PAUSABLE; priority <= CJob::PRIORITY_DEDICATED; ++priority)
+    m_queued[priority] = 0;
   m_running = true;
   m_pauseJobs = false;
+  m_workersStarted = false;
+
+  // no point in more workers than jobs we allow to run at once
+  for (unsigned int i = 0; i < GetMaxWorkers(CJob::PRIORITY_HIGH); ++i)
+    m_queues.push_back(std::unique_ptr<CWorkQueue>(new CWorkQueue));
 }
 
 void CJobManager::Restart()
@@ -197,25 +216,53 @@ void CJobManager::Restart()
 
 void CJobManager::CancelJobs()
 {
-  CSingleLock lock(m_section);
-  m_running = false;
+  Workers workers;
+  {
+    CSingleLock lock(m_section);
+    m_running = false;
+    m_workersStarted = false;
+    workers.swap(m_workers);
 
-  // clear any pending jobs
-  for (unsigned int priority = CJob::PRIORITY_LOW_PAUSABLE; priority <= CJob::PRIORITY_DEDICATED; ++priority)
+    // cancel any callbacks on dedicated jobs still processing
+    for (Workers::iterator it = m_dedicated.begin(); it != m_dedicated.end(); ++it)
+    {
+      CWorkQueue &queue = *(*it)->m_queue;
+      CSingleLock queueLock(queue.m_section);
+      queue.m_current.Cancel();
+    }
+  }
+
+  // cancel any callbacks on pooled jobs still processing. Workers check m_running under
+  // their queue's lock before starting a job, so no new callbacks can be set after this.
+  for (WorkQueues::iterator it = m_queues.begin(); it != m_queues.end(); ++it)
   {
-    for_each(m_jobQueue[priority].begin(), m_jobQueue[priority].end(), std::mem_fun_ref(&CWorkItem::FreeJob));
-    m_jobQueue[priority].clear();
+    CSingleLock lock((*it)->m_section);
+    (*it)->m_current.Cancel();
   }
 
-  // cancel any callbacks on jobs still processing
-  for_each(m_processing.begin(), m_processing.end(), std::mem_fun_ref(&CWorkItem::Cancel));
+  // tell our pool workers to finish
+  WakeWorkers();
+  for (Workers::iterator it = workers.begin(); it != workers.end(); ++it)
+    delete *it; // waits for the worker to exit
 
-  // tell our workers to finish
-  while (m_workers.size())
+  // clear any pending jobs
+  for (WorkQueues::iterator it = m_queues.begin(); it != m_queues.end(); ++it)
+  {
+    CSingleLock lock((*it)->m_section);
+    for (unsigned int priority = CJob::PRIORITY_LOW_PAUSABLE; priority <= CJob::PRIORITY_DEDICATED; ++priority)
+    {
+      m_queued[priority] -= (*it)->m_jobs[priority].size();
+      for_each((*it)->m_jobs[priority].begin(), (*it)->m_jobs[priority].end(), std::mem_fun_ref(&CWorkItem::FreeJob));
+      (*it)->m_jobs[priority].clear();
+    }
+  }
+
+  // wait for the dedicated workers to die
+  CSingleLock lock(m_section);
+  while (m_dedicated.size())
   {
     lock.Leave();
-    m_jobEvent.Set();
-    Sleep(0); // yield after setting the event to give the workers some time to die
+    Sleep(0); // yield to give the workers some time to die
     lock.Enter();
   }
 }
@@ -226,110 +273,261 @@ CJobManager::~CJobManager()
 
 unsigned int CJobManager::AddJob(CJob *job, IJobCallback *callback, CJob::PRIORITY priority)
 {
-  CSingleLock lock(m_section);
-
   if (!m_running)
     return 0;
 
   // increment the job counter, ensuring 0 (invalid job) is never hit
-  m_jobCounter++;
-  if (m_jobCounter == 0)
-    m_jobCounter++;
+  unsigned int id = ++m_jobCounter;
+  if (id == 0)
+    id = ++m_jobCounter;
 
   // create a work item for this job
-  CWorkItem work(job, m_jobCounter, priority, callback);
-  m_jobQueue[priority].push_back(work);
+  CWorkItem work(job, id, priority, callback);
+
+  if (priority == CJob::PRIORITY_DEDICATED)
+  {
+    // dedicated jobs get a worker of their own
+    CSingleLock lock(m_section);
+    if (!m_running)
+      return 0;
+
+    CWorkQueue *queue = new CWorkQueue;
+    queue->m_jobs[priority].push_back(work);
+    m_queued[priority]++;
+    m_dedicated.push_back(new CJobWorker(this, queue, true));
+    return id;
+  }
+
+  StartWorkers();
+
+  // keep jobs added by a worker local, otherwise spread them over the workers
+  CWorkQueue *queue = t_poolWorker ? t_poolWorker->m_queue : m_queues[m_nextQueue++ % m_queues.size()].get();
+
+  {
+    CSingleLock lock(queue->m_section);
+    queue->m_jobs[priority].push_back(work);
+    m_queued[priority]++;
+  }
 
-  StartWorkers(priority);
-  return work.m_id;
+  // CancelJobs() may have cleared the queues before we added to them
+  if (!m_running)
+  {
+    RemoveQueuedJob(id);
+    return 0;
+  }
+
+  WakeWorker(*queue);
+  return id;
 }
 
 void CJobManager::CancelJob(unsigned int jobID)
 {
-  CSingleLock lock(m_section);
-
   // check whether we have this job in the queue
-  for (unsigned int priority = CJob::PRIORITY_LOW_PAUSABLE; priority <= CJob::PRIORITY_DEDICATED; ++priority)
+  if (RemoveQueuedJob(jobID))
+    return;
+
+  // or if we're processing it
+  CSingleLock lock(m_section);
+  for (WorkQueues::iterator it = m_queues.begin(); it != m_queues.end(); ++it)
   {
-    JobQueue::iterator i = find(m_jobQueue[priority].begin(), m_jobQueue[priority].end(), jobID);
-    if (i != m_jobQueue[priority].end())
+    CSingleLock queueLock((*it)->m_section);
+    if ((*it)->m_current.m_job && (*it)->m_current == jobID)
     {
-      delete i->m_job;
-      m_jobQueue[priority].erase(i);
+      (*it)->m_current.m_callback = NULL; // job is in progress, so only thing to do is to remove callback
+      return;
+    }
+  }
+  for (Workers::iterator it = m_dedicated.begin(); it != m_dedicated.end(); ++it)
+  {
+    CWorkQueue &queue = *(*it)->m_queue;
+    CSingleLock queueLock(queue.m_section);
+    if (queue.m_current.m_job && queue.m_current == jobID)
+    {
+      queue.m_current.m_callback = NULL;
       return;
     }
   }
-  // or if we're processing it
-  Processing::iterator it = find(m_processing.begin(), m_processing.end(), jobID);
-  if (it != m_processing.end())
-    it->m_callback = NULL; // job is in progress, so only thing to do is to remove callback
 }
 
-void CJobManager::StartWorkers(CJob::PRIORITY priority)
+bool CJobManager::RemoveQueuedJob(unsigned int jobID)
 {
+  for (WorkQueues::iterator it = m_queues.begin(); it != m_queues.end(); ++it)
+  {
+    CSingleLock lock((*it)->m_section);
+    for (unsigned int priority = CJob::PRIORITY_LOW_PAUSABLE; priority < CJob::PRIORITY_DEDICATED; ++priority)
+    {
+      std::deque<CWorkItem> &jobs = (*it)->m_jobs[priority];
+      std::deque<CWorkItem>::iterator i = find(jobs.begin(), jobs.end(), jobID);
+      if (i != jobs.end())
+      {
+        delete i->m_job;
+        jobs.erase(i);
+        m_queued[priority]--;
+        return true;
+      }
+    }
+  }
+
   CSingleLock lock(m_section);
+  for (Workers::iterator it = m_dedicated.begin(); it != m_dedicated.end(); ++it)
+  {
+    CWorkQueue &queue = *(*it)->m_queue;
+    CSingleLock queueLock(queue.m_section);
+    std::deque<CWorkItem> &jobs = queue.m_jobs[CJob::PRIORITY_DEDICATED];
+    std::deque<CWorkItem>::iterator i = find(jobs.begin(), jobs.end(), jobID);
+    if (i != jobs.end())
+    {
+      delete i->m_job;
+      jobs.erase(i);
+      m_queued[CJob::PRIORITY_DEDICATED]--;
+      return true;
+    }
+  }
+  return false;
+}
 
-  // check how many free threads we have
-  if (m_processing.size() >= GetMaxWorkers(priority))
+void CJobManager::StartWorkers()
+{
+  if (m_workersStarted)
+    return;
+
+  CSingleLock lock(m_section);
+  if (!m_running || m_workersStarted)
     return;
 
-  // do we have any sleeping threads?
-  if (m_processing.size() < m_workers.size())
+  for (WorkQueues::iterator it = m_queues.begin(); it != m_queues.end(); ++it)
+    m_workers.push_back(new CJobWorker(this, it->get(), false));
+  m_workersStarted = true;
+}
+
+void CJobManager::WakeWorker(CWorkQueue &preferred)
+{
+  if (preferred.m_sleeping.exchange(false))
   {
-    m_jobEvent.Set();
+    preferred.m_wakeEvent.Set();
     return;
   }
 
-  // everyone is busy - we need more workers
-  m_workers.push_back(new CJobWorker(this));
+  // the owner is busy, have someone else steal the job
+  for (WorkQueues::iterator it = m_queues.begin(); it != m_queues.end(); ++it)
+  {
+    if ((*it)->m_sleeping.exchange(false))
+    {
+      (*it)->m_wakeEvent.Set();
+      return;
+    }
+  }
 }
 
-CJob *CJobManager::PopJob()
+void CJobManager::WakeWorkers()
 {
-  CSingleLock lock(m_section);
-  for (int priority = CJob::PRIORITY_DEDICATED; priority >= CJob::PRIORITY_LOW_PAUSABLE; --priority)
+  for (WorkQueues::iterator it = m_queues.begin(); it != m_queues.end(); ++it)
+  {
+    (*it)->m_sleeping = false;
+    (*it)->m_wakeEvent.Set();
+  }
+}
+
+bool CJobManager::ReserveWorker(CJob::PRIORITY priority)
+{
+  const unsigned int maxWorkers = GetMaxWorkers(priority);
+  unsigned int processing = m_processing;
+  while (processing < maxWorkers)
+  {
+    if (m_processing.compare_exchange_weak(processing, processing + 1))
+      return true;
+  }
+  return false;
+}
+
+CJob *CJobManager::TakeJob(CWorkQueue &from, CWorkQueue &to, CJob::PRIORITY priority)
+{
+  // hold both queues, locked in a fixed order, so that CancelJob() finds the job either
+  // queued or processing while it moves over
+  const bool fromFirst = std::less<CWorkQueue*>()(&from, &to);
+  CSingleLock firstLock(fromFirst ? from.m_section : to.m_section);
+  CSingleLock secondLock(fromFirst ? to.m_section : from.m_section);
+  std::deque<CWorkItem> &jobs = from.m_jobs[priority];
+  if (jobs.empty())
+    return NULL;
+
+  CWorkItem work = jobs.front();
+  jobs.pop_front();
+  m_queued[priority]--;
+
+  if (!m_running)
+  {
+    // CancelJobs() was called while we were looking
+    work.FreeJob();
+    return NULL;
+  }
+
+  // mark as processing
+  to.m_current = work;
+  work.m_job->m_callback = this;
+  return work.m_job;
+}
+
+CJob *CJobManager::PopJob(CWorkQueue &queue)
+{
+  for (int priority = CJob::PRIORITY_HIGH; priority >= CJob::PRIORITY_LOW_PAUSABLE; --priority)
   {
     // Check whether we're pausing pausable jobs
     if (priority == CJob::PRIORITY_LOW_PAUSABLE && m_pauseJobs)
       continue;
 
-    if (m_jobQueue[priority].size() && m_processing.size() < GetMaxWorkers(CJob::PRIORITY(priority)))
+    if (m_queued[priority] == 0)
+      continue;
+
+    // lower priorities allow fewer workers, so if we can't run this one we can't run any
+    if (!ReserveWorker(CJob::PRIORITY(priority)))
+      break;
+
+    // our own queue first, then steal from the others
+    CJob *job = TakeJob(queue, queue, CJob::PRIORITY(priority));
+    for (size_t i = 0; !job && m_running && i < m_queues.size(); ++i)
     {
-      // pop the job off the queue
-      CWorkItem job = m_jobQueue[priority].front();
-      m_jobQueue[priority].pop_front();
-
-      // add to the processing vector
-      m_processing.push_back(job);
-      job.m_job->m_callback = this;
-      return job.m_job;
+      if (m_queues[i].get() != &queue)
+        job = TakeJob(*m_queues[i], queue, CJob::PRIORITY(priority));
     }
+    if (job)
+      return job;
+
+    m_processing--;
+    if (!m_running)
+      return NULL;
   }
   return NULL;
 }
 
 void CJobManager::PauseJobs()
 {
-  CSingleLock lock(m_section);
   m_pauseJobs = true;
 }
 
 void CJobManager::UnPauseJobs()
 {
-  CSingleLock lock(m_section);
   m_pauseJobs = false;
+  WakeWorkers();
 }
 
 bool CJobManager::IsProcessing(const CJob::PRIORITY &priority) const
 {
-  CSingleLock lock(m_section);
-
   if (m_pauseJobs)
     return false;
 
-  for(Processing::const_iterator it = m_processing.begin(); it < m_processing.end(); ++it)
+  CSingleLock lock(m_section);
+  for (WorkQueues::const_iterator it = m_queues.begin(); it != m_queues.end(); ++it)
   {
-    if (priority == it->m_priority)
+    CSingleLock queueLock((*it)->m_section);
+    if ((*it)->m_current.m_job && priority == (*it)->m_current.m_priority)
+      return true;
+  }
+  for (Workers::const_iterator it = m_dedicated.begin(); it != m_dedicated.end(); ++it)
+  {
+    CWorkQueue &queue = *(*it)->m_queue;
+    CSingleLock queueLock(queue.m_section);
+    if (queue.m_current.m_job && priority == queue.m_current.m_priority)
       return true;
   }
   return false;
@@ -338,14 +536,22 @@ bool CJobManager::IsProcessing(const CJob::PRIORITY &priority) const
 int CJobManager::IsProcessing(const std::string &type) const
 {
   int jobsMatched = 0;
-  CSingleLock lock(m_section);
 
   if (m_pauseJobs)
     return 0;
 
-  for(Processing::const_iterator it = m_processing.begin(); it < m_processing.end(); ++it)
+  CSingleLock lock(m_section);
+  for (WorkQueues::const_iterator it = m_queues.begin(); it != m_queues.end(); ++it)
   {
-    if (type == std::string(it->m_job->GetType()))
+    CSingleLock queueLock((*it)->m_section);
+    if ((*it)->m_current.m_job && type == std::string((*it)->m_current.m_job->GetType()))
+      jobsMatched++;
+  }
+  for (Workers::const_iterator it = m_dedicated.begin(); it != m_dedicated.end(); ++it)
+  {
+    CWorkQueue &queue = *(*it)->m_queue;
+    CSingleLock queueLock(queue.m_section);
+    if (queue.m_current.m_job && type == std::string(queue.m_current.m_job->GetType()))
       jobsMatched++;
   }
   return jobsMatched;
@@ -353,38 +559,69 @@ int CJobManager::IsProcessing(const std::string &type) const
 
 CJob *CJobManager::GetNextJob(const CJobWorker *worker)
 {
-  CSingleLock lock(m_section);
+  CWorkQueue &queue = *worker->m_queue;
+
+  // dedicated workers only ever run the job they were created for
+  if (worker->m_dedicated)
+  {
+    CJob *job = TakeJob(queue, queue, CJob::PRIORITY_DEDICATED);
+    if (!job)
+    {
+      RemoveWorker(worker);
+      return NULL;
+    }
+    m_processing++;
+    return job;
+  }
+
   while (m_running)
   {
-    // grab a job off the queue if we have one
-    CJob *job = PopJob();
+    // grab a job off the queues if we have one
+    CJob *job = PopJob(queue);
     if (job)
       return job;
-    // no jobs are left - sleep for 30 seconds to allow new jobs to come in
-    lock.Leave();
-    bool newJob = m_jobEvent.WaitMSec(30000);
-    lock.Enter();
-    if (!newJob)
-      break;
+
+    // announce we're going to sleep, then make sure no job came in before we did
+    queue.m_sleeping = true;
+    job = PopJob(queue);
+    if (job)
+    {
+      queue.m_sleeping = false;
+      return job;
+    }
+    queue.m_wakeEvent.Wait();
+    queue.m_sleeping = false;
+  }
+  return NULL;
+}
+
+CJobManager::CWorkQueue *CJobManager::FindProcessing(const CJob *job) const
+{
+  for (WorkQueues::const_iterator it = m_queues.begin(); it != m_queues.end(); ++it)
+  {
+    CSingleLock lock((*it)->m_section);
+    if ((*it)->m_current == job)
+      return it->get();
+  }
+  for (Workers::const_iterator it = m_dedicated.begin(); it != m_dedicated.end(); ++it)
+  {
+    CSingleLock lock((*it)->m_queue->m_section);
+    if ((*it)->m_queue->m_current == job)
+      return (*it)->m_queue;
   }
-  // ensure no jobs have come in during the period after
-  // timeout and before we held the lock
-  CJob *job = PopJob();
-  if (job)
-    return job;
-  // have no jobs
-  RemoveWorker(worker);
   return NULL;
 }
 
 bool CJobManager::OnJobProgress(unsigned int progress, unsigned int total, const CJob *job) const
 {
   CSingleLock lock(m_section);
-  // find the job in the processing queue, and check whether it's cancelled (no callback)
-  Processing::const_iterator i = find(m_processing.begin(), m_processing.end(), job);
-  if (i != m_processing.end())
+  // find the job being processed, and check whether it's cancelled (no callback)
+  CWorkQueue *queue = FindProcessing(job);
+  if (queue)
   {
-    CWorkItem item(*i);
+    CSingleLock queueLock(queue->m_section);
+    CWorkItem item(queue->m_current);
+    queueLock.Leave();
     lock.Leave(); // leave section prior to call
     if (item.m_callback)
     {
@@ -398,13 +635,15 @@ bool CJobManager::OnJobProgress(unsigned int progress, unsigned int total, const
 void CJobManager::OnJobComplete(bool success, CJob *job)
 {
   CSingleLock lock(m_section);
-  // remove the job from the processing queue
-  Processing::iterator i = find(m_processing.begin(), m_processing.end(), job);
-  if (i != m_processing.end())
+  // find the worker processing the job
+  CWorkQueue *queue = FindProcessing(job);
+  lock.Leave();
+  if (queue)
   {
     // tell any listeners we're done with the job, then delete it
-    CWorkItem item(*i);
-    lock.Leave();
+    CSingleLock queueLock(queue->m_section);
+    CWorkItem item(queue->m_current);
+    queueLock.Leave();
     try
     {
       if (item.m_callback)
@@ -414,12 +653,15 @@ void CJobManager::OnJobComplete(bool success, CJob *job)
     {
       CLog::Log(LOGERROR, "%s error processing job %s", __FUNCTION__, item.m_job->GetType());
     }
-    lock.Enter();
-    Processing::iterator j = find(m_processing.begin(), m_processing.end(), job);
-    if (j != m_processing.end())
-      m_processing.erase(j);
-    lock.Leave();
+    queueLock.Enter();
+    queue->m_current = CWorkItem(NULL, 0, CJob::PRIORITY_LOW, NULL);
+    queueLock.Leave();
+    m_processing--;
     item.FreeJob();
+
+    // lower priority jobs may have been waiting for a free slot
+    if (item.m_priority == CJob::PRIORITY_DEDICATED && m_running)
+      WakeWorker(*m_queues.front());
   }
 }
 
@@ -427,9 +669,9 @@ void CJobManager::RemoveWorker(const CJobWorker *worker)
 {
   CSingleLock lock(m_section);
   // remove our worker
-  Workers::iterator i = find(m_workers.begin(), m_workers.end(), worker);
-  if (i != m_workers.end())
-    m_workers.erase(i); // workers auto-delete
+  Workers::iterator i = find(m_dedicated.begin(), m_dedicated.end(), worker);
+  if (i != m_dedicated.end())
+    m_dedicated.erase(i); // workers auto-delete
 }
 
 unsigned int CJobManager::GetMaxWorkers(CJob::PRIORITY priority)
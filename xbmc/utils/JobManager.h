@@ -19,25 +19,17 @@
  *
  */
 
+#include <atomic>
+#include <memory>
 #include <queue>
 #include <vector>
 #include <string>
 #include "threads/CriticalSection.h"
+#include "threads/Event.h"
 #include "threads/Thread.h"
 #include "Job.h"
 
-class CJobManager;
-
-class CJobWorker : public CThread
-{
-public:
-  CJobWorker(CJobManager *manager);
-  virtual ~CJobWorker();
-
-  void Process();
-private:
-  CJobManager  *m_jobManager;
-};
+class CJobWorker;
 
 /*!
  \ingroup jobs
@@ -170,6 +162,11 @@ private:
  priority levels.  Lower priority jobs are executed only if there are sufficient
  spare worker threads free to allow for higher priority jobs that may arise.
 
+ Jobs are run by a persistent pool of workers, each with its own set of per-priority
+ queues.  Jobs added from a worker go to that worker's queues, others are spread over
+ the workers, and idle workers steal from the queues of busy ones.  Dedicated jobs
+ each get a thread of their own.
+
  \sa CJob and IJobCallback
  */
 class CJobManager
@@ -207,6 +204,21 @@ class CJobManager
     CJob::PRIORITY m_priority;
   };
 
+  /*!
+   \brief Job queues of a single worker along with the job it is processing
+   */
+  class CWorkQueue
+  {
+  public:
+    CWorkQueue() : m_current(NULL, 0, CJob::PRIORITY_LOW, NULL), m_sleeping(false) {}
+
+    CCriticalSection  m_section;  ///< guards m_jobs and m_current
+    std::deque<CWorkItem> m_jobs[CJob::PRIORITY_DEDICATED + 1];
+    CWorkItem         m_current;  ///< job being processed, m_job is NULL when idle
+    CEvent            m_wakeEvent;
+    std::atomic<bool> m_sleeping;
+  };
+
   template<typename F>
   class CLambdaJob : public CJob
   {
@@ -335,27 +347,64 @@ private:
   CJobManager const& operator=(CJobManager const&);
   virtual ~CJobManager();
 
-  /*! \brief Pop a job off the job queue and add to the processing queue ready to process
+  /*! \brief Pop a job off the job queues, stealing from other workers if needed, and mark it as processing
+   \param queue the queues of the worker that is to process the job
    \return the job to process, NULL if no jobs are available
    */
-  CJob *PopJob();
+  CJob *PopJob(CWorkQueue &queue);
+
+  /*! \brief Take the oldest job of the given priority off a worker's queue and mark it as processing
+   \param from the queue to take the job from
+   \param to the queues of the worker that is to process the job, may be the same as from
+   \param priority the priority of the job to take
+   \return the job to process, NULL if there is none or jobs are being cancelled
+   */
+  CJob *TakeJob(CWorkQueue &from, CWorkQueue &to, CJob::PRIORITY priority);
+  bool ReserveWorker(CJob::PRIORITY priority);
+
+  /*! \brief Find the queue whose worker is processing the given job, m_section must be held */
+  CWorkQueue *FindProcessing(const CJob *job) const;
+  bool RemoveQueuedJob(unsigned int jobID);
+  void WakeWorker(CWorkQueue &preferred);
+  void WakeWorkers();
 
-  void StartWorkers(CJob::PRIORITY priority);
+  void StartWorkers();
   void RemoveWorker(const CJobWorker *worker);
   static unsigned int GetMaxWorkers(CJob::PRIORITY priority);
 
-  unsigned int m_jobCounter;
+  std::atomic<unsigned int> m_jobCounter;
 
-  typedef std::deque<CWorkItem>    JobQueue;
-  typedef std::vector<CWorkItem>   Processing;
   typedef std::vector<CJobWorker*> Workers;
+  typedef std::vector<std::unique_ptr<CWorkQueue>> WorkQueues;
+
+  WorkQueues m_queues;            ///< one per pool worker, live as long as the manager
+  Workers    m_workers;           ///< pool workers, started on demand
+  Workers    m_dedicated;         ///< workers running a PRIORITY_DEDICATED job
+  std::atomic<unsigned int> m_nextQueue;
+  std::atomic<unsigned int> m_queued[CJob::PRIORITY_DEDICATED + 1];
+  std::atomic<unsigned int> m_processing;
+  std::atomic<bool> m_pauseJobs;
+  std::atomic<bool> m_workersStarted;
+
+  CCriticalSection m_section;     ///< guards starting and stopping workers, and m_dedicated
+  std::atomic<bool> m_running;
+};
 
-  JobQueue   m_jobQueue[CJob::PRIORITY_DEDICATED + 1];
-  bool       m_pauseJobs;
-  Processing m_processing;
-  Workers    m_workers;
+class CJobWorker : public CThread
+{
+public:
+  /*!
+   \brief Create a worker processing jobs from the given queue
+   \param dedicated whether the worker should exit once its queue is empty, rather than
+   wait for and steal other jobs.
+   */
+  CJobWorker(CJobManager *manager, CJobManager::CWorkQueue *queue, bool dedicated);
+  virtual ~CJobWorker();
 
-  CCriticalSection m_section;
-  CEvent           m_jobEvent;
-  bool             m_running;
+  void Process();
+private:
+  friend class CJobManager;
+  CJobManager  *m_jobManager;
+  CJobManager::CWorkQueue *m_queue;
+  bool          m_dedicated;
 };
@@ -18,6 +18,14 @@
  *
  */
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include "log.h"
 #include "system.h"
 #include "threads/SingleLock.h"
@@ -35,6 +43,335 @@ static const char* const logLevelNames[] =
 // s_globals is used as static global with CLog global variables
 #define s_globals XBMC_GLOBAL_USE(CLog).m_globalInstance
 
+// number of lines a single thread can have queued before further lines are dropped
+static const size_t LOG_QUEUE_SIZE = 1024;
+// longest time a queued line waits before the writer picks it up
+static const unsigned int LOG_WRITE_INTERVAL_MS = 100;
+
+namespace
+{
+
+// a single log line, time and thread are taken when the line is logged
+struct LogEntry
+{
+  uint64_t sequence;
+  int level;
+  int hour;
+  int minute;
+  int second;
+  int millisecond;
+  uint64_t threadId;
+  std::string message;
+};
+
+/*!
+ \brief Fixed size single producer, single consumer queue of log lines.
+ The owning thread pushes, the writer thread drains.
+ */
+class CLogRing
+{
+public:
+  CLogRing() : m_orphaned(false), m_entries(LOG_QUEUE_SIZE), m_head(0), m_tail(0) {}
+
+  /*! \brief Queue a line, returns the number of queued lines or 0 if the ring is full */
+  size_t Push(LogEntry &entry)
+  {
+    const size_t head = m_head.load(std::memory_order_relaxed);
+    const size_t used = head - m_tail.load(std::memory_order_acquire);
+    if (used >= m_entries.size())
+      return 0;
+
+    m_entries[head % m_entries.size()] = std::move(entry);
+    m_head.store(head + 1, std::memory_order_release);
+    return used + 1;
+  }
+
+  void Drain(std::vector<LogEntry> &entries)
+  {
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    const size_t head = m_head.load(std::memory_order_acquire);
+    for (; tail != head; ++tail)
+      entries.push_back(std::move(m_entries[tail % m_entries.size()]));
+    m_tail.store(tail, std::memory_order_release);
+  }
+
+  bool IsEmpty() const
+  {
+    return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_relaxed);
+  }
+
+  std::atomic<bool> m_orphaned; // set once the owning thread has exited
+
+private:
+  std::vector<LogEntry> m_entries;
+  std::atomic<size_t> m_head;
+  std::atomic<size_t> m_tail;
+};
+
+// hands the ring back to the writer when a thread exits
+class CLogRingOwner
+{
+public:
+  ~CLogRingOwner()
+  {
+    if (m_ring)
+      m_ring->m_orphaned = true;
+  }
+
+  std::shared_ptr<CLogRing> m_ring;
+};
+
+thread_local CLogRingOwner t_logRing;
+
+}
+
+/*!
+ \brief Collects lines from per-thread queues and writes them to the log file
+ in batches from a dedicated thread. The writer is a plain std::thread rather
+ than a CThread as CThread logs itself.
+ */
+class CLog::CLogQueue
+{
+public:
+  CLogQueue();
+  ~CLogQueue();
+
+  void Start();
+  void Stop();
+
+  /*! \brief Queue a line for the writer, returns false if the writer isn't running */
+  bool Push(LogEntry &entry);
+  void Flush();
+  uint64_t GetDropped() const { return m_dropped; }
+
+  /*! \brief Stamp a line with the current time and thread */
+  static void FillEntry(LogEntry &entry, int logLevel, const std::string &message);
+  /*! \brief Format a line (collapsing repeats) and append it to lines, s_globals.critSec must be held */
+  static void FormatEntry(const LogEntry &entry, std::string &lines);
+
+private:
+  static void AppendLine(const LogEntry &entry, int logLevel, const std::string &message, std::string &lines);
+  void Process();
+  void WriteQueued();
+
+  std::atomic<bool> m_running;
+  std::thread m_thread;
+  std::mutex m_lock; // guards m_rings, m_stop and the flush counters
+  std::condition_variable m_wake;
+  std::condition_variable m_flushed;
+  std::vector<std::shared_ptr<CLogRing>> m_rings;
+  bool m_stop;
+  uint64_t m_flushRequested;
+  uint64_t m_flushDone;
+  std::atomic<uint64_t> m_sequence;
+  std::atomic<uint64_t> m_dropped;
+  uint64_t m_droppedReported;
+};
+
+CLog::CLogQueue::CLogQueue() :
+  m_running(false),
+  m_stop(false),
+  m_flushRequested(0),
+  m_flushDone(0),
+  m_sequence(0),
+  m_dropped(0),
+  m_droppedReported(0)
+{}
+
+CLog::CLogQueue::~CLogQueue()
+{
+  Stop();
+}
+
+void CLog::CLogQueue::Start()
+{
+  std::lock_guard<std::mutex> lock(m_lock);
+  if (m_thread.joinable())
+    return;
+
+  // lines that raced with the previous Stop() belong to a closed log file
+  std::vector<LogEntry> stale;
+  for (auto &ring : m_rings)
+    ring->Drain(stale);
+
+  m_stop = false;
+  m_running = true;
+  m_thread = std::thread(&CLogQueue::Process, this);
+}
+
+void CLog::CLogQueue::Stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_lock);
+    if (!m_thread.joinable())
+      return;
+    m_running = false;
+    m_stop = true;
+  }
+  m_wake.notify_one();
+  m_flushed.notify_all();
+  m_thread.join();
+
+  WriteQueued();
+}
+
+bool CLog::CLogQueue::Push(LogEntry &entry)
+{
+  if (!m_running)
+    return false;
+
+  CLogRingOwner &owner = t_logRing;
+  if (!owner.m_ring)
+  {
+    owner.m_ring = std::make_shared<CLogRing>();
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_rings.push_back(owner.m_ring);
+  }
+
+  entry.sequence = m_sequence++;
+  const size_t queued = owner.m_ring->Push(entry);
+  if (queued == 0)
+    m_dropped++;
+  else if (queued == LOG_QUEUE_SIZE / 2)
+    m_wake.notify_one(); // don't wait for the interval when a thread is logging heavily
+
+  return true;
+}
+
+void CLog::CLogQueue::Flush()
+{
+  std::unique_lock<std::mutex> lock(m_lock);
+  if (m_stop || !m_thread.joinable())
+    return;
+
+  const uint64_t request = ++m_flushRequested;
+  m_wake.notify_one();
+  m_flushed.wait(lock, [this, request]() { return m_flushDone >= request || m_stop; });
+}
+
+void CLog::CLogQueue::Process()
+{
+  std::unique_lock<std::mutex> lock(m_lock);
+  while (!m_stop)
+  {
+    const uint64_t request = m_flushRequested;
+    lock.unlock();
+    WriteQueued();
+    lock.lock();
+
+    m_flushDone = request;
+    m_flushed.notify_all();
+    if (!m_stop && m_flushRequested == m_flushDone)
+      m_wake.wait_for(lock, std::chrono::milliseconds(LOG_WRITE_INTERVAL_MS));
+  }
+}
+
+void CLog::CLogQueue::WriteQueued()
+{
+  std::vector<LogEntry> entries;
+  {
+    std::lock_guard<std::mutex> lock(m_lock);
+    for (auto it = m_rings.begin(); it != m_rings.end();)
+    {
+      (*it)->Drain(entries);
+      if ((*it)->m_orphaned && (*it)->IsEmpty())
+        it = m_rings.erase(it);
+      else
+        ++it;
+    }
+  }
+
+  const uint64_t dropped = m_dropped;
+  if (entries.empty() && dropped == m_droppedReported)
+    return;
+
+  // restore the order lines were logged in across threads
+  std::sort(entries.begin(), entries.end(), [](const LogEntry &a, const LogEntry &b) { return a.sequence < b.sequence; });
+
+  CSingleLock waitLock(s_globals.critSec);
+  std::string lines;
+  for (const auto &entry : entries)
+    FormatEntry(entry, lines);
+
+  if (dropped != m_droppedReported)
+  {
+    LogEntry warning;
+    FillEntry(warning, LOGWARNING, StringUtils::Format("Log queue overflow, %" PRIu64" lines dropped",
+                                                       dropped - m_droppedReported));
+    FormatEntry(warning, lines);
+    m_droppedReported = dropped;
+  }
+
+  if (!lines.empty())
+    s_globals.m_platform.WriteStringToLog(lines);
+}
+
+void CLog::CLogQueue::FillEntry(LogEntry &entry, int logLevel, const std::string &message)
+{
+  double millisecond;
+  s_globals.m_platform.GetCurrentLocalTime(entry.hour, entry.minute, entry.second, millisecond);
+  entry.millisecond = static_cast<int>(millisecond);
+  entry.threadId = (uint64_t)CThread::GetCurrentThreadId();
+  entry.level = logLevel;
+  entry.sequence = 0;
+  entry.message = message;
+}
+
+void CLog::CLogQueue::FormatEntry(const LogEntry &entry, std::string &lines)
+{
+  if (s_globals.m_repeatLogLevel == entry.level && s_globals.m_repeatLine == entry.message)
+  {
+    s_globals.m_repeatCount++;
+    return;
+  }
+  else if (s_globals.m_repeatCount)
+  {
+    std::string strData2 = StringUtils::Format("Previous line repeats %d times.",
+                                              s_globals.m_repeatCount);
+    PrintDebugString(strData2);
+    AppendLine(entry, s_globals.m_repeatLogLevel, strData2, lines);
+    s_globals.m_repeatCount = 0;
+  }
+
+  s_globals.m_repeatLine = entry.message;
+  s_globals.m_repeatLogLevel = entry.level;
+
+  PrintDebugString(entry.message);
+
+  AppendLine(entry, entry.level, entry.message, lines);
+}
+
+void CLog::CLogQueue::AppendLine(const LogEntry &entry, int logLevel, const std::string &message, std::string &lines)
+{
+  static const char* prefixFormat = "%02d:%02d:%02d.%03d T:%" PRIu64" %7s: ";
+
+  std::string strData(message);
+  /* fixup newline alignment, number of spaces should equal prefix length */
+  StringUtils::Replace(strData, "\n", "\n                                            ");
+
+  if (!lines.empty())
+    lines += '\n';
+  lines += StringUtils::Format(prefixFormat,
+                               entry.hour,
+                               entry.minute,
+                               entry.second,
+                               entry.millisecond,
+                               entry.threadId,
+                               levelNames[logLevel]);
+  lines += strData;
+}
+
+CLog::CLogGlobals::CLogGlobals(void) :
+  m_repeatCount(0),
+  m_repeatLogLevel(-1),
+  m_logLevel(LOG_LEVEL_DEBUG),
+  m_extraLogLevels(0),
+  m_queue(new CLogQueue)
+{}
+
+CLog::CLogGlobals::~CLogGlobals()
+{}
+
 CLog::CLog()
 {}
 
@@ -43,6 +380,9 @@ CLog::~CLog()
 
 void CLog::Close()
 {
+  // the writer needs critSec to finish, so stop it before taking the lock
+  s_globals.m_queue->Stop();
+
   CSingleLock waitLock(s_globals.critSec);
   s_globals.m_platform.CloseLogFile();
   s_globals.m_repeatLine.clear();
@@ -75,32 +415,28 @@ void CLog::LogFunction(int loglevel, const char* functionName, const char* forma
 
 void CLog::LogString(int logLevel, const std::string& logString)
 {
-  CSingleLock waitLock(s_globals.critSec);
   std::string strData(logString);
   StringUtils::TrimRight(strData);
-  if (!strData.empty())
-  {
-    if (s_globals.m_repeatLogLevel == logLevel && s_globals.m_repeatLine == strData)
-    {
-      s_globals.m_repeatCount++;
-      return;
-    }
-    else if (s_globals.m_repeatCount)
-    {
-      std::string strData2 = StringUtils::Format("Previous line repeats %d times.",
-                                                s_globals.m_repeatCount);
-      PrintDebugString(strData2);
-      WriteLogString(s_globals.m_repeatLogLevel, strData2);
-      s_globals.m_repeatCount = 0;
-    }
-
-    s_globals.m_repeatLine = strData;
-    s_globals.m_repeatLogLevel = logLevel;
+  if (strData.empty())
+    return;
 
-    PrintDebugString(strData);
+  LogEntry entry;
+  CLogQueue::FillEntry(entry, logLevel, strData);
 
-    WriteLogString(logLevel, strData);
+  if (s_globals.m_queue->Push(entry))
+  {
+    // don't let a crash following a severe error swallow it
+    if ((logLevel & LOGMASK) >= LOGSEVERE)
+      s_globals.m_queue->Flush();
+    return;
   }
+
+  // no writer thread (before Init() or after Close()), write directly
+  CSingleLock waitLock(s_globals.critSec);
+  std::string lines;
+  CLogQueue::FormatEntry(entry, lines);
+  if (!lines.empty())
+    s_globals.m_platform.WriteStringToLog(lines);
 }
 
 bool CLog::Init(const std::string& path)
@@ -112,7 +448,11 @@ bool CLog::Init(const std::string& path)
 
   std::string appName = CCompileInfo::GetAppName();
   StringUtils::ToLower(appName);
-  return s_globals.m_platform.OpenLogFile(path + appName + ".log", path + appName + ".old.log");
+  if (!s_globals.m_platform.OpenLogFile(path + appName + ".log", path + appName + ".old.log"))
+    return false;
+
+  s_globals.m_queue->Start();
+  return true;
 }
 
 void CLog::MemDump(char *pData, int length)
@@ -189,32 +529,19 @@ bool CLog::IsLogLevelLogged(int loglevel)
 }
 
 
-void CLog::PrintDebugString(const std::string& line)
+void CLog::Flush()
 {
-#if defined(_DEBUG) || defined(PROFILE)
-  s_globals.m_platform.PrintDebugString(line);
-#endif // defined(_DEBUG) || defined(PROFILE)
+  s_globals.m_queue->Flush();
 }
 
-bool CLog::WriteLogString(int logLevel, const std::string& logString)
+uint64_t CLog::GetDroppedLines()
 {
-  static const char* prefixFormat = "%02d:%02d:%02d.%03d T:%" PRIu64" %7s: ";
-
-  std::string strData(logString);
-  /* fixup newline alignment, number of spaces should equal prefix length */
-  StringUtils::Replace(strData, "\n", "\n                                            ");
-
-  int hour, minute, second;
-  double millisecond;
-  s_globals.m_platform.GetCurrentLocalTime(hour, minute, second, millisecond);
-
-  strData = StringUtils::Format(prefixFormat,
-                                  hour,
-                                  minute,
-                                  second,
-                                  static_cast<int>(millisecond),
-                                  (uint64_t)CThread::GetCurrentThreadId(),
-                                  levelNames[logLevel]) + strData;
+  return s_globals.m_queue->GetDropped();
+}
 
-  return s_globals.m_platform.WriteStringToLog(strData);
+void CLog::PrintDebugString(const std::string& line)
+{
+#if defined(_DEBUG) || defined(PROFILE)
+  s_globals.m_platform.PrintDebugString(line);
+#endif // defined(_DEBUG) || defined(PROFILE)
 }
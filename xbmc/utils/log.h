@@ -20,6 +20,8 @@
  *
  */
 
+#include <memory>
+#include <stdint.h>
 #include <string>
 
 #if defined(TARGET_POSIX)
@@ -52,13 +54,18 @@ public:
   static int  GetLogLevel();
   static void SetExtraLogLevels(int level);
   static bool IsLogLevelLogged(int loglevel);
+  /*! \brief Block until all lines queued so far have been written to the log file */
+  static void Flush();
+  /*! \brief Number of lines dropped because a thread's log queue was full */
+  static uint64_t GetDroppedLines();
 
 protected:
+  class CLogQueue; // background writer, runs between Init() and Close()
   class CLogGlobals
   {
   public:
-    CLogGlobals(void) : m_repeatCount(0), m_repeatLogLevel(-1), m_logLevel(LOG_LEVEL_DEBUG), m_extraLogLevels(0) {}
-    ~CLogGlobals() {}
+    CLogGlobals(void);
+    ~CLogGlobals();
     PlatformInterfaceForCLog m_platform;
     int         m_repeatCount;
     int         m_repeatLogLevel;
@@ -66,10 +73,10 @@ protected:
     int         m_logLevel;
     int         m_extraLogLevels;
     CCriticalSection critSec;
+    std::unique_ptr<CLogQueue> m_queue;
   };
   class CLogGlobals m_globalInstance; // used as static global variable
   static void LogString(int logLevel, const std::string& logString);
-  static bool WriteLogString(int logLevel, const std::string& logString);
 };
 
 
@@ -0,0 +1,159 @@
+/*
+ *      Copyright (C) 2005-2013 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "threads/Event.h"
+#include "threads/Thread.h"
+#include "utils/ActorProtocol.h"
+
+#include <string.h>
+
+#include "gtest/gtest.h"
+
+#define TESTNUM 1000
+#define WARMUP 10
+
+using namespace Actor;
+
+struct LargePayload
+{
+  int values[32];
+};
+
+class CTestReplier : public CThread
+{
+public:
+  CTestReplier(Protocol &port, CEvent &outEvent) :
+    CThread("TestReplier"), m_port(port), m_outEvent(outEvent) {}
+
+protected:
+  virtual void Process()
+  {
+    Message *msg;
+    while (!m_bStop)
+    {
+      if (!m_port.ReceiveOutMessage(&msg))
+      {
+        m_outEvent.WaitMSec(10);
+        continue;
+      }
+      LargePayload reply = *(LargePayload*)msg->data;
+      reply.values[0]++;
+      msg->Reply(msg->signal + 1, &reply, sizeof(reply));
+      msg->Release();
+    }
+  }
+
+  Protocol &m_port;
+  CEvent &m_outEvent;
+};
+
+TEST(TestActorProtocol, Async)
+{
+  CEvent inEvent, outEvent;
+  Protocol port("test", &inEvent, &outEvent);
+  LargePayload large;
+  memset(&large, 0, sizeof(large));
+  unsigned int allocations = 0;
+
+  for (int i = 0; i < TESTNUM; i++)
+  {
+    large.values[31] = i;
+    EXPECT_TRUE(port.SendOutMessage(1, &i, sizeof(i)));
+    EXPECT_TRUE(port.SendOutMessage(2, &large, sizeof(large)));
+    EXPECT_TRUE(port.SendInMessage(3));
+
+    Message *msg;
+    ASSERT_TRUE(port.ReceiveOutMessage(&msg));
+    EXPECT_EQ(1, msg->signal);
+    EXPECT_EQ(i, *(int*)msg->data);
+    msg->Release();
+    ASSERT_TRUE(port.ReceiveOutMessage(&msg));
+    EXPECT_EQ(2, msg->signal);
+    EXPECT_EQ(i, ((LargePayload*)msg->data)->values[31]);
+    msg->Release();
+    EXPECT_FALSE(port.ReceiveOutMessage(&msg));
+    ASSERT_TRUE(port.ReceiveInMessage(&msg));
+    EXPECT_EQ(3, msg->signal);
+    EXPECT_EQ(NULL, msg->data);
+    msg->Release();
+
+    // the messages used last are recycled together with their payload buffers
+    if (i == WARMUP)
+      allocations = port.GetAllocations();
+  }
+  EXPECT_GE(3u, allocations);
+  EXPECT_EQ(allocations, port.GetAllocations());
+}
+
+TEST(TestActorProtocol, Sync)
+{
+  CEvent inEvent, outEvent;
+  Protocol port("test", &inEvent, &outEvent);
+  CTestReplier replier(port, outEvent);
+  replier.Create();
+
+  LargePayload large;
+  memset(&large, 0, sizeof(large));
+  unsigned int allocations = 0;
+
+  for (int i = 0; i < TESTNUM; i++)
+  {
+    Message *reply;
+    large.values[0] = i;
+    ASSERT_TRUE(port.SendOutMessageSync(1, &reply, 5000, &large, sizeof(large)));
+    EXPECT_EQ(2, reply->signal);
+    EXPECT_FALSE(reply->isOut);
+    EXPECT_EQ(i + 1, ((LargePayload*)reply->data)->values[0]);
+    reply->Release();
+
+    if (i == WARMUP)
+      allocations = port.GetAllocations();
+  }
+  EXPECT_GE(4u, allocations);
+  EXPECT_EQ(allocations, port.GetAllocations());
+
+  replier.StopThread();
+}
+
+TEST(TestActorProtocol, Purge)
+{
+  CEvent inEvent, outEvent;
+  Protocol port("test", &inEvent, &outEvent);
+
+  for (int i = 0; i < 6; i++)
+    port.SendInMessage(i % 2, &i, sizeof(i));
+  port.PurgeIn(0);
+
+  Message *msg;
+  for (int i = 1; i < 6; i += 2)
+  {
+    ASSERT_TRUE(port.ReceiveInMessage(&msg));
+    EXPECT_EQ(i, *(int*)msg->data);
+    msg->Release();
+  }
+  EXPECT_FALSE(port.ReceiveInMessage(&msg));
+
+  port.SendOutMessage(1);
+  port.SendInMessage(1);
+  port.Purge();
+  EXPECT_FALSE(port.ReceiveOutMessage(&msg));
+  EXPECT_FALSE(port.ReceiveInMessage(&msg));
+  EXPECT_EQ(0u, port.GetAllocations());
+}
@@ -0,0 +1,137 @@
+/*
+ *      Copyright (C) 2005-2013 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <map>
+#include <string>
+
+#include "utils/FlatMap.h"
+#include "utils/InternedString.h"
+
+#include "gtest/gtest.h"
+
+TEST(TestInternedString, Equality)
+{
+  std::string thumb("thumb");
+  CInternedString a(thumb);
+  CInternedString b("thumb");
+  CInternedString c("fanart");
+
+  EXPECT_EQ(&a.str(), &b.str());
+  EXPECT_TRUE(a == b);
+  EXPECT_TRUE(a != c);
+  EXPECT_TRUE(c < a);
+  EXPECT_STREQ("thumb", a.c_str());
+}
+
+TEST(TestInternedString, Empty)
+{
+  CInternedString a;
+  CInternedString b("");
+  CInternedString c(std::string(""));
+
+  EXPECT_TRUE(a.empty());
+  EXPECT_TRUE(a == b);
+  EXPECT_TRUE(a == c);
+}
+
+TEST(TestInternedString, PoolSize)
+{
+  CInternedString a("TestInternedString.PoolSize");
+  size_t size = CInternedString::GetPoolSize();
+  CInternedString b(std::string("TestInternedString.PoolSize"));
+  EXPECT_EQ(size, CInternedString::GetPoolSize());
+}
+
+TEST(TestFlatMap, Insert)
+{
+  CFlatMap<std::string, int> map;
+  EXPECT_TRUE(map.empty());
+
+  EXPECT_TRUE(map.insert(std::make_pair(std::string("b"), 2)).second);
+  EXPECT_TRUE(map.insert(std::make_pair(std::string("c"), 3)).second);
+  EXPECT_TRUE(map.insert(std::make_pair(std::string("a"), 1)).second);
+  EXPECT_FALSE(map.insert(std::make_pair(std::string("a"), 4)).second);
+  map["d"] = 4;
+  map["b"] = 5;
+
+  ASSERT_EQ(4U, map.size());
+  CFlatMap<std::string, int>::const_iterator it = map.begin();
+  EXPECT_EQ("a", it->first);
+  EXPECT_EQ(1, it->second);
+  ++it;
+  EXPECT_EQ("b", it->first);
+  EXPECT_EQ(5, it->second);
+  ++it;
+  EXPECT_EQ("c", it->first);
+  ++it;
+  EXPECT_EQ("d", it->first);
+}
+
+TEST(TestFlatMap, FindErase)
+{
+  CFlatMap<std::string, int> map;
+  map["one"] = 1;
+  map["two"] = 2;
+
+  EXPECT_EQ(1U, map.count("one"));
+  EXPECT_EQ(0U, map.count("three"));
+  EXPECT_TRUE(map.find("three") == map.end());
+  ASSERT_TRUE(map.find("two") != map.end());
+  EXPECT_EQ(2, map.find("two")->second);
+
+  EXPECT_EQ(1U, map.erase("one"));
+  EXPECT_EQ(0U, map.erase("one"));
+  EXPECT_EQ(1U, map.size());
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+}
+
+TEST(TestFlatMap, Assign)
+{
+  std::map<std::string, std::string> art;
+  art["thumb"] = "thumb.jpg";
+  art["fanart"] = "fanart.jpg";
+  art["poster"] = "poster.jpg";
+
+  CFlatMap<CInternedString, std::string, std::less<std::string> > map(art.begin(), art.end());
+  ASSERT_EQ(art.size(), map.size());
+  EXPECT_TRUE(std::equal(art.begin(), art.end(), map.begin(),
+    [](const std::pair<const std::string, std::string> &lhs, const std::pair<CInternedString, std::string> &rhs)
+    { return lhs.first == rhs.first.str() && lhs.second == rhs.second; }));
+
+  // lookups with a plain string
+  EXPECT_EQ("poster.jpg", map.find(std::string("poster"))->second);
+  EXPECT_TRUE(map.find(std::string("banner")) == map.end());
+}
+
+TEST(TestFlatMap, AssignDuplicates)
+{
+  std::pair<std::string, int> values[] = {
+    std::make_pair("b", 1),
+    std::make_pair("a", 2),
+    std::make_pair("b", 3)
+  };
+
+  CFlatMap<std::string, int> map(values, values + 3);
+  ASSERT_EQ(2U, map.size());
+  EXPECT_EQ(2, map["a"]);
+  EXPECT_EQ(1, map["b"]);
+}
@@ -18,6 +18,8 @@
  *
  */
 
+#include <limits>
+
 #include "utils/JSONVariantWriter.h"
 #include "utils/Variant.h"
 
@@ -31,3 +33,37 @@ TEST(TestJSONVariantWriter, Write)
   str = CJSONVariantWriter::Write(variant, false);
   EXPECT_STREQ("null\n", str.c_str());
 }
+
+static void AppendOutput(void *context, const char *data, size_t length)
+{
+  static_cast<std::string*>(context)->append(data, length);
+}
+
+TEST(TestJSONVariantWriter, WriteCallback)
+{
+  CVariant variant;
+  variant["title"] = "a \"title\"";
+  variant["year"] = 2016;
+  variant["genre"].push_back("Drama");
+  variant["genre"].push_back("Comedy");
+
+  std::string str;
+  EXPECT_TRUE(CJSONVariantWriter::Write(variant, true, AppendOutput, &str));
+  EXPECT_EQ(CJSONVariantWriter::Write(variant, true), str);
+
+  str.clear();
+  EXPECT_TRUE(CJSONVariantWriter::Write(variant, false, AppendOutput, &str));
+  EXPECT_EQ(CJSONVariantWriter::Write(variant, false), str);
+}
+
+TEST(TestJSONVariantWriter, WriteCallbackFailure)
+{
+  // yajl refuses non-finite numbers after part of the output has been passed on
+  CVariant variant;
+  variant["title"] = "title";
+  variant["rating"] = std::numeric_limits<double>::infinity();
+
+  std::string str;
+  EXPECT_FALSE(CJSONVariantWriter::Write(variant, true, AppendOutput, &str));
+  EXPECT_TRUE(CJSONVariantWriter::Write(variant, true).empty());
+}
@@ -20,7 +20,15 @@
 
 #include "utils/JobManager.h"
 #include "settings/Settings.h"
+#include "utils/Stopwatch.h"
 #include "utils/SystemInfo.h"
+#ifdef TARGET_POSIX
+#include "linux/XTimeUtils.h"
+#endif
+
+#include <atomic>
+#include <iostream>
+#include <set>
 
 #include "gtest/gtest.h"
 
@@ -178,3 +186,100 @@ TEST_F(TestJobManager, IsProcessing)
 
   job->FinishAndStopBlocking();
 }
+
+TEST_F(TestJobManager, NestedSubmit)
+{
+  static const int outer = 20;
+  static const int inner = 50;
+  std::atomic<int> done(0);
+
+  // jobs queued from a worker land on its own queue and get stolen by idle workers
+  for (int i = 0; i < outer; i++)
+  {
+    CJobManager::GetInstance().Submit([&done]()
+    {
+      for (int j = 0; j < inner; j++)
+        CJobManager::GetInstance().Submit([&done]() { done++; });
+    });
+  }
+
+  CStopWatch timer;
+  timer.StartZero();
+  while (done < outer * inner && timer.GetElapsedSeconds() < 10.0f)
+    Sleep(1);
+  EXPECT_EQ(outer * inner, done);
+}
+
+TEST_F(TestJobManager, Throughput)
+{
+  static const int jobs = 100000;
+  std::atomic<int> done(0);
+
+  CStopWatch timer;
+  timer.StartZero();
+  for (int i = 0; i < jobs; i++)
+    CJobManager::GetInstance().Submit([&done]() { done++; }, CJob::PRIORITY(i % CJob::PRIORITY_DEDICATED));
+  while (done < jobs && timer.GetElapsedSeconds() < 30.0f)
+    Sleep(1);
+  float elapsed = timer.GetElapsedSeconds();
+
+  EXPECT_EQ(jobs, done);
+  std::cout << "Jobs per second: " << testing::PrintToString(jobs / elapsed) << std::endl;
+}
+
+namespace
+{
+class NoopJob : public CJob
+{
+public:
+  bool DoWork() override
+  {
+    return true;
+  }
+};
+
+// counts completions of jobs whose CancelJob() call already returned
+class CancelCheckingCallback : public IJobCallback
+{
+public:
+  CancelCheckingCallback() : m_late(0) {}
+
+  void Cancelled(unsigned int jobID)
+  {
+    CSingleLock lock(m_section);
+    m_cancelled.insert(jobID);
+  }
+
+  void OnJobComplete(unsigned int jobID, bool success, CJob *job) override
+  {
+    CSingleLock lock(m_section);
+    if (m_cancelled.find(jobID) != m_cancelled.end())
+      m_late++;
+  }
+
+  std::atomic<int> m_late;
+
+private:
+  CCriticalSection m_section;
+  std::set<unsigned int> m_cancelled;
+};
+}
+
+TEST_F(TestJobManager, CancelWhileStealing)
+{
+  static const int jobs = 20000;
+  CancelCheckingCallback callback;
+
+  // idle workers keep stealing these while they are being cancelled
+  for (int i = 0; i < jobs; i++)
+  {
+    unsigned int id = CJobManager::GetInstance().AddJob(new NoopJob, &callback, CJob::PRIORITY(i % CJob::PRIORITY_DEDICATED));
+    CJobManager::GetInstance().CancelJob(id);
+    callback.Cancelled(id);
+  }
+
+  // waits for the workers, so no callback is running once the callback goes away
+  CJobManager::GetInstance().CancelJobs();
+  CJobManager::GetInstance().Restart();
+  EXPECT_EQ(0, callback.m_late);
+}
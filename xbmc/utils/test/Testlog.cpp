@@ -19,6 +19,9 @@
  */
 
 #include <stdlib.h>
+#include <thread>
+#include <vector>
+
 #include "utils/log.h"
 #include "utils/RegExp.h"
 #include "filesystem/File.h"
@@ -134,6 +137,57 @@ TEST_F(Testlog, MemDump)
   EXPECT_TRUE(XFILE::CFile::Delete(logfile));
 }
 
+TEST_F(Testlog, ConcurrentLog)
+{
+  static const int threadCount = 4;
+  static const int linesPerThread = 500;
+  std::string logfile, logstring;
+  char buf[100];
+  unsigned int bytesread;
+  XFILE::CFile file;
+
+  std::string appName = CCompileInfo::GetAppName();
+  StringUtils::ToLower(appName);
+  logfile = CSpecialProtocol::TranslatePath("special://temp/") + appName + ".log";
+  EXPECT_TRUE(CLog::Init(CSpecialProtocol::TranslatePath("special://temp/").c_str()));
+  EXPECT_TRUE(XFILE::CFile::Exists(logfile));
+
+  const uint64_t droppedBefore = CLog::GetDroppedLines();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < threadCount; i++)
+  {
+    threads.push_back(std::thread([i]()
+    {
+      for (int j = 0; j < linesPerThread; j++)
+        CLog::Log(LOGDEBUG, "concurrent log message %d %d", i, j);
+    }));
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  CLog::Log(LOGNOTICE, "flushed log message");
+  CLog::Flush();
+  CLog::Close();
+
+  EXPECT_TRUE(file.Open(logfile));
+  while ((bytesread = file.Read(buf, sizeof(buf) - 1)) > 0)
+  {
+    buf[bytesread] = '\0';
+    logstring.append(buf);
+  }
+  file.Close();
+
+  // every line is either written or accounted for as dropped
+  int written = 0;
+  for (size_t pos = logstring.find("DEBUG: concurrent log message"); pos != std::string::npos;
+       pos = logstring.find("DEBUG: concurrent log message", pos + 1))
+    written++;
+  EXPECT_EQ(threadCount * linesPerThread, written + (int)(CLog::GetDroppedLines() - droppedBefore));
+  EXPECT_NE(std::string::npos, logstring.find("NOTICE: flushed log message"));
+
+  EXPECT_TRUE(XFILE::CFile::Delete(logfile));
+}
+
 TEST_F(Testlog, SetLogLevel)
 {
   std::string logfile;
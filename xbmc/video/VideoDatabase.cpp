@@ -530,8 +530,8 @@ int CVideoDatabase::GetPathId(const std::string& strPath)
 
     URIUtils::AddSlashAtEnd(strPath1);
 
-    strSQL=PrepareSQL("select idPath from path where strPath='%s'",strPath1.c_str());
-    m_pDS->query(strSQL);
+    strSQL = "select idPath from path where strPath=?";
+    m_pDS->query(strSQL, { strPath1 });
     if (!m_pDS->eof())
       idPath = m_pDS->fv("path.idPath").get_asInt();
 
@@ -667,11 +667,11 @@ bool CVideoDatabase::GetPathsForTvShow(int idShow, std::set<int>& paths)
   return false;
 }
 
-int CVideoDatabase::RunQuery(const std::string &sql)
+int CVideoDatabase::RunQuery(const std::string &sql, bool streaming /* = false */)
 {
   unsigned int time = XbmcThreads::SystemClockMillis();
   int rows = -1;
-  if (m_pDS->query(sql))
+  if (streaming ? m_pDS->query_streaming(sql) : m_pDS->query(sql))
   {
     rows = m_pDS->num_rows();
     if (rows == 0)
@@ -765,8 +765,7 @@ bool CVideoDatabase::GetPathHash(const std::string &path, std::string &hash)
     if (NULL == m_pDB.get()) return false;
     if (NULL == m_pDS.get()) return false;
 
-    std::string strSQL=PrepareSQL("select strHash from path where strPath='%s'", path.c_str());
-    m_pDS->query(strSQL);
+    m_pDS->query("select strHash from path where strPath=?", { path });
     if (m_pDS->num_rows() == 0)
       return false;
     hash = m_pDS->fv("strHash").get_asString();
@@ -1062,9 +1061,7 @@ int CVideoDatabase::GetFileId(const std::string& strFilenameAndPath)
     int idPath = GetPathId(strPath);
     if (idPath >= 0)
     {
-      std::string strSQL;
-      strSQL=PrepareSQL("select idFile from files where strFileName='%s' and idPath=%i", strFileName.c_str(),idPath);
-      m_pDS->query(strSQL);
+      m_pDS->query("select idFile from files where strFileName=? and idPath=?", { strFileName, idPath });
       if (m_pDS->num_rows() > 0)
       {
         int idFile = m_pDS->fv("files.idFile").get_asInt();
@@ -6644,10 +6641,51 @@ bool CVideoDatabase::GetMoviesByWhere(const std::string& strBaseDir, const Filte
 
     strSQL = PrepareSQL(strSQL, !extFilter.fields.empty() ? extFilter.fields.c_str() : "*") + strSQLExtra;
 
-    int iRowsFound = RunQuery(strSQL);
+    // without sorting in memory the rows can be read through a forward-only cursor
+    // instead of keeping a full copy of the result set next to the item list.
+    // MySQL cursors block the connection, so only use them if no details are queried
+    bool streaming = sortDescription.sortBy == SortByNone && (m_sqlite || getDetails == VideoDbDetailsNone);
+
+    int iRowsFound = RunQuery(strSQL, streaming);
     if (iRowsFound <= 0)
       return iRowsFound == 0;
 
+    auto addMovie = [&](const dbiplus::sql_record* const record)
+    {
+      CVideoInfoTag movie = GetDetailsForMovie(record, getDetails);
+      if (CProfilesManager::GetInstance().GetMasterProfile().getLockMode() == LOCK_MODE_EVERYONE ||
+          g_passwordManager.bMasterUser                                   ||
+          g_passwordManager.IsDatabasePathUnlocked(movie.m_strPath, *CMediaSourceSettings::GetInstance().GetSources("video")))
+      {
+        CFileItemPtr pItem(new CFileItem(movie));
+
+        CVideoDbUrl itemUrl = videoUrl;
+        std::string path = StringUtils::Format("%i", movie.m_iDbId);
+        itemUrl.AppendPath(path);
+        pItem->SetPath(itemUrl.ToString());
+
+        pItem->SetOverlayImage(CGUIListItem::ICON_OVERLAY_UNWATCHED,movie.m_playCount > 0);
+        items.Add(pItem);
+      }
+    };
+
+    if (streaming)
+    {
+      while (!m_pDS->eof())
+      {
+        addMovie(m_pDS->get_sql_record());
+        m_pDS->next();
+      }
+
+      iRowsFound = m_pDS->num_rows();
+      if (total < iRowsFound)
+        total = iRowsFound;
+      items.SetProperty("total", total);
+
+      m_pDS->close();
+      return true;
+    }
+
     // store the total value of items as a property
     if (total < iRowsFound)
       total = iRowsFound;
@@ -6665,23 +6703,7 @@ bool CVideoDatabase::GetMoviesByWhere(const std::string& strBaseDir, const Filte
     for (const auto &i : results)
     {
       unsigned int targetRow = (unsigned int)i.at(FieldRow).asInteger();
-      const dbiplus::sql_record* const record = data.at(targetRow);
-
-      CVideoInfoTag movie = GetDetailsForMovie(record, getDetails);
-      if (CProfilesManager::GetInstance().GetMasterProfile().getLockMode() == LOCK_MODE_EVERYONE ||
-          g_passwordManager.bMasterUser                                   ||
-          g_passwordManager.IsDatabasePathUnlocked(movie.m_strPath, *CMediaSourceSettings::GetInstance().GetSources("video")))
-      {
-        CFileItemPtr pItem(new CFileItem(movie));
-
-        CVideoDbUrl itemUrl = videoUrl;
-        std::string path = StringUtils::Format("%i", movie.m_iDbId);
-        itemUrl.AppendPath(path);
-        pItem->SetPath(itemUrl.ToString());
-
-        pItem->SetOverlayImage(CGUIListItem::ICON_OVERLAY_UNWATCHED,movie.m_playCount > 0);
-        items.Add(pItem);
-      }
+      addMovie(data.at(targetRow));
     }
 
     // cleanup
@@ -6878,30 +6900,18 @@ bool CVideoDatabase::GetEpisodesByWhere(const std::string& strBaseDir, const Fil
 
     strSQL = PrepareSQL(strSQL, !extFilter.fields.empty() ? extFilter.fields.c_str() : "*") + strSQLExtra;
 
-    int iRowsFound = RunQuery(strSQL);
+    // without sorting in memory the rows can be read through a forward-only cursor,
+    // see GetMoviesByWhere
+    bool streaming = sorting.sortBy == SortByNone && (m_sqlite || getDetails == VideoDbDetailsNone);
+
+    int iRowsFound = RunQuery(strSQL, streaming);
     if (iRowsFound <= 0)
       return iRowsFound == 0;
 
-    // store the total value of items as a property
-    if (total < iRowsFound)
-      total = iRowsFound;
-    items.SetProperty("total", total);
-    
-    DatabaseResults results;
-    results.reserve(iRowsFound);
-    if (!SortUtils::SortFromDataset(sorting, MediaTypeEpisode, m_pDS, results))
-      return false;
-    
-    // get data from returned rows
-    items.Reserve(results.size());
     CLabelFormatter formatter("%H. %T", "");
 
-    const query_data &data = m_pDS->get_result_set().records;
-    for (const auto &i : results)
+    auto addEpisode = [&](const dbiplus::sql_record* const record)
     {
-      unsigned int targetRow = (unsigned int)i.at(FieldRow).asInteger();
-      const dbiplus::sql_record* const record = data.at(targetRow);
-
       CVideoInfoTag movie = GetDetailsForEpisode(record, getDetails);
       if (CProfilesManager::GetInstance().GetMasterProfile().getLockMode() == LOCK_MODE_EVERYONE ||
           g_passwordManager.bMasterUser                                     ||
@@ -6925,6 +6935,42 @@ bool CVideoDatabase::GetEpisodesByWhere(const std::string& strBaseDir, const Fil
         pItem->m_dateTime = movie.m_firstAired;
         items.Add(pItem);
       }
+    };
+
+    if (streaming)
+    {
+      while (!m_pDS->eof())
+      {
+        addEpisode(m_pDS->get_sql_record());
+        m_pDS->next();
+      }
+
+      iRowsFound = m_pDS->num_rows();
+      if (total < iRowsFound)
+        total = iRowsFound;
+      items.SetProperty("total", total);
+
+      m_pDS->close();
+      return true;
+    }
+
+    // store the total value of items as a property
+    if (total < iRowsFound)
+      total = iRowsFound;
+    items.SetProperty("total", total);
+    
+    DatabaseResults results;
+    results.reserve(iRowsFound);
+    if (!SortUtils::SortFromDataset(sorting, MediaTypeEpisode, m_pDS, results))
+      return false;
+    
+    // get data from returned rows
+    items.Reserve(results.size());
+    const query_data &data = m_pDS->get_result_set().records;
+    for (const auto &i : results)
+    {
+      unsigned int targetRow = (unsigned int)i.at(FieldRow).asInteger();
+      addEpisode(data.at(targetRow));
     }
 
     // cleanup
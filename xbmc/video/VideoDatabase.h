@@ -944,9 +944,10 @@ private:
   /*! \brief Run a query on the main dataset and return the number of rows
    If no rows are found we close the dataset and return 0.
    \param sql the sql query to run
-   \return the number of rows, -1 for an error.
+   \param streaming whether to open a forward-only cursor instead of fetching all rows
+   \return the number of rows (fetched so far if streaming), -1 for an error.
    */
-  int RunQuery(const std::string &sql);
+  int RunQuery(const std::string &sql, bool streaming = false);
 
   void AppendIdLinkFilter(const char* field, const char *table, const MediaType& mediaType, const char *view, const char *viewKey, const CUrlOptions::UrlOptions& options, Filter &filter);
   void AppendLinkFilter(const char* field, const char *table, const MediaType& mediaType, const char *view, const char *viewKey, const CUrlOptions::UrlOptions& options, Filter &filter);
@@ -55,6 +55,7 @@
 #include "video/VideoLibraryQueue.h"
 #include "video/VideoThumbLoader.h"
 #include "VideoInfoDownloader.h"
+#include "VideoScanEnumerator.h"
 
 using namespace XFILE;
 using namespace ADDON;
@@ -129,6 +130,9 @@ namespace VIDEO
       // result in unexpected behaviour.
       m_bCanInterrupt = false;
 
+      m_stats = ScanStats();
+      StartEnumerator();
+
       bool bCancelled = false;
       while (!bCancelled && !m_pathsToScan.empty())
       {
@@ -143,7 +147,7 @@ namespace VIDEO
         {
           bCancelled = true;
         }
-        else if (!CDirectory::Exists(directory))
+        else if (!DirectoryExists(directory))
         {
           /*
            * Note that this will skip clean (if m_bClean is enabled) if the directory really
@@ -157,6 +161,18 @@ namespace VIDEO
           bCancelled = true;
       }
 
+      if (m_enumerator)
+      {
+        m_enumerator->Abort();
+        unsigned int elapsed = m_enumerator->GetElapsedMs();
+        CLog::Log(LOGNOTICE, "VideoInfoScanner: Enumerated %u directories (%u listed) in %u ms (%.1f dirs/s), waited %u ms for them",
+                  m_enumerator->GetDirectoryCount(), m_enumerator->GetListedCount(), elapsed,
+                  elapsed ? m_enumerator->GetDirectoryCount() * 1000.0f / elapsed : 0.0f, m_stats.waitMs);
+        m_enumerator.reset();
+      }
+      CLog::Log(LOGNOTICE, "VideoInfoScanner: Checked %u directories, %u unchanged, %u scraped in %u ms",
+                m_stats.directories, m_stats.unchanged, m_stats.scraped, m_stats.scrapeMs);
+
       if (!bCancelled)
       {
         if (m_bClean)
@@ -233,6 +249,61 @@ namespace VIDEO
     m_bStop = true;
   }
 
+  void CVideoInfoScanner::StartEnumerator()
+  {
+    if (g_advancedSettings.m_iVideoLibraryScanConnections <= 0)
+      return;
+
+    m_enumerator.reset(new CVideoScanEnumerator(g_advancedSettings.m_iVideoLibraryScanConnections));
+    for (std::set<std::string>::const_iterator it = m_pathsToScan.begin(); it != m_pathsToScan.end(); ++it)
+    {
+      // only movie and music video folders are listed the same way for every path, see DoScan()
+      SScanSettings settings;
+      bool foundDirectly = false;
+      ScraperPtr info = m_database.GetScraperForPath(*it, settings, foundDirectly);
+      CONTENT_TYPE content = info ? info->Content() : CONTENT_NONE;
+      if (content != CONTENT_MOVIES && content != CONTENT_MUSICVIDEOS)
+        continue;
+
+      if ((!m_scanAll && settings.noupdate) || IsExcluded(*it, g_advancedSettings.m_moviesExcludeFromScanRegExps))
+        continue;
+
+      std::string dbHash;
+      m_database.GetPathHash(*it, dbHash);
+      ScanDirectoryPtr directory = m_enumerator->Add(*it, dbHash, g_advancedSettings.m_moviesExcludeFromScanRegExps);
+      // DoScan() uses the lookup instead of doing it again
+      directory->scraper = info;
+      directory->settings = settings;
+      directory->foundDirectly = foundDirectly;
+    }
+    m_enumerator->Start();
+  }
+
+  bool CVideoInfoScanner::WaitEnumerated(const ScanDirectoryPtr &directory)
+  {
+    unsigned int waitStart = XbmcThreads::SystemClockMillis();
+    bool done = true;
+    while (!directory->done.WaitMSec(100))
+    {
+      if (m_bStop)
+      {
+        done = false;
+        break;
+      }
+    }
+    m_stats.waitMs += XbmcThreads::SystemClockMillis() - waitStart;
+    return done;
+  }
+
+  bool CVideoInfoScanner::DirectoryExists(const std::string &directory)
+  {
+    ScanDirectoryPtr enumerated = m_enumerator ? m_enumerator->Get(directory) : ScanDirectoryPtr();
+    if (enumerated && WaitEnumerated(enumerated) && !enumerated->hash.empty())
+      return true;
+
+    return CDirectory::Exists(directory);
+  }
+
   static void OnDirectoryScanned(const std::string& strDirectory)
   {
     CGUIMessage msg(GUI_MSG_DIRECTORY_SCANNED, 0, 0, 0);
@@ -262,7 +333,16 @@ namespace VIDEO
     bool bSkip = false;
 
     SScanSettings settings;
-    ScraperPtr info = m_database.GetScraperForPath(strDirectory, settings, foundDirectly);
+    ScraperPtr info;
+    ScanDirectoryPtr enumerated = m_enumerator ? m_enumerator->Take(strDirectory) : ScanDirectoryPtr();
+    if (enumerated)
+    { // looked up when the scan started
+      info = enumerated->scraper;
+      settings = enumerated->settings;
+      foundDirectly = enumerated->foundDirectly;
+    }
+    else
+      info = m_database.GetScraperForPath(strDirectory, settings, foundDirectly);
     CONTENT_TYPE content = info ? info->Content() : CONTENT_NONE;
 
     // exclude folders that match our exclude regexps
@@ -285,29 +365,38 @@ namespace VIDEO
         m_handle->SetTitle(StringUtils::Format(g_localizeStrings.Get(str).c_str(), info->Name().c_str()));
       }
 
-      std::string fastHash;
-      if (g_advancedSettings.m_bVideoLibraryUseFastHash)
-        fastHash = GetFastHash(strDirectory, regexps);
-
-      if (m_database.GetPathHash(strDirectory, dbHash) && !fastHash.empty() && fastHash == dbHash)
-      { // fast hashes match - no need to process anything
-        hash = fastHash;
+      if (enumerated && enumerated->started)
+      {
+        if (!WaitEnumerated(enumerated))
+          return false;
       }
       else
-      { // need to fetch the folder
-        CDirectory::GetDirectory(strDirectory, items, g_advancedSettings.m_videoExtensions);
-        items.Stack();
+      {
+        if (!enumerated)
+        { // not queued for the enumerator, e.g. a folder that is new since the last scan
+          enumerated.reset(new SScanDirectory);
+          enumerated->path = strDirectory;
+          enumerated->excludes = regexps;
+          m_database.GetPathHash(strDirectory, enumerated->dbHash);
+        }
+        // not read ahead yet
+        CVideoScanEnumerator::Enumerate(*enumerated);
+      }
 
-        // check whether to re-use previously computed fast hash
-        if (!CanFastHash(items, regexps) || fastHash.empty())
-          GetPathHash(items, hash);
-        else
-          hash = fastHash;
+      dbHash = enumerated->dbHash;
+      hash = enumerated->hash;
+      const std::string &fastHash = enumerated->fastHash;
+      if (enumerated->listed)
+      {
+        items.Assign(enumerated->items);
+        enumerated->items.Clear();
       }
+      m_stats.directories++;
 
       if (hash == dbHash)
       { // hash matches - skipping
         CLog::Log(LOGDEBUG, "VideoInfoScanner: Skipping dir '%s' due to no change%s", CURL::GetRedacted(strDirectory).c_str(), !fastHash.empty() ? " (fasthash)" : "");
+        m_stats.unchanged++;
         bSkip = true;
       }
       else if (hash.empty())
@@ -354,7 +443,12 @@ namespace VIDEO
 
     if (!bSkip)
     {
-      if (RetrieveVideoInfo(items, settings.parent_name_root, content))
+      unsigned int scrapeStart = XbmcThreads::SystemClockMillis();
+      bool retrieved = RetrieveVideoInfo(items, settings.parent_name_root, content);
+      m_stats.scraped++;
+      m_stats.scrapeMs += XbmcThreads::SystemClockMillis() - scrapeStart;
+
+      if (retrieved)
       {
         if (!m_bStop && (content == CONTENT_MOVIES || content == CONTENT_MUSICVIDEOS))
         {
@@ -1396,8 +1490,10 @@ namespace VIDEO
         art.insert(std::make_pair("fanart", fanart));
     }
 
+    std::vector<std::string> images;
     for (CGUIListItem::ArtMap::const_iterator i = art.begin(); i != art.end(); ++i)
-      CTextureCache::GetInstance().BackgroundCacheImage(i->second);
+      images.push_back(i->second);
+    CTextureCache::GetInstance().BackgroundCacheImages(images);
 
     pItem->SetArt(art);
 
@@ -1814,7 +1910,7 @@ namespace VIDEO
     return count;
   }
 
-  bool CVideoInfoScanner::CanFastHash(const CFileItemList &items, const std::vector<std::string> &excludes) const
+  bool CVideoInfoScanner::CanFastHash(const CFileItemList &items, const std::vector<std::string> &excludes)
   {
     if (!g_advancedSettings.m_bVideoLibraryUseFastHash)
       return false;
@@ -1828,7 +1924,7 @@ namespace VIDEO
   }
 
   std::string CVideoInfoScanner::GetFastHash(const std::string &directory,
-      const std::vector<std::string> &excludes) const
+      const std::vector<std::string> &excludes)
   {
     XBMC::XBMC_MD5 md5state;
 
@@ -1982,6 +2078,7 @@ namespace VIDEO
     if (CDirectory::Exists(actorsDir))
       CDirectory::GetDirectory(actorsDir, items, ".png|.jpg|.tbn", DIR_FLAG_NO_FILE_DIRS |
                                DIR_FLAG_NO_FILE_INFO);
+    std::vector<std::string> thumbs;
     for (std::vector<SActorInfo>::iterator i = actors.begin(); i != actors.end(); ++i)
     {
       if (i->thumb.empty())
@@ -2001,9 +2098,10 @@ namespace VIDEO
         if (i->thumb.empty() && !i->thumbUrl.GetFirstThumb().m_url.empty())
           i->thumb = CScraperUrl::GetThumbURL(i->thumbUrl.GetFirstThumb());
         if (!i->thumb.empty())
-          CTextureCache::GetInstance().BackgroundCacheImage(i->thumb);
+          thumbs.push_back(i->thumb);
       }
     }
+    CTextureCache::GetInstance().BackgroundCacheImages(thumbs);
   }
 
   CNfoFile::NFOResult CVideoInfoScanner::CheckForNFOFile(CFileItem* pItem, bool bGrabAny, ScraperPtr& info, CScraperUrl& scrUrl)
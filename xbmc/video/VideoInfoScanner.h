@@ -19,6 +19,7 @@
  *
  */
 
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -34,6 +35,10 @@ class CFileItemList;
 
 namespace VIDEO
 {
+  class CVideoScanEnumerator;
+  struct SScanDirectory;
+  typedef std::shared_ptr<SScanDirectory> ScanDirectoryPtr;
+
   typedef struct SScanSettings
   {
     SScanSettings() { parent_name = parent_name_root = noupdate = exclude = false; recurse = 1;}
@@ -127,6 +132,8 @@ namespace VIDEO
     bool EnumerateEpisodeItem(const CFileItem *item, EPISODELIST& episodeList);
 
   protected:
+    friend class CVideoScanEnumerator;
+
     virtual void Process();
     bool DoScan(const std::string& strDirectory) override;
 
@@ -197,7 +204,7 @@ namespace VIDEO
      \param excludes string array of exclude expressions
      \return the md5 hash of the folder"
      */
-    std::string GetFastHash(const std::string &directory, const std::vector<std::string> &excludes) const;
+    static std::string GetFastHash(const std::string &directory, const std::vector<std::string> &excludes);
 
     /*! \brief Retrieve a "fast" hash of the given directory recursively (if available)
      Performs a stat() on the directory, and uses modified time to create a "fast"
@@ -219,7 +226,7 @@ namespace VIDEO
      \param excludes string array of exclude expressions
      \return true if this directory listing can be fast hashed, false otherwise
      */
-    bool CanFastHash(const CFileItemList &items, const std::vector<std::string> &excludes) const;
+    static bool CanFastHash(const CFileItemList &items, const std::vector<std::string> &excludes);
 
     /*! \brief Process a series folder, filling in episode details and adding them to the database.
      @todo Ideally we would return INFO_HAVE_ALREADY if we don't have to update any episodes
@@ -239,6 +246,21 @@ namespace VIDEO
 
     std::string GetnfoFile(CFileItem *item, bool bGrabAny=false) const;
 
+    /*! \brief Start listing and hashing the movie and music video paths to scan ahead of DoScan()
+     Does nothing if videolibrary/scanconnectionsperhost is 0.
+     */
+    void StartEnumerator();
+
+    /*! \brief Wait for the enumerator to read a directory
+     \param directory a directory the enumerator started
+     \return false if the scan was stopped while waiting
+     */
+    bool WaitEnumerated(const ScanDirectoryPtr &directory);
+
+    /*! \brief Check whether a path to scan exists, using the enumerator's result if there is one
+     */
+    bool DirectoryExists(const std::string &directory);
+
     bool m_showDialog;
     CGUIDialogProgressBarHandle* m_handle;
     int m_currentItem;
@@ -254,6 +276,17 @@ namespace VIDEO
     std::set<std::string> m_pathsToCount;
     std::set<int> m_pathsToClean;
     CNfoFile m_nfoReader;
+    std::shared_ptr<CVideoScanEnumerator> m_enumerator;
+
+    struct ScanStats
+    {
+      ScanStats() : directories(0), unchanged(0), waitMs(0), scraped(0), scrapeMs(0) { }
+      unsigned int directories; ///< movie and music video directories checked
+      unsigned int unchanged;   ///< directories skipped as their hash didn't change
+      unsigned int waitMs;      ///< time spent waiting for the enumerator
+      unsigned int scraped;     ///< directories handed to the scraper
+      unsigned int scrapeMs;    ///< time spent retrieving info for them
+    } m_stats;
   };
 }
 
@@ -82,6 +82,7 @@ public:
   bool Save(TiXmlNode *node, const std::string &tag, bool savePathInfo = true, const TiXmlElement *additionalNode = NULL);
   virtual void Archive(CArchive& ar);
   virtual void Serialize(CVariant& value) const;
+  virtual void SerializeFields(CVariant& value, const std::set<std::string>& fields) const;
   virtual void ToSortable(SortItem& sortable, Field field) const;
   const CRating GetRating(std::string type = "") const;
   const std::string& GetDefaultRating() const;
@@ -232,6 +233,11 @@ private:
    */
   void ParseNative(const TiXmlElement* element, bool prioritise);
 
+  /* \brief Serialize the members named in fields, or all of them if fields is NULL.
+   \sa SerializeFields
+   */
+  void Serialize(CVariant& value, const std::set<std::string>* fields) const;
+
   std::string m_strDefaultRating;
   std::string m_strDefaultUniqueID;
   std::map<std::string, std::string> m_uniqueIDs;
@@ -0,0 +1,222 @@
+/*
+ *      Copyright (C) 2005-2013 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+
+#include "VideoScanEnumerator.h"
+#include "URL.h"
+#include "VideoInfoScanner.h"
+#include "filesystem/Directory.h"
+#include "settings/AdvancedSettings.h"
+#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "utils/Job.h"
+#include "utils/JobManager.h"
+
+using namespace VIDEO;
+
+namespace VIDEO
+{
+  class CVideoScanEnumeratorJob : public CJob
+  {
+  public:
+    CVideoScanEnumeratorJob(const std::shared_ptr<CVideoScanEnumerator> &enumerator, const ScanDirectoryPtr &directory, const std::string &host)
+      : m_enumerator(enumerator),
+        m_directory(directory),
+        m_host(host)
+    { }
+
+    virtual bool DoWork()
+    {
+      CVideoScanEnumerator::Enumerate(*m_directory);
+      m_directory->done.Set();
+      m_enumerator->OnDirectoryDone(m_host, m_directory->listed);
+      return true;
+    }
+
+    virtual const char* GetType() const { return "videoscanenumerator"; }
+
+  private:
+    std::shared_ptr<CVideoScanEnumerator> m_enumerator;
+    ScanDirectoryPtr m_directory;
+    std::string m_host;
+  };
+}
+
+CVideoScanEnumerator::CVideoScanEnumerator(int connectionsPerHost, unsigned int maxReadAhead /* = 32 */)
+  : m_connectionsPerHost(connectionsPerHost),
+    m_maxReadAhead(maxReadAhead),
+    m_aborted(false),
+    m_startTime(0),
+    m_endTime(0),
+    m_count(0),
+    m_pending(0),
+    m_listed(0),
+    m_readAhead(0)
+{ }
+
+ScanDirectoryPtr CVideoScanEnumerator::Add(const std::string &path, const std::string &dbHash, const std::vector<std::string> &excludes)
+{
+  CSingleLock lock(m_section);
+  std::map<std::string, ScanDirectoryPtr>::const_iterator it = m_directories.find(path);
+  if (it != m_directories.end())
+    return it->second;
+
+  ScanDirectoryPtr directory(new SScanDirectory);
+  directory->path = path;
+  directory->dbHash = dbHash;
+  directory->excludes = excludes;
+
+  m_directories.insert(std::make_pair(path, directory));
+  m_queued[CURL(path).GetHostName()].push_back(directory);
+  m_count++;
+  m_pending++;
+  return directory;
+}
+
+void CVideoScanEnumerator::Start()
+{
+  CSingleLock lock(m_section);
+  m_startTime = m_endTime = XbmcThreads::SystemClockMillis();
+  StartNext();
+}
+
+void CVideoScanEnumerator::Abort()
+{
+  CSingleLock lock(m_section);
+  m_aborted = true;
+
+  // nobody waits for the directories that will never be read
+  for (std::map<std::string, std::deque<ScanDirectoryPtr> >::iterator it = m_queued.begin(); it != m_queued.end(); ++it)
+  {
+    for (std::deque<ScanDirectoryPtr>::const_iterator directory = it->second.begin(); directory != it->second.end(); ++directory)
+      m_directories.erase((*directory)->path);
+    it->second.clear();
+  }
+}
+
+ScanDirectoryPtr CVideoScanEnumerator::Get(const std::string &path) const
+{
+  CSingleLock lock(m_section);
+  std::map<std::string, ScanDirectoryPtr>::const_iterator it = m_directories.find(path);
+  if (it == m_directories.end() || !it->second->started)
+    return ScanDirectoryPtr();
+
+  return it->second;
+}
+
+ScanDirectoryPtr CVideoScanEnumerator::Take(const std::string &path)
+{
+  CSingleLock lock(m_section);
+  std::map<std::string, ScanDirectoryPtr>::iterator it = m_directories.find(path);
+  if (it == m_directories.end())
+    return ScanDirectoryPtr();
+
+  ScanDirectoryPtr directory = it->second;
+  m_directories.erase(it);
+
+  if (directory->started)
+  {
+    m_readAhead--;
+    StartNext();
+  }
+  else
+  { // the scanner got here first and reads it itself
+    std::deque<ScanDirectoryPtr> &queued = m_queued[CURL(path).GetHostName()];
+    queued.erase(std::remove(queued.begin(), queued.end(), directory), queued.end());
+    m_pending--;
+  }
+
+  return directory;
+}
+
+void CVideoScanEnumerator::Enumerate(SScanDirectory &directory)
+{
+  if (g_advancedSettings.m_bVideoLibraryUseFastHash)
+    directory.fastHash = CVideoInfoScanner::GetFastHash(directory.path, directory.excludes);
+
+  if (!directory.fastHash.empty() && directory.fastHash == directory.dbHash)
+  { // fast hashes match - no need to list the directory
+    directory.hash = directory.fastHash;
+    return;
+  }
+
+  XFILE::CDirectory::GetDirectory(directory.path, directory.items, g_advancedSettings.m_videoExtensions);
+  directory.items.Stack();
+  directory.listed = true;
+
+  // check whether to re-use previously computed fast hash
+  if (!CVideoInfoScanner::CanFastHash(directory.items, directory.excludes) || directory.fastHash.empty())
+    CVideoInfoScanner::GetPathHash(directory.items, directory.hash);
+  else
+    directory.hash = directory.fastHash;
+}
+
+unsigned int CVideoScanEnumerator::GetDirectoryCount() const
+{
+  CSingleLock lock(m_section);
+  return m_count;
+}
+
+unsigned int CVideoScanEnumerator::GetListedCount() const
+{
+  CSingleLock lock(m_section);
+  return m_listed;
+}
+
+unsigned int CVideoScanEnumerator::GetElapsedMs() const
+{
+  CSingleLock lock(m_section);
+  if (m_pending > 0 && !m_aborted)
+    return XbmcThreads::SystemClockMillis() - m_startTime;
+
+  return m_endTime - m_startTime;
+}
+
+void CVideoScanEnumerator::OnDirectoryDone(const std::string &host, bool listed)
+{
+  CSingleLock lock(m_section);
+  m_pending--;
+  m_running[host]--;
+  if (listed)
+    m_listed++;
+  m_endTime = XbmcThreads::SystemClockMillis();
+
+  StartNext();
+}
+
+void CVideoScanEnumerator::StartNext()
+{
+  // m_section is held
+  for (std::map<std::string, std::deque<ScanDirectoryPtr> >::iterator it = m_queued.begin(); it != m_queued.end(); ++it)
+  {
+    std::deque<ScanDirectoryPtr> &queued = it->second;
+    int &running = m_running[it->first];
+    while (!m_aborted && !queued.empty() && running < m_connectionsPerHost && m_readAhead < m_maxReadAhead)
+    {
+      ScanDirectoryPtr directory = queued.front();
+      queued.pop_front();
+      directory->started = true;
+      running++;
+      m_readAhead++;
+      CJobManager::GetInstance().AddJob(new CVideoScanEnumeratorJob(shared_from_this(), directory, it->first), NULL, CJob::PRIORITY_DEDICATED);
+    }
+  }
+}
@@ -0,0 +1,138 @@
+#pragma once
+/*
+ *      Copyright (C) 2005-2013 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "FileItem.h"
+#include "VideoInfoScanner.h"
+#include "addons/Scraper.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+
+namespace VIDEO
+{
+  /*!
+   \brief Listing and hash of a directory, read ahead of the scan.
+   */
+  struct SScanDirectory
+  {
+    SScanDirectory() : foundDirectly(false), listed(false), started(false), done(true) { }
+
+    std::string path;
+    std::string dbHash;                ///< hash in the database, empty for a new directory
+    std::vector<std::string> excludes; ///< exclude expressions of the directory's content
+    ADDON::ScraperPtr scraper;         ///< scraper of the directory, as looked up by the scanner
+    SScanSettings settings;            ///< scan settings that came with scraper
+    bool foundDirectly;                ///< whether scraper is set for the directory itself
+    std::string fastHash;              ///< empty if fast hashing is off or not possible
+    std::string hash;                  ///< empty if the directory is empty or doesn't exist
+    CFileItemList items;               ///< the listing, only read if the fast hash changed
+    bool listed;                       ///< whether items was read
+    bool started;                      ///< whether the enumerator started reading it
+    CEvent done;                       ///< set once the directory has been read
+  };
+  typedef std::shared_ptr<SScanDirectory> ScanDirectoryPtr;
+
+  /*!
+   \brief Lists and hashes the directories of a movie or music video scan ahead of the scanner.
+
+   Directories are read on dedicated workers, at most connectionsPerHost of the same host
+   at once so a single NAS isn't flooded with requests. A directory whose fast hash still
+   matches the database isn't listed at all. The scanner thread picks the results up with
+   Take() and only has to compare hashes and scrape what changed. At most maxReadAhead
+   directories are read or held ahead of the scanner, the next one is started when the
+   scanner takes one.
+   */
+  class CVideoScanEnumerator : public std::enable_shared_from_this<CVideoScanEnumerator>
+  {
+  public:
+    explicit CVideoScanEnumerator(int connectionsPerHost, unsigned int maxReadAhead = 32);
+
+    /*!
+     \brief Queue a directory, must be called before Start().
+     \param path the directory to read
+     \param dbHash the hash of the directory in the database
+     \param excludes exclude expressions for the content of the directory
+     \return the queued directory, its scraper may be filled in until Start() is called
+     */
+    ScanDirectoryPtr Add(const std::string &path, const std::string &dbHash, const std::vector<std::string> &excludes);
+
+    /*!
+     \brief Start reading the queued directories.
+     */
+    void Start();
+
+    /*!
+     \brief Stop starting further directories, the ones being read are finished.
+     */
+    void Abort();
+
+    /*!
+     \brief Get a directory that is being read, wait for its done event before using it.
+     \return the directory, or NULL if it wasn't queued, isn't started yet or was taken
+     */
+    ScanDirectoryPtr Get(const std::string &path) const;
+
+    /*!
+     \brief Take a queued directory over from the enumerator, which makes room to read the next one.
+     If the directory hasn't been started it never will be, the caller reads it with Enumerate().
+     Otherwise wait for its done event before using it.
+     \return the directory, or NULL if it wasn't queued or was taken already
+     */
+    ScanDirectoryPtr Take(const std::string &path);
+
+    /*!
+     \brief Read a directory the way CVideoInfoScanner::DoScan does.
+     */
+    static void Enumerate(SScanDirectory &directory);
+
+    unsigned int GetDirectoryCount() const;
+    unsigned int GetListedCount() const;
+    /*!
+     \brief Time from Start() until the last directory was read, or until now if some are left.
+     */
+    unsigned int GetElapsedMs() const;
+
+  private:
+    friend class CVideoScanEnumeratorJob;
+
+    void OnDirectoryDone(const std::string &host, bool listed);
+    void StartNext();
+
+    int m_connectionsPerHost;
+    unsigned int m_maxReadAhead;
+    bool m_aborted;
+    unsigned int m_startTime;
+    unsigned int m_endTime;
+    unsigned int m_count;
+    unsigned int m_pending;
+    unsigned int m_listed;
+    unsigned int m_readAhead;                                      ///< directories started and not taken yet
+    std::map<std::string, ScanDirectoryPtr> m_directories;         ///< directories not taken yet
+    std::map<std::string, std::deque<ScanDirectoryPtr> > m_queued; ///< directories not started yet, by host
+    std::map<std::string, int> m_running;                          ///< directories being read, by host
+    mutable CCriticalSection m_section;
+  };
+}
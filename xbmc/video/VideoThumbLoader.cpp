@@ -519,7 +519,7 @@ bool CVideoThumbLoader::FillLibraryArt(CFileItem &item)
     }
     m_videoDatabase->Close();
   }
-  return !item.GetArt().empty();
+  return item.HasArt();
 }
 
 bool CVideoThumbLoader::FillThumb(CFileItem &item)
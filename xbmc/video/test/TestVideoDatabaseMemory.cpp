@@ -0,0 +1,126 @@
+/*
+ *      Copyright (C) 2005-2013 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "system.h"
+
+#if defined(TARGET_LINUX)
+#include <malloc.h>
+#endif
+
+#include <iostream>
+#include <map>
+#include <string>
+
+#include "FileItem.h"
+#include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
+#include "settings/AdvancedSettings.h"
+#include "utils/InternedString.h"
+#include "utils/Stopwatch.h"
+#include "utils/StringUtils.h"
+#include "video/VideoDatabase.h"
+
+#include "gtest/gtest.h"
+
+#define BENCHMARK_DATABASE    "TestVideoDatabaseMemory"
+#define BENCHMARK_MOVIES      2000
+
+namespace
+{
+  // bytes handed out by malloc, or 0 if unknown
+  size_t GetAllocatedBytes()
+  {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    return mallinfo2().uordblks;
+#elif defined(TARGET_LINUX)
+    return mallinfo().uordblks;
+#else
+    return 0;
+#endif
+  }
+}
+
+class TestVideoDatabaseMemory : public ::testing::Test
+{
+protected:
+  static CVideoDatabase *database;
+
+  // the database is filled once for all tests of the suite
+  static void SetUpTestCase()
+  {
+    DatabaseSettings settings;
+    settings.type = "sqlite3";
+    settings.name = BENCHMARK_DATABASE;
+    settings.host = CSpecialProtocol::TranslatePath("special://temp/");
+
+    database = new CVideoDatabase;
+    ASSERT_TRUE(database->Connect(BENCHMARK_DATABASE, settings, true));
+
+    database->BeginTransaction();
+    for (int i = 0; i < BENCHMARK_MOVIES; i++)
+    {
+      CVideoInfoTag details;
+      details.SetTitle(StringUtils::Format("Movie %i", i));
+      details.SetPlot(StringUtils::Format("The plot of movie %i.", i));
+      details.SetYear(1950 + i % 60);
+      details.SetGenre(StringUtils::Split(i % 2 ? "Drama / Comedy" : "Action", " / "));
+
+      std::map<std::string, std::string> art;
+      art["thumb"] = StringUtils::Format("/movies/%i/poster.jpg", i);
+      art["fanart"] = StringUtils::Format("/movies/%i/fanart.jpg", i);
+      database->SetDetailsForMovie(StringUtils::Format("/movies/%i/movie.mkv", i), details, art);
+    }
+    ASSERT_TRUE(database->CommitTransaction());
+  }
+
+  static void TearDownTestCase()
+  {
+    database->Close();
+    delete database;
+    database = NULL;
+    XFILE::CFile::Delete("special://temp/" BENCHMARK_DATABASE ".db");
+  }
+};
+
+CVideoDatabase *TestVideoDatabaseMemory::database = NULL;
+
+TEST_F(TestVideoDatabaseMemory, Benchmark)
+{
+  CVideoDatabase::Filter filter;
+  size_t allocated = GetAllocatedBytes();
+  size_t pool = CInternedString::GetPoolSize();
+
+  CStopWatch timer;
+  timer.StartZero();
+  CFileItemList *items = new CFileItemList;
+  EXPECT_TRUE(database->GetMoviesByWhere("videodb://movies/titles/", filter, *items));
+  float elapsed = timer.GetElapsedSeconds();
+  allocated = GetAllocatedBytes() - allocated;
+  EXPECT_EQ(BENCHMARK_MOVIES, items->Size());
+
+  std::cout << items->Size() << " movies in " << testing::PrintToString(elapsed) << " s, "
+            << "sizeof(CFileItem) " << sizeof(CFileItem) << ", "
+            << "sizeof(CVideoInfoTag) " << sizeof(CVideoInfoTag) << ", "
+            << allocated / 1024 << " KiB allocated, "
+            << (items->Size() ? allocated / items->Size() : 0) << " bytes per item, "
+            << CInternedString::GetPoolSize() - pool << " new interned strings" << std::endl;
+
+  delete items;
+}
@@ -0,0 +1,109 @@
+/*
+ *      Copyright (C) 2005-2013 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
+#include "utils/URIUtils.h"
+#include "video/VideoScanEnumerator.h"
+
+#include "gtest/gtest.h"
+
+using namespace VIDEO;
+
+static ScanDirectoryPtr EnumerateDirectory(const std::string &path, const std::string &dbHash)
+{
+  std::shared_ptr<CVideoScanEnumerator> enumerator(new CVideoScanEnumerator(2));
+  enumerator->Add(path, dbHash, std::vector<std::string>());
+  enumerator->Start();
+
+  ScanDirectoryPtr directory = enumerator->Get(path);
+  if (directory)
+    EXPECT_TRUE(directory->done.WaitMSec(10000));
+  EXPECT_EQ(nullptr, enumerator->Get(path + "missing/"));
+  return directory;
+}
+
+TEST(TestVideoScanEnumerator, Enumerate)
+{
+  std::string path = URIUtils::AddFileToFolder(CSpecialProtocol::TranslatePath("special://temp/"), "TestVideoScanEnumerator");
+  URIUtils::AddSlashAtEnd(path);
+  ASSERT_TRUE(XFILE::CDirectory::Create(path));
+
+  XFILE::CFile file;
+  ASSERT_TRUE(file.OpenForWrite(URIUtils::AddFileToFolder(path, "movie1.mkv"), true));
+  file.Close();
+  ASSERT_TRUE(file.OpenForWrite(URIUtils::AddFileToFolder(path, "movie2.mkv"), true));
+  file.Close();
+
+  // a new directory is listed and hashed
+  ScanDirectoryPtr directory = EnumerateDirectory(path, "");
+  ASSERT_NE(nullptr, directory);
+  EXPECT_TRUE(directory->listed);
+  EXPECT_EQ(2, directory->items.Size());
+  EXPECT_FALSE(directory->hash.empty());
+
+  // an unchanged one isn't listed again
+  std::string hash = directory->hash;
+  directory = EnumerateDirectory(path, hash);
+  ASSERT_NE(nullptr, directory);
+  EXPECT_FALSE(directory->listed);
+  EXPECT_EQ(0, directory->items.Size());
+  EXPECT_EQ(hash, directory->hash);
+
+  EXPECT_TRUE(XFILE::CDirectory::RemoveRecursive(path));
+}
+
+TEST(TestVideoScanEnumerator, ReadAhead)
+{
+  std::string path = URIUtils::AddFileToFolder(CSpecialProtocol::TranslatePath("special://temp/"), "TestVideoScanEnumerator");
+  std::string pathA = URIUtils::AddFileToFolder(path, "a/");
+  std::string pathB = URIUtils::AddFileToFolder(path, "b/");
+  std::string pathC = URIUtils::AddFileToFolder(path, "c/");
+
+  // only one directory is read ahead of the scanner
+  std::shared_ptr<CVideoScanEnumerator> enumerator(new CVideoScanEnumerator(2, 1));
+  enumerator->Add(pathA, "", std::vector<std::string>());
+  enumerator->Add(pathB, "", std::vector<std::string>());
+  enumerator->Add(pathC, "", std::vector<std::string>());
+  enumerator->Start();
+
+  ScanDirectoryPtr directory = enumerator->Get(pathA);
+  ASSERT_NE(nullptr, directory);
+  EXPECT_TRUE(directory->done.WaitMSec(10000));
+  EXPECT_EQ(nullptr, enumerator->Get(pathB));
+
+  // a directory the scanner takes before it's started is left to the scanner
+  directory = enumerator->Take(pathC);
+  ASSERT_NE(nullptr, directory);
+  EXPECT_FALSE(directory->started);
+  EXPECT_EQ(nullptr, enumerator->Take(pathC));
+
+  // taking the one that was read starts the next
+  directory = enumerator->Take(pathA);
+  ASSERT_NE(nullptr, directory);
+  EXPECT_TRUE(directory->started);
+  EXPECT_EQ(nullptr, enumerator->Get(pathA));
+  directory = enumerator->Get(pathB);
+  ASSERT_NE(nullptr, directory);
+  EXPECT_TRUE(directory->done.WaitMSec(10000));
+  EXPECT_EQ(nullptr, enumerator->Get(pathC));
+  EXPECT_EQ(3U, enumerator->GetDirectoryCount());
+}